@@ -1,5 +1,6 @@
 //Gets autoregressive (AR) params from the autocorrelation (AC) function for each vector in X.
 //Uses a Levinson-Durbin recursion from the AC values.
+//For more than one vec, the recursion is run for 8 vecs at once (see levdurb_lanes.c).
 
 //The complex-valued case here uses multiply and divide with no conjugation.
 //This matches the real-valued case (i.e., make a complex-valued input with 0 imaginary parts),
@@ -7,6 +8,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "levdurb_lanes.c"
 #include <math.h>
 
 #ifdef __cplusplus
@@ -55,54 +57,40 @@ int ac2ar_s (float *Y, float *E, const float *X, const size_t R, const size_t C,
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/Lx, G = V/B;
+            const size_t V = N/Lx, NL = LEVDURB_NL;
+            size_t v;
+            float *ACb, *ARb, *Ab, Eb[LEVDURB_NL];
+            if (!(ACb=(float *)malloc(Lx*NL*sizeof(float)))) { fprintf(stderr,"error in ac2ar_s: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(ARb=(float *)malloc(P*NL*sizeof(float)))) { fprintf(stderr,"error in ac2ar_s: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(Ab=(float *)malloc(P*NL*sizeof(float)))) { fprintf(stderr,"error in ac2ar_s: problem with malloc. "); perror("malloc"); return 1; }
 
-            if (K==1u && (G==1u || B==1u))
+            for (size_t v0=0u; v0<V; v0+=NL)
             {
-                for (size_t v=V; v>0u; --v, Y+=P, ++E)
+                //Transpose ACFs of NL vecs into lane-major order (a partial block repeats its first vec)
+                for (size_t n=0u; n<NL; ++n)
                 {
-                    e = *X++;
-                    *Y = *X / e; a = -*Y;
-                    e += a * *X++;
-                    for (size_t p=1u; p<P; ++p, X+=p)
+                    if (v0+n<V)
                     {
-                        a = *X;
-                        for (size_t q=p; q>0u; --q, ++Y) { --X; a -= *X * *Y; }
-                        a /= -e;
-                        *Y = -a;
-                        for (size_t q=p; q>0u; --q, ++A) { --Y; *A = *Y; }
-                        Y += p;
-                        for (size_t q=p; q>0u; --q) { --A; --Y; *Y += a * *A; }
-                        e *= 1.0f - a*a;
+                        v = v0 + n;
+                        const float *Xv = &X[(v/K)*K*Lx+v%K];
+                        for (size_t l=0u; l<Lx; ++l) { ACb[l*NL+n] = Xv[l*K]; }
                     }
-                    *E = e;
+                    else { for (size_t l=0u; l<Lx; ++l) { ACb[l*NL+n] = ACb[l*NL]; } }
                 }
-            }
-            else
-            {
-                for (size_t g=G; g>0u; --g, X+=B*P, Y+=B*(P-1u))
+
+                //Get AR params and error vars (Lev-Durb)
+                levdurb_lanes_s(ARb,NULL,Eb,ACb,Ab,P);
+
+                //Transpose back to Y and E
+                for (size_t n=0u; n<NL && v0+n<V; ++n)
                 {
-                    for (size_t b=B; b>0u; --b, X-=K*Lx-1u, ++Y, ++E)
-                    {
-                        e = *X; X += K;
-                        *Y = *X / e; a = -*Y;
-                        e += a * *X; X += K;
-                        for (size_t p=1u; p<P; ++p, X+=p*K)
-                        {
-                            a = *X;
-                            for (size_t q=p; q>0u; --q, Y+=K) { X-=K; a -= *X * *Y; }
-                            a /= -e;
-                            *Y = -a;
-                            for (size_t q=p; q>0u; --q, ++A) { Y-=K; *A = *Y; }
-                            Y += p*K;
-                            for (size_t q=p; q>0u; --q) { --A; Y-=K; *Y += a * *A; }
-                            e *= 1.0f - a*a;
-                        }
-                        *E = e;
-                    }
+                    v = v0 + n;
+                    float *Yv = &Y[(v/K)*K*P+v%K];
+                    for (size_t p=0u; p<P; ++p) { Yv[p*K] = ARb[p*NL+n]; }
+                    E[v] = Eb[n];
                 }
             }
+            free(ACb); free(ARb); free(Ab);
         }
         free(A);
     }
@@ -147,54 +135,40 @@ int ac2ar_d (double *Y, double *E, const double *X, const size_t R, const size_t
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/Lx, G = V/B;
+            const size_t V = N/Lx, NL = LEVDURB_NL;
+            size_t v;
+            double *ACb, *ARb, *Ab, Eb[LEVDURB_NL];
+            if (!(ACb=(double *)malloc(Lx*NL*sizeof(double)))) { fprintf(stderr,"error in ac2ar_d: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(ARb=(double *)malloc(P*NL*sizeof(double)))) { fprintf(stderr,"error in ac2ar_d: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(Ab=(double *)malloc(P*NL*sizeof(double)))) { fprintf(stderr,"error in ac2ar_d: problem with malloc. "); perror("malloc"); return 1; }
 
-            if (K==1u && (G==1u || B==1u))
+            for (size_t v0=0u; v0<V; v0+=NL)
             {
-                for (size_t v=V; v>0u; --v, Y+=P, ++E)
+                //Transpose ACFs of NL vecs into lane-major order (a partial block repeats its first vec)
+                for (size_t n=0u; n<NL; ++n)
                 {
-                    e = *X++;
-                    *Y = *X / e; a = -*Y;
-                    e += a * *X++;
-                    for (size_t p=1u; p<P; ++p, X+=p)
+                    if (v0+n<V)
                     {
-                        a = *X;
-                        for (size_t q=p; q>0u; --q, ++Y) { --X; a -= *X * *Y; }
-                        a /= -e;
-                        *Y = -a;
-                        for (size_t q=p; q>0u; --q, ++A) { --Y; *A = *Y; }
-                        Y += p;
-                        for (size_t q=p; q>0u; --q) { --A; --Y; *Y += a * *A; }
-                        e *= 1.0 - a*a;
+                        v = v0 + n;
+                        const double *Xv = &X[(v/K)*K*Lx+v%K];
+                        for (size_t l=0u; l<Lx; ++l) { ACb[l*NL+n] = Xv[l*K]; }
                     }
-                    *E = e;
+                    else { for (size_t l=0u; l<Lx; ++l) { ACb[l*NL+n] = ACb[l*NL]; } }
                 }
-            }
-            else
-            {
-                for (size_t g=G; g>0u; --g, X+=B*P, Y+=B*(P-1u))
+
+                //Get AR params and error vars (Lev-Durb)
+                levdurb_lanes_d(ARb,NULL,Eb,ACb,Ab,P);
+
+                //Transpose back to Y and E
+                for (size_t n=0u; n<NL && v0+n<V; ++n)
                 {
-                    for (size_t b=B; b>0u; --b, X-=K*Lx-1u, ++Y, ++E)
-                    {
-                        e = *X; X += K;
-                        *Y = *X / e; a = -*Y;
-                        e += a * *X; X += K;
-                        for (size_t p=1u; p<P; ++p, X+=p*K)
-                        {
-                            a = *X;
-                            for (size_t q=p; q>0u; --q, Y+=K) { X-=K; a -= *X * *Y; }
-                            a /= -e;
-                            *Y = -a;
-                            for (size_t q=p; q>0u; --q, ++A) { Y-=K; *A = *Y; }
-                            Y += p*K;
-                            for (size_t q=p; q>0u; --q) { --A; Y-=K; *Y += a * *A; }
-                            e *= 1.0 - a*a;
-                        }
-                        *E = e;
-                    }
+                    v = v0 + n;
+                    double *Yv = &Y[(v/K)*K*P+v%K];
+                    for (size_t p=0u; p<P; ++p) { Yv[p*K] = ARb[p*NL+n]; }
+                    E[v] = Eb[n];
                 }
             }
+            free(ACb); free(ARb); free(Ab);
         }
         free(A);
     }
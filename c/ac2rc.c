@@ -1,5 +1,6 @@
 //Gets reflection coefficients (RCs) from the autocorrelation (AC) function for each vector in X.
 //Uses a Levinson-Durbin recursion from the AC values.
+//For more than one vec, the recursion is run for 8 vecs at once (see levdurb_lanes.c).
 
 //This adopts levinson.m from Octave's signal package as the correct answer, including the sign convention.
 //This even matches Octave for some pathological cases giving Inf and/or NaN.
@@ -7,6 +8,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "levdurb_lanes.c"
 #include <math.h>
 
 #ifdef __cplusplus
@@ -53,11 +55,15 @@ int ac2rc_s (float *Y, float *E, const float *X, const size_t R, const size_t C,
                 for (size_t q=p; q>0u; --q) { --A2; --A1; *A1 += a * *A2; }
                 e *= 1.0f - a*a;
             }
-            a = *X;
-            for (size_t q=P; q>0u; --q, ++A1) { --X; a += *X * *A1; }
-            A1 -= P;
-            a /= -e; *Y = a;
-            *E = e * (1.0f-a*a);
+            if (P>1u)
+            {
+                a = *X;
+                for (size_t q=P-1u; q>0u; --q, ++A1) { --X; a += *X * *A1; }
+                A1 -= P-1u;
+                a /= -e; *Y = a;
+                *E = e * (1.0f-a*a);
+            }
+            else { *E = e; }
 
             //This has approx. same speed, but assembly code definitely longer
             // A1[0] = 1.0f;
@@ -81,64 +87,41 @@ int ac2rc_s (float *Y, float *E, const float *X, const size_t R, const size_t C,
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/Lx, G = V/B;
+            const size_t V = N/Lx, NL = LEVDURB_NL;
+            size_t v;
+            float *ACb, *ARb, *Ab, *RCb, Eb[LEVDURB_NL];
+            if (!(ACb=(float *)malloc(Lx*NL*sizeof(float)))) { fprintf(stderr,"error in ac2rc_s: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(ARb=(float *)malloc(P*NL*sizeof(float)))) { fprintf(stderr,"error in ac2rc_s: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(RCb=(float *)malloc(P*NL*sizeof(float)))) { fprintf(stderr,"error in ac2rc_s: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(Ab=(float *)malloc(P*NL*sizeof(float)))) { fprintf(stderr,"error in ac2rc_s: problem with malloc. "); perror("malloc"); return 1; }
 
-            if (K==1u && (G==1u || B==1u))
+            for (size_t v0=0u; v0<V; v0+=NL)
             {
-                for (size_t v=V; v>0u; --v, X+=Lx, ++Y, ++E)
+                //Transpose ACFs of NL vecs into lane-major order (a partial block repeats its first vec)
+                for (size_t n=0u; n<NL; ++n)
                 {
-                    e = *X++;
-                    a = -*X / e;
-                    *Y++ = *A1 = a;
-                    e += a * *X++;
-                    for (size_t p=1u; p<P-1u; ++p, X+=p)
+                    if (v0+n<V)
                     {
-                        a = *X;
-                        for (size_t q=p; q>0u; --q, ++A1) { --X; a += *X * *A1; }
-                        a /= -e;
-                        *A1 = a; *Y++ = a;
-                        for (size_t q=p; q>0u; --q, ++A2) { --A1; *A2 = *A1; }
-                        A1 += p;
-                        for (size_t q=p; q>0u; --q) { --A2; --A1; *A1 += a * *A2; }
-                        e *= 1.0f - a*a;
+                        v = v0 + n;
+                        const float *Xv = &X[(v/K)*K*Lx+v%K];
+                        for (size_t l=0u; l<Lx; ++l) { ACb[l*NL+n] = Xv[l*K]; }
                     }
-                    a = *X;
-                    for (size_t q=P; q>0u; --q, ++A1) { --X; a += *X * *A1; }
-                    A1 -= P;
-                    a /= -e; *Y = a;
-                    *E = e * (1.0f-a*a);
+                    else { for (size_t l=0u; l<Lx; ++l) { ACb[l*NL+n] = ACb[l*NL]; } }
                 }
-            }
-            else
-            {
-                for (size_t g=G; g>0u; --g, X+=B*(Lx-1u), Y+=B*(P-1u))
+
+                //Get RCs and error vars (Lev-Durb)
+                levdurb_lanes_s(ARb,RCb,Eb,ACb,Ab,P);
+
+                //Transpose back to Y and E
+                for (size_t n=0u; n<NL && v0+n<V; ++n)
                 {
-                    for (size_t b=B; b>0u; --b, ++X, Y-=K*P-K-1u, ++E)
-                    {
-                        e = *X; X += K;
-                        a = -*X / e;
-                        *Y = *A1 = a; Y += K;
-                        e += a * *X; X += K;
-                        for (size_t p=1u; p<P-1u; ++p, X+=p*K)
-                        {
-                            a = *X;
-                            for (size_t q=p; q>0u; --q, ++A1) { X-=K; a += *X * *A1; }
-                            a /= -e;
-                            *A1 = a; *Y = a; Y += K;
-                            for (size_t q=p; q>0u; --q, ++A2) { --A1; *A2 = *A1; }
-                            A1 += p;
-                            for (size_t q=p; q>0u; --q) { --A2; --A1; *A1 += a * *A2; }
-                            e *= 1.0f - a*a;
-                        }
-                        a = *X;
-                        for (size_t q=P; q>0u; --q, ++A1) { X-=K; a += *X * *A1; }
-                        A1 -= P;
-                        a /= -e; *Y = a;
-                        *E = e * (1.0f-a*a);
-                    }
+                    v = v0 + n;
+                    float *Yv = &Y[(v/K)*K*P+v%K];
+                    for (size_t p=0u; p<P; ++p) { Yv[p*K] = RCb[p*NL+n]; }
+                    E[v] = Eb[n];
                 }
             }
+            free(ACb); free(ARb); free(RCb); free(Ab);
         }
         free(A1); free(A2);
     }
@@ -180,73 +163,54 @@ int ac2rc_d (double *Y, double *E, const double *X, const size_t R, const size_t
                 for (size_t q=p; q>0u; --q) { --A2; --A1; *A1 += a * *A2; }
                 e *= 1.0 - a*a;
             }
-            a = *X;
-            for (size_t q=P; q>0u; --q, ++A1) { --X; a += *X * *A1; }
-            A1 -= P;
-            a /= -e; *Y = a;
-            *E = e * (1.0-a*a);
+            if (P>1u)
+            {
+                a = *X;
+                for (size_t q=P-1u; q>0u; --q, ++A1) { --X; a += *X * *A1; }
+                A1 -= P-1u;
+                a /= -e; *Y = a;
+                *E = e * (1.0-a*a);
+            }
+            else { *E = e; }
         }
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/Lx, G = V/B;
+            const size_t V = N/Lx, NL = LEVDURB_NL;
+            size_t v;
+            double *ACb, *ARb, *Ab, *RCb, Eb[LEVDURB_NL];
+            if (!(ACb=(double *)malloc(Lx*NL*sizeof(double)))) { fprintf(stderr,"error in ac2rc_d: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(ARb=(double *)malloc(P*NL*sizeof(double)))) { fprintf(stderr,"error in ac2rc_d: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(RCb=(double *)malloc(P*NL*sizeof(double)))) { fprintf(stderr,"error in ac2rc_d: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(Ab=(double *)malloc(P*NL*sizeof(double)))) { fprintf(stderr,"error in ac2rc_d: problem with malloc. "); perror("malloc"); return 1; }
 
-            if (K==1u && (G==1u || B==1u))
+            for (size_t v0=0u; v0<V; v0+=NL)
             {
-                for (size_t v=V; v>0u; --v, X+=Lx, ++Y, ++E)
+                //Transpose ACFs of NL vecs into lane-major order (a partial block repeats its first vec)
+                for (size_t n=0u; n<NL; ++n)
                 {
-                    e = *X++;
-                    a = -*X / e;
-                    *Y++ = *A1 = a;
-                    e += a * *X++;
-                    for (size_t p=1u; p<P-1u; ++p, X+=p)
+                    if (v0+n<V)
                     {
-                        a = *X;
-                        for (size_t q=p; q>0u; --q, ++A1) { --X; a += *X * *A1; }
-                        a /= -e;
-                        *A1 = a; *Y++ = a;
-                        for (size_t q=p; q>0u; --q, ++A2) { --A1; *A2 = *A1; }
-                        A1 += p;
-                        for (size_t q=p; q>0u; --q) { --A2; --A1; *A1 += a * *A2; }
-                        e *= 1.0 - a*a;
+                        v = v0 + n;
+                        const double *Xv = &X[(v/K)*K*Lx+v%K];
+                        for (size_t l=0u; l<Lx; ++l) { ACb[l*NL+n] = Xv[l*K]; }
                     }
-                    a = *X;
-                    for (size_t q=P; q>0u; --q, ++A1) { --X; a += *X * *A1; }
-                    A1 -= P;
-                    a /= -e; *Y = a;
-                    *E = e * (1.0-a*a);
+                    else { for (size_t l=0u; l<Lx; ++l) { ACb[l*NL+n] = ACb[l*NL]; } }
                 }
-            }
-            else
-            {
-                for (size_t g=G; g>0u; --g, X+=B*(Lx-1u), Y+=B*(P-1u))
+
+                //Get RCs and error vars (Lev-Durb)
+                levdurb_lanes_d(ARb,RCb,Eb,ACb,Ab,P);
+
+                //Transpose back to Y and E
+                for (size_t n=0u; n<NL && v0+n<V; ++n)
                 {
-                    for (size_t b=B; b>0u; --b, ++X, Y-=K*P-K-1u, ++E)
-                    {
-                        e = *X; X += K;
-                        a = -*X / e;
-                        *Y = *A1 = a; Y += K;
-                        e += a * *X; X += K;
-                        for (size_t p=1u; p<P-1u; ++p, X+=p*K)
-                        {
-                            a = *X;
-                            for (size_t q=p; q>0u; --q, ++A1) { X-=K; a += *X * *A1; }
-                            a /= -e;
-                            *A1 = a; *Y = a; Y += K;
-                            for (size_t q=p; q>0u; --q, ++A2) { --A1; *A2 = *A1; }
-                            A1 += p;
-                            for (size_t q=p; q>0u; --q) { --A2; --A1; *A1 += a * *A2; }
-                            e *= 1.0 - a*a;
-                        }
-                        a = *X;
-                        for (size_t q=P; q>0u; --q, ++A1) { X-=K; a += *X * *A1; }
-                        A1 -= P;
-                        a /= -e; *Y = a;
-                        *E = e * (1.0-a*a);
-                    }
+                    v = v0 + n;
+                    double *Yv = &Y[(v/K)*K*P+v%K];
+                    for (size_t p=0u; p<P; ++p) { Yv[p*K] = RCb[p*NL+n]; }
+                    E[v] = Eb[n];
                 }
             }
+            free(ACb); free(ARb); free(RCb); free(Ab);
         }
         free(A1); free(A2);
     }
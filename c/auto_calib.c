@@ -0,0 +1,159 @@
+//Calibrates the cost-model constants used by the *_auto front doors,
+//and prints a new auto_cost.h to stdout. This is a standalone program (not a library function).
+//It is run by "make calib", which overwrites c/auto_cost.h, after which the *_auto tools are rebuilt.
+
+//The direct costs (ns per multiply-accumulate) are timed with a single vec of length 2^14 and L2 = 64.
+//For fir, the complex cost (per complex multiply-accumulate) is also timed, since complex fir uses cblas.
+//The FFT and PLAN costs are solved from 2 timings of fir_fft (short and long vecs),
+//using the same cost formula as fir_auto (3 plans + (1+3V) FFTs of length nfft).
+//Each timing is the min over several reps, to reduce the effect of other processes.
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "conv.c"
+#include "conv1d.c"
+#include "fir.c"
+#include "fir_fft.c"
+#include "sig2ac.c"
+
+#ifdef __cplusplus
+using namespace codee;
+#endif
+
+#define AUTO_CALIB_REPS 7
+
+static double auto_calib_now (void);
+static void auto_calib_fill_s (float *X, const size_t N);
+static void auto_calib_fill_d (double *X, const size_t N);
+
+
+static double auto_calib_now (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC,&ts);
+    return 1e9*(double)ts.tv_sec + (double)ts.tv_nsec;
+}
+
+
+static void auto_calib_fill_s (float *X, const size_t N)
+{
+    for (size_t n=0u; n<N; ++n) { X[n] = (float)rand()/(float)RAND_MAX - 0.5f; }
+}
+
+
+static void auto_calib_fill_d (double *X, const size_t N)
+{
+    for (size_t n=0u; n<N; ++n) { X[n] = (double)rand()/(double)RAND_MAX - 0.5; }
+}
+
+
+//Times one call (expr) as the min over reps, in ns
+#define AUTO_CALIB_TIME(t, expr) \
+    do { \
+        t = 1e300; \
+        for (int rep=0; rep<AUTO_CALIB_REPS; ++rep) \
+        { \
+            const double t0 = auto_calib_now(); \
+            if (expr) { fprintf(stderr,"error in auto_calib: kernel failed\n"); return 1; } \
+            const double t1 = auto_calib_now() - t0; \
+            if (t1<t) { t = t1; } \
+        } \
+    } while (0)
+
+
+int main (void)
+{
+    const size_t L = 16384u, L2 = 64u, Lb = 65536u, Ls = 256u;
+    const size_t Ly = L - L2 + 1u;
+    double t, ts, tl;
+    double conv[2], conv1d[2], fir[4], ac[2], fft[2], plan[2];
+
+    float *Xs, *Hs, *Ys;
+    double *Xd, *Hd, *Yd;
+    if (!(Xs=(float *)malloc(Lb*sizeof(float)))) { fprintf(stderr,"error in auto_calib: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Hs=(float *)malloc(2u*L2*sizeof(float)))) { fprintf(stderr,"error in auto_calib: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Ys=(float *)malloc((Lb+L2)*sizeof(float)))) { fprintf(stderr,"error in auto_calib: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Xd=(double *)malloc(Lb*sizeof(double)))) { fprintf(stderr,"error in auto_calib: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Hd=(double *)malloc(2u*L2*sizeof(double)))) { fprintf(stderr,"error in auto_calib: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Yd=(double *)malloc((Lb+L2)*sizeof(double)))) { fprintf(stderr,"error in auto_calib: problem with malloc. "); perror("malloc"); return 1; }
+    auto_calib_fill_s(Xs,Lb); auto_calib_fill_s(Hs,2u*L2);
+    auto_calib_fill_d(Xd,Lb); auto_calib_fill_d(Hd,2u*L2);
+
+    //Direct costs
+    AUTO_CALIB_TIME(t, conv_s(Ys,Xs,Hs,L,1u,1u,1u,0,L2,"full",0u));
+    conv[0] = t / ((double)L*(double)L2);
+    AUTO_CALIB_TIME(t, conv_d(Yd,Xd,Hd,L,1u,1u,1u,0,L2,"full",0u));
+    conv[1] = t / ((double)L*(double)L2);
+    AUTO_CALIB_TIME(t, conv1d_s(Ys,Xs,Hs,L,1u,1u,1u,0,L2,0,1u,1u,0u));
+    conv1d[0] = t / ((double)Ly*(double)L2);
+    AUTO_CALIB_TIME(t, conv1d_d(Yd,Xd,Hd,L,1u,1u,1u,0,L2,0,1u,1u,0u));
+    conv1d[1] = t / ((double)Ly*(double)L2);
+    AUTO_CALIB_TIME(t, fir_s(Ys,Xs,Hs,L,1u,1u,1u,0,L2-1u,0u));
+    fir[0] = t / ((double)L*(double)L2);
+    AUTO_CALIB_TIME(t, fir_d(Yd,Xd,Hd,L,1u,1u,1u,0,L2-1u,0u));
+    fir[1] = t / ((double)L*(double)L2);
+    AUTO_CALIB_TIME(t, fir_c(Ys,Xs,Hs,L,1u,1u,1u,0,L2-1u,0u));
+    fir[2] = t / ((double)L*(double)L2);
+    AUTO_CALIB_TIME(t, fir_z(Yd,Xd,Hd,L,1u,1u,1u,0,L2-1u,0u));
+    fir[3] = t / ((double)L*(double)L2);
+    AUTO_CALIB_TIME(t, sig2ac_s(Ys,Xs,L,1u,1u,1u,0,0u,L2,0,0,0));
+    ac[0] = t / ((double)L2*(double)L - 0.5*(double)L2*(double)(L2-1u));
+    AUTO_CALIB_TIME(t, sig2ac_d(Yd,Xd,L,1u,1u,1u,0,0u,L2,0,0,0));
+    ac[1] = t / ((double)L2*(double)L - 0.5*(double)L2*(double)(L2-1u));
+
+    //FFT and PLAN costs: t = 3*PLAN + FFT*nfft*log2(nfft)*4 for 1 vec
+    size_t ns = 1u, nl = 1u;
+    while (ns<Ls+L2-1u) { ns *= 2u; }
+    while (nl<Lb+L2-1u) { nl *= 2u; }
+    const double as = 4.0*(double)ns*log2((double)ns), al = 4.0*(double)nl*log2((double)nl);
+    AUTO_CALIB_TIME(ts, fir_fft_s(Ys,Xs,Hs,Ls,1u,1u,1u,0,L2-1u,0u));
+    AUTO_CALIB_TIME(tl, fir_fft_s(Ys,Xs,Hs,Lb,1u,1u,1u,0,L2-1u,0u));
+    fft[0] = (tl-ts) / (al-as);
+    plan[0] = (ts-fft[0]*as) / 3.0;
+    AUTO_CALIB_TIME(ts, fir_fft_d(Yd,Xd,Hd,Ls,1u,1u,1u,0,L2-1u,0u));
+    AUTO_CALIB_TIME(tl, fir_fft_d(Yd,Xd,Hd,Lb,1u,1u,1u,0,L2-1u,0u));
+    fft[1] = (tl-ts) / (al-as);
+    plan[1] = (ts-fft[1]*as) / 3.0;
+    for (int i=0; i<2; ++i)
+    {
+        if (fft[i]<0.01) { fft[i] = 0.01; }
+        if (plan[i]<100.0) { plan[i] = 100.0; }
+    }
+
+    free(Xs); free(Hs); free(Ys); free(Xd); free(Hd); free(Yd);
+
+    //Print auto_cost.h
+    printf("//Cost-model constants for the *_auto front doors (conv_auto, xcorr_auto, conv1d_auto,\n");
+    printf("//xcorr1d_auto, fir_auto, sig2ac_auto), which choose between direct, FFT and OLS methods.\n\n");
+    printf("//All costs are in ns, for real-valued data (s = float, d = double).\n");
+    printf("//The DIR costs are per multiply-accumulate of the direct method of each op.\n");
+    printf("//The FFT cost is per nfft*log2(nfft) of one real-valued FFT (including the pointwise work).\n");
+    printf("//The PLAN cost is for making one fftw plan (FFTW_ESTIMATE) and the allocations.\n");
+    printf("//For complex-valued data, the DIR costs are x4 and the FFT cost is x2,\n");
+    printf("//except for fir, which has its own complex DIR costs (FIR_C, FIR_Z, per complex multiply-accumulate).\n\n");
+    printf("//These are overwritten by \"make calib\" (see c/auto_calib.c),\n");
+    printf("//which times the kernels on the current machine and prints this file.\n");
+    printf("//The values below were calibrated by auto_calib.\n\n");
+    printf("#ifndef AUTO_COST_H\n#define AUTO_COST_H\n\n");
+    printf("#define AUTO_COST_CONV_S %.4g\n", conv[0]);
+    printf("#define AUTO_COST_CONV_D %.4g\n", conv[1]);
+    printf("#define AUTO_COST_CONV1D_S %.4g\n", conv1d[0]);
+    printf("#define AUTO_COST_CONV1D_D %.4g\n", conv1d[1]);
+    printf("#define AUTO_COST_FIR_S %.4g\n", fir[0]);
+    printf("#define AUTO_COST_FIR_D %.4g\n", fir[1]);
+    printf("#define AUTO_COST_FIR_C %.4g\n", fir[2]);
+    printf("#define AUTO_COST_FIR_Z %.4g\n", fir[3]);
+    printf("#define AUTO_COST_SIG2AC_S %.4g\n", ac[0]);
+    printf("#define AUTO_COST_SIG2AC_D %.4g\n", ac[1]);
+    printf("#define AUTO_COST_FFT_S %.4g\n", fft[0]);
+    printf("#define AUTO_COST_FFT_D %.4g\n", fft[1]);
+    printf("#define AUTO_COST_PLAN_S %.1f\n", plan[0]);
+    printf("#define AUTO_COST_PLAN_D %.1f\n", plan[1]);
+    printf("\n#endif\n");
+
+    return 0;
+}
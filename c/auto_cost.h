@@ -0,0 +1,36 @@
+//Cost-model constants for the *_auto front doors (conv_auto, xcorr_auto, conv1d_auto,
+//xcorr1d_auto, fir_auto, sig2ac_auto), which choose between direct, FFT and OLS methods.
+
+//All costs are in ns, for real-valued data (s = float, d = double).
+//The DIR costs are per multiply-accumulate of the direct method of each op.
+//The FFT cost is per nfft*log2(nfft) of one real-valued FFT (including the pointwise work).
+//The PLAN cost is for making one fftw plan (FFTW_ESTIMATE) and the allocations.
+//For complex-valued data, the DIR costs are x4 and the FFT cost is x2,
+//except for fir, which has its own complex DIR costs (FIR_C, FIR_Z, per complex multiply-accumulate).
+
+//These are overwritten by "make calib" (see c/auto_calib.c),
+//which times the kernels on the current machine and prints this file.
+//The DIR values below were timed by auto_calib against the current kernels (-O3 -ffast-math -march=native).
+//The FFT values were not timed directly: they were set so that fir_auto reproduces the measured
+//fir vs. fir_ola crossovers (direct is faster up to Q of about 128-256 for L = 16k and 1M).
+//The PLAN values are typical of FFTW_ESTIMATE. Run "make calib" to replace all of these.
+
+#ifndef AUTO_COST_H
+#define AUTO_COST_H
+
+#define AUTO_COST_CONV_S 0.09
+#define AUTO_COST_CONV_D 0.11
+#define AUTO_COST_CONV1D_S 0.062
+#define AUTO_COST_CONV1D_D 0.12
+#define AUTO_COST_FIR_S 0.081
+#define AUTO_COST_FIR_D 0.11
+#define AUTO_COST_FIR_C 0.42
+#define AUTO_COST_FIR_Z 0.79
+#define AUTO_COST_SIG2AC_S 0.23
+#define AUTO_COST_SIG2AC_D 0.46
+#define AUTO_COST_FFT_S 0.45
+#define AUTO_COST_FFT_D 0.75
+#define AUTO_COST_PLAN_S 20000.0
+#define AUTO_COST_PLAN_D 20000.0
+
+#endif
@@ -0,0 +1,83 @@
+//Converts bit-packed events (the output of zcs_bits, lcs_bits or mcs_bits) to an event list.
+//See densify.c for the event-list format (6-element header, then the indices).
+//No values are included (all events have value 1).
+
+//R, C, S, H are the size of the dense (unpacked) tensor, and dim is the dim used for the packing,
+//so B has length ceil(L/64) along dim, where L is the length of the dense tensor along dim.
+
+//First use bits2events_count to get the number of events E (by popcount of B),
+//and then Y must have length 6+E.
+//The indices are found from the set bits of each word by count-trailing-zeros,
+//so the time is proportional to the number of words plus the number of events.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+int bits2events_count (size_t *E, const uint64_t *B, const size_t R, const size_t C, const size_t S, const size_t H, const size_t dim);
+int bits2events (double *Y, const uint64_t *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim);
+
+
+int bits2events_count (size_t *E, const uint64_t *B, const size_t R, const size_t C, const size_t S, const size_t H, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in bits2events_count: dim must be in [0 3]\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    *E = 0u;
+    if (N>0u)
+    {
+        const size_t Nb = (N/L) * ((L+63u)/64u);
+        for (size_t j=0u; j<Nb; ++j) { *E += (size_t)__builtin_popcountll(B[j]); }
+    }
+
+    return 0;
+}
+
+
+int bits2events (double *Y, const uint64_t *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in bits2events: dim must be in [0 3]\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    size_t e = 0u;
+
+    if (N>0u)
+    {
+        const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t V = N/L, Lb = (L+63u)/64u;
+        uint64_t w;
+
+        for (size_t v=0u; v<V; ++v)
+        {
+            const uint64_t *b = &B[(v/K)*K*Lb+v%K];
+            const size_t n0 = (v/K)*K*L + v%K;
+            for (size_t j=0u; j<Lb; ++j)
+            {
+                w = b[j*K];
+                while (w)
+                {
+                    Y[6u+e] = (double)(n0 + (64u*j+(size_t)__builtin_ctzll(w))*K);
+                    w &= w - 1u; ++e;
+                }
+            }
+        }
+    }
+
+    Y[0] = (double)R; Y[1] = (double)C; Y[2] = (double)S; Y[3] = (double)H;
+    Y[4] = (double)e; Y[5] = 0.0;
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -7,7 +7,12 @@
 //This is like xcorr1d, except uses Ly directly instead of padding to control framing.
 //This is more flexible, intuitive, slightly faster, and allows BLAS-like usage.
 
+//For the real-valued case with str=1, dil=1 and L2 in {3,5} (the usual small kernels),
+//the outputs with X2 fully within X1 use Winograd minimal filtering F(4,3) or F(4,5).
+//See wino1d.c for the method and its error bound. All other cases use direct summation.
+
 #include <stdio.h>
+#include "wino1d.c"
 
 #ifdef __cplusplus
 namespace codee {
@@ -74,6 +79,12 @@ int conv1_s (float *Y, const float *X1, const float *X2, const size_t R, const s
         }
         else            //X2 fully within X1
         {        
+            if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<Ly)
+            {
+                const size_t nw = ((size_t)((int)L1-es)<Ly-w) ? (size_t)((int)L1-es) : Ly-w;
+                wino1d_s(Y,X1,X2-(L2-1u),nw,L2,1u,1);
+                X1 += nw; Y += nw; es += (int)nw; w += nw;
+            }
             while (es<(int)L1 && w<Ly)
             {
                 sm = 0.0f;
@@ -144,6 +155,12 @@ int conv1_s (float *Y, const float *X1, const float *X2, const size_t R, const s
                 }
                 else            //X2 fully within X1
                 {        
+                    if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<Ly)
+                    {
+                        const size_t nw = ((size_t)((int)L1-es)<Ly-w) ? (size_t)((int)L1-es) : Ly-w;
+                        wino1d_s(Y,X1,X2-(L2-1u),nw,L2,K,1);
+                        X1 += nw*K; Y += nw*K; es += (int)nw; w += nw;
+                    }
                     while (es<(int)L1 && w<Ly)
                     {
                         sm = 0.0f;
@@ -233,6 +250,12 @@ int conv1_d (double *Y, const double *X1, const double *X2, const size_t R, cons
         }
         else            //X2 fully within X1
         {        
+            if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<Ly)
+            {
+                const size_t nw = ((size_t)((int)L1-es)<Ly-w) ? (size_t)((int)L1-es) : Ly-w;
+                wino1d_d(Y,X1,X2-(L2-1u),nw,L2,1u,1);
+                X1 += nw; Y += nw; es += (int)nw; w += nw;
+            }
             while (es<(int)L1 && w<Ly)
             {
                 sm = 0.0;
@@ -303,6 +326,12 @@ int conv1_d (double *Y, const double *X1, const double *X2, const size_t R, cons
                 }
                 else            //X2 fully within X1
                 {        
+                    if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<Ly)
+                    {
+                        const size_t nw = ((size_t)((int)L1-es)<Ly-w) ? (size_t)((int)L1-es) : Ly-w;
+                        wino1d_d(Y,X1,X2-(L2-1u),nw,L2,K,1);
+                        X1 += nw*K; Y += nw*K; es += (int)nw; w += nw;
+                    }
                     while (es<(int)L1 && w<Ly)
                     {
                         sm = 0.0;
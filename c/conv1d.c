@@ -14,7 +14,16 @@
 //N_in is the full length of input vectors including padding.
 //N_out is the full length of X2 including dilation.
 
+//For the real-valued case with str=1, dil=1 and L2 in {3,5} (the usual small kernels),
+//the outputs with X2 fully within X1 use Winograd minimal filtering F(4,3) or F(4,5).
+//See wino1d.c for the method and its error bound. All other cases use direct summation.
+
+//For the real-valued case with dil>1 and contiguous vecs, the outputs with X2 fully within X1
+//use blocked direct summation with the taps in the outer loop (see dil1d.c).
+
 #include <stdio.h>
+#include "wino1d.c"
+#include "dil1d.c"
 
 #ifdef __cplusplus
 namespace codee {
@@ -89,6 +98,18 @@ int conv1d_s (float *Y, const float *X1, const float *X2, const size_t R, const
         }
         else            //X2 fully within X1
         {        
+            if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<W)
+            {
+                const size_t nw = ((size_t)((int)L1-es)<W-w) ? (size_t)((int)L1-es) : W-w;
+                wino1d_s(Y,X1,X2-(L2-1u),nw,L2,1u,1);
+                X1 += nw; Y += nw; es += (int)nw; w += nw;
+            }
+            else if (dil>1u && es<(int)L1 && w<W)
+            {
+                const size_t nw = ((size_t)((int)L1-1-es)/str+1u<W-w) ? (size_t)((int)L1-1-es)/str+1u : W-w;
+                dil1d_s(Y,X1,X2-(L2-1u),nw,L2,str,dil,1);
+                X1 += nw*str; Y += nw; es += (int)(nw*str); w += nw;
+            }
             while (es<(int)L1 && w<W)
             {
                 sm = 0.0f;
@@ -159,6 +180,18 @@ int conv1d_s (float *Y, const float *X1, const float *X2, const size_t R, const
                 }
                 else            //X2 fully within X1
                 {        
+                    if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<W)
+                    {
+                        const size_t nw = ((size_t)((int)L1-es)<W-w) ? (size_t)((int)L1-es) : W-w;
+                        wino1d_s(Y,X1,X2-(L2-1u),nw,L2,K,1);
+                        X1 += nw*K; Y += nw*K; es += (int)nw; w += nw;
+                    }
+                    else if (K==1u && dil>1u && es<(int)L1 && w<W)
+                    {
+                        const size_t nw = ((size_t)((int)L1-1-es)/str+1u<W-w) ? (size_t)((int)L1-1-es)/str+1u : W-w;
+                        dil1d_s(Y,X1,X2-(L2-1u),nw,L2,str,dil,1);
+                        X1 += nw*str; Y += nw; es += (int)(nw*str); w += nw;
+                    }
                     while (es<(int)L1 && w<W)
                     {
                         sm = 0.0f;
@@ -256,6 +289,18 @@ int conv1d_d (double *Y, const double *X1, const double *X2, const size_t R, con
         }
         else            //X2 fully within X1
         {        
+            if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<W)
+            {
+                const size_t nw = ((size_t)((int)L1-es)<W-w) ? (size_t)((int)L1-es) : W-w;
+                wino1d_d(Y,X1,X2-(L2-1u),nw,L2,1u,1);
+                X1 += nw; Y += nw; es += (int)nw; w += nw;
+            }
+            else if (dil>1u && es<(int)L1 && w<W)
+            {
+                const size_t nw = ((size_t)((int)L1-1-es)/str+1u<W-w) ? (size_t)((int)L1-1-es)/str+1u : W-w;
+                dil1d_d(Y,X1,X2-(L2-1u),nw,L2,str,dil,1);
+                X1 += nw*str; Y += nw; es += (int)(nw*str); w += nw;
+            }
             while (es<(int)L1 && w<W)
             {
                 sm = 0.0;
@@ -326,6 +371,18 @@ int conv1d_d (double *Y, const double *X1, const double *X2, const size_t R, con
                 }
                 else            //X2 fully within X1
                 {        
+                    if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<W)
+                    {
+                        const size_t nw = ((size_t)((int)L1-es)<W-w) ? (size_t)((int)L1-es) : W-w;
+                        wino1d_d(Y,X1,X2-(L2-1u),nw,L2,K,1);
+                        X1 += nw*K; Y += nw*K; es += (int)nw; w += nw;
+                    }
+                    else if (K==1u && dil>1u && es<(int)L1 && w<W)
+                    {
+                        const size_t nw = ((size_t)((int)L1-1-es)/str+1u<W-w) ? (size_t)((int)L1-1-es)/str+1u : W-w;
+                        dil1d_d(Y,X1,X2-(L2-1u),nw,L2,str,dil,1);
+                        X1 += nw*str; Y += nw; es += (int)(nw*str); w += nw;
+                    }
                     while (es<(int)L1 && w<W)
                     {
                         sm = 0.0;
@@ -3,8 +3,22 @@
 //This gives identical output to conv1d, but uses FFT internally.
 //See conv1d for more info.
 
-//I could not find any condition where this is faster than conv1d.
-//conv1d is also more numerically accurate.
+//For the real-valued case (s, d), this uses overlap-save (OLS) in blocks of nfft samples,
+//with the FFT of X2 made once and shared by all vecs, and with r2c/c2r transforms.
+//The vecs are done in batches of up to 16, with one (plan_many) FFT/IFFT per block for the batch.
+
+//Stride is handled by polyphase decomposition, so only the needed outputs are computed:
+//the padded X1 and the dilated X2 are each split into str phases (every str-th sample),
+//and the str phase-by-phase products are summed in the frequency domain before one IFFT.
+//Dilation only inserts zeros into X2 (its cost is that of a kernel of length N2).
+//Outputs where X2 overlaps only the padding are set to 0 directly.
+
+//nfft is the power-of-2 (>= 2*M) that minimizes the approximate cost per output,
+//where M = ceil(N2/str) is the length of each phase of X2.
+//The cost per output grows with log(nfft) rather than with N2, so this is meant for long X2,
+//but it is somewhat less accurate than conv1d. The L2 above which it is faster depends on the machine
+//(and on str, dil and L1), and has not been benchmarked here; conv1d_auto chooses between them by cost model.
+//The complex-valued case (c, z) still uses one whole-signal FFT per vec.
 
 #include <stdio.h>
 #include <math.h>
@@ -15,12 +29,34 @@ namespace codee {
 extern "C" {
 #endif
 
+static size_t conv1d_fft_get_nfft (const size_t M, const size_t P, const size_t Ly);
+
 int conv1d_fft_s (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const size_t pad, const size_t str, const size_t dil, const size_t dim);
 int conv1d_fft_d (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const size_t pad, const size_t str, const size_t dil, const size_t dim);
 int conv1d_fft_c (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const size_t pad, const size_t str, const size_t dil, const size_t dim);
 int conv1d_fft_z (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const size_t pad, const size_t str, const size_t dil, const size_t dim);
 
 
+static size_t conv1d_fft_get_nfft (const size_t M, const size_t P, const size_t Ly)
+{
+    size_t nmax = 1u, n = 32u, nfft;
+    while (nmax<Ly+M-1u) { nmax *= 2u; }
+    while (n<2u*M) { n *= 2u; }
+    if (n>=nmax) { return nmax; }
+
+    const double np = (double)P;
+    double lg = log2((double)n), cst, cmin = (double)n*((np+1.0)*lg+np)/(double)(n-M+1u);
+    nfft = n;
+    for (n*=2u, lg+=1.0; n<=nmax; n*=2u, lg+=1.0)
+    {
+        cst = (double)n*((np+1.0)*lg+np)/(double)(n-M+1u);
+        if (cst<cmin) { cmin = cst; nfft = n; }
+    }
+
+    return nfft;
+}
+
+
 int conv1d_fft_s (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const size_t pad, const size_t str, const size_t dil, const size_t dim)
 {
     if (dim>3u) { fprintf(stderr,"error in conv1d_fft_s: dim must be in [0 3]\n"); return 1; }
@@ -35,162 +71,126 @@ int conv1d_fft_s (float *Y, const float *X1, const float *X2, const size_t R, co
     if (L1+2u*pad<=dil*(L2-1u)) { fprintf(stderr,"error in conv1d_fft_s: L1+2*pad must be > dil*(L2-1)\n"); return 1; }
 
     //Set Ly (W)
-    const int N1 = (int)(L1+2u*pad);            //full length of vecs in X1 including padding
-    const int N2 = (int)(dil*(L2-1u)) + 1;      //full length of vec in X2 including dilation
-    const size_t Ly = 1u + (size_t)(N1-N2)/str;
-
-    if (Ly==0u) {}
-    else
+    const size_t N1 = L1 + 2u*pad;              //full length of vecs in X1 including padding
+    const size_t N2 = dil*(L2-1u) + 1u;         //full length of vec in X2 including dilation
+    const size_t Ly = 1u + (N1-N2)/str;
+
+    //Outputs [w0 w1) overlap X1 (others are 0)
+    const size_t w0 = (pad>=N2) ? 1u + (pad-N2)/str : 0u;
+    const size_t w1 = ((pad+L1+str-1u)/str<Ly) ? (pad+L1+str-1u)/str : Ly;
+
+    //Set lanes (vec v starts at (v/K)*K*L1 + v%K, with stride K)
+    const size_t K = (L1==N) ? 1u : (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+    const size_t V = N/L1;
+
+    //Set polyphase (one phase per stride), block size and number of freqs
+    const size_t P = str, M = (N2+str-1u)/str;      //num phases and length of each phase of X2
+    const size_t nfft = conv1d_fft_get_nfft(M,P,w1-w0);
+    const size_t Lb = nfft - M + 1u, F = nfft/2u + 1u;
+    const size_t NT = (V<16u) ? V : 16u;            //num vecs per batch
+    const float sc = 1.0f / (float)nfft;
+    float xr, xi, hr, hi, sr, si;
+
+    //Initialize fftw
+    float *Xb, *Fx, *Hf, *Fy, *Yb;
+    Xb = (float *)fftwf_malloc(NT*P*nfft*sizeof(float));
+    Fx = (float *)fftwf_malloc(NT*P*2u*F*sizeof(float));
+    Hf = (float *)fftwf_malloc(P*2u*F*sizeof(float));
+    Fy = (float *)fftwf_malloc(NT*2u*F*sizeof(float));
+    Yb = (float *)fftwf_malloc(NT*nfft*sizeof(float));
+    if (!Xb || !Fx || !Hf || !Fy || !Yb) { fprintf(stderr,"error in conv1d_fft_s: problem with fftwf_malloc. "); perror("fftwf_malloc"); return 1; }
+    const int n[1] = {(int)nfft};
+    fftwf_plan hplan = fftwf_plan_many_dft_r2c(1,n,(int)P,Xb,NULL,1,(int)nfft,(fftwf_complex *)Hf,NULL,1,(int)F,FFTW_ESTIMATE);
+    if (!hplan) { fprintf(stderr,"error in conv1d_fft_s: problem creating fftw plan\n"); return 1; }
+    fftwf_plan fplan = fftwf_plan_many_dft_r2c(1,n,(int)(NT*P),Xb,NULL,1,(int)nfft,(fftwf_complex *)Fx,NULL,1,(int)F,FFTW_ESTIMATE);
+    if (!fplan) { fprintf(stderr,"error in conv1d_fft_s: problem creating fftw plan\n"); return 1; }
+    fftwf_plan iplan = fftwf_plan_many_dft_c2r(1,n,(int)NT,(fftwf_complex *)Fy,NULL,1,(int)F,Yb,NULL,1,(int)nfft,FFTW_ESTIMATE);
+    if (!iplan) { fprintf(stderr,"error in conv1d_fft_s: problem creating fftw plan\n"); return 1; }
+
+    //Get Hf (scaled FFT of each phase of flipped X2, with dilation holes, reversed)
+    for (size_t i=0u; i<P*nfft; ++i) { Xb[i] = 0.0f; }
+    for (size_t l=0u; l<L2; ++l)
     {
-        //Set nfft and F
-        size_t nfft = 1u;
-        while ((int)nfft<N1+N2) { nfft *= 2u; }
-        const size_t F = nfft/2u + 1u;
-        //if (nfft%2u) { fprintf(stderr,"error in conv1d_fft_s: nfft must be even"); return 1; }
-
-        //Set scale
-        const float sc = 2.0f / (float)nfft;
-
-        //Initialize FFTs
-        float *X1f, *X2f, *Y1f, *Y2f, y1r, y1i, y2r, y2i;
-        X1f = (float *)fftwf_malloc(nfft*sizeof(float));
-        X2f = (float *)fftwf_malloc(nfft*sizeof(float));
-        Y1f = (float *)fftwf_malloc(2u*nfft*sizeof(float));
-        Y2f = (float *)fftwf_malloc(2u*nfft*sizeof(float));
-        fftwf_plan fplan1 = fftwf_plan_dft_r2c_1d((int)nfft,X1f,(fftwf_complex *)Y1f,FFTW_ESTIMATE);
-        if (!fplan1) { fprintf(stderr,"error in conv1d_fft_s: problem creating fftw plan"); return 1; }
-        fftwf_plan fplan2 = fftwf_plan_dft_r2c_1d((int)nfft,X2f,(fftwf_complex *)Y2f,FFTW_ESTIMATE);
-        if (!fplan2) { fprintf(stderr,"error in conv1d_fft_s: problem creating fftw plan"); return 1; }
-        for (size_t n=nfft; n>0u; --n, ++X1f) { *X1f = 0.0f; }
-        X1f -= nfft;
+        const size_t j = l*dil;
+        Xb[(j%str)*nfft + M-1u-j/str] = X2[L2-1u-l] * sc;
+    }
+    fftwf_execute(hplan);
 
-        //Initialize IFFT
-        float *Z1f;
-        Z1f = (float *)fftwf_malloc(2u*nfft*sizeof(float));
-        fftwf_plan iplan = fftwf_plan_dft_1d((int)nfft,(fftwf_complex *)Y1f,(fftwf_complex *)Z1f,FFTW_BACKWARD,FFTW_ESTIMATE);
-        if (!iplan) { fprintf(stderr,"error in conv1d_fft_s: problem creating fftw plan"); return 1; }
-        for (size_t n=2u*nfft; n>0u; --n, ++Y1f) { *Y1f = 0.0f; }
-        Y1f -= 2u*nfft;
+    for (size_t v0=0u; v0<V; v0+=NT)
+    {
+        const size_t nt = (V-v0<NT) ? V-v0 : NT;
 
-        //Get Y2f (scaled FFT of X2f with dilation holes)
-        for (size_t n=L2; n>0u; --n, ++X2, ++X2f)
+        for (size_t t=0u; t<nt; ++t)
         {
-            *X2f = *X2;
-            for (size_t i=dil; i>1u; --i) { *++X2f = 0.0f; }
+            const size_t v = v0 + t;
+            float *y = &Y[(v/K)*K*Ly + v%K];
+            for (size_t w=0u; w<w0; ++w) { y[w*K] = 0.0f; }
+            for (size_t w=w1; w<Ly; ++w) { y[w*K] = 0.0f; }
         }
-        for (size_t n=L2*dil; n<nfft; ++n, ++X2f) { *X2f = 0.0f; }
-        X2f -= nfft;
-        fftwf_execute(fplan2);
-        *Y2f++ /= (float)nfft; ++Y2f;
-        for (size_t l=nfft-2u; l>0u; --l, ++Y2f) { *Y2f *= sc; }
-        *Y2f /= (float)nfft;
-        Y2f -= nfft;
 
-        if (L1==N)
+        for (size_t ws=w0; ws<w1; ws+=Lb)
         {
-            //struct timespec tic, toc; clock_gettime(CLOCK_REALTIME,&tic);
+            const size_t nw = (w1-ws<Lb) ? w1-ws : Lb;
 
-            //Copy input
-            X1f += pad;
-            for (size_t l=L1; l>0u; --l, ++X1, ++X1f) { *X1f = *X1; }
-            X1f -= pad + L1;
+            //Copy input (each phase of the padded vecs)
+            for (size_t t=0u; t<nt; ++t)
+            {
+                const size_t v = v0 + t;
+                const float *x = &X1[(v/K)*K*L1 + v%K];
+                for (size_t p=0u; p<P; ++p)
+                {
+                    float *xb = &Xb[(t*P+p)*nfft];
+                    const size_t a = ws*str + p;
+                    size_t ilo = (a>=pad) ? 0u : (pad-a+str-1u)/str;
+                    size_t ihi = (a>=pad+L1) ? 0u : (pad+L1-a+str-1u)/str;
+                    if (ihi>nfft) { ihi = nfft; }
+                    if (ilo>ihi) { ilo = ihi; }
+                    for (size_t i=0u; i<ilo; ++i) { xb[i] = 0.0f; }
+                    for (size_t i=ilo; i<ihi; ++i) { xb[i] = x[(a+i*str-pad)*K]; }
+                    for (size_t i=ihi; i<nfft; ++i) { xb[i] = 0.0f; }
+                }
+            }
 
             //FFT
-            fftwf_execute(fplan1);
+            fftwf_execute(fplan);
 
-            //Multiply FFTs
-            *Y1f++ *= *Y2f++; ++Y1f; ++Y2f;
-            for (size_t f=F-2u; f>0u; --f)
+            //Multiply FFTs and sum over phases
+            for (size_t t=0u; t<nt; ++t)
             {
-                y1r = *Y1f++; y1i = *Y1f--;
-                y2r = *Y2f++; y2i = *Y2f++;
-                *Y1f++ = y2r*y1r - y2i*y1i;
-                *Y1f++ = y2r*y1i + y2i*y1r;
+                float *fy = &Fy[2u*t*F];
+                for (size_t f=0u; f<F; ++f) { fy[2u*f] = fy[2u*f+1u] = 0.0f; }
+                for (size_t p=0u; p<P; ++p)
+                {
+                    const float *fx = &Fx[2u*(t*P+p)*F], *hf = &Hf[2u*p*F];
+                    for (size_t f=0u; f<F; ++f)
+                    {
+                        xr = fx[2u*f]; xi = fx[2u*f+1u];
+                        hr = hf[2u*f]; hi = hf[2u*f+1u];
+                        sr = fy[2u*f] + xr*hr - xi*hi;
+                        si = fy[2u*f+1u] + xr*hi + xi*hr;
+                        fy[2u*f] = sr; fy[2u*f+1u] = si;
+                    }
+                }
             }
-            *Y1f *= *Y2f;
-            Y1f -= nfft; Y2f -= nfft;
 
             //IFFT
             fftwf_execute(iplan);
 
             //Copy output
-            Z1f += 2u*(size_t)(N2-1);
-            if ((int)pad>=N2)
+            for (size_t t=0u; t<nt; ++t)
             {
-                const size_t nz = 1u + (pad-(size_t)N2)/str;
-                for (size_t l=nz; l>0u; --l, ++Y) { *Y = 0.0f; }
-                Z1f += 2u*(1u + pad - (size_t)N2);
-                for (size_t l=Ly-2u*nz; l>0u; --l, Z1f+=2u*str, ++Y) { *Y = *Z1f; }
-                for (size_t l=nz; l>0u; --l, ++Y) { *Y = 0.0f; }
-                Z1f -= 2u*(str*(Ly-2u*nz) + pad);
+                const size_t v = v0 + t;
+                float *y = &Y[(v/K)*K*Ly + v%K + ws*K];
+                const float *yb = &Yb[t*nfft + M-1u];
+                for (size_t w=0u; w<nw; ++w) { y[w*K] = yb[w]; }
             }
-            else
-            {
-                for (size_t l=Ly; l>0u; --l, Z1f+=2u*str, ++Y) { *Y = *Z1f; }
-                Z1f -= 2u*((size_t)N2-1u+Ly*str);
-            }
-
-            //clock_gettime(CLOCK_REALTIME,&toc);
-            //fprintf(stderr,"elapsed time = %.6f ms\n",(double)(toc.tv_sec-tic.tv_sec)*1e3+(double)(toc.tv_nsec-tic.tv_nsec)/1e6);
         }
-        else
-        {
-            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/L1, G = V/B;
-
-            for (size_t g=G; g>0u; --g, X1+=B*(L1-1u), Y+=B*(Ly-1u))
-            {
-                for (size_t b=B; b>0u; --b, X1-=K*L1-1u, Y-=K*Ly-1u)
-                {
-                    //Copy input
-                    X1f += pad;
-                    for (size_t l=L1; l>0u; --l, X1+=K, ++X1f) { *X1f = *X1; }
-                    X1f -= pad + L1;
-
-                    //FFT
-                    fftwf_execute(fplan1);
-
-                    //Multiply FFTs
-                    *Y1f++ *= *Y2f++; ++Y1f; ++Y2f;
-                    for (size_t f=F-2u; f>0u; --f)
-                    {
-                        y1r = *Y1f++; y1i = *Y1f--;
-                        y2r = *Y2f++; y2i = *Y2f++;
-                        *Y1f++ = y2r*y1r - y2i*y1i;
-                        *Y1f++ = y2r*y1i + y2i*y1r;
-                    }
-                    *Y1f *= *Y2f;
-                    Y1f -= nfft; Y2f -= nfft;
-
-                    //IFFT
-                    fftwf_execute(iplan);
-
-                    //Copy output
-                    Z1f += 2u*(size_t)(N2-1);
-                    if ((int)pad>=N2)
-                    {
-                        const size_t nz = 1u + (pad-(size_t)N2)/str;
-                        for (size_t l=nz; l>0u; --l, Y+=K) { *Y = 0.0f; }
-                        Z1f += 2u*(1u + pad - (size_t)N2);
-                        for (size_t l=Ly-2u*nz; l>0u; --l, Z1f+=2u*str, Y+=K) { *Y = *Z1f; }
-                        for (size_t l=nz; l>0u; --l, Y+=K) { *Y = 0.0f; }
-                        Z1f -= 2u*(str*(Ly-2u*nz) + pad);
-                    }
-                    else
-                    {
-                        for (size_t l=Ly; l>0u; --l, Z1f+=2u*str, Y+=K) { *Y = *Z1f; }
-                        Z1f -= 2u*((size_t)N2-1u+Ly*str);
-                    }
-                }
-            }
-        }
-
-        //Free
-        fftwf_free(X1f); fftwf_free(Y2f); fftwf_free(Y1f); fftwf_free(Z1f);
-        fftwf_destroy_plan(fplan1); fftwf_destroy_plan(fplan2); fftwf_destroy_plan(iplan);
     }
 
+    //Free
+    fftwf_free(Xb); fftwf_free(Fx); fftwf_free(Hf); fftwf_free(Fy); fftwf_free(Yb);
+    fftwf_destroy_plan(hplan); fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+
     return 0;
 }
 
@@ -209,157 +209,126 @@ int conv1d_fft_d (double *Y, const double *X1, const double *X2, const size_t R,
     if (L1+2u*pad<=dil*(L2-1u)) { fprintf(stderr,"error in conv1d_fft_d: L1+2*pad must be > dil*(L2-1)\n"); return 1; }
 
     //Set Ly (W)
-    const int N1 = (int)(L1+2u*pad);            //full length of vecs in X1 including padding
-    const int N2 = (int)(dil*(L2-1u)) + 1;      //full length of vec in X2 including dilation
-    const size_t Ly = 1u + (size_t)(N1-N2)/str;
-
-    if (Ly==0u) {}
-    else
+    const size_t N1 = L1 + 2u*pad;              //full length of vecs in X1 including padding
+    const size_t N2 = dil*(L2-1u) + 1u;         //full length of vec in X2 including dilation
+    const size_t Ly = 1u + (N1-N2)/str;
+
+    //Outputs [w0 w1) overlap X1 (others are 0)
+    const size_t w0 = (pad>=N2) ? 1u + (pad-N2)/str : 0u;
+    const size_t w1 = ((pad+L1+str-1u)/str<Ly) ? (pad+L1+str-1u)/str : Ly;
+
+    //Set lanes (vec v starts at (v/K)*K*L1 + v%K, with stride K)
+    const size_t K = (L1==N) ? 1u : (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+    const size_t V = N/L1;
+
+    //Set polyphase (one phase per stride), block size and number of freqs
+    const size_t P = str, M = (N2+str-1u)/str;      //num phases and length of each phase of X2
+    const size_t nfft = conv1d_fft_get_nfft(M,P,w1-w0);
+    const size_t Lb = nfft - M + 1u, F = nfft/2u + 1u;
+    const size_t NT = (V<16u) ? V : 16u;            //num vecs per batch
+    const double sc = 1.0 / (double)nfft;
+    double xr, xi, hr, hi, sr, si;
+
+    //Initialize fftw
+    double *Xb, *Fx, *Hf, *Fy, *Yb;
+    Xb = (double *)fftw_malloc(NT*P*nfft*sizeof(double));
+    Fx = (double *)fftw_malloc(NT*P*2u*F*sizeof(double));
+    Hf = (double *)fftw_malloc(P*2u*F*sizeof(double));
+    Fy = (double *)fftw_malloc(NT*2u*F*sizeof(double));
+    Yb = (double *)fftw_malloc(NT*nfft*sizeof(double));
+    if (!Xb || !Fx || !Hf || !Fy || !Yb) { fprintf(stderr,"error in conv1d_fft_d: problem with fftw_malloc. "); perror("fftw_malloc"); return 1; }
+    const int n[1] = {(int)nfft};
+    fftw_plan hplan = fftw_plan_many_dft_r2c(1,n,(int)P,Xb,NULL,1,(int)nfft,(fftw_complex *)Hf,NULL,1,(int)F,FFTW_ESTIMATE);
+    if (!hplan) { fprintf(stderr,"error in conv1d_fft_d: problem creating fftw plan\n"); return 1; }
+    fftw_plan fplan = fftw_plan_many_dft_r2c(1,n,(int)(NT*P),Xb,NULL,1,(int)nfft,(fftw_complex *)Fx,NULL,1,(int)F,FFTW_ESTIMATE);
+    if (!fplan) { fprintf(stderr,"error in conv1d_fft_d: problem creating fftw plan\n"); return 1; }
+    fftw_plan iplan = fftw_plan_many_dft_c2r(1,n,(int)NT,(fftw_complex *)Fy,NULL,1,(int)F,Yb,NULL,1,(int)nfft,FFTW_ESTIMATE);
+    if (!iplan) { fprintf(stderr,"error in conv1d_fft_d: problem creating fftw plan\n"); return 1; }
+
+    //Get Hf (scaled FFT of each phase of flipped X2, with dilation holes, reversed)
+    for (size_t i=0u; i<P*nfft; ++i) { Xb[i] = 0.0; }
+    for (size_t l=0u; l<L2; ++l)
     {
-        //Set nfft and F
-        size_t nfft = 1u;
-        while ((int)nfft<N1+N2) { nfft *= 2u; }
-        const size_t F = nfft/2u + 1u;
-        //if (nfft%2u) { fprintf(stderr,"error in conv1d_fft_s: nfft must be even"); return 1; }
-
-        //Set scale
-        const double sc = 2.0 / (double)nfft;
-
-        //Initialize FFTs
-        double *X1f, *X2f, *Y1f, *Y2f, y1r, y1i, y2r, y2i;
-        X1f = (double *)fftw_malloc(nfft*sizeof(double));
-        X2f = (double *)fftw_malloc(nfft*sizeof(double));
-        Y1f = (double *)fftw_malloc(2u*nfft*sizeof(double));
-        Y2f = (double *)fftw_malloc(2u*nfft*sizeof(double));
-        fftw_plan fplan1 = fftw_plan_dft_r2c_1d((int)nfft,X1f,(fftw_complex *)Y1f,FFTW_ESTIMATE);
-        if (!fplan1) { fprintf(stderr,"error in conv1d_fft_d: problem creating fftw plan"); return 1; }
-        fftw_plan fplan2 = fftw_plan_dft_r2c_1d((int)nfft,X2f,(fftw_complex *)Y2f,FFTW_ESTIMATE);
-        if (!fplan2) { fprintf(stderr,"error in conv1d_fft_d: problem creating fftw plan"); return 1; }
-        for (size_t n=nfft; n>0u; --n, ++X1f) { *X1f = 0.0; }
-        X1f -= nfft;
+        const size_t j = l*dil;
+        Xb[(j%str)*nfft + M-1u-j/str] = X2[L2-1u-l] * sc;
+    }
+    fftw_execute(hplan);
 
-        //Initialize IFFT
-        double *Z1f;
-        Z1f = (double *)fftw_malloc(2u*nfft*sizeof(double));
-        fftw_plan iplan = fftw_plan_dft_1d((int)nfft,(fftw_complex *)Y1f,(fftw_complex *)Z1f,FFTW_BACKWARD,FFTW_ESTIMATE);
-        if (!iplan) { fprintf(stderr,"error in conv1d_fft_d: problem creating fftw plan"); return 1; }
-        for (size_t n=2u*nfft; n>0u; --n, ++Y1f) { *Y1f = 0.0; }
-        Y1f -= 2u*nfft;
+    for (size_t v0=0u; v0<V; v0+=NT)
+    {
+        const size_t nt = (V-v0<NT) ? V-v0 : NT;
 
-        //Get Y2f (scaled FFT of X2f with dilation holes)
-        for (size_t n=L2; n>0u; --n, ++X2, ++X2f)
+        for (size_t t=0u; t<nt; ++t)
         {
-            *X2f = *X2;
-            for (size_t i=dil; i>1u; --i) { *++X2f = 0.0; }
+            const size_t v = v0 + t;
+            double *y = &Y[(v/K)*K*Ly + v%K];
+            for (size_t w=0u; w<w0; ++w) { y[w*K] = 0.0; }
+            for (size_t w=w1; w<Ly; ++w) { y[w*K] = 0.0; }
         }
-        for (size_t n=L2*dil; n<nfft; ++n, ++X2f) { *X2f = 0.0; }
-        X2f -= nfft;
-        fftw_execute(fplan2);
-        *Y2f++ /= (double)nfft; ++Y2f;
-        for (size_t l=nfft-2u; l>0u; --l, ++Y2f) { *Y2f *= sc; }
-        *Y2f /= (double)nfft;
-        Y2f -= nfft;
 
-        if (L1==N)
+        for (size_t ws=w0; ws<w1; ws+=Lb)
         {
-            //Copy input
-            X1f += pad;
-            for (size_t l=L1; l>0u; --l, ++X1, ++X1f) { *X1f = *X1; }
-            X1f -= pad + L1;
+            const size_t nw = (w1-ws<Lb) ? w1-ws : Lb;
 
-            //FFT
-            fftw_execute(fplan1);
-
-            //Multiply FFTs
-            *Y1f++ *= *Y2f++; ++Y1f; ++Y2f;
-            for (size_t f=F-2u; f>0u; --f)
+            //Copy input (each phase of the padded vecs)
+            for (size_t t=0u; t<nt; ++t)
             {
-                y1r = *Y1f++; y1i = *Y1f--;
-                y2r = *Y2f++; y2i = *Y2f++;
-                *Y1f++ = y2r*y1r - y2i*y1i;
-                *Y1f++ = y2r*y1i + y2i*y1r;
+                const size_t v = v0 + t;
+                const double *x = &X1[(v/K)*K*L1 + v%K];
+                for (size_t p=0u; p<P; ++p)
+                {
+                    double *xb = &Xb[(t*P+p)*nfft];
+                    const size_t a = ws*str + p;
+                    size_t ilo = (a>=pad) ? 0u : (pad-a+str-1u)/str;
+                    size_t ihi = (a>=pad+L1) ? 0u : (pad+L1-a+str-1u)/str;
+                    if (ihi>nfft) { ihi = nfft; }
+                    if (ilo>ihi) { ilo = ihi; }
+                    for (size_t i=0u; i<ilo; ++i) { xb[i] = 0.0; }
+                    for (size_t i=ilo; i<ihi; ++i) { xb[i] = x[(a+i*str-pad)*K]; }
+                    for (size_t i=ihi; i<nfft; ++i) { xb[i] = 0.0; }
+                }
             }
-            *Y1f *= *Y2f;
-            Y1f -= nfft; Y2f -= nfft;
-
-            //IFFT
-            fftw_execute(iplan);
 
-            //Copy output
-            Z1f += 2u*(size_t)(N2-1);
-            if ((int)pad>=N2)
-            {
-                const size_t nz = 1u + (pad-(size_t)N2)/str;
-                for (size_t l=nz; l>0u; --l, ++Y) { *Y = 0.0; }
-                Z1f += 2u*(1u + pad - (size_t)N2);
-                for (size_t l=Ly-2u*nz; l>0u; --l, Z1f+=2u*str, ++Y) { *Y = *Z1f; }
-                for (size_t l=nz; l>0u; --l, ++Y) { *Y = 0.0; }
-                Z1f -= 2u*(str*(Ly-2u*nz) + pad);
-            }
-            else
-            {
-                for (size_t l=Ly; l>0u; --l, Z1f+=2u*str, ++Y) { *Y = *Z1f; }
-                Z1f -= 2u*((size_t)N2-1u+Ly*str);
-            }
-        }
-        else
-        {
-            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/L1, G = V/B;
+            //FFT
+            fftw_execute(fplan);
 
-            for (size_t g=G; g>0u; --g, X1+=B*(L1-1u), Y+=B*(Ly-1u))
+            //Multiply FFTs and sum over phases
+            for (size_t t=0u; t<nt; ++t)
             {
-                for (size_t b=B; b>0u; --b, X1-=K*L1-1u, Y-=K*Ly-1u)
+                double *fy = &Fy[2u*t*F];
+                for (size_t f=0u; f<F; ++f) { fy[2u*f] = fy[2u*f+1u] = 0.0; }
+                for (size_t p=0u; p<P; ++p)
                 {
-                    //Copy input
-                    X1f += pad;
-                    for (size_t l=L1; l>0u; --l, X1+=K, ++X1f) { *X1f = *X1; }
-                    X1f -= pad + L1;
-
-                    //FFT
-                    fftw_execute(fplan1);
-
-                    //Multiply FFTs
-                    *Y1f++ *= *Y2f++; ++Y1f; ++Y2f;
-                    for (size_t f=F-2u; f>0u; --f)
+                    const double *fx = &Fx[2u*(t*P+p)*F], *hf = &Hf[2u*p*F];
+                    for (size_t f=0u; f<F; ++f)
                     {
-                        y1r = *Y1f++; y1i = *Y1f--;
-                        y2r = *Y2f++; y2i = *Y2f++;
-                        *Y1f++ = y2r*y1r - y2i*y1i;
-                        *Y1f++ = y2r*y1i + y2i*y1r;
+                        xr = fx[2u*f]; xi = fx[2u*f+1u];
+                        hr = hf[2u*f]; hi = hf[2u*f+1u];
+                        sr = fy[2u*f] + xr*hr - xi*hi;
+                        si = fy[2u*f+1u] + xr*hi + xi*hr;
+                        fy[2u*f] = sr; fy[2u*f+1u] = si;
                     }
-                    *Y1f *= *Y2f;
-                    Y1f -= nfft; Y2f -= nfft;
+                }
+            }
 
-                    //IFFT
-                    fftw_execute(iplan);
+            //IFFT
+            fftw_execute(iplan);
 
-                    //Copy output
-                    Z1f += 2u*(size_t)(N2-1);
-                    if ((int)pad>=N2)
-                    {
-                        const size_t nz = 1u + (pad-(size_t)N2)/str;
-                        for (size_t l=nz; l>0u; --l, Y+=K) { *Y = 0.0; }
-                        Z1f += 2u*(1u + pad - (size_t)N2);
-                        for (size_t l=Ly-2u*nz; l>0u; --l, Z1f+=2u*str, Y+=K) { *Y = *Z1f; }
-                        for (size_t l=nz; l>0u; --l, Y+=K) { *Y = 0.0; }
-                        Z1f -= 2u*(str*(Ly-2u*nz) + pad);
-                    }
-                    else
-                    {
-                        for (size_t l=Ly; l>0u; --l, Z1f+=2u*str, Y+=K) { *Y = *Z1f; }
-                        Z1f -= 2u*((size_t)N2-1u+Ly*str);
-                    }
-                }
+            //Copy output
+            for (size_t t=0u; t<nt; ++t)
+            {
+                const size_t v = v0 + t;
+                double *y = &Y[(v/K)*K*Ly + v%K + ws*K];
+                const double *yb = &Yb[t*nfft + M-1u];
+                for (size_t w=0u; w<nw; ++w) { y[w*K] = yb[w]; }
             }
         }
-
-        //Free
-        fftw_free(X1f); fftw_free(Y2f); fftw_free(Y1f); fftw_free(Z1f);
-        fftw_destroy_plan(fplan1); fftw_destroy_plan(fplan2); fftw_destroy_plan(iplan);
     }
 
+    //Free
+    fftw_free(Xb); fftw_free(Fx); fftw_free(Hf); fftw_free(Fy); fftw_free(Yb);
+    fftw_destroy_plan(hplan); fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+
     return 0;
 }
 
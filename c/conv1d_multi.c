@@ -0,0 +1,263 @@
+//1D multichannel convolution, as in a Conv1d layer of a neural network.
+//Each item in a batch of NB items has Cin input channels (each of length L),
+//and is mapped to Cout output channels (each of length Lout).
+
+//The framing (pad, stride, dilation) is exactly as in conv1d, so:
+//Lout = floor[1 + (L + 2*pad - dil*(K-1) - 1)/stride].
+
+//The weights W have size Cout x Cin/G x K, where K is the kernel_size and G is the number of groups.
+//The input channels are split into G groups of Cin/G channels, and the output channels into G groups of Cout/G.
+//Each output channel is the sum over the input channels in its group, plus the bias B (length Cout).
+//Use B = NULL for no bias.
+
+//As in conv1d, the kernel is flipped (i.e. a true convolution).
+//Set xc to nonzero to do cross-correlation instead (no flip), which is what PyTorch Conv1d does.
+//So use xc=1 to run a layer with weights exported from PyTorch.
+
+//The following convention is forced here (as in frame_univar):
+//Samples from one channel are always contiguous in memory, i.e. memory order is NB x Cin x L.
+//So, if X is row-major, then it has size NB x Cin x L (or Cin x L for one item),
+//but if X is col-major, then it has size L x Cin x NB (or L x Cin for one item).
+//Likewise, W has memory order Cout x Cin/G x K, and Y has memory order NB x Cout x Lout.
+
+//For the general case, this uses im2col and GEMM (BLAS sgemm) per group:
+//the im2col matrix has (Cin/G)*K rows, and it is made in tiles of LB output samples,
+//where LB is chosen so that the tile stays in L2 cache (about 256 kB).
+//For the depthwise case (Cin/G==1), the GEMM would have only Cout/G rows,
+//so a direct loop over taps is used instead (on blocks of output samples that stay in L1 cache).
+
+//The items in the batch are processed in turn (BLAS can multithread each GEMM).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <cblas.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void conv1d_multi_lims (int *lo, int *hi, const int t0, const int str, const int L, const int nw);
+static void conv1d_multi_im2col_s (float *Cl, const float *X, const size_t L, const size_t Ci, const size_t K, const size_t w0, const size_t nw, const size_t LB, const int pad, const size_t str, const size_t dil, const int xc);
+static void conv1d_multi_im2col_d (double *Cl, const double *X, const size_t L, const size_t Ci, const size_t K, const size_t w0, const size_t nw, const size_t LB, const int pad, const size_t str, const size_t dil, const int xc);
+
+int conv1d_multi_s (float *Y, const float *X, const float *W, const float *B, const size_t L, const size_t Cin, const size_t Cout, const size_t NB, const size_t K, const size_t G, const int pad, const size_t str, const size_t dil, const int xc);
+int conv1d_multi_d (double *Y, const double *X, const double *W, const double *B, const size_t L, const size_t Cin, const size_t Cout, const size_t NB, const size_t K, const size_t G, const int pad, const size_t str, const size_t dil, const int xc);
+
+
+static void conv1d_multi_lims (int *lo, int *hi, const int t0, const int str, const int L, const int nw)
+{
+    //Range [lo hi) of w in [0 nw) such that t0+w*str is in [0 L)
+    int l = (t0>=0) ? 0 : (-t0+str-1)/str;
+    int h = (t0>L-1) ? 0 : (L-1-t0)/str + 1;
+    if (l>nw) { l = nw; }
+    if (h>nw) { h = nw; }
+    if (h<l) { h = l; }
+    *lo = l; *hi = h;
+}
+
+
+static void conv1d_multi_im2col_s (float *Cl, const float *X, const size_t L, const size_t Ci, const size_t K, const size_t w0, const size_t nw, const size_t LB, const int pad, const size_t str, const size_t dil, const int xc)
+{
+    int lo, hi;
+
+    for (size_t ci=0u; ci<Ci; ++ci, X+=L)
+    {
+        for (size_t k=0u; k<K; ++k, Cl+=LB)
+        {
+            const int t0 = (int)(w0*str) + (int)(dil*(xc ? k : K-1u-k)) - pad;
+            conv1d_multi_lims(&lo,&hi,t0,(int)str,(int)L,(int)nw);
+            for (int w=0; w<lo; ++w) { Cl[w] = 0.0f; }
+            if (str==1u) { for (int w=lo; w<hi; ++w) { Cl[w] = X[t0+w]; } }
+            else { for (int w=lo; w<hi; ++w) { Cl[w] = X[t0+w*(int)str]; } }
+            for (int w=hi; w<(int)nw; ++w) { Cl[w] = 0.0f; }
+        }
+    }
+}
+
+
+static void conv1d_multi_im2col_d (double *Cl, const double *X, const size_t L, const size_t Ci, const size_t K, const size_t w0, const size_t nw, const size_t LB, const int pad, const size_t str, const size_t dil, const int xc)
+{
+    int lo, hi;
+
+    for (size_t ci=0u; ci<Ci; ++ci, X+=L)
+    {
+        for (size_t k=0u; k<K; ++k, Cl+=LB)
+        {
+            const int t0 = (int)(w0*str) + (int)(dil*(xc ? k : K-1u-k)) - pad;
+            conv1d_multi_lims(&lo,&hi,t0,(int)str,(int)L,(int)nw);
+            for (int w=0; w<lo; ++w) { Cl[w] = 0.0; }
+            if (str==1u) { for (int w=lo; w<hi; ++w) { Cl[w] = X[t0+w]; } }
+            else { for (int w=lo; w<hi; ++w) { Cl[w] = X[t0+w*(int)str]; } }
+            for (int w=hi; w<(int)nw; ++w) { Cl[w] = 0.0; }
+        }
+    }
+}
+
+
+int conv1d_multi_s (float *Y, const float *X, const float *W, const float *B, const size_t L, const size_t Cin, const size_t Cout, const size_t NB, const size_t K, const size_t G, const int pad, const size_t str, const size_t dil, const int xc)
+{
+    if (str<1u) { fprintf(stderr,"error in conv1d_multi_s: str (stride) must be positive\n"); return 1; }
+    if (dil<1u) { fprintf(stderr,"error in conv1d_multi_s: dil (dilation) must be positive\n"); return 1; }
+    if (K<1u) { fprintf(stderr,"error in conv1d_multi_s: K (kernel_size) must be positive\n"); return 1; }
+    if (G<1u) { fprintf(stderr,"error in conv1d_multi_s: G (num groups) must be positive\n"); return 1; }
+    if (Cin<1u || Cout<1u) { fprintf(stderr,"error in conv1d_multi_s: Cin and Cout must be positive\n"); return 1; }
+    if (Cin%G || Cout%G) { fprintf(stderr,"error in conv1d_multi_s: Cin and Cout must be divisible by G\n"); return 1; }
+    if (L<1u) { fprintf(stderr,"error in conv1d_multi_s: L (length of input channels) must be positive\n"); return 1; }
+    if (pad<0) { fprintf(stderr,"error in conv1d_multi_s: pad must be nonnegative\n"); return 1; }
+    if ((int)L+2*pad<=(int)(dil*(K-1u))) { fprintf(stderr,"error in conv1d_multi_s: L+2*pad must be > dil*(K-1)\n"); return 1; }
+
+    const size_t Lout = 1u + (L+2u*(size_t)pad-dil*(K-1u)-1u)/str;
+    const size_t Ci = Cin/G, Co = Cout/G;   //channels per group
+    const size_t CK = Ci*K;                 //rows of im2col matrix (= cols of W for one group)
+    int lo, hi;
+
+    if (NB==0u) {}
+    else if (Ci==1u)
+    {
+        //Depthwise (direct)
+        const size_t LB = 512u;
+        for (size_t b=NB; b>0u; --b)
+        {
+            for (size_t g=0u; g<G; ++g, X+=L)
+            {
+                for (size_t co=g*Co; co<(g+1u)*Co; ++co, Y+=Lout)
+                {
+                    const float *Wc = &W[co*K];
+                    const float bs = (B) ? B[co] : 0.0f;
+                    for (size_t w0=0u; w0<Lout; w0+=LB)
+                    {
+                        const size_t nw = (Lout-w0<LB) ? Lout-w0 : LB;
+                        float *y = &Y[w0];
+                        for (size_t w=0u; w<nw; ++w) { y[w] = bs; }
+                        for (size_t k=0u; k<K; ++k)
+                        {
+                            const float wk = Wc[xc ? k : K-1u-k];
+                            const int t0 = (int)(w0*str) + (int)(dil*k) - pad;
+                            conv1d_multi_lims(&lo,&hi,t0,(int)str,(int)L,(int)nw);
+                            if (str==1u) { for (int w=lo; w<hi; ++w) { y[w] += wk * X[t0+w]; } }
+                            else { for (int w=lo; w<hi; ++w) { y[w] += wk * X[t0+w*(int)str]; } }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        //im2col + GEMM
+        size_t LB = (256u*1024u) / (CK*sizeof(float));
+        LB = (LB<16u) ? 16u : (LB>Lout) ? Lout : LB - LB%16u;
+        float *Cl;
+        if (!(Cl=(float *)malloc(CK*LB*sizeof(float)))) { fprintf(stderr,"error in conv1d_multi_s: problem with malloc. "); perror("malloc"); return 1; }
+
+        for (size_t b=NB; b>0u; --b)
+        {
+            for (size_t g=0u; g<G; ++g, X+=Ci*L, Y+=Co*Lout)
+            {
+                const float *Wg = &W[g*Co*CK];
+                for (size_t co=0u; co<Co; ++co)
+                {
+                    const float bs = (B) ? B[g*Co+co] : 0.0f;
+                    for (size_t w=0u; w<Lout; ++w) { Y[co*Lout+w] = bs; }
+                }
+                for (size_t w0=0u; w0<Lout; w0+=LB)
+                {
+                    const size_t nw = (Lout-w0<LB) ? Lout-w0 : LB;
+                    conv1d_multi_im2col_s(Cl,X,L,Ci,K,w0,nw,LB,pad,str,dil,xc);
+                    cblas_sgemm(CblasRowMajor,CblasNoTrans,CblasNoTrans,(int)Co,(int)nw,(int)CK,1.0f,Wg,(int)CK,Cl,(int)LB,1.0f,&Y[w0],(int)Lout);
+                }
+            }
+        }
+        free(Cl);
+    }
+
+    return 0;
+}
+
+
+int conv1d_multi_d (double *Y, const double *X, const double *W, const double *B, const size_t L, const size_t Cin, const size_t Cout, const size_t NB, const size_t K, const size_t G, const int pad, const size_t str, const size_t dil, const int xc)
+{
+    if (str<1u) { fprintf(stderr,"error in conv1d_multi_d: str (stride) must be positive\n"); return 1; }
+    if (dil<1u) { fprintf(stderr,"error in conv1d_multi_d: dil (dilation) must be positive\n"); return 1; }
+    if (K<1u) { fprintf(stderr,"error in conv1d_multi_d: K (kernel_size) must be positive\n"); return 1; }
+    if (G<1u) { fprintf(stderr,"error in conv1d_multi_d: G (num groups) must be positive\n"); return 1; }
+    if (Cin<1u || Cout<1u) { fprintf(stderr,"error in conv1d_multi_d: Cin and Cout must be positive\n"); return 1; }
+    if (Cin%G || Cout%G) { fprintf(stderr,"error in conv1d_multi_d: Cin and Cout must be divisible by G\n"); return 1; }
+    if (L<1u) { fprintf(stderr,"error in conv1d_multi_d: L (length of input channels) must be positive\n"); return 1; }
+    if (pad<0) { fprintf(stderr,"error in conv1d_multi_d: pad must be nonnegative\n"); return 1; }
+    if ((int)L+2*pad<=(int)(dil*(K-1u))) { fprintf(stderr,"error in conv1d_multi_d: L+2*pad must be > dil*(K-1)\n"); return 1; }
+
+    const size_t Lout = 1u + (L+2u*(size_t)pad-dil*(K-1u)-1u)/str;
+    const size_t Ci = Cin/G, Co = Cout/G;   //channels per group
+    const size_t CK = Ci*K;                 //rows of im2col matrix (= cols of W for one group)
+    int lo, hi;
+
+    if (NB==0u) {}
+    else if (Ci==1u)
+    {
+        //Depthwise (direct)
+        const size_t LB = 512u;
+        for (size_t b=NB; b>0u; --b)
+        {
+            for (size_t g=0u; g<G; ++g, X+=L)
+            {
+                for (size_t co=g*Co; co<(g+1u)*Co; ++co, Y+=Lout)
+                {
+                    const double *Wc = &W[co*K];
+                    const double bs = (B) ? B[co] : 0.0;
+                    for (size_t w0=0u; w0<Lout; w0+=LB)
+                    {
+                        const size_t nw = (Lout-w0<LB) ? Lout-w0 : LB;
+                        double *y = &Y[w0];
+                        for (size_t w=0u; w<nw; ++w) { y[w] = bs; }
+                        for (size_t k=0u; k<K; ++k)
+                        {
+                            const double wk = Wc[xc ? k : K-1u-k];
+                            const int t0 = (int)(w0*str) + (int)(dil*k) - pad;
+                            conv1d_multi_lims(&lo,&hi,t0,(int)str,(int)L,(int)nw);
+                            if (str==1u) { for (int w=lo; w<hi; ++w) { y[w] += wk * X[t0+w]; } }
+                            else { for (int w=lo; w<hi; ++w) { y[w] += wk * X[t0+w*(int)str]; } }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    else
+    {
+        //im2col + GEMM
+        size_t LB = (256u*1024u) / (CK*sizeof(double));
+        LB = (LB<16u) ? 16u : (LB>Lout) ? Lout : LB - LB%16u;
+        double *Cl;
+        if (!(Cl=(double *)malloc(CK*LB*sizeof(double)))) { fprintf(stderr,"error in conv1d_multi_d: problem with malloc. "); perror("malloc"); return 1; }
+
+        for (size_t b=NB; b>0u; --b)
+        {
+            for (size_t g=0u; g<G; ++g, X+=Ci*L, Y+=Co*Lout)
+            {
+                const double *Wg = &W[g*Co*CK];
+                for (size_t co=0u; co<Co; ++co)
+                {
+                    const double bs = (B) ? B[g*Co+co] : 0.0;
+                    for (size_t w=0u; w<Lout; ++w) { Y[co*Lout+w] = bs; }
+                }
+                for (size_t w0=0u; w0<Lout; w0+=LB)
+                {
+                    const size_t nw = (Lout-w0<LB) ? Lout-w0 : LB;
+                    conv1d_multi_im2col_d(Cl,X,L,Ci,K,w0,nw,LB,pad,str,dil,xc);
+                    cblas_dgemm(CblasRowMajor,CblasNoTrans,CblasNoTrans,(int)Co,(int)nw,(int)CK,1.0,Wg,(int)CK,Cl,(int)LB,1.0,&Y[w0],(int)Lout);
+                }
+            }
+        }
+        free(Cl);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
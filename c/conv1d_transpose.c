@@ -0,0 +1,439 @@
+//1D transposed convolution (fractionally-strided convolution) of each vector in X1 by X2.
+//Each vector in X1 has length L1. X2 has length L2 (kernel_size).
+
+//This is the transpose (adjoint) of conv1d with the same pad, str (stride) and dil (dilation),
+//i.e. the usual learned upsampling layer of decoders and vocoders.
+//With X2 flipped, this emulates PyTorch ConvTranspose1d (without output_padding),
+//just as conv1d emulates PyTorch Conv1d with X2 flipped.
+//Each vector in Y has length L_out, set by:
+//L_out = (L1-1)*str + dil*(L2-1) + 1 - 2*pad.
+
+//For a univariate signal, with frame positions i*str - pad:
+//Y[i*str - pad + (L2-1-l)*dil] += X1[i] * X2[l], for i = 0..L1-1 and l = 0..L2-1.
+
+//This is the same as zero-stuffing X1 (str-1 zeros after each sample) and then conv1d with stride 1,
+//but computed polyphase, so that only the nonzero samples are multiplied:
+//for output phase p = (n+pad)%str, only the taps with (L2-1-l)*dil%str==p contribute.
+//This takes L1*L2 multiplies per vec, instead of ~str*L1*L2 for zero-stuffing.
+
+//Each vec of X1 is first copied to a zero-padded buffer, so there are no edge cases.
+//Each phase is then done in blocks of 512 outputs, accumulating 4 taps at a time
+//over contiguous runs of X1 (so the inner loop vectorizes), and then scattering to Y with step str.
+
+//Negative pad is allowed, and gives zeros at the edges of Y (as for conv1d).
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void conv1d_transpose_taps (size_t *P0, size_t *Lp, const size_t L2, const size_t str, const size_t dil);
+static void conv1d_transpose_1d_s (float *Y, const float *Xp, const float *Hp, const size_t *Qp, const size_t *P0, float *Yb, const size_t JB, const size_t W, const int pad, const size_t str, const size_t K);
+static void conv1d_transpose_1d_d (double *Y, const double *Xp, const double *Hp, const size_t *Qp, const size_t *P0, double *Yb, const size_t JB, const size_t W, const int pad, const size_t str, const size_t K);
+static void conv1d_transpose_1d_c (float *Y, const float *Xp, const float *Hp, const size_t *Qp, const size_t *P0, float *Yb, const size_t JB, const size_t W, const int pad, const size_t str, const size_t K);
+static void conv1d_transpose_1d_z (double *Y, const double *Xp, const double *Hp, const size_t *Qp, const size_t *P0, double *Yb, const size_t JB, const size_t W, const int pad, const size_t str, const size_t K);
+
+int conv1d_transpose_s (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim);
+int conv1d_transpose_d (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim);
+int conv1d_transpose_c (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim);
+int conv1d_transpose_z (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim);
+
+
+static void conv1d_transpose_taps (size_t *P0, size_t *Lp, const size_t L2, const size_t str, const size_t dil)
+{
+    //Orders the taps by output phase: taps P0[p] to P0[p+1]-1 are for phase p,
+    //and Lp[t] is the original tap index l. Within each phase, the offsets (L2-1-l)*dil/str are ascending.
+    size_t t = 0u;
+    for (size_t p=0u; p<str; ++p)
+    {
+        P0[p] = t;
+        for (size_t m=0u; m<L2; ++m)
+        {
+            if ((m*dil)%str==p) { Lp[t++] = L2-1u-m; }
+        }
+    }
+    P0[str] = t;
+}
+
+
+static void conv1d_transpose_1d_s (float *Y, const float *Xp, const float *Hp, const size_t *Qp, const size_t *P0, float *Yb, const size_t JB, const size_t W, const int pad, const size_t str, const size_t K)
+{
+    //Outputs before the first frame (negative pad)
+    for (size_t n=0u; (int)n<-pad && n<W; ++n) { Y[n*K] = 0.0f; }
+
+    //Outputs of phase p are Y[p+str*j-pad], for j in [jlo jhi).
+    //The phases are done together for each block of j, so that each block of Y stays in cache.
+    const size_t jend = (size_t)((int)W+pad+(int)str-1) / str;
+    for (size_t jb=(pad>0) ? (size_t)pad/str : 0u; jb<jend; jb+=JB)
+    {
+        for (size_t p=0u; p<str; ++p)
+        {
+            const int n0 = (int)p - pad;
+            const size_t jlo = (n0>=0) ? 0u : (size_t)(-n0+(int)str-1)/str;
+            const size_t jhi = ((int)W>n0) ? (size_t)((int)W-n0+(int)str-1)/str : 0u;
+            const size_t j0 = (jb>jlo) ? jb : jlo;
+            const size_t j1 = (jb+JB<jhi) ? jb+JB : jhi;
+            if (j1<=j0) { continue; }
+            const size_t J = j1 - j0, t1 = P0[p+1u];
+            const float *x = &Xp[j0];
+            size_t t = P0[p];
+            for (size_t j=0u; j<J; ++j) { Yb[j] = 0.0f; }
+
+            //Accumulate 4 taps per pass over Yb (Xp is zero-padded, so no bounds checks)
+            for (; t+4u<=t1; t+=4u)
+            {
+                const float h0 = Hp[t], h1 = Hp[t+1u], h2 = Hp[t+2u], h3 = Hp[t+3u];
+                const float *x0 = x - Qp[t], *x1 = x - Qp[t+1u], *x2 = x - Qp[t+2u], *x3 = x - Qp[t+3u];
+                for (size_t j=0u; j<J; ++j) { Yb[j] += h0*x0[j] + h1*x1[j] + h2*x2[j] + h3*x3[j]; }
+            }
+            for (; t<t1; ++t)
+            {
+                const float h0 = Hp[t], *x0 = x - Qp[t];
+                for (size_t j=0u; j<J; ++j) { Yb[j] += h0*x0[j]; }
+            }
+
+            float *y = &Y[(size_t)((int)(str*j0)+n0)*K];
+            for (size_t j=0u; j<J; ++j, y+=str*K) { *y = Yb[j]; }
+        }
+    }
+}
+
+
+static void conv1d_transpose_1d_d (double *Y, const double *Xp, const double *Hp, const size_t *Qp, const size_t *P0, double *Yb, const size_t JB, const size_t W, const int pad, const size_t str, const size_t K)
+{
+    //Outputs before the first frame (negative pad)
+    for (size_t n=0u; (int)n<-pad && n<W; ++n) { Y[n*K] = 0.0; }
+
+    //Outputs of phase p are Y[p+str*j-pad], for j in [jlo jhi).
+    //The phases are done together for each block of j, so that each block of Y stays in cache.
+    const size_t jend = (size_t)((int)W+pad+(int)str-1) / str;
+    for (size_t jb=(pad>0) ? (size_t)pad/str : 0u; jb<jend; jb+=JB)
+    {
+        for (size_t p=0u; p<str; ++p)
+        {
+            const int n0 = (int)p - pad;
+            const size_t jlo = (n0>=0) ? 0u : (size_t)(-n0+(int)str-1)/str;
+            const size_t jhi = ((int)W>n0) ? (size_t)((int)W-n0+(int)str-1)/str : 0u;
+            const size_t j0 = (jb>jlo) ? jb : jlo;
+            const size_t j1 = (jb+JB<jhi) ? jb+JB : jhi;
+            if (j1<=j0) { continue; }
+            const size_t J = j1 - j0, t1 = P0[p+1u];
+            const double *x = &Xp[j0];
+            size_t t = P0[p];
+            for (size_t j=0u; j<J; ++j) { Yb[j] = 0.0; }
+
+            //Accumulate 4 taps per pass over Yb (Xp is zero-padded, so no bounds checks)
+            for (; t+4u<=t1; t+=4u)
+            {
+                const double h0 = Hp[t], h1 = Hp[t+1u], h2 = Hp[t+2u], h3 = Hp[t+3u];
+                const double *x0 = x - Qp[t], *x1 = x - Qp[t+1u], *x2 = x - Qp[t+2u], *x3 = x - Qp[t+3u];
+                for (size_t j=0u; j<J; ++j) { Yb[j] += h0*x0[j] + h1*x1[j] + h2*x2[j] + h3*x3[j]; }
+            }
+            for (; t<t1; ++t)
+            {
+                const double h0 = Hp[t], *x0 = x - Qp[t];
+                for (size_t j=0u; j<J; ++j) { Yb[j] += h0*x0[j]; }
+            }
+
+            double *y = &Y[(size_t)((int)(str*j0)+n0)*K];
+            for (size_t j=0u; j<J; ++j, y+=str*K) { *y = Yb[j]; }
+        }
+    }
+}
+
+
+static void conv1d_transpose_1d_c (float *Y, const float *Xp, const float *Hp, const size_t *Qp, const size_t *P0, float *Yb, const size_t JB, const size_t W, const int pad, const size_t str, const size_t K)
+{
+    //Outputs before the first frame (negative pad)
+    for (size_t n=0u; (int)n<-pad && n<W; ++n) { Y[2u*n*K] = Y[2u*n*K+1u] = 0.0f; }
+
+    //Outputs of phase p are Y[p+str*j-pad], for j in [jlo jhi).
+    //The phases are done together for each block of j, so that each block of Y stays in cache.
+    const size_t jend = (size_t)((int)W+pad+(int)str-1) / str;
+    for (size_t jb=(pad>0) ? (size_t)pad/str : 0u; jb<jend; jb+=JB)
+    {
+        for (size_t p=0u; p<str; ++p)
+        {
+            const int n0 = (int)p - pad;
+            const size_t jlo = (n0>=0) ? 0u : (size_t)(-n0+(int)str-1)/str;
+            const size_t jhi = ((int)W>n0) ? (size_t)((int)W-n0+(int)str-1)/str : 0u;
+            const size_t j0 = (jb>jlo) ? jb : jlo;
+            const size_t j1 = (jb+JB<jhi) ? jb+JB : jhi;
+            if (j1<=j0) { continue; }
+            const size_t J = j1 - j0;
+            const float *x = &Xp[2u*j0];
+            for (size_t j=0u; j<2u*J; ++j) { Yb[j] = 0.0f; }
+
+            //Accumulate one tap per pass over Yb (Xp is zero-padded, so no bounds checks)
+            for (size_t t=P0[p]; t<P0[p+1u]; ++t)
+            {
+                const float hr = Hp[2u*t], hi = Hp[2u*t+1u], *x0 = x - 2u*Qp[t];
+                for (size_t j=0u; j<2u*J; j+=2u)
+                {
+                    Yb[j] += hr*x0[j] - hi*x0[j+1u];
+                    Yb[j+1u] += hr*x0[j+1u] + hi*x0[j];
+                }
+            }
+
+            float *y = &Y[2u*K*(size_t)((int)(str*j0)+n0)];
+            for (size_t j=0u; j<2u*J; j+=2u, y+=2u*str*K) { *y = Yb[j]; *(y+1) = Yb[j+1u]; }
+        }
+    }
+}
+
+
+static void conv1d_transpose_1d_z (double *Y, const double *Xp, const double *Hp, const size_t *Qp, const size_t *P0, double *Yb, const size_t JB, const size_t W, const int pad, const size_t str, const size_t K)
+{
+    //Outputs before the first frame (negative pad)
+    for (size_t n=0u; (int)n<-pad && n<W; ++n) { Y[2u*n*K] = Y[2u*n*K+1u] = 0.0; }
+
+    //Outputs of phase p are Y[p+str*j-pad], for j in [jlo jhi).
+    //The phases are done together for each block of j, so that each block of Y stays in cache.
+    const size_t jend = (size_t)((int)W+pad+(int)str-1) / str;
+    for (size_t jb=(pad>0) ? (size_t)pad/str : 0u; jb<jend; jb+=JB)
+    {
+        for (size_t p=0u; p<str; ++p)
+        {
+            const int n0 = (int)p - pad;
+            const size_t jlo = (n0>=0) ? 0u : (size_t)(-n0+(int)str-1)/str;
+            const size_t jhi = ((int)W>n0) ? (size_t)((int)W-n0+(int)str-1)/str : 0u;
+            const size_t j0 = (jb>jlo) ? jb : jlo;
+            const size_t j1 = (jb+JB<jhi) ? jb+JB : jhi;
+            if (j1<=j0) { continue; }
+            const size_t J = j1 - j0;
+            const double *x = &Xp[2u*j0];
+            for (size_t j=0u; j<2u*J; ++j) { Yb[j] = 0.0; }
+
+            //Accumulate one tap per pass over Yb (Xp is zero-padded, so no bounds checks)
+            for (size_t t=P0[p]; t<P0[p+1u]; ++t)
+            {
+                const double hr = Hp[2u*t], hi = Hp[2u*t+1u], *x0 = x - 2u*Qp[t];
+                for (size_t j=0u; j<2u*J; j+=2u)
+                {
+                    Yb[j] += hr*x0[j] - hi*x0[j+1u];
+                    Yb[j+1u] += hr*x0[j+1u] + hi*x0[j];
+                }
+            }
+
+            double *y = &Y[2u*K*(size_t)((int)(str*j0)+n0)];
+            for (size_t j=0u; j<2u*J; j+=2u, y+=2u*str*K) { *y = Yb[j]; *(y+1) = Yb[j+1u]; }
+        }
+    }
+}
+
+
+int conv1d_transpose_s (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in conv1d_transpose_s: dim must be in [0 3]\n"); return 1; }
+    if (str<1u) { fprintf(stderr,"error in conv1d_transpose_s: str (stride) must be positive\n"); return 1; }
+    if (dil<1u) { fprintf(stderr,"error in conv1d_transpose_s: dil (dilation) must be positive\n"); return 1; }
+    if (L2<1u) { fprintf(stderr,"error in conv1d_transpose_s: L2 (length of X2) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if (N<1u) { fprintf(stderr,"error in conv1d_transpose_s: N (total length of X1) must be positive\n"); return 1; }
+    if (L1<1u) { fprintf(stderr,"error in conv1d_transpose_s: L1 (length of vecs in X1) must be positive\n"); return 1; }
+
+    const int Nf = (int)((L1-1u)*str + dil*(L2-1u)) + 1;     //full length of vecs in Y without padding
+    if (Nf<=2*pad) { fprintf(stderr,"error in conv1d_transpose_s: (L1-1)*str+dil*(L2-1)+1 must be > 2*pad\n"); return 1; }
+    const size_t W = (size_t)(Nf-2*pad);                     //L_out
+
+    const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+    const size_t V = N/L1;
+    const size_t JB = 512u;                                  //block size (outputs per phase)
+    const size_t Q = (L2-1u)*dil/str;                        //max tap offset (in samps of X1)
+    const size_t J = ((int)W+pad>0) ? ((size_t)((int)W+pad)+str-1u)/str : 0u;
+    const size_t LX = Q + ((J>L1) ? J : L1);                 //length of zero-padded X1
+
+    //Polyphase taps
+    size_t *P0, *Lp, *Qp;
+    float *Hp, *Xp, *Yb;
+    if (!(P0=(size_t *)malloc((str+1u)*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_s: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Lp=(size_t *)malloc(L2*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_s: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Qp=(size_t *)malloc(L2*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_s: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Hp=(float *)malloc(L2*sizeof(float)))) { fprintf(stderr,"error in conv1d_transpose_s: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Xp=(float *)calloc(LX,sizeof(float)))) { fprintf(stderr,"error in conv1d_transpose_s: problem with calloc. "); perror("calloc"); return 1; }
+    if (!(Yb=(float *)malloc(JB*sizeof(float)))) { fprintf(stderr,"error in conv1d_transpose_s: problem with malloc. "); perror("malloc"); return 1; }
+    conv1d_transpose_taps(P0,Lp,L2,str,dil);
+    for (size_t t=0u; t<L2; ++t)
+    {
+        Hp[t] = X2[Lp[t]];
+        Qp[t] = (L2-1u-Lp[t])*dil/str;
+    }
+
+    for (size_t v=0u; v<V; ++v)
+    {
+        const float *x1 = &X1[(v/K)*K*L1+v%K];
+        for (size_t l=0u; l<L1; ++l) { Xp[Q+l] = x1[l*K]; }
+        conv1d_transpose_1d_s(&Y[(v/K)*K*W+v%K],&Xp[Q],Hp,Qp,P0,Yb,JB,W,pad,str,K);
+    }
+
+    free(P0); free(Lp); free(Qp); free(Hp); free(Xp); free(Yb);
+
+    return 0;
+}
+
+
+int conv1d_transpose_d (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in conv1d_transpose_d: dim must be in [0 3]\n"); return 1; }
+    if (str<1u) { fprintf(stderr,"error in conv1d_transpose_d: str (stride) must be positive\n"); return 1; }
+    if (dil<1u) { fprintf(stderr,"error in conv1d_transpose_d: dil (dilation) must be positive\n"); return 1; }
+    if (L2<1u) { fprintf(stderr,"error in conv1d_transpose_d: L2 (length of X2) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if (N<1u) { fprintf(stderr,"error in conv1d_transpose_d: N (total length of X1) must be positive\n"); return 1; }
+    if (L1<1u) { fprintf(stderr,"error in conv1d_transpose_d: L1 (length of vecs in X1) must be positive\n"); return 1; }
+
+    const int Nf = (int)((L1-1u)*str + dil*(L2-1u)) + 1;     //full length of vecs in Y without padding
+    if (Nf<=2*pad) { fprintf(stderr,"error in conv1d_transpose_d: (L1-1)*str+dil*(L2-1)+1 must be > 2*pad\n"); return 1; }
+    const size_t W = (size_t)(Nf-2*pad);                     //L_out
+
+    const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+    const size_t V = N/L1;
+    const size_t JB = 512u;                                  //block size (outputs per phase)
+    const size_t Q = (L2-1u)*dil/str;                        //max tap offset (in samps of X1)
+    const size_t J = ((int)W+pad>0) ? ((size_t)((int)W+pad)+str-1u)/str : 0u;
+    const size_t LX = Q + ((J>L1) ? J : L1);                 //length of zero-padded X1
+
+    //Polyphase taps
+    size_t *P0, *Lp, *Qp;
+    double *Hp, *Xp, *Yb;
+    if (!(P0=(size_t *)malloc((str+1u)*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_d: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Lp=(size_t *)malloc(L2*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_d: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Qp=(size_t *)malloc(L2*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_d: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Hp=(double *)malloc(L2*sizeof(double)))) { fprintf(stderr,"error in conv1d_transpose_d: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Xp=(double *)calloc(LX,sizeof(double)))) { fprintf(stderr,"error in conv1d_transpose_d: problem with calloc. "); perror("calloc"); return 1; }
+    if (!(Yb=(double *)malloc(JB*sizeof(double)))) { fprintf(stderr,"error in conv1d_transpose_d: problem with malloc. "); perror("malloc"); return 1; }
+    conv1d_transpose_taps(P0,Lp,L2,str,dil);
+    for (size_t t=0u; t<L2; ++t)
+    {
+        Hp[t] = X2[Lp[t]];
+        Qp[t] = (L2-1u-Lp[t])*dil/str;
+    }
+
+    for (size_t v=0u; v<V; ++v)
+    {
+        const double *x1 = &X1[(v/K)*K*L1+v%K];
+        for (size_t l=0u; l<L1; ++l) { Xp[Q+l] = x1[l*K]; }
+        conv1d_transpose_1d_d(&Y[(v/K)*K*W+v%K],&Xp[Q],Hp,Qp,P0,Yb,JB,W,pad,str,K);
+    }
+
+    free(P0); free(Lp); free(Qp); free(Hp); free(Xp); free(Yb);
+
+    return 0;
+}
+
+
+int conv1d_transpose_c (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in conv1d_transpose_c: dim must be in [0 3]\n"); return 1; }
+    if (str<1u) { fprintf(stderr,"error in conv1d_transpose_c: str (stride) must be positive\n"); return 1; }
+    if (dil<1u) { fprintf(stderr,"error in conv1d_transpose_c: dil (dilation) must be positive\n"); return 1; }
+    if (L2<1u) { fprintf(stderr,"error in conv1d_transpose_c: L2 (length of X2) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if (N<1u) { fprintf(stderr,"error in conv1d_transpose_c: N (total length of X1) must be positive\n"); return 1; }
+    if (L1<1u) { fprintf(stderr,"error in conv1d_transpose_c: L1 (length of vecs in X1) must be positive\n"); return 1; }
+
+    const int Nf = (int)((L1-1u)*str + dil*(L2-1u)) + 1;     //full length of vecs in Y without padding
+    if (Nf<=2*pad) { fprintf(stderr,"error in conv1d_transpose_c: (L1-1)*str+dil*(L2-1)+1 must be > 2*pad\n"); return 1; }
+    const size_t W = (size_t)(Nf-2*pad);                     //L_out
+
+    const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+    const size_t V = N/L1;
+    const size_t JB = 512u;                                  //block size (outputs per phase)
+    const size_t Q = (L2-1u)*dil/str;                        //max tap offset (in samps of X1)
+    const size_t J = ((int)W+pad>0) ? ((size_t)((int)W+pad)+str-1u)/str : 0u;
+    const size_t LX = Q + ((J>L1) ? J : L1);                 //length of zero-padded X1
+
+    //Polyphase taps
+    size_t *P0, *Lp, *Qp;
+    float *Hp, *Xp, *Yb;
+    if (!(P0=(size_t *)malloc((str+1u)*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_c: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Lp=(size_t *)malloc(L2*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_c: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Qp=(size_t *)malloc(L2*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_c: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Hp=(float *)malloc(2u*L2*sizeof(float)))) { fprintf(stderr,"error in conv1d_transpose_c: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Xp=(float *)calloc(2u*LX,sizeof(float)))) { fprintf(stderr,"error in conv1d_transpose_c: problem with calloc. "); perror("calloc"); return 1; }
+    if (!(Yb=(float *)malloc(2u*JB*sizeof(float)))) { fprintf(stderr,"error in conv1d_transpose_c: problem with malloc. "); perror("malloc"); return 1; }
+    conv1d_transpose_taps(P0,Lp,L2,str,dil);
+    for (size_t t=0u; t<L2; ++t)
+    {
+        Hp[2u*t] = X2[2u*Lp[t]]; Hp[2u*t+1u] = X2[2u*Lp[t]+1u];
+        Qp[t] = (L2-1u-Lp[t])*dil/str;
+    }
+
+    for (size_t v=0u; v<V; ++v)
+    {
+        const float *x1 = &X1[2u*((v/K)*K*L1+v%K)];
+        for (size_t l=0u; l<L1; ++l) { Xp[2u*(Q+l)] = x1[2u*l*K]; Xp[2u*(Q+l)+1u] = x1[2u*l*K+1u]; }
+        conv1d_transpose_1d_c(&Y[2u*((v/K)*K*W+v%K)],&Xp[2u*Q],Hp,Qp,P0,Yb,JB,W,pad,str,K);
+    }
+
+    free(P0); free(Lp); free(Qp); free(Hp); free(Xp); free(Yb);
+
+    return 0;
+}
+
+
+int conv1d_transpose_z (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in conv1d_transpose_z: dim must be in [0 3]\n"); return 1; }
+    if (str<1u) { fprintf(stderr,"error in conv1d_transpose_z: str (stride) must be positive\n"); return 1; }
+    if (dil<1u) { fprintf(stderr,"error in conv1d_transpose_z: dil (dilation) must be positive\n"); return 1; }
+    if (L2<1u) { fprintf(stderr,"error in conv1d_transpose_z: L2 (length of X2) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if (N<1u) { fprintf(stderr,"error in conv1d_transpose_z: N (total length of X1) must be positive\n"); return 1; }
+    if (L1<1u) { fprintf(stderr,"error in conv1d_transpose_z: L1 (length of vecs in X1) must be positive\n"); return 1; }
+
+    const int Nf = (int)((L1-1u)*str + dil*(L2-1u)) + 1;     //full length of vecs in Y without padding
+    if (Nf<=2*pad) { fprintf(stderr,"error in conv1d_transpose_z: (L1-1)*str+dil*(L2-1)+1 must be > 2*pad\n"); return 1; }
+    const size_t W = (size_t)(Nf-2*pad);                     //L_out
+
+    const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+    const size_t V = N/L1;
+    const size_t JB = 512u;                                  //block size (outputs per phase)
+    const size_t Q = (L2-1u)*dil/str;                        //max tap offset (in samps of X1)
+    const size_t J = ((int)W+pad>0) ? ((size_t)((int)W+pad)+str-1u)/str : 0u;
+    const size_t LX = Q + ((J>L1) ? J : L1);                 //length of zero-padded X1
+
+    //Polyphase taps
+    size_t *P0, *Lp, *Qp;
+    double *Hp, *Xp, *Yb;
+    if (!(P0=(size_t *)malloc((str+1u)*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_z: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Lp=(size_t *)malloc(L2*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_z: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Qp=(size_t *)malloc(L2*sizeof(size_t)))) { fprintf(stderr,"error in conv1d_transpose_z: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Hp=(double *)malloc(2u*L2*sizeof(double)))) { fprintf(stderr,"error in conv1d_transpose_z: problem with malloc. "); perror("malloc"); return 1; }
+    if (!(Xp=(double *)calloc(2u*LX,sizeof(double)))) { fprintf(stderr,"error in conv1d_transpose_z: problem with calloc. "); perror("calloc"); return 1; }
+    if (!(Yb=(double *)malloc(2u*JB*sizeof(double)))) { fprintf(stderr,"error in conv1d_transpose_z: problem with malloc. "); perror("malloc"); return 1; }
+    conv1d_transpose_taps(P0,Lp,L2,str,dil);
+    for (size_t t=0u; t<L2; ++t)
+    {
+        Hp[2u*t] = X2[2u*Lp[t]]; Hp[2u*t+1u] = X2[2u*Lp[t]+1u];
+        Qp[t] = (L2-1u-Lp[t])*dil/str;
+    }
+
+    for (size_t v=0u; v<V; ++v)
+    {
+        const double *x1 = &X1[2u*((v/K)*K*L1+v%K)];
+        for (size_t l=0u; l<L1; ++l) { Xp[2u*(Q+l)] = x1[2u*l*K]; Xp[2u*(Q+l)+1u] = x1[2u*l*K+1u]; }
+        conv1d_transpose_1d_z(&Y[2u*((v/K)*K*W+v%K)],&Xp[2u*Q],Hp,Qp,P0,Yb,JB,W,pad,str,K);
+    }
+
+    free(P0); free(Lp); free(Qp); free(Hp); free(Xp); free(Yb);
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,113 @@
+//1D convolution of each vector in X1 by X2 along dim.
+//This is a front door for conv and conv_fft, which give the same output (see those for more info).
+//The faster method is chosen from a simple cost model, which uses L1, L2, the number of vecs,
+//and the data type (real or complex), with constants from auto_cost.h.
+
+//The direct method costs ~L1*L2 multiply-accumulates per vec.
+//The FFT method costs ~3 FFTs of length nfft = nextpow2(L1+L2) per vec, plus 1 FFT of X2 and 3 fftw plans.
+//So the FFT method is chosen for long X2, except when L1 is short and there are few vecs.
+//The constants in auto_cost.h can be calibrated for the current machine by "make calib".
+
+#include <stdio.h>
+#include <math.h>
+#include "auto_cost.h"
+#include "conv.c"
+#include "conv_fft.c"
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static int conv_auto_fft (const size_t N, const size_t L1, const size_t L2, const int cplx, const double cdir, const double cfft, const double cplan);
+
+int conv_auto_s (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const char shape[], const size_t dim);
+int conv_auto_d (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const char shape[], const size_t dim);
+int conv_auto_c (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const char shape[], const size_t dim);
+int conv_auto_z (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const char shape[], const size_t dim);
+
+
+static int conv_auto_fft (const size_t N, const size_t L1, const size_t L2, const int cplx, const double cdir, const double cfft, const double cplan)
+{
+    const double V = (double)(N/L1);
+    size_t nfft = 1u;
+    while (nfft<L1+L2) { nfft *= 2u; }
+    const double m = (cplx) ? 4.0 : 1.0, f = (cplx) ? 2.0 : 1.0;
+    const double dir = m * cdir * V * (double)L1 * (double)L2;
+    const double fft = 3.0*cplan + f * cfft * (double)nfft * log2((double)nfft) * (1.0+3.0*V);
+    return (fft<dir);
+}
+
+
+int conv_auto_s (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const char shape[], const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in conv_auto_s: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N>0u && conv_auto_fft(N,L1,L2,0,AUTO_COST_CONV_S,AUTO_COST_FFT_S,AUTO_COST_PLAN_S))
+    {
+        return conv_fft_s(Y,X1,X2,R,C,S,H,iscolmajor,L2,shape,dim);
+    }
+    else
+    {
+        return conv_s(Y,X1,X2,R,C,S,H,iscolmajor,L2,shape,dim);
+    }
+}
+
+
+int conv_auto_d (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const char shape[], const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in conv_auto_d: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N>0u && conv_auto_fft(N,L1,L2,0,AUTO_COST_CONV_D,AUTO_COST_FFT_D,AUTO_COST_PLAN_D))
+    {
+        return conv_fft_d(Y,X1,X2,R,C,S,H,iscolmajor,L2,shape,dim);
+    }
+    else
+    {
+        return conv_d(Y,X1,X2,R,C,S,H,iscolmajor,L2,shape,dim);
+    }
+}
+
+
+int conv_auto_c (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const char shape[], const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in conv_auto_c: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N>0u && conv_auto_fft(N,L1,L2,1,AUTO_COST_CONV_S,AUTO_COST_FFT_S,AUTO_COST_PLAN_S))
+    {
+        return conv_fft_c(Y,X1,X2,R,C,S,H,iscolmajor,L2,shape,dim);
+    }
+    else
+    {
+        return conv_c(Y,X1,X2,R,C,S,H,iscolmajor,L2,shape,dim);
+    }
+}
+
+
+int conv_auto_z (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const char shape[], const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in conv_auto_z: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N>0u && conv_auto_fft(N,L1,L2,1,AUTO_COST_CONV_D,AUTO_COST_FFT_D,AUTO_COST_PLAN_D))
+    {
+        return conv_fft_z(Y,X1,X2,R,C,S,H,iscolmajor,L2,shape,dim);
+    }
+    else
+    {
+        return conv_z(Y,X1,X2,R,C,S,H,iscolmajor,L2,shape,dim);
+    }
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,132 @@
+//Densifies an event list, giving the full (dense) tensor with the events at their indices and 0 elsewhere.
+//This is for compatibility with tools that need the dense tensor,
+//since zcs, lcs, mcs, unit_impulse, delta_impulse and rect_pulse can output event lists (with -e).
+//The output is the same as those tools give without -e (up to data type).
+
+//The event list X is a vector of doubles, with a 6-element header:
+//X[0], X[1], X[2], X[3] = R, C, S, H (size of the dense tensor)
+//X[4] = E (number of events)
+//X[5] = 1 if values are included, or 0 if not (then all values are 1.0)
+//X[6] to X[6+E-1] = indices of the events into the dense tensor (in memory order)
+//X[6+E] to X[6+2E-1] = values of the events (only if X[5]==1)
+//So X has length 6+E without values, or 6+2E with values.
+
+//The indices are grouped by vec (in the order of the vecs along dim), and increase within each vec.
+//For a vector (the usual case), the index is just the samp number.
+//Doubles represent the indices exactly (up to 2^53).
+
+//For complex output, the values go to the real part (imaginary part is 0).
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+int densify_s (float *Y, const double *X, const size_t Nx);
+int densify_d (double *Y, const double *X, const size_t Nx);
+int densify_c (float *Y, const double *X, const size_t Nx);
+int densify_z (double *Y, const double *X, const size_t Nx);
+
+
+int densify_s (float *Y, const double *X, const size_t Nx)
+{
+    if (Nx<6u) { fprintf(stderr,"error in densify_s: X (event list) must have at least 6 elements (header)\n"); return 1; }
+    if (X[0]<1.0 || X[1]<1.0 || X[2]<1.0 || X[3]<1.0 || X[4]<0.0) { fprintf(stderr,"error in densify_s: X (event list) has invalid header\n"); return 1; }
+
+    const size_t N = (size_t)X[0] * (size_t)X[1] * (size_t)X[2] * (size_t)X[3];
+    const size_t E = (size_t)X[4];
+    const int hasvals = (X[5]!=0.0);
+    if (Nx!=6u+E+(size_t)hasvals*E) { fprintf(stderr,"error in densify_s: X (event list) length does not match its header\n"); return 1; }
+
+    const double *I = &X[6], *V = &X[6u+E];
+    size_t n;
+
+    for (size_t m=0u; m<N; ++m) { Y[m] = 0.0f; }
+    for (size_t e=0u; e<E; ++e)
+    {
+        if (I[e]<0.0 || (n=(size_t)I[e])>=N) { fprintf(stderr,"error in densify_s: event index out of range\n"); return 1; }
+        Y[n] = (hasvals) ? (float)V[e] : 1.0f;
+    }
+
+    return 0;
+}
+
+
+int densify_d (double *Y, const double *X, const size_t Nx)
+{
+    if (Nx<6u) { fprintf(stderr,"error in densify_d: X (event list) must have at least 6 elements (header)\n"); return 1; }
+    if (X[0]<1.0 || X[1]<1.0 || X[2]<1.0 || X[3]<1.0 || X[4]<0.0) { fprintf(stderr,"error in densify_d: X (event list) has invalid header\n"); return 1; }
+
+    const size_t N = (size_t)X[0] * (size_t)X[1] * (size_t)X[2] * (size_t)X[3];
+    const size_t E = (size_t)X[4];
+    const int hasvals = (X[5]!=0.0);
+    if (Nx!=6u+E+(size_t)hasvals*E) { fprintf(stderr,"error in densify_d: X (event list) length does not match its header\n"); return 1; }
+
+    const double *I = &X[6], *V = &X[6u+E];
+    size_t n;
+
+    for (size_t m=0u; m<N; ++m) { Y[m] = 0.0; }
+    for (size_t e=0u; e<E; ++e)
+    {
+        if (I[e]<0.0 || (n=(size_t)I[e])>=N) { fprintf(stderr,"error in densify_d: event index out of range\n"); return 1; }
+        Y[n] = (hasvals) ? V[e] : 1.0;
+    }
+
+    return 0;
+}
+
+
+int densify_c (float *Y, const double *X, const size_t Nx)
+{
+    if (Nx<6u) { fprintf(stderr,"error in densify_c: X (event list) must have at least 6 elements (header)\n"); return 1; }
+    if (X[0]<1.0 || X[1]<1.0 || X[2]<1.0 || X[3]<1.0 || X[4]<0.0) { fprintf(stderr,"error in densify_c: X (event list) has invalid header\n"); return 1; }
+
+    const size_t N = (size_t)X[0] * (size_t)X[1] * (size_t)X[2] * (size_t)X[3];
+    const size_t E = (size_t)X[4];
+    const int hasvals = (X[5]!=0.0);
+    if (Nx!=6u+E+(size_t)hasvals*E) { fprintf(stderr,"error in densify_c: X (event list) length does not match its header\n"); return 1; }
+
+    const double *I = &X[6], *V = &X[6u+E];
+    size_t n;
+
+    for (size_t m=0u; m<2u*N; ++m) { Y[m] = 0.0f; }
+    for (size_t e=0u; e<E; ++e)
+    {
+        if (I[e]<0.0 || (n=(size_t)I[e])>=N) { fprintf(stderr,"error in densify_c: event index out of range\n"); return 1; }
+        Y[2u*n] = (hasvals) ? (float)V[e] : 1.0f;
+    }
+
+    return 0;
+}
+
+
+int densify_z (double *Y, const double *X, const size_t Nx)
+{
+    if (Nx<6u) { fprintf(stderr,"error in densify_z: X (event list) must have at least 6 elements (header)\n"); return 1; }
+    if (X[0]<1.0 || X[1]<1.0 || X[2]<1.0 || X[3]<1.0 || X[4]<0.0) { fprintf(stderr,"error in densify_z: X (event list) has invalid header\n"); return 1; }
+
+    const size_t N = (size_t)X[0] * (size_t)X[1] * (size_t)X[2] * (size_t)X[3];
+    const size_t E = (size_t)X[4];
+    const int hasvals = (X[5]!=0.0);
+    if (Nx!=6u+E+(size_t)hasvals*E) { fprintf(stderr,"error in densify_z: X (event list) length does not match its header\n"); return 1; }
+
+    const double *I = &X[6], *V = &X[6u+E];
+    size_t n;
+
+    for (size_t m=0u; m<2u*N; ++m) { Y[m] = 0.0; }
+    for (size_t e=0u; e<E; ++e)
+    {
+        if (I[e]<0.0 || (n=(size_t)I[e])>=N) { fprintf(stderr,"error in densify_z: event index out of range\n"); return 1; }
+        Y[2u*n] = (hasvals) ? V[e] : 1.0;
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,68 @@
+//Blocked direct summation for dilated 1D conv/xcorr, used by conv1d and xcorr1d.
+//This is an include-only file with static functions for the real-valued case.
+
+//The outputs are done in blocks of 1024 (in L1 cache) with the taps in the outer loop,
+//so each tap is one stream over X1 (contiguous for str=1, stride str otherwise),
+//instead of L2 loads spaced dil apart for each output. This vectorizes across outputs,
+//so most of the gain is for str=1 (for str>1, the stream over X1 is strided).
+
+//X2 is given in memory order, and flip=1 reverses it (for conv), or flip=0 uses it as is (for xcorr).
+//X1 and Y are contiguous, and Y gets Ly outputs with X2 fully within X1.
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void dil1d_s (float *Y, const float *X1, const float *X2, const size_t Ly, const size_t L2, const size_t str, const size_t dil, const int flip);
+static void dil1d_d (double *Y, const double *X1, const double *X2, const size_t Ly, const size_t L2, const size_t str, const size_t dil, const int flip);
+
+
+static void dil1d_s (float *Y, const float *X1, const float *X2, const size_t Ly, const size_t L2, const size_t str, const size_t dil, const int flip)
+{
+    const size_t TB = 1024u;        //block of outputs (in L1 cache)
+    float hl;
+
+    //Each tap is one stream over a block of outputs (contiguous for str=1), instead of dil-strided taps for each output
+    for (size_t w0=0u; w0<Ly; w0+=TB, Y+=TB, X1+=TB*str)
+    {
+        const size_t tb = (Ly-w0<TB) ? Ly-w0 : TB;
+        for (size_t t=0u; t<tb; ++t) { Y[t] = 0.0f; }
+        for (size_t l=0u; l<L2; ++l)
+        {
+            const float *x = &X1[l*dil];
+            hl = (flip) ? X2[L2-1u-l] : X2[l];
+            if (str==1u) { for (size_t t=0u; t<tb; ++t) { Y[t] += hl * x[t]; } }
+            else { for (size_t t=0u; t<tb; ++t) { Y[t] += hl * x[t*str]; } }
+        }
+    }
+}
+
+
+static void dil1d_d (double *Y, const double *X1, const double *X2, const size_t Ly, const size_t L2, const size_t str, const size_t dil, const int flip)
+{
+    const size_t TB = 1024u;        //block of outputs (in L1 cache)
+    double hl;
+
+    //Each tap is one stream over a block of outputs (contiguous for str=1), instead of dil-strided taps for each output
+    for (size_t w0=0u; w0<Ly; w0+=TB, Y+=TB, X1+=TB*str)
+    {
+        const size_t tb = (Ly-w0<TB) ? Ly-w0 : TB;
+        for (size_t t=0u; t<tb; ++t) { Y[t] = 0.0; }
+        for (size_t l=0u; l<L2; ++l)
+        {
+            const double *x = &X1[l*dil];
+            hl = (flip) ? X2[L2-1u-l] : X2[l];
+            if (str==1u) { for (size_t t=0u; t<tb; ++t) { Y[t] += hl * x[t]; } }
+            else { for (size_t t=0u; t<tb; ++t) { Y[t] += hl * x[t*str]; } }
+        }
+    }
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -8,9 +8,11 @@
 
 //The calling program must ensure that the sizes are correct, the filter is stable, etc.
 
+//For real X, the FIR part uses the register-blocked kernel in fir_blk.c (as in fir).
+
 #include <stdio.h>
 #include <math.h>
-#include <cblas.h>
+#include "fir_blk.c"
 
 #ifdef __cplusplus
 namespace codee {
@@ -30,43 +32,28 @@ int filter_s (float *Y, const float *X, float *A, float *B, const size_t R, cons
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
 
-    //Deal with a0 (usually 1) and b0; also initialize Y
-    float a = *A++, b = *B++;
+    //Deal with a0 (usually 1), and negate a1 to aP
+    const float a = *A++;
     if (a==1.0f)
     {
         for (size_t p=P; p>0u; --p, ++A) { *A = -*A; }
-        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = b * *X; }
     }
     else
     {
-        const float b_a = b / a;
         for (size_t p=P; p>0u; --p, ++A) { *A = -*A / a; }
-        for (size_t q=Q; q>0u; --q, ++B) { *B /= a; }
-        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = b_a * *X; }
-        B -= Q;
+        for (size_t q=Q+1u; q>0u; --q, ++B) { *B /= a; }
+        B -= Q + 1u;
     }
-    A -= P; X -= N; Y -= N;
+    A -= P;
 
-    if (N==0u || L==1u) {}
+    if (N==0u) {}
     else if (L==N)
     {
         //FIR
-        if (L<3000u)
-        {
-            for (size_t q=1u; q<=Q; ++q, ++B, X-=L-q+1u, Y-=L-q)
-            {
-                b = *B;
-                for (size_t l=q; l<L; ++l, ++X) { ++Y; *Y = fmaf(b,*X,*Y); }
-            }
-        }
-        else
-        {
-            for (size_t q=1u; q<=Q; ++q, ++B) { ++Y; cblas_saxpy((int)(L-q),*B,X,1,Y,1); }
-        }
-        Y -= Q;
+        fir_blk_s(Y,X,B,L,Q,1u,1u);
 
         //IIR
-        for (size_t l=0u; l<P; A-=l, ++l, ++Y)
+        for (size_t l=0u; l<P && l<L; A-=l, ++l, ++Y)
         {
             for (size_t p=1u; p<=l; ++p, ++A) { *Y = fmaf(*A,*(Y-p),*Y); }
         }
@@ -83,28 +70,13 @@ int filter_s (float *Y, const float *X, float *A, float *B, const size_t R, cons
 
         if (K==1u && (G==1u || BS==1u))
         {
-            for (size_t v=V; v>0u; --v)
+            for (size_t v=V; v>0u; --v, X+=L)
             {
                 //FIR
-                if (L<30000u)
-                {
-                    for (size_t q=1u; q<=Q; ++q, ++B)
-                    {
-                        b = *B;
-                        for (size_t l=q; l<L; ++l, ++X) { ++Y; *Y = fmaf(b,*X,*Y); }
-                        if (q<Q) { X -= L-q; Y -= L-q-1u; }
-                        else { X += Q; Y -= L-1u; }
-                    }
-                }
-                else
-                {
-                    for (size_t q=1u; q<=Q; ++q, ++B) { ++Y; cblas_saxpy((int)(L-q),*B,X,1,Y,1); }
-                    X += L; Y -= Q;
-                }
-                B -= Q;
+                fir_blk_s(Y,X,B,L,Q,1u,1u);
 
                 //IIR
-                for (size_t l=0u; l<P; A-=l, ++l, ++Y)
+                for (size_t l=0u; l<P && l<L; A-=l, ++l, ++Y)
                 {
                     for (size_t p=1u; p<=l; ++p, ++A) { *Y = fmaf(*A,*(Y-p),*Y); }
                 }
@@ -116,16 +88,15 @@ int filter_s (float *Y, const float *X, float *A, float *B, const size_t R, cons
         }
         else
         {
-            for (size_t g=G; g>0u; --g, X+=BS*(L-1u), Y+=BS*(L-1u))
+            for (size_t g=G; g>0u; --g, X+=K*L, Y+=K*(L-1u))
             {
-                for (size_t bs=BS; bs>0u; --bs, ++X, Y-=K*L-1u)
-                {
-                    //FIR
-                    for (size_t q=1u; q<=Q; ++q, ++B) { Y+=K; cblas_saxpy((int)(L-q),*B,X,(int)K,Y,(int)K); }
-                    Y -= Q*K; B -= Q;
+                //FIR (interleaved vectors are done together as lanes)
+                fir_blk_s(Y,X,B,L,Q,K,K);
 
-                    //IIR
-                    for (size_t l=0u; l<P; A-=l, ++l, Y+=K)
+                //IIR
+                for (size_t bs=K; bs>0u; --bs, Y-=K*L-1u)
+                {
+                    for (size_t l=0u; l<P && l<L; A-=l, ++l, Y+=K)
                     {
                         for (size_t p=1u; p<=l; ++p, ++A) { *Y = fmaf(*A,*(Y-K*p),*Y); }
                     }
@@ -149,43 +120,28 @@ int filter_d (double *Y, const double *X, double *A, double *B, const size_t R,
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
 
-    //Deal with a0 (usually 1) and b0; also initialize Y
-    double a = *A++, b = *B++;
+    //Deal with a0 (usually 1), and negate a1 to aP
+    const double a = *A++;
     if (a==1.0)
     {
         for (size_t p=P; p>0u; --p, ++A) { *A = -*A; }
-        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = b * *X; }
     }
     else
     {
-        const double b_a = b / a;
         for (size_t p=P; p>0u; --p, ++A) { *A = -*A / a; }
-        for (size_t q=Q; q>0u; --q, ++B) { *B /= a; }
-        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = b_a * *X; }
-        B -= Q;
+        for (size_t q=Q+1u; q>0u; --q, ++B) { *B /= a; }
+        B -= Q + 1u;
     }
-    A -= P; X -= N; Y -= N;
+    A -= P;
 
-    if (N==0u || L==1u) {}
+    if (N==0u) {}
     else if (L==N)
     {
         //FIR
-        if (L<3000u)
-        {
-            for (size_t q=1u; q<=Q; ++q, ++B, X-=L-q+1u, Y-=L-q)
-            {
-                b = *B;
-                for (size_t l=q; l<L; ++l, ++X) { ++Y; *Y = fma(b,*X,*Y); }
-            }
-        }
-        else
-        {
-            for (size_t q=1u; q<=Q; ++q, ++B) { ++Y; cblas_daxpy((int)(L-q),*B,X,1,Y,1); }
-        }
-        Y -= Q;
+        fir_blk_d(Y,X,B,L,Q,1u,1u);
 
         //IIR
-        for (size_t l=0u; l<P; A-=l, ++l, ++Y)
+        for (size_t l=0u; l<P && l<L; A-=l, ++l, ++Y)
         {
             for (size_t p=1u; p<=l; ++p, ++A) { *Y = fma(*A,*(Y-p),*Y); }
         }
@@ -202,28 +158,13 @@ int filter_d (double *Y, const double *X, double *A, double *B, const size_t R,
 
         if (K==1u && (G==1u || BS==1u))
         {
-            for (size_t v=V; v>0u; --v)
+            for (size_t v=V; v>0u; --v, X+=L)
             {
                 //FIR
-                if (L<30000u)
-                {
-                    for (size_t q=1u; q<=Q; ++q, ++B)
-                    {
-                        b = *B;
-                        for (size_t l=q; l<L; ++l, ++X) { ++Y; *Y = fma(b,*X,*Y); }
-                        if (q<Q) { X -= L-q; Y -= L-q-1u; }
-                        else { X += Q; Y -= L-1u; }
-                    }
-                }
-                else
-                {
-                    for (size_t q=1u; q<=Q; ++q, ++B) { ++Y; cblas_daxpy((int)(L-q),*B,X,1,Y,1); }
-                    X += L; Y -= Q;
-                }
-                B -= Q;
+                fir_blk_d(Y,X,B,L,Q,1u,1u);
 
                 //IIR
-                for (size_t l=0u; l<P; A-=l, ++l, ++Y)
+                for (size_t l=0u; l<P && l<L; A-=l, ++l, ++Y)
                 {
                     for (size_t p=1u; p<=l; ++p, ++A) { *Y = fma(*A,*(Y-p),*Y); }
                 }
@@ -235,16 +176,15 @@ int filter_d (double *Y, const double *X, double *A, double *B, const size_t R,
         }
         else
         {
-            for (size_t g=G; g>0u; --g, X+=BS*(L-1u), Y+=BS*(L-1u))
+            for (size_t g=G; g>0u; --g, X+=K*L, Y+=K*(L-1u))
             {
-                for (size_t bs=BS; bs>0u; --bs, ++X, Y-=K*L-1u)
-                {
-                    //FIR
-                    for (size_t q=1u; q<=Q; ++q, ++B) { Y+=K; cblas_daxpy((int)(L-q),*B,X,(int)K,Y,(int)K); }
-                    Y -= Q*K; B -= Q;
+                //FIR (interleaved vectors are done together as lanes)
+                fir_blk_d(Y,X,B,L,Q,K,K);
 
-                    //IIR
-                    for (size_t l=0u; l<P; A-=l, ++l, Y+=K)
+                //IIR
+                for (size_t bs=K; bs>0u; --bs, Y-=K*L-1u)
+                {
+                    for (size_t l=0u; l<P && l<L; A-=l, ++l, Y+=K)
                     {
                         for (size_t p=1u; p<=l; ++p, ++A) { *Y = fma(*A,*(Y-K*p),*Y); }
                     }
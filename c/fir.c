@@ -2,9 +2,12 @@
 //FIR impulse response is given in vector B with length Q+1.
 //(I use P for IIR filter order, since same as polynomial order.)
 
+//For real X, this uses the register-blocked kernel in fir_blk.c.
+
 #include <stdio.h>
 #include <math.h>
 #include <cblas.h>
+#include "fir_blk.c"
 
 #ifdef __cplusplus
 namespace codee {
@@ -24,26 +27,10 @@ int fir_s (float *Y, const float *X, const float *B, const size_t R, const size_
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
 
-    //Initialize Y
-    float b = *B++;
-    for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = b * *X; }
-    X -= N; Y -= N - 1u;
-
-    if (N==0u || L==1u || Q==0u) {}
+    if (N==0u) {}
     else if (L==N)
     {
-        if (L<30000u)
-        {
-            for (size_t q=1u; q<=Q; ++q, ++B, X-=L-q+1u, Y-=L-q)
-            {
-                b = *B;
-                for (size_t l=q; l<L; ++l, ++X, ++Y) { *Y = fmaf(b,*X,*Y); }
-            }
-        }
-        else
-        {
-            for (size_t q=1u; q<=Q; ++q, ++B, ++Y) { cblas_saxpy((int)(L-q),*B,X,1,Y,1); }
-        }
+        fir_blk_s(Y,X,B,L,Q,1u,1u);
     }
     else
     {
@@ -53,36 +40,12 @@ int fir_s (float *Y, const float *X, const float *B, const size_t R, const size_
 
         if (K==1u && (G==1u || BS==1u))
         {
-            if (L<30000u)
-            {
-                for (size_t v=V; v>0u; --v, B-=Q, X+=Q, ++Y)
-                {
-                    for (size_t q=1u; q<=Q; ++q, ++B)
-                    {
-                        b = *B;
-                        for (size_t l=q; l<L; ++l, ++X, ++Y) { *Y = fmaf(b,*X,*Y); }
-                        if (q<Q) { X -= L-q; Y -= L-q-1u; }
-                    }
-                }
-            }
-            else
-            {
-                for (size_t v=V; v>0u; --v, B-=Q, X+=L, Y+=L-Q)
-                {
-                    for (size_t q=1u; q<=Q; ++q, ++B, ++Y) { cblas_saxpy((int)(L-q),*B,X,1,Y,1); }
-                }
-            }
+            for (size_t v=V; v>0u; --v, X+=L, Y+=L) { fir_blk_s(Y,X,B,L,Q,1u,1u); }
         }
         else
         {
-            Y += K - 1u;
-            for (size_t g=G; g>0u; --g, X+=BS*(L-1u), Y+=BS*(L-1u))
-            {
-                for (size_t bs=BS; bs>0u; --bs, ++X, B-=Q, Y-=K*Q-1u)
-                {
-                    for (size_t q=1u; q<=Q; ++q, ++B, Y+=K) { cblas_saxpy((int)(L-q),*B,X,(int)K,Y,(int)K); }
-                }
-            }
+            //Interleaved vectors are done together as lanes
+            for (size_t g=G; g>0u; --g, X+=K*L, Y+=K*L) { fir_blk_s(Y,X,B,L,Q,K,K); }
         }
     }
 
@@ -97,26 +60,10 @@ int fir_d (double *Y, const double *X, const double *B, const size_t R, const si
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
 
-    //Initialize Y
-    double b = *B++;
-    for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = b * *X; }
-    X -= N; Y -= N - 1u;
-
-    if (N==0u || L==1u || Q==0u) {}
+    if (N==0u) {}
     else if (L==N)
     {
-        if (L<30000u)
-        {
-            for (size_t q=1u; q<=Q; ++q, ++B, X-=L-q+1u, Y-=L-q)
-            {
-                b = *B;
-                for (size_t l=q; l<L; ++l, ++X, ++Y) { *Y = fma(b,*X,*Y); }
-            }
-        }
-        else
-        {
-            for (size_t q=1u; q<=Q; ++q, ++B, ++Y) { cblas_daxpy((int)(L-q),*B,X,1,Y,1); }
-        }
+        fir_blk_d(Y,X,B,L,Q,1u,1u);
     }
     else
     {
@@ -126,36 +73,12 @@ int fir_d (double *Y, const double *X, const double *B, const size_t R, const si
 
         if (K==1u && (G==1u || BS==1u))
         {
-            if (L<30000u)
-            {
-                for (size_t v=V; v>0u; --v, B-=Q, X+=Q, ++Y)
-                {
-                    for (size_t q=1u; q<=Q; ++q, ++B)
-                    {
-                        b = *B;
-                        for (size_t l=q; l<L; ++l, ++X, ++Y) { *Y = fma(b,*X,*Y); }
-                        if (q<Q) { X -= L-q; Y -= L-q-1u; }
-                    }
-                }
-            }
-            else
-            {
-                for (size_t v=V; v>0u; --v, B-=Q, X+=L, Y+=L-Q)
-                {
-                    for (size_t q=1u; q<=Q; ++q, ++B, ++Y) { cblas_daxpy((int)(L-q),*B,X,1,Y,1); }
-                }
-            }
+            for (size_t v=V; v>0u; --v, X+=L, Y+=L) { fir_blk_d(Y,X,B,L,Q,1u,1u); }
         }
         else
         {
-            Y += K - 1u;
-            for (size_t g=G; g>0u; --g, X+=BS*(L-1u), Y+=BS*(L-1u))
-            {
-                for (size_t bs=BS; bs>0u; --bs, ++X, B-=Q, Y-=K*Q-1u)
-                {
-                    for (size_t q=1u; q<=Q; ++q, ++B, Y+=K) { cblas_daxpy((int)(L-q),*B,X,(int)K,Y,(int)K); }
-                }
-            }
+            //Interleaved vectors are done together as lanes
+            for (size_t g=G; g>0u; --g, X+=K*L, Y+=K*L) { fir_blk_d(Y,X,B,L,Q,K,K); }
         }
     }
 
@@ -0,0 +1,104 @@
+//Causal FIR filtering of each vector in X along dim.
+//FIR impulse response is given in vector B with length Q+1.
+//This is a front door for fir, fir_fft and fir_ola, which give the same output (see those for more info).
+//The fastest method is chosen from a simple cost model, which uses L, Q, the number of vecs,
+//and the data type (real or complex), with constants from auto_cost.h.
+
+//The direct method costs ~L*(Q+1) multiply-accumulates per vec (complex fir has its own cost per complex MAC).
+//The FFT method costs ~3 FFTs of length nextpow2(L+Q) per vec.
+//The OLS method costs ~2 FFTs of length nfft per block of nfft-Q outputs per vec, with nfft chosen as in fir_ola.
+//Each FFT method also costs 1 FFT of B and ~3 fftw plans.
+//The constants in auto_cost.h can be calibrated for the current machine by "make calib".
+
+#include <stdio.h>
+#include <math.h>
+#include "auto_cost.h"
+#include "fir.c"
+#include "fir_fft.c"
+#include "fir_ola.c"
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static int fir_auto_alg (const size_t N, const size_t L, const size_t Q, const int cplx, const double cdir, const double cfft, const double cplan);
+
+int fir_auto_s (float *Y, const float *X, const float *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t dim);
+int fir_auto_d (double *Y, const double *X, const double *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t dim);
+int fir_auto_c (float *Y, const float *X, const float *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t dim);
+int fir_auto_z (double *Y, const double *X, const double *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t dim);
+
+
+static int fir_auto_alg (const size_t N, const size_t L, const size_t Q, const int cplx, const double cdir, const double cfft, const double cplan)
+{
+    //Returns 0 for direct, 1 for FFT, 2 for OLS (cdir is already per complex MAC if cplx)
+    const double V = (double)(N/L);
+    const double f = (cplx) ? 2.0 : 1.0;
+    const double dir = cdir * V * (double)L * (double)(Q+1u);
+    size_t nfft = 1u;
+    while (nfft<L+Q) { nfft *= 2u; }
+    const double fft = 3.0*cplan + f * cfft * (double)nfft * log2((double)nfft) * (1.0+3.0*V);
+    nfft = fir_ola_get_nfft(L,Q);
+    const double nblk = (double)((L+nfft-Q-1u)/(nfft-Q));
+    const double ola = 3.0*cplan + f * cfft * (double)nfft * log2((double)nfft) * (1.0+2.0*V*nblk);
+    return (dir<=fft && dir<=ola) ? 0 : (fft<ola) ? 1 : 2;
+}
+
+
+int fir_auto_s (float *Y, const float *X, const float *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_auto_s: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    const int alg = (N==0u) ? 0 : fir_auto_alg(N,L,Q,0,AUTO_COST_FIR_S,AUTO_COST_FFT_S,AUTO_COST_PLAN_S);
+    if (alg==2) { return fir_ola_s(Y,X,B,R,C,S,H,iscolmajor,Q,0u,dim); }
+    else if (alg==1) { return fir_fft_s(Y,X,B,R,C,S,H,iscolmajor,Q,dim); }
+    else { return fir_s(Y,X,B,R,C,S,H,iscolmajor,Q,dim); }
+}
+
+
+int fir_auto_d (double *Y, const double *X, const double *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_auto_d: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    const int alg = (N==0u) ? 0 : fir_auto_alg(N,L,Q,0,AUTO_COST_FIR_D,AUTO_COST_FFT_D,AUTO_COST_PLAN_D);
+    if (alg==2) { return fir_ola_d(Y,X,B,R,C,S,H,iscolmajor,Q,0u,dim); }
+    else if (alg==1) { return fir_fft_d(Y,X,B,R,C,S,H,iscolmajor,Q,dim); }
+    else { return fir_d(Y,X,B,R,C,S,H,iscolmajor,Q,dim); }
+}
+
+
+int fir_auto_c (float *Y, const float *X, const float *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_auto_c: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    const int alg = (N==0u) ? 0 : fir_auto_alg(N,L,Q,1,AUTO_COST_FIR_C,AUTO_COST_FFT_S,AUTO_COST_PLAN_S);
+    if (alg==2) { return fir_ola_c(Y,X,B,R,C,S,H,iscolmajor,Q,0u,dim); }
+    else if (alg==1) { return fir_fft_c(Y,X,B,R,C,S,H,iscolmajor,Q,dim); }
+    else { return fir_c(Y,X,B,R,C,S,H,iscolmajor,Q,dim); }
+}
+
+
+int fir_auto_z (double *Y, const double *X, const double *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_auto_z: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    const int alg = (N==0u) ? 0 : fir_auto_alg(N,L,Q,1,AUTO_COST_FIR_Z,AUTO_COST_FFT_D,AUTO_COST_PLAN_D);
+    if (alg==2) { return fir_ola_z(Y,X,B,R,C,S,H,iscolmajor,Q,0u,dim); }
+    else if (alg==1) { return fir_fft_z(Y,X,B,R,C,S,H,iscolmajor,Q,dim); }
+    else { return fir_z(Y,X,B,R,C,S,H,iscolmajor,Q,dim); }
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,429 @@
+//Causal FIR filtering of vector X by each of NB filters in B (a filterbank).
+//Each FIR impulse response has length Q+1, and is given in one row of B.
+//(I use P for IIR filter order, since same as polynomial order.)
+
+//This is the filterbank version of fir_ola (overlap-save),
+//for the common case of many filters (e.g. 64 bandpass filters) applied to one signal.
+//The input block is transformed only once and multiplied by all NB cached filter spectra,
+//and the NB inverse FFTs are done as one batched (plan_many) transform.
+//So the cost per block is 1 forward FFT and NB inverse FFTs, instead of 2*NB FFTs.
+
+//The following convention is forced here (as in frame_univar):
+//Samples from one filter are always contiguous in memory, regardless of row- vs. col-major.
+//So, if B is row-major, then it has size NB x (Q+1), and Y has size NB x N;
+//but if B is col-major, then it has size (Q+1) x NB, and Y has size N x NB.
+
+//If nfft is input as 0, it is chosen from Q and NB (not from N):
+//this is the power-of-2 (>=64) that minimizes nfft*((NB+1)*log2(nfft)+NB)/(nfft-Q),
+//i.e. the approximate cost of the FFTs and the multiplies per output sample.
+//It is capped at nextpow2(N+Q), in which case this is one FFT of X for all filters.
+
+#include <stdio.h>
+#include <math.h>
+#include <fftw3.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static size_t fir_bank_get_nfft (const size_t N, const size_t Q, const size_t NB);
+
+int fir_bank_s (float *Y, const float *X, const float *B, const size_t N, const size_t NB, const size_t Q, const size_t nfft);
+int fir_bank_d (double *Y, const double *X, const double *B, const size_t N, const size_t NB, const size_t Q, const size_t nfft);
+int fir_bank_c (float *Y, const float *X, const float *B, const size_t N, const size_t NB, const size_t Q, const size_t nfft);
+int fir_bank_z (double *Y, const double *X, const double *B, const size_t N, const size_t NB, const size_t Q, const size_t nfft);
+
+
+static size_t fir_bank_get_nfft (const size_t N, const size_t Q, const size_t NB)
+{
+    size_t nmax = 1u, n = 64u, nfft;
+    while (nmax<N+Q) { nmax *= 2u; }
+    while (n<=Q) { n *= 2u; }
+    if (n>=nmax) { return nmax; }
+
+    const double nb = (double)NB;
+    double lg = log2((double)n), cst, cmin = (double)n*((nb+1.0)*lg+nb)/(double)(n-Q);
+    nfft = n;
+    for (n*=2u, lg+=1.0; n<=nmax; n*=2u, lg+=1.0)
+    {
+        cst = (double)n*((nb+1.0)*lg+nb)/(double)(n-Q);
+        if (cst<cmin) { cmin = cst; nfft = n; }
+    }
+
+    return nfft;
+}
+
+
+int fir_bank_s (float *Y, const float *X, const float *B, const size_t N, const size_t NB, const size_t Q, const size_t nfft)
+{
+    if (nfft>0u && nfft<=Q) { fprintf(stderr,"error in fir_bank_s: nfft must be > Q (or 0 to choose from Q)\n"); return 1; }
+
+    if (N==0u || NB==0u) {}
+    else if (Q==0u)
+    {
+        for (size_t b=NB; b>0u; --b, ++B, X-=N)
+        {
+            for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = *B * *X; }
+        }
+    }
+    else
+    {
+        //Set block size and number of freqs
+        const size_t nf = (nfft>0u) ? nfft : fir_bank_get_nfft(N,Q,NB);
+        const size_t M = nf - Q, F = nf/2u + 1u;
+        const float sc = 1.0f / (float)nf;
+        float xr, xi, hr, hi;
+
+        //Initialize fftw
+        float *Xb, *Fx, *Fb, *Yb, *Hf;
+        Xb = (float *)fftwf_malloc(nf*sizeof(float));
+        Fx = (float *)fftwf_malloc(2u*F*sizeof(float));
+        Fb = (float *)fftwf_malloc(2u*F*NB*sizeof(float));
+        Yb = (float *)fftwf_malloc(nf*NB*sizeof(float));
+        Hf = (float *)fftwf_malloc(2u*F*NB*sizeof(float));
+        if (!Xb || !Fx || !Fb || !Yb || !Hf) { fprintf(stderr,"error in fir_bank_s: problem with fftwf_malloc\n"); return 1; }
+        fftwf_plan fplan = fftwf_plan_dft_r2c_1d((int)nf,Xb,(fftwf_complex *)Fx,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in fir_bank_s: problem creating fftw plan\n"); return 1; }
+        const int n1[1] = {(int)nf};
+        fftwf_plan iplan = fftwf_plan_many_dft_c2r(1,n1,(int)NB,(fftwf_complex *)Fb,NULL,1,(int)F,Yb,NULL,1,(int)nf,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in fir_bank_s: problem creating fftw plan\n"); return 1; }
+
+        //Get Hf (FFTs of all filters, scaled), computed once for all blocks
+        for (size_t b=0u; b<NB; ++b)
+        {
+            for (size_t n=0u; n<=Q; ++n, ++B) { Xb[n] = *B; }
+            for (size_t n=Q+1u; n<nf; ++n) { Xb[n] = 0.0f; }
+            fftwf_execute(fplan);
+            for (size_t f=0u; f<2u*F; ++f) { Hf[2u*F*b+f] = sc * Fx[f]; }
+        }
+
+        //The first block sees Q zeros of pre-history
+        for (size_t n=0u; n<Q; ++n) { Xb[n] = 0.0f; }
+
+        for (size_t l=0u; l<N; l+=M)
+        {
+            const size_t Mb = (N-l<M) ? N-l : M;
+
+            //Append the next Mb samples (zero the rest of a final partial block)
+            for (size_t n=Q; n<Q+Mb; ++n, ++X) { Xb[n] = *X; }
+            for (size_t n=Q+Mb; n<nf; ++n) { Xb[n] = 0.0f; }
+
+            //One forward FFT, then multiply by each cached filter spectrum
+            fftwf_execute(fplan);
+            for (size_t b=0u; b<NB; ++b)
+            {
+                const float *hf = &Hf[2u*F*b];
+                float *fb = &Fb[2u*F*b];
+                for (size_t f=0u; f<2u*F; f+=2u)
+                {
+                    xr = Fx[f]; xi = Fx[f+1u];
+                    hr = hf[f]; hi = hf[f+1u];
+                    fb[f] = hr*xr - hi*xi;
+                    fb[f+1u] = hr*xi + hi*xr;
+                }
+            }
+
+            //Batched inverse FFTs (one per filter)
+            fftwf_execute(iplan);
+
+            //Keep the last M outputs of each filter (the first Q are circularly aliased)
+            for (size_t b=0u; b<NB; ++b)
+            {
+                for (size_t n=0u; n<Mb; ++n) { Y[b*N+l+n] = Yb[b*nf+Q+n]; }
+            }
+
+            //Slide the last Q inputs to the front for the next block
+            for (size_t n=0u; n<Q; ++n) { Xb[n] = Xb[n+M]; }
+        }
+
+        fftwf_free(Xb); fftwf_free(Fx); fftwf_free(Fb); fftwf_free(Yb); fftwf_free(Hf);
+        fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int fir_bank_d (double *Y, const double *X, const double *B, const size_t N, const size_t NB, const size_t Q, const size_t nfft)
+{
+    if (nfft>0u && nfft<=Q) { fprintf(stderr,"error in fir_bank_d: nfft must be > Q (or 0 to choose from Q)\n"); return 1; }
+
+    if (N==0u || NB==0u) {}
+    else if (Q==0u)
+    {
+        for (size_t b=NB; b>0u; --b, ++B, X-=N)
+        {
+            for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = *B * *X; }
+        }
+    }
+    else
+    {
+        //Set block size and number of freqs
+        const size_t nf = (nfft>0u) ? nfft : fir_bank_get_nfft(N,Q,NB);
+        const size_t M = nf - Q, F = nf/2u + 1u;
+        const double sc = 1.0 / (double)nf;
+        double xr, xi, hr, hi;
+
+        //Initialize fftw
+        double *Xb, *Fx, *Fb, *Yb, *Hf;
+        Xb = (double *)fftw_malloc(nf*sizeof(double));
+        Fx = (double *)fftw_malloc(2u*F*sizeof(double));
+        Fb = (double *)fftw_malloc(2u*F*NB*sizeof(double));
+        Yb = (double *)fftw_malloc(nf*NB*sizeof(double));
+        Hf = (double *)fftw_malloc(2u*F*NB*sizeof(double));
+        if (!Xb || !Fx || !Fb || !Yb || !Hf) { fprintf(stderr,"error in fir_bank_d: problem with fftw_malloc\n"); return 1; }
+        fftw_plan fplan = fftw_plan_dft_r2c_1d((int)nf,Xb,(fftw_complex *)Fx,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in fir_bank_d: problem creating fftw plan\n"); return 1; }
+        const int n1[1] = {(int)nf};
+        fftw_plan iplan = fftw_plan_many_dft_c2r(1,n1,(int)NB,(fftw_complex *)Fb,NULL,1,(int)F,Yb,NULL,1,(int)nf,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in fir_bank_d: problem creating fftw plan\n"); return 1; }
+
+        //Get Hf (FFTs of all filters, scaled), computed once for all blocks
+        for (size_t b=0u; b<NB; ++b)
+        {
+            for (size_t n=0u; n<=Q; ++n, ++B) { Xb[n] = *B; }
+            for (size_t n=Q+1u; n<nf; ++n) { Xb[n] = 0.0; }
+            fftw_execute(fplan);
+            for (size_t f=0u; f<2u*F; ++f) { Hf[2u*F*b+f] = sc * Fx[f]; }
+        }
+
+        //The first block sees Q zeros of pre-history
+        for (size_t n=0u; n<Q; ++n) { Xb[n] = 0.0; }
+
+        for (size_t l=0u; l<N; l+=M)
+        {
+            const size_t Mb = (N-l<M) ? N-l : M;
+
+            //Append the next Mb samples (zero the rest of a final partial block)
+            for (size_t n=Q; n<Q+Mb; ++n, ++X) { Xb[n] = *X; }
+            for (size_t n=Q+Mb; n<nf; ++n) { Xb[n] = 0.0; }
+
+            //One forward FFT, then multiply by each cached filter spectrum
+            fftw_execute(fplan);
+            for (size_t b=0u; b<NB; ++b)
+            {
+                const double *hf = &Hf[2u*F*b];
+                double *fb = &Fb[2u*F*b];
+                for (size_t f=0u; f<2u*F; f+=2u)
+                {
+                    xr = Fx[f]; xi = Fx[f+1u];
+                    hr = hf[f]; hi = hf[f+1u];
+                    fb[f] = hr*xr - hi*xi;
+                    fb[f+1u] = hr*xi + hi*xr;
+                }
+            }
+
+            //Batched inverse FFTs (one per filter)
+            fftw_execute(iplan);
+
+            //Keep the last M outputs of each filter (the first Q are circularly aliased)
+            for (size_t b=0u; b<NB; ++b)
+            {
+                for (size_t n=0u; n<Mb; ++n) { Y[b*N+l+n] = Yb[b*nf+Q+n]; }
+            }
+
+            //Slide the last Q inputs to the front for the next block
+            for (size_t n=0u; n<Q; ++n) { Xb[n] = Xb[n+M]; }
+        }
+
+        fftw_free(Xb); fftw_free(Fx); fftw_free(Fb); fftw_free(Yb); fftw_free(Hf);
+        fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int fir_bank_c (float *Y, const float *X, const float *B, const size_t N, const size_t NB, const size_t Q, const size_t nfft)
+{
+    if (nfft>0u && nfft<=Q) { fprintf(stderr,"error in fir_bank_c: nfft must be > Q (or 0 to choose from Q)\n"); return 1; }
+
+    if (N==0u || NB==0u) {}
+    else if (Q==0u)
+    {
+        for (size_t b=NB; b>0u; --b, B+=2, X-=2u*N)
+        {
+            for (size_t n=N; n>0u; --n, X+=2, Y+=2)
+            {
+                *Y = *B**X - *(B+1)**(X+1);
+                *(Y+1) = *B**(X+1) + *(B+1)**X;
+            }
+        }
+    }
+    else
+    {
+        //Set block size
+        const size_t nf = (nfft>0u) ? nfft : fir_bank_get_nfft(N,Q,NB);
+        const size_t M = nf - Q;
+        const float sc = 1.0f / (float)nf;
+        float xr, xi, hr, hi;
+
+        //Initialize fftw
+        float *Xb, *Fx, *Fb, *Yb, *Hf;
+        Xb = (float *)fftwf_malloc(2u*nf*sizeof(float));
+        Fx = (float *)fftwf_malloc(2u*nf*sizeof(float));
+        Fb = (float *)fftwf_malloc(2u*nf*NB*sizeof(float));
+        Yb = (float *)fftwf_malloc(2u*nf*NB*sizeof(float));
+        Hf = (float *)fftwf_malloc(2u*nf*NB*sizeof(float));
+        if (!Xb || !Fx || !Fb || !Yb || !Hf) { fprintf(stderr,"error in fir_bank_c: problem with fftwf_malloc\n"); return 1; }
+        fftwf_plan fplan = fftwf_plan_dft_1d((int)nf,(fftwf_complex *)Xb,(fftwf_complex *)Fx,FFTW_FORWARD,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in fir_bank_c: problem creating fftw plan\n"); return 1; }
+        const int n1[1] = {(int)nf};
+        fftwf_plan iplan = fftwf_plan_many_dft(1,n1,(int)NB,(fftwf_complex *)Fb,NULL,1,(int)nf,(fftwf_complex *)Yb,NULL,1,(int)nf,FFTW_BACKWARD,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in fir_bank_c: problem creating fftw plan\n"); return 1; }
+
+        //Get Hf (FFTs of all filters, scaled), computed once for all blocks
+        for (size_t b=0u; b<NB; ++b)
+        {
+            for (size_t n=0u; n<2u*(Q+1u); ++n, ++B) { Xb[n] = *B; }
+            for (size_t n=2u*Q+2u; n<2u*nf; ++n) { Xb[n] = 0.0f; }
+            fftwf_execute(fplan);
+            for (size_t f=0u; f<2u*nf; ++f) { Hf[2u*nf*b+f] = sc * Fx[f]; }
+        }
+
+        //The first block sees Q zeros of pre-history
+        for (size_t n=0u; n<2u*Q; ++n) { Xb[n] = 0.0f; }
+
+        for (size_t l=0u; l<N; l+=M)
+        {
+            const size_t Mb = (N-l<M) ? N-l : M;
+
+            //Append the next Mb samples (zero the rest of a final partial block)
+            for (size_t n=2u*Q; n<2u*(Q+Mb); n+=2u, X+=2) { Xb[n] = *X; Xb[n+1u] = *(X+1); }
+            for (size_t n=2u*(Q+Mb); n<2u*nf; ++n) { Xb[n] = 0.0f; }
+
+            //One forward FFT, then multiply by each cached filter spectrum
+            fftwf_execute(fplan);
+            for (size_t b=0u; b<NB; ++b)
+            {
+                const float *hf = &Hf[2u*nf*b];
+                float *fb = &Fb[2u*nf*b];
+                for (size_t f=0u; f<2u*nf; f+=2u)
+                {
+                    xr = Fx[f]; xi = Fx[f+1u];
+                    hr = hf[f]; hi = hf[f+1u];
+                    fb[f] = hr*xr - hi*xi;
+                    fb[f+1u] = hr*xi + hi*xr;
+                }
+            }
+
+            //Batched inverse FFTs (one per filter)
+            fftwf_execute(iplan);
+
+            //Keep the last M outputs of each filter (the first Q are circularly aliased)
+            for (size_t b=0u; b<NB; ++b)
+            {
+                for (size_t n=0u; n<2u*Mb; ++n) { Y[2u*(b*N+l)+n] = Yb[2u*(b*nf+Q)+n]; }
+            }
+
+            //Slide the last Q inputs to the front for the next block
+            for (size_t n=0u; n<2u*Q; ++n) { Xb[n] = Xb[n+2u*M]; }
+        }
+
+        fftwf_free(Xb); fftwf_free(Fx); fftwf_free(Fb); fftwf_free(Yb); fftwf_free(Hf);
+        fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int fir_bank_z (double *Y, const double *X, const double *B, const size_t N, const size_t NB, const size_t Q, const size_t nfft)
+{
+    if (nfft>0u && nfft<=Q) { fprintf(stderr,"error in fir_bank_z: nfft must be > Q (or 0 to choose from Q)\n"); return 1; }
+
+    if (N==0u || NB==0u) {}
+    else if (Q==0u)
+    {
+        for (size_t b=NB; b>0u; --b, B+=2, X-=2u*N)
+        {
+            for (size_t n=N; n>0u; --n, X+=2, Y+=2)
+            {
+                *Y = *B**X - *(B+1)**(X+1);
+                *(Y+1) = *B**(X+1) + *(B+1)**X;
+            }
+        }
+    }
+    else
+    {
+        //Set block size
+        const size_t nf = (nfft>0u) ? nfft : fir_bank_get_nfft(N,Q,NB);
+        const size_t M = nf - Q;
+        const double sc = 1.0 / (double)nf;
+        double xr, xi, hr, hi;
+
+        //Initialize fftw
+        double *Xb, *Fx, *Fb, *Yb, *Hf;
+        Xb = (double *)fftw_malloc(2u*nf*sizeof(double));
+        Fx = (double *)fftw_malloc(2u*nf*sizeof(double));
+        Fb = (double *)fftw_malloc(2u*nf*NB*sizeof(double));
+        Yb = (double *)fftw_malloc(2u*nf*NB*sizeof(double));
+        Hf = (double *)fftw_malloc(2u*nf*NB*sizeof(double));
+        if (!Xb || !Fx || !Fb || !Yb || !Hf) { fprintf(stderr,"error in fir_bank_z: problem with fftw_malloc\n"); return 1; }
+        fftw_plan fplan = fftw_plan_dft_1d((int)nf,(fftw_complex *)Xb,(fftw_complex *)Fx,FFTW_FORWARD,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in fir_bank_z: problem creating fftw plan\n"); return 1; }
+        const int n1[1] = {(int)nf};
+        fftw_plan iplan = fftw_plan_many_dft(1,n1,(int)NB,(fftw_complex *)Fb,NULL,1,(int)nf,(fftw_complex *)Yb,NULL,1,(int)nf,FFTW_BACKWARD,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in fir_bank_z: problem creating fftw plan\n"); return 1; }
+
+        //Get Hf (FFTs of all filters, scaled), computed once for all blocks
+        for (size_t b=0u; b<NB; ++b)
+        {
+            for (size_t n=0u; n<2u*(Q+1u); ++n, ++B) { Xb[n] = *B; }
+            for (size_t n=2u*Q+2u; n<2u*nf; ++n) { Xb[n] = 0.0; }
+            fftw_execute(fplan);
+            for (size_t f=0u; f<2u*nf; ++f) { Hf[2u*nf*b+f] = sc * Fx[f]; }
+        }
+
+        //The first block sees Q zeros of pre-history
+        for (size_t n=0u; n<2u*Q; ++n) { Xb[n] = 0.0; }
+
+        for (size_t l=0u; l<N; l+=M)
+        {
+            const size_t Mb = (N-l<M) ? N-l : M;
+
+            //Append the next Mb samples (zero the rest of a final partial block)
+            for (size_t n=2u*Q; n<2u*(Q+Mb); n+=2u, X+=2) { Xb[n] = *X; Xb[n+1u] = *(X+1); }
+            for (size_t n=2u*(Q+Mb); n<2u*nf; ++n) { Xb[n] = 0.0; }
+
+            //One forward FFT, then multiply by each cached filter spectrum
+            fftw_execute(fplan);
+            for (size_t b=0u; b<NB; ++b)
+            {
+                const double *hf = &Hf[2u*nf*b];
+                double *fb = &Fb[2u*nf*b];
+                for (size_t f=0u; f<2u*nf; f+=2u)
+                {
+                    xr = Fx[f]; xi = Fx[f+1u];
+                    hr = hf[f]; hi = hf[f+1u];
+                    fb[f] = hr*xr - hi*xi;
+                    fb[f+1u] = hr*xi + hi*xr;
+                }
+            }
+
+            //Batched inverse FFTs (one per filter)
+            fftw_execute(iplan);
+
+            //Keep the last M outputs of each filter (the first Q are circularly aliased)
+            for (size_t b=0u; b<NB; ++b)
+            {
+                for (size_t n=0u; n<2u*Mb; ++n) { Y[2u*(b*N+l)+n] = Yb[2u*(b*nf+Q)+n]; }
+            }
+
+            //Slide the last Q inputs to the front for the next block
+            for (size_t n=0u; n<2u*Q; ++n) { Xb[n] = Xb[n+2u*M]; }
+        }
+
+        fftw_free(Xb); fftw_free(Fx); fftw_free(Fb); fftw_free(Yb); fftw_free(Hf);
+        fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
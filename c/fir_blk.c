@@ -0,0 +1,209 @@
+//Register-blocked direct-form FIR, used by fir, and by filter for the FIR part, for real X.
+//Each tile of outputs is computed against all taps while the inputs are still in registers/L1
+//(rather than one pass over Y per tap). NV vectors that are interleaved in memory
+//(with stride K, e.g. along rows of a col-major matrix) are processed together as lanes.
+
+#include <stdio.h>
+#include <math.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void fir_blk_s (float *Y, const float *X, const float *B, const size_t L, const size_t Q, const size_t K, const size_t NV);
+static void fir_blk_d (double *Y, const double *X, const double *B, const size_t L, const size_t Q, const size_t K, const size_t NV);
+
+
+static void fir_blk_s (float *Y, const float *X, const float *B, const size_t L, const size_t Q, const size_t K, const size_t NV)
+{
+    const size_t L0 = (Q<L) ? Q : L;
+    float sm;
+
+    //Outputs with partial taps (l<Q)
+    for (size_t l=0u; l<L0; ++l)
+    {
+        for (size_t v=0u; v<NV; ++v)
+        {
+            sm = 0.0f;
+            for (size_t q=0u; q<=l; ++q) { sm = fmaf(B[q],X[(l-q)*K+v],sm); }
+            Y[l*K+v] = sm;
+        }
+    }
+
+    if (NV==1u)
+    {
+        //Tiles of 32 outputs against all taps
+        float acc[32];
+        size_t l = L0;
+        for (; l+32u<=L; l+=32u)
+        {
+            for (size_t t=0u; t<32u; ++t) { acc[t] = 0.0f; }
+            for (size_t q=0u; q<=Q; ++q)
+            {
+                const float b = B[q], *x = X + l - q;
+                for (size_t t=0u; t<32u; ++t) { acc[t] = fmaf(b,x[t],acc[t]); }
+            }
+            for (size_t t=0u; t<32u; ++t) { Y[l+t] = acc[t]; }
+        }
+        for (; l<L; ++l)
+        {
+            sm = 0.0f;
+            for (size_t q=0u; q<=Q; ++q) { sm = fmaf(B[q],X[l-q],sm); }
+            Y[l] = sm;
+        }
+    }
+    else
+    {
+        //Tiles of 4 outputs x 16 lanes against all taps
+        float acc[4][16];
+        for (size_t l=L0; l<L; l+=4u)
+        {
+            const size_t nt = (L-l<4u) ? L-l : 4u;
+            for (size_t v0=0u; v0<NV; v0+=16u)
+            {
+                const size_t nv = (NV-v0<16u) ? NV-v0 : 16u;
+                if (nt==4u && nv==16u)
+                {
+                    for (size_t t=0u; t<4u; ++t) { for (size_t v=0u; v<16u; ++v) { acc[t][v] = 0.0f; } }
+                    for (size_t q=0u; q<=Q; ++q)
+                    {
+                        const float b = B[q];
+                        for (size_t t=0u; t<4u; ++t)
+                        {
+                            const float *x = X + (l+t-q)*K + v0;
+                            for (size_t v=0u; v<16u; ++v) { acc[t][v] = fmaf(b,x[v],acc[t][v]); }
+                        }
+                    }
+                    for (size_t t=0u; t<4u; ++t) { for (size_t v=0u; v<16u; ++v) { Y[(l+t)*K+v0+v] = acc[t][v]; } }
+                }
+                else if (nt==4u)
+                {
+                    for (size_t t=0u; t<4u; ++t) { for (size_t v=0u; v<nv; ++v) { acc[t][v] = 0.0f; } }
+                    for (size_t q=0u; q<=Q; ++q)
+                    {
+                        const float b = B[q];
+                        for (size_t t=0u; t<4u; ++t)
+                        {
+                            const float *x = X + (l+t-q)*K + v0;
+                            for (size_t v=0u; v<nv; ++v) { acc[t][v] = fmaf(b,x[v],acc[t][v]); }
+                        }
+                    }
+                    for (size_t t=0u; t<4u; ++t) { for (size_t v=0u; v<nv; ++v) { Y[(l+t)*K+v0+v] = acc[t][v]; } }
+                }
+                else
+                {
+                    for (size_t t=0u; t<nt; ++t)
+                    {
+                        for (size_t v=0u; v<nv; ++v)
+                        {
+                            sm = 0.0f;
+                            for (size_t q=0u; q<=Q; ++q) { sm = fmaf(B[q],X[(l+t-q)*K+v0+v],sm); }
+                            Y[(l+t)*K+v0+v] = sm;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+static void fir_blk_d (double *Y, const double *X, const double *B, const size_t L, const size_t Q, const size_t K, const size_t NV)
+{
+    const size_t L0 = (Q<L) ? Q : L;
+    double sm;
+
+    //Outputs with partial taps (l<Q)
+    for (size_t l=0u; l<L0; ++l)
+    {
+        for (size_t v=0u; v<NV; ++v)
+        {
+            sm = 0.0;
+            for (size_t q=0u; q<=l; ++q) { sm = fma(B[q],X[(l-q)*K+v],sm); }
+            Y[l*K+v] = sm;
+        }
+    }
+
+    if (NV==1u)
+    {
+        //Tiles of 32 outputs against all taps
+        double acc[32];
+        size_t l = L0;
+        for (; l+32u<=L; l+=32u)
+        {
+            for (size_t t=0u; t<32u; ++t) { acc[t] = 0.0; }
+            for (size_t q=0u; q<=Q; ++q)
+            {
+                const double b = B[q], *x = X + l - q;
+                for (size_t t=0u; t<32u; ++t) { acc[t] = fma(b,x[t],acc[t]); }
+            }
+            for (size_t t=0u; t<32u; ++t) { Y[l+t] = acc[t]; }
+        }
+        for (; l<L; ++l)
+        {
+            sm = 0.0;
+            for (size_t q=0u; q<=Q; ++q) { sm = fma(B[q],X[l-q],sm); }
+            Y[l] = sm;
+        }
+    }
+    else
+    {
+        //Tiles of 4 outputs x 16 lanes against all taps
+        double acc[4][16];
+        for (size_t l=L0; l<L; l+=4u)
+        {
+            const size_t nt = (L-l<4u) ? L-l : 4u;
+            for (size_t v0=0u; v0<NV; v0+=16u)
+            {
+                const size_t nv = (NV-v0<16u) ? NV-v0 : 16u;
+                if (nt==4u && nv==16u)
+                {
+                    for (size_t t=0u; t<4u; ++t) { for (size_t v=0u; v<16u; ++v) { acc[t][v] = 0.0; } }
+                    for (size_t q=0u; q<=Q; ++q)
+                    {
+                        const double b = B[q];
+                        for (size_t t=0u; t<4u; ++t)
+                        {
+                            const double *x = X + (l+t-q)*K + v0;
+                            for (size_t v=0u; v<16u; ++v) { acc[t][v] = fma(b,x[v],acc[t][v]); }
+                        }
+                    }
+                    for (size_t t=0u; t<4u; ++t) { for (size_t v=0u; v<16u; ++v) { Y[(l+t)*K+v0+v] = acc[t][v]; } }
+                }
+                else if (nt==4u)
+                {
+                    for (size_t t=0u; t<4u; ++t) { for (size_t v=0u; v<nv; ++v) { acc[t][v] = 0.0; } }
+                    for (size_t q=0u; q<=Q; ++q)
+                    {
+                        const double b = B[q];
+                        for (size_t t=0u; t<4u; ++t)
+                        {
+                            const double *x = X + (l+t-q)*K + v0;
+                            for (size_t v=0u; v<nv; ++v) { acc[t][v] = fma(b,x[v],acc[t][v]); }
+                        }
+                    }
+                    for (size_t t=0u; t<4u; ++t) { for (size_t v=0u; v<nv; ++v) { Y[(l+t)*K+v0+v] = acc[t][v]; } }
+                }
+                else
+                {
+                    for (size_t t=0u; t<nt; ++t)
+                    {
+                        for (size_t v=0u; v<nv; ++v)
+                        {
+                            sm = 0.0;
+                            for (size_t q=0u; q<=Q; ++q) { sm = fma(B[q],X[(l+t-q)*K+v0+v],sm); }
+                            Y[(l+t)*K+v0+v] = sm;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
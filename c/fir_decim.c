@@ -0,0 +1,419 @@
+//Causal FIR filtering of each vector in X along dim, followed by decimation by M.
+//FIR impulse response is given in vector B with length Q+1 (same as fir).
+
+//For each vector: Y[n] = B[0]*X[nM] + B[1]*X[nM-1] + ... + B[Q]*X[nM-Q],
+//so Y is the same as fir followed by taking every M-th sample (starting at 0).
+//But only the retained outputs are computed (polyphase decimator),
+//so the cost is 1/M of a full-rate FIR, and no full-rate intermediate is made.
+//Each vector in Y has length Ly = ceil(L/M).
+
+//Z is the state carried between calls (for streaming), or NULL.
+//If not NULL, Z has length V*Q, where V is the number of vectors,
+//and must be zeros before the first call. Z holds the last Q inputs of each vector.
+//For streaming, each call must give a multiple of M samples per vector,
+//except for the last call.
+
+//decimate does decimation by M with a designed lowpass filter (as in decimate of Octave).
+//For large M, this is done in multiple stages (see decimate_plan),
+//each with a Hamming-windowed sinc lowpass of order 20*Ms (Ms is the stage factor).
+//The delay of each stage is compensated, so Y is aligned with X.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#ifndef M_PI
+   #define M_PI 3.141592653589793238462643383279502884
+#endif
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void fir_decim_lanes_s (float *Y, const float *X, const float *B, float *Z, const size_t L, const size_t Ly, const size_t Q, const size_t M, const size_t D, const size_t K, const size_t NV);
+static void fir_decim_lanes_d (double *Y, const double *X, const double *B, double *Z, const size_t L, const size_t Ly, const size_t Q, const size_t M, const size_t D, const size_t K, const size_t NV);
+static void fir_decim_design_s (float *B, const size_t Ms);
+static void fir_decim_design_d (double *B, const size_t Ms);
+
+size_t decimate_plan (size_t *Ms, const size_t M);
+int fir_decim_s (float *Y, const float *X, const float *B, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t M, const size_t dim);
+int fir_decim_d (double *Y, const double *X, const double *B, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t M, const size_t dim);
+int decimate_s (float *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t M, const size_t dim);
+int decimate_d (double *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t M, const size_t dim);
+
+
+static void fir_decim_lanes_s (float *Y, const float *X, const float *B, float *Z, const size_t L, const size_t Ly, const size_t Q, const size_t M, const size_t D, const size_t K, const size_t NV)
+{
+    size_t n0, qlo, qhi;
+    float b;
+
+    for (size_t m=0u; m<Ly; ++m, Y+=K)
+    {
+        n0 = m*M + D;
+        for (size_t v=0u; v<NV; ++v) { Y[v] = 0.0f; }
+
+        //Taps within X
+        qlo = (n0<L) ? 0u : n0-L+1u;
+        qhi = (n0<Q) ? n0 : Q;
+        for (size_t q=qlo; q<qhi+1u; ++q)
+        {
+            const float *x = X + (n0-q)*K;
+            b = B[q];
+            for (size_t v=0u; v<NV; ++v) { Y[v] += b * x[v]; }
+        }
+
+        //Taps before X (from the carried state)
+        if (Z)
+        {
+            for (size_t q=n0+1u; q<=Q; ++q)
+            {
+                const float *z = Z + Q + n0 - q;
+                b = B[q];
+                for (size_t v=0u; v<NV; ++v) { Y[v] += b * z[v*Q]; }
+            }
+        }
+    }
+
+    //Update state to the last Q inputs
+    if (Z && Q>0u)
+    {
+        if (L>=Q)
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Q; ++i) { Z[v*Q+i] = X[(L-Q+i)*K+v]; }
+            }
+        }
+        else
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Q-L; ++i) { Z[v*Q+i] = Z[v*Q+i+L]; }
+                for (size_t i=0u; i<L; ++i) { Z[v*Q+Q-L+i] = X[i*K+v]; }
+            }
+        }
+    }
+}
+
+
+static void fir_decim_lanes_d (double *Y, const double *X, const double *B, double *Z, const size_t L, const size_t Ly, const size_t Q, const size_t M, const size_t D, const size_t K, const size_t NV)
+{
+    size_t n0, qlo, qhi;
+    double b;
+
+    for (size_t m=0u; m<Ly; ++m, Y+=K)
+    {
+        n0 = m*M + D;
+        for (size_t v=0u; v<NV; ++v) { Y[v] = 0.0; }
+
+        //Taps within X
+        qlo = (n0<L) ? 0u : n0-L+1u;
+        qhi = (n0<Q) ? n0 : Q;
+        for (size_t q=qlo; q<qhi+1u; ++q)
+        {
+            const double *x = X + (n0-q)*K;
+            b = B[q];
+            for (size_t v=0u; v<NV; ++v) { Y[v] += b * x[v]; }
+        }
+
+        //Taps before X (from the carried state)
+        if (Z)
+        {
+            for (size_t q=n0+1u; q<=Q; ++q)
+            {
+                const double *z = Z + Q + n0 - q;
+                b = B[q];
+                for (size_t v=0u; v<NV; ++v) { Y[v] += b * z[v*Q]; }
+            }
+        }
+    }
+
+    //Update state to the last Q inputs
+    if (Z && Q>0u)
+    {
+        if (L>=Q)
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Q; ++i) { Z[v*Q+i] = X[(L-Q+i)*K+v]; }
+            }
+        }
+        else
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Q-L; ++i) { Z[v*Q+i] = Z[v*Q+i+L]; }
+                for (size_t i=0u; i<L; ++i) { Z[v*Q+Q-L+i] = X[i*K+v]; }
+            }
+        }
+    }
+}
+
+
+static void fir_decim_design_s (float *B, const size_t Ms)
+{
+    const size_t Q = 20u*Ms, c = Q/2u;
+    double x, sm = 0.0;
+
+    for (size_t q=0u; q<=Q; ++q)
+    {
+        x = ((double)q-(double)c) / (double)Ms;
+        B[q] = (float)(((q==c) ? 1.0 : sin(M_PI*x)/(M_PI*x)) * (0.54-0.46*cos(2.0*M_PI*(double)q/(double)Q)));
+        sm += (double)B[q];
+    }
+    for (size_t q=0u; q<=Q; ++q) { B[q] = (float)((double)B[q]/sm); }
+}
+
+
+static void fir_decim_design_d (double *B, const size_t Ms)
+{
+    const size_t Q = 20u*Ms, c = Q/2u;
+    double x, sm = 0.0;
+
+    for (size_t q=0u; q<=Q; ++q)
+    {
+        x = ((double)q-(double)c) / (double)Ms;
+        B[q] = (double)(((q==c) ? 1.0 : sin(M_PI*x)/(M_PI*x)) * (0.54-0.46*cos(2.0*M_PI*(double)q/(double)Q)));
+        sm += (double)B[q];
+    }
+    for (size_t q=0u; q<=Q; ++q) { B[q] = (double)((double)B[q]/sm); }
+}
+
+
+size_t decimate_plan (size_t *Ms, const size_t M)
+{
+    size_t f[64], nf = 0u, ns = 0u, m = M, t;
+
+    //Prime factors (descending)
+    for (size_t p=2u; p*p<=m; ++p) { while (m%p==0u) { f[nf++] = p; m /= p; } }
+    if (m>1u) { f[nf++] = m; }
+    for (size_t i=0u; i<nf/2u; ++i) { t = f[i]; f[i] = f[nf-1u-i]; f[nf-1u-i] = t; }
+
+    //Pack into stages with factors up to 8 (or a single prime > 8)
+    for (size_t i=0u; i<nf; ++i)
+    {
+        if (ns>0u && Ms[ns-1u]*f[i]<=8u) { Ms[ns-1u] *= f[i]; }
+        else { Ms[ns++] = f[i]; }
+    }
+
+    //Largest factor first
+    for (size_t i=1u; i<ns; ++i)
+    {
+        for (size_t j=i; j>0u && Ms[j-1u]<Ms[j]; --j) { t = Ms[j]; Ms[j] = Ms[j-1u]; Ms[j-1u] = t; }
+    }
+
+    return ns;
+}
+
+
+int fir_decim_s (float *Y, const float *X, const float *B, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t M, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_decim_s: dim must be in [0 3]\n"); return 1; }
+    if (M<1u) { fprintf(stderr,"error in fir_decim_s: M (decimation factor) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t Ly = (L+M-1u) / M;
+
+        if (L==N)
+        {
+            fir_decim_lanes_s(Y,X,B,Z,L,Ly,Q,M,0u,1u,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=Ly)
+                {
+                    fir_decim_lanes_s(Y,X,B,Z,L,Ly,Q,M,0u,1u,1u);
+                    if (Z) { Z += Q; }
+                }
+            }
+            else
+            {
+                //Interleaved vectors are done together as lanes
+                for (size_t g=G; g>0u; --g, X+=K*L, Y+=K*Ly)
+                {
+                    fir_decim_lanes_s(Y,X,B,Z,L,Ly,Q,M,0u,K,K);
+                    if (Z) { Z += K*Q; }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+int fir_decim_d (double *Y, const double *X, const double *B, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t M, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_decim_d: dim must be in [0 3]\n"); return 1; }
+    if (M<1u) { fprintf(stderr,"error in fir_decim_d: M (decimation factor) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t Ly = (L+M-1u) / M;
+
+        if (L==N)
+        {
+            fir_decim_lanes_d(Y,X,B,Z,L,Ly,Q,M,0u,1u,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=Ly)
+                {
+                    fir_decim_lanes_d(Y,X,B,Z,L,Ly,Q,M,0u,1u,1u);
+                    if (Z) { Z += Q; }
+                }
+            }
+            else
+            {
+                //Interleaved vectors are done together as lanes
+                for (size_t g=G; g>0u; --g, X+=K*L, Y+=K*Ly)
+                {
+                    fir_decim_lanes_d(Y,X,B,Z,L,Ly,Q,M,0u,K,K);
+                    if (Z) { Z += K*Q; }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+int decimate_s (float *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t M, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in decimate_s: dim must be in [0 3]\n"); return 1; }
+    if (M<1u) { fprintf(stderr,"error in decimate_s: M (decimation factor) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (M==1u)
+    {
+        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = *X; }
+    }
+    else
+    {
+        const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+        const size_t V = N/L, G = V/BS;
+        const int lanes = (L<N && !(K==1u && (G==1u || BS==1u)));
+        const size_t NV = (lanes) ? K : 1u, NG = (lanes) ? G : V;
+        const size_t Ly = (L+M-1u) / M;
+
+        //Plan stages and design filters
+        size_t Ms[64], os[65], ns;
+        ns = decimate_plan(Ms,M);
+        os[0] = 0u;
+        for (size_t s=0u; s<ns; ++s) { os[s+1u] = os[s] + 20u*Ms[s] + 1u; }
+        float *Bs, *T1, *T2;
+        if (!(Bs=(float *)malloc(os[ns]*sizeof(float)))) { fprintf(stderr,"error in decimate_s: problem with malloc\n"); return 1; }
+        for (size_t s=0u; s<ns; ++s) { fir_decim_design_s(Bs+os[s],Ms[s]); }
+
+        //Intermediate buffers (ping-pong)
+        const size_t L1 = (L+Ms[0]-1u) / Ms[0];
+        if (!(T1=(float *)malloc(NV*L1*sizeof(float)))) { fprintf(stderr,"error in decimate_s: problem with malloc\n"); return 1; }
+        if (!(T2=(float *)malloc(NV*L1*sizeof(float)))) { fprintf(stderr,"error in decimate_s: problem with malloc\n"); return 1; }
+
+        for (size_t g=NG; g>0u; --g, X+=NV*L, Y+=NV*Ly)
+        {
+            const float *src = X;
+            float *dst;
+            size_t Ls = L, Ld;
+            for (size_t s=0u; s<ns; ++s)
+            {
+                Ld = (Ls+Ms[s]-1u) / Ms[s];
+                dst = (s+1u==ns) ? Y : (s%2u) ? T2 : T1;
+                fir_decim_lanes_s(dst,src,Bs+os[s],NULL,Ls,Ld,20u*Ms[s],Ms[s],10u*Ms[s],NV,NV);
+                src = dst; Ls = Ld;
+            }
+        }
+        free(Bs); free(T1); free(T2);
+    }
+
+    return 0;
+}
+
+
+int decimate_d (double *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t M, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in decimate_d: dim must be in [0 3]\n"); return 1; }
+    if (M<1u) { fprintf(stderr,"error in decimate_d: M (decimation factor) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (M==1u)
+    {
+        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = *X; }
+    }
+    else
+    {
+        const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+        const size_t V = N/L, G = V/BS;
+        const int lanes = (L<N && !(K==1u && (G==1u || BS==1u)));
+        const size_t NV = (lanes) ? K : 1u, NG = (lanes) ? G : V;
+        const size_t Ly = (L+M-1u) / M;
+
+        //Plan stages and design filters
+        size_t Ms[64], os[65], ns;
+        ns = decimate_plan(Ms,M);
+        os[0] = 0u;
+        for (size_t s=0u; s<ns; ++s) { os[s+1u] = os[s] + 20u*Ms[s] + 1u; }
+        double *Bs, *T1, *T2;
+        if (!(Bs=(double *)malloc(os[ns]*sizeof(double)))) { fprintf(stderr,"error in decimate_d: problem with malloc\n"); return 1; }
+        for (size_t s=0u; s<ns; ++s) { fir_decim_design_d(Bs+os[s],Ms[s]); }
+
+        //Intermediate buffers (ping-pong)
+        const size_t L1 = (L+Ms[0]-1u) / Ms[0];
+        if (!(T1=(double *)malloc(NV*L1*sizeof(double)))) { fprintf(stderr,"error in decimate_d: problem with malloc\n"); return 1; }
+        if (!(T2=(double *)malloc(NV*L1*sizeof(double)))) { fprintf(stderr,"error in decimate_d: problem with malloc\n"); return 1; }
+
+        for (size_t g=NG; g>0u; --g, X+=NV*L, Y+=NV*Ly)
+        {
+            const double *src = X;
+            double *dst;
+            size_t Ls = L, Ld;
+            for (size_t s=0u; s<ns; ++s)
+            {
+                Ld = (Ls+Ms[s]-1u) / Ms[s];
+                dst = (s+1u==ns) ? Y : (s%2u) ? T2 : T1;
+                fir_decim_lanes_d(dst,src,Bs+os[s],NULL,Ls,Ld,20u*Ms[s],Ms[s],10u*Ms[s],NV,NV);
+                src = dst; Ls = Ld;
+            }
+        }
+        free(Bs); free(T1); free(T2);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,234 @@
+//Interpolation of each vector in X along dim by the integer factor M,
+//i.e. upsampling by M (inserting M-1 zeros after each sample), followed by
+//causal FIR filtering with impulse response B of length Q+1 (same as fir).
+
+//For each vector: Y[kM+p] = B[p]*X[k] + B[p+M]*X[k-1] + B[p+2M]*X[k-2] + ...
+//So the zeros are never multiplied (polyphase interpolator),
+//and the cost is about (Q+1)/M multiply-adds per output sample.
+//Each vector in Y has length Ly = L*M.
+//B is usually a lowpass filter with cutoff 1/M (of Nyquist) and a gain of M.
+
+//Z is the state carried between calls (for streaming), or NULL.
+//If not NULL, Z has length V*(ceil((Q+1)/M)-1), where V is the number of vectors,
+//and must be zeros before the first call. Z holds the last inputs of each vector.
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void fir_interp_lanes_s (float *Y, const float *X, const float *B, float *Z, const size_t L, const size_t Q, const size_t M, const size_t K, const size_t NV);
+static void fir_interp_lanes_d (double *Y, const double *X, const double *B, double *Z, const size_t L, const size_t Q, const size_t M, const size_t K, const size_t NV);
+
+int fir_interp_s (float *Y, const float *X, const float *B, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t M, const size_t dim);
+int fir_interp_d (double *Y, const double *X, const double *B, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t M, const size_t dim);
+
+
+static void fir_interp_lanes_s (float *Y, const float *X, const float *B, float *Z, const size_t L, const size_t Q, const size_t M, const size_t K, const size_t NV)
+{
+    const size_t Nh = Q/M;
+    float b;
+
+    for (size_t k=0u; k<L; ++k)
+    {
+        for (size_t p=0u; p<M; ++p, Y+=K)
+        {
+            for (size_t v=0u; v<NV; ++v) { Y[v] = 0.0f; }
+
+            //Taps within X
+            for (size_t j=0u, q=p; q<=Q && j<=k; ++j, q+=M)
+            {
+                const float *x = X + (k-j)*K;
+                b = B[q];
+                for (size_t v=0u; v<NV; ++v) { Y[v] += b * x[v]; }
+            }
+
+            //Taps before X (from the carried state)
+            if (Z)
+            {
+                for (size_t j=k+1u, q=p+(k+1u)*M; q<=Q; ++j, q+=M)
+                {
+                    const float *z = Z + Nh + k - j;
+                    b = B[q];
+                    for (size_t v=0u; v<NV; ++v) { Y[v] += b * z[v*Nh]; }
+                }
+            }
+        }
+    }
+
+    //Update state to the last Nh inputs
+    if (Z && Nh>0u)
+    {
+        if (L>=Nh)
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Nh; ++i) { Z[v*Nh+i] = X[(L-Nh+i)*K+v]; }
+            }
+        }
+        else
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Nh-L; ++i) { Z[v*Nh+i] = Z[v*Nh+i+L]; }
+                for (size_t i=0u; i<L; ++i) { Z[v*Nh+Nh-L+i] = X[i*K+v]; }
+            }
+        }
+    }
+}
+
+
+static void fir_interp_lanes_d (double *Y, const double *X, const double *B, double *Z, const size_t L, const size_t Q, const size_t M, const size_t K, const size_t NV)
+{
+    const size_t Nh = Q/M;
+    double b;
+
+    for (size_t k=0u; k<L; ++k)
+    {
+        for (size_t p=0u; p<M; ++p, Y+=K)
+        {
+            for (size_t v=0u; v<NV; ++v) { Y[v] = 0.0; }
+
+            //Taps within X
+            for (size_t j=0u, q=p; q<=Q && j<=k; ++j, q+=M)
+            {
+                const double *x = X + (k-j)*K;
+                b = B[q];
+                for (size_t v=0u; v<NV; ++v) { Y[v] += b * x[v]; }
+            }
+
+            //Taps before X (from the carried state)
+            if (Z)
+            {
+                for (size_t j=k+1u, q=p+(k+1u)*M; q<=Q; ++j, q+=M)
+                {
+                    const double *z = Z + Nh + k - j;
+                    b = B[q];
+                    for (size_t v=0u; v<NV; ++v) { Y[v] += b * z[v*Nh]; }
+                }
+            }
+        }
+    }
+
+    //Update state to the last Nh inputs
+    if (Z && Nh>0u)
+    {
+        if (L>=Nh)
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Nh; ++i) { Z[v*Nh+i] = X[(L-Nh+i)*K+v]; }
+            }
+        }
+        else
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Nh-L; ++i) { Z[v*Nh+i] = Z[v*Nh+i+L]; }
+                for (size_t i=0u; i<L; ++i) { Z[v*Nh+Nh-L+i] = X[i*K+v]; }
+            }
+        }
+    }
+}
+
+
+int fir_interp_s (float *Y, const float *X, const float *B, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t M, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_interp_s: dim must be in [0 3]\n"); return 1; }
+    if (M<1u) { fprintf(stderr,"error in fir_interp_s: M (interpolation factor) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t Ly = L*M, Nh = Q/M;
+
+        if (L==N)
+        {
+            fir_interp_lanes_s(Y,X,B,Z,L,Q,M,1u,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=Ly)
+                {
+                    fir_interp_lanes_s(Y,X,B,Z,L,Q,M,1u,1u);
+                    if (Z) { Z += Nh; }
+                }
+            }
+            else
+            {
+                //Interleaved vectors are done together as lanes
+                for (size_t g=G; g>0u; --g, X+=K*L, Y+=K*Ly)
+                {
+                    fir_interp_lanes_s(Y,X,B,Z,L,Q,M,K,K);
+                    if (Z) { Z += K*Nh; }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+int fir_interp_d (double *Y, const double *X, const double *B, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t M, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_interp_d: dim must be in [0 3]\n"); return 1; }
+    if (M<1u) { fprintf(stderr,"error in fir_interp_d: M (interpolation factor) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t Ly = L*M, Nh = Q/M;
+
+        if (L==N)
+        {
+            fir_interp_lanes_d(Y,X,B,Z,L,Q,M,1u,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=Ly)
+                {
+                    fir_interp_lanes_d(Y,X,B,Z,L,Q,M,1u,1u);
+                    if (Z) { Z += Nh; }
+                }
+            }
+            else
+            {
+                //Interleaved vectors are done together as lanes
+                for (size_t g=G; g>0u; --g, X+=K*L, Y+=K*Ly)
+                {
+                    fir_interp_lanes_d(Y,X,B,Z,L,Q,M,K,K);
+                    if (Z) { Z += K*Nh; }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,510 @@
+//Causal FIR filtering of each vector in X along dim.
+//FIR impulse response is given in vector B with length Q+1.
+//(I use P for IIR filter order, since same as polynomial order.)
+
+//This is the overlap-save (OLS) version of fir_fft.
+//Each vector is processed in blocks of M = nfft-Q new samples,
+//so scratch memory is O(nfft) instead of O(L), and the FFT of B
+//is computed only once and reused for every block of every vector.
+
+//If nfft is input as 0, it is chosen from Q (not from L):
+//this is the power-of-2 (>=64) that minimizes nfft*(2*log2(nfft)+1)/(nfft-Q),
+//i.e. the approximate cost of the 2 FFTs and the multiply per output sample.
+//It is capped at nextpow2(L+Q), in which case this is one big FFT as in fir_fft.
+
+#include <stdio.h>
+#include <math.h>
+#include <fftw3.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static size_t fir_ola_get_nfft (const size_t L, const size_t Q);
+static void fir_ola_1d_s (float *Y, const float *X, const float *Hf, float *Xb, float *Fb, float *Yb, const fftwf_plan fplan, const fftwf_plan iplan, const size_t L, const size_t Q, const size_t nfft, const size_t K);
+static void fir_ola_1d_d (double *Y, const double *X, const double *Hf, double *Xb, double *Fb, double *Yb, const fftw_plan fplan, const fftw_plan iplan, const size_t L, const size_t Q, const size_t nfft, const size_t K);
+static void fir_ola_1d_c (float *Y, const float *X, const float *Hf, float *Xb, float *Fb, float *Yb, const fftwf_plan fplan, const fftwf_plan iplan, const size_t L, const size_t Q, const size_t nfft, const size_t K);
+static void fir_ola_1d_z (double *Y, const double *X, const double *Hf, double *Xb, double *Fb, double *Yb, const fftw_plan fplan, const fftw_plan iplan, const size_t L, const size_t Q, const size_t nfft, const size_t K);
+
+int fir_ola_s (float *Y, const float *X, const float *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t nfft, const size_t dim);
+int fir_ola_d (double *Y, const double *X, const double *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t nfft, const size_t dim);
+int fir_ola_c (float *Y, const float *X, const float *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t nfft, const size_t dim);
+int fir_ola_z (double *Y, const double *X, const double *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t nfft, const size_t dim);
+
+
+static size_t fir_ola_get_nfft (const size_t L, const size_t Q)
+{
+    size_t nmax = 1u, n = 64u, nfft;
+    while (nmax<L+Q) { nmax *= 2u; }
+    while (n<=Q) { n *= 2u; }
+    if (n>=nmax) { return nmax; }
+
+    double lg = log2((double)n), cst, cmin = (double)n*(2.0*lg+1.0)/(double)(n-Q);
+    nfft = n;
+    for (n*=2u, lg+=1.0; n<=nmax; n*=2u, lg+=1.0)
+    {
+        cst = (double)n*(2.0*lg+1.0)/(double)(n-Q);
+        if (cst<cmin) { cmin = cst; nfft = n; }
+    }
+
+    return nfft;
+}
+
+
+static void fir_ola_1d_s (float *Y, const float *X, const float *Hf, float *Xb, float *Fb, float *Yb, const fftwf_plan fplan, const fftwf_plan iplan, const size_t L, const size_t Q, const size_t nfft, const size_t K)
+{
+    const size_t M = nfft - Q, F = nfft/2u + 1u;
+    float xr, xi, hr, hi;
+
+    //The first block sees Q zeros of pre-history
+    for (size_t n=0u; n<Q; ++n) { Xb[n] = 0.0f; }
+
+    for (size_t l=0u; l<L; l+=M)
+    {
+        const size_t Mb = (L-l<M) ? L-l : M;
+
+        //Append the next Mb samples (zero the rest of a final partial block)
+        for (size_t n=Q; n<Q+Mb; ++n, X+=K) { Xb[n] = *X; }
+        for (size_t n=Q+Mb; n<nfft; ++n) { Xb[n] = 0.0f; }
+
+        //Multiply by the cached spectrum of B (already scaled by 1/nfft)
+        fftwf_execute(fplan);
+        for (size_t f=0u; f<2u*F; f+=2u)
+        {
+            xr = Fb[f]; xi = Fb[f+1u];
+            hr = Hf[f]; hi = Hf[f+1u];
+            Fb[f] = hr*xr - hi*xi;
+            Fb[f+1u] = hr*xi + hi*xr;
+        }
+        fftwf_execute(iplan);
+
+        //Keep the last M outputs (the first Q are circularly aliased)
+        for (size_t n=Q; n<Q+Mb; ++n, Y+=K) { *Y = Yb[n]; }
+
+        //Slide the last Q inputs to the front for the next block
+        for (size_t n=0u; n<Q; ++n) { Xb[n] = Xb[n+M]; }
+    }
+}
+
+
+static void fir_ola_1d_d (double *Y, const double *X, const double *Hf, double *Xb, double *Fb, double *Yb, const fftw_plan fplan, const fftw_plan iplan, const size_t L, const size_t Q, const size_t nfft, const size_t K)
+{
+    const size_t M = nfft - Q, F = nfft/2u + 1u;
+    double xr, xi, hr, hi;
+
+    //The first block sees Q zeros of pre-history
+    for (size_t n=0u; n<Q; ++n) { Xb[n] = 0.0; }
+
+    for (size_t l=0u; l<L; l+=M)
+    {
+        const size_t Mb = (L-l<M) ? L-l : M;
+
+        //Append the next Mb samples (zero the rest of a final partial block)
+        for (size_t n=Q; n<Q+Mb; ++n, X+=K) { Xb[n] = *X; }
+        for (size_t n=Q+Mb; n<nfft; ++n) { Xb[n] = 0.0; }
+
+        //Multiply by the cached spectrum of B (already scaled by 1/nfft)
+        fftw_execute(fplan);
+        for (size_t f=0u; f<2u*F; f+=2u)
+        {
+            xr = Fb[f]; xi = Fb[f+1u];
+            hr = Hf[f]; hi = Hf[f+1u];
+            Fb[f] = hr*xr - hi*xi;
+            Fb[f+1u] = hr*xi + hi*xr;
+        }
+        fftw_execute(iplan);
+
+        //Keep the last M outputs (the first Q are circularly aliased)
+        for (size_t n=Q; n<Q+Mb; ++n, Y+=K) { *Y = Yb[n]; }
+
+        //Slide the last Q inputs to the front for the next block
+        for (size_t n=0u; n<Q; ++n) { Xb[n] = Xb[n+M]; }
+    }
+}
+
+
+static void fir_ola_1d_c (float *Y, const float *X, const float *Hf, float *Xb, float *Fb, float *Yb, const fftwf_plan fplan, const fftwf_plan iplan, const size_t L, const size_t Q, const size_t nfft, const size_t K)
+{
+    const size_t M = nfft - Q;
+    float xr, xi, hr, hi;
+
+    //The first block sees Q zeros of pre-history
+    for (size_t n=0u; n<2u*Q; ++n) { Xb[n] = 0.0f; }
+
+    for (size_t l=0u; l<L; l+=M)
+    {
+        const size_t Mb = (L-l<M) ? L-l : M;
+
+        //Append the next Mb samples (zero the rest of a final partial block)
+        for (size_t n=2u*Q; n<2u*(Q+Mb); n+=2u, X+=2u*K) { Xb[n] = *X; Xb[n+1u] = *(X+1); }
+        for (size_t n=2u*(Q+Mb); n<2u*nfft; ++n) { Xb[n] = 0.0f; }
+
+        //Multiply by the cached spectrum of B (already scaled by 1/nfft)
+        fftwf_execute(fplan);
+        for (size_t f=0u; f<2u*nfft; f+=2u)
+        {
+            xr = Fb[f]; xi = Fb[f+1u];
+            hr = Hf[f]; hi = Hf[f+1u];
+            Fb[f] = hr*xr - hi*xi;
+            Fb[f+1u] = hr*xi + hi*xr;
+        }
+        fftwf_execute(iplan);
+
+        //Keep the last M outputs (the first Q are circularly aliased)
+        for (size_t n=2u*Q; n<2u*(Q+Mb); n+=2u, Y+=2u*K) { *Y = Yb[n]; *(Y+1) = Yb[n+1u]; }
+
+        //Slide the last Q inputs to the front for the next block
+        for (size_t n=0u; n<2u*Q; ++n) { Xb[n] = Xb[n+2u*M]; }
+    }
+}
+
+
+static void fir_ola_1d_z (double *Y, const double *X, const double *Hf, double *Xb, double *Fb, double *Yb, const fftw_plan fplan, const fftw_plan iplan, const size_t L, const size_t Q, const size_t nfft, const size_t K)
+{
+    const size_t M = nfft - Q;
+    double xr, xi, hr, hi;
+
+    //The first block sees Q zeros of pre-history
+    for (size_t n=0u; n<2u*Q; ++n) { Xb[n] = 0.0; }
+
+    for (size_t l=0u; l<L; l+=M)
+    {
+        const size_t Mb = (L-l<M) ? L-l : M;
+
+        //Append the next Mb samples (zero the rest of a final partial block)
+        for (size_t n=2u*Q; n<2u*(Q+Mb); n+=2u, X+=2u*K) { Xb[n] = *X; Xb[n+1u] = *(X+1); }
+        for (size_t n=2u*(Q+Mb); n<2u*nfft; ++n) { Xb[n] = 0.0; }
+
+        //Multiply by the cached spectrum of B (already scaled by 1/nfft)
+        fftw_execute(fplan);
+        for (size_t f=0u; f<2u*nfft; f+=2u)
+        {
+            xr = Fb[f]; xi = Fb[f+1u];
+            hr = Hf[f]; hi = Hf[f+1u];
+            Fb[f] = hr*xr - hi*xi;
+            Fb[f+1u] = hr*xi + hi*xr;
+        }
+        fftw_execute(iplan);
+
+        //Keep the last M outputs (the first Q are circularly aliased)
+        for (size_t n=2u*Q; n<2u*(Q+Mb); n+=2u, Y+=2u*K) { *Y = Yb[n]; *(Y+1) = Yb[n+1u]; }
+
+        //Slide the last Q inputs to the front for the next block
+        for (size_t n=0u; n<2u*Q; ++n) { Xb[n] = Xb[n+2u*M]; }
+    }
+}
+
+
+int fir_ola_s (float *Y, const float *X, const float *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t nfft, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_ola_s: dim must be in [0 3]\n"); return 1; }
+    if (nfft>0u && nfft<=Q) { fprintf(stderr,"error in fir_ola_s: nfft must be > Q (or 0 to choose from Q)\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (Q==0u)
+    {
+        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = *B * *X; }
+    }
+    else
+    {
+        //Set block size and number of freqs
+        const size_t nf = (nfft>0u) ? nfft : fir_ola_get_nfft(L,Q);
+        const size_t F = nf/2u + 1u;
+        const float sc = 1.0f / (float)nf;
+
+        //Initialize fftw
+        float *Xb, *Fb, *Yb, *Hf;
+        Xb = (float *)fftwf_malloc(nf*sizeof(float));
+        Fb = (float *)fftwf_malloc(2u*F*sizeof(float));
+        Yb = (float *)fftwf_malloc(nf*sizeof(float));
+        Hf = (float *)fftwf_malloc(2u*F*sizeof(float));
+        if (!Xb || !Fb || !Yb || !Hf) { fprintf(stderr,"error in fir_ola_s: problem with fftwf_malloc\n"); return 1; }
+        fftwf_plan fplan = fftwf_plan_dft_r2c_1d((int)nf,Xb,(fftwf_complex *)Fb,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in fir_ola_s: problem creating fftw plan\n"); return 1; }
+        fftwf_plan iplan = fftwf_plan_dft_c2r_1d((int)nf,(fftwf_complex *)Fb,Yb,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in fir_ola_s: problem creating fftw plan\n"); return 1; }
+
+        //Get Hf (FFT of B, scaled), computed once for all blocks and vecs
+        for (size_t n=0u; n<=Q; ++n) { Xb[n] = B[n]; }
+        for (size_t n=Q+1u; n<nf; ++n) { Xb[n] = 0.0f; }
+        fftwf_execute(fplan);
+        for (size_t f=0u; f<2u*F; ++f) { Hf[f] = sc * Fb[f]; }
+
+        if (L==N)
+        {
+            fir_ola_1d_s(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=L)
+                {
+                    fir_ola_1d_s(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,1u);
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=BS*(L-1u), Y+=BS*(L-1u))
+                {
+                    for (size_t bs=BS; bs>0u; --bs, ++X, ++Y)
+                    {
+                        fir_ola_1d_s(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,K);
+                    }
+                }
+            }
+        }
+        fftwf_free(Xb); fftwf_free(Fb); fftwf_free(Yb); fftwf_free(Hf);
+        fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int fir_ola_d (double *Y, const double *X, const double *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t nfft, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_ola_d: dim must be in [0 3]\n"); return 1; }
+    if (nfft>0u && nfft<=Q) { fprintf(stderr,"error in fir_ola_d: nfft must be > Q (or 0 to choose from Q)\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (Q==0u)
+    {
+        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = *B * *X; }
+    }
+    else
+    {
+        //Set block size and number of freqs
+        const size_t nf = (nfft>0u) ? nfft : fir_ola_get_nfft(L,Q);
+        const size_t F = nf/2u + 1u;
+        const double sc = 1.0 / (double)nf;
+
+        //Initialize fftw
+        double *Xb, *Fb, *Yb, *Hf;
+        Xb = (double *)fftw_malloc(nf*sizeof(double));
+        Fb = (double *)fftw_malloc(2u*F*sizeof(double));
+        Yb = (double *)fftw_malloc(nf*sizeof(double));
+        Hf = (double *)fftw_malloc(2u*F*sizeof(double));
+        if (!Xb || !Fb || !Yb || !Hf) { fprintf(stderr,"error in fir_ola_d: problem with fftw_malloc\n"); return 1; }
+        fftw_plan fplan = fftw_plan_dft_r2c_1d((int)nf,Xb,(fftw_complex *)Fb,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in fir_ola_d: problem creating fftw plan\n"); return 1; }
+        fftw_plan iplan = fftw_plan_dft_c2r_1d((int)nf,(fftw_complex *)Fb,Yb,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in fir_ola_d: problem creating fftw plan\n"); return 1; }
+
+        //Get Hf (FFT of B, scaled), computed once for all blocks and vecs
+        for (size_t n=0u; n<=Q; ++n) { Xb[n] = B[n]; }
+        for (size_t n=Q+1u; n<nf; ++n) { Xb[n] = 0.0; }
+        fftw_execute(fplan);
+        for (size_t f=0u; f<2u*F; ++f) { Hf[f] = sc * Fb[f]; }
+
+        if (L==N)
+        {
+            fir_ola_1d_d(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=L)
+                {
+                    fir_ola_1d_d(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,1u);
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=BS*(L-1u), Y+=BS*(L-1u))
+                {
+                    for (size_t bs=BS; bs>0u; --bs, ++X, ++Y)
+                    {
+                        fir_ola_1d_d(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,K);
+                    }
+                }
+            }
+        }
+        fftw_free(Xb); fftw_free(Fb); fftw_free(Yb); fftw_free(Hf);
+        fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int fir_ola_c (float *Y, const float *X, const float *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t nfft, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_ola_c: dim must be in [0 3]\n"); return 1; }
+    if (nfft>0u && nfft<=Q) { fprintf(stderr,"error in fir_ola_c: nfft must be > Q (or 0 to choose from Q)\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (Q==0u)
+    {
+        const float br = *B, bi = *(B+1);
+        float xr, xi;
+        for (size_t n=N; n>0u; --n)
+        {
+            xr = *X++; xi = *X++;
+            *Y++ = br*xr - bi*xi;
+            *Y++ = br*xi + bi*xr;
+        }
+    }
+    else
+    {
+        //Set block size
+        const size_t nf = (nfft>0u) ? nfft : fir_ola_get_nfft(L,Q);
+        const float sc = 1.0f / (float)nf;
+
+        //Initialize fftw
+        float *Xb, *Fb, *Yb, *Hf;
+        Xb = (float *)fftwf_malloc(2u*nf*sizeof(float));
+        Fb = (float *)fftwf_malloc(2u*nf*sizeof(float));
+        Yb = (float *)fftwf_malloc(2u*nf*sizeof(float));
+        Hf = (float *)fftwf_malloc(2u*nf*sizeof(float));
+        if (!Xb || !Fb || !Yb || !Hf) { fprintf(stderr,"error in fir_ola_c: problem with fftwf_malloc\n"); return 1; }
+        fftwf_plan fplan = fftwf_plan_dft_1d((int)nf,(fftwf_complex *)Xb,(fftwf_complex *)Fb,FFTW_FORWARD,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in fir_ola_c: problem creating fftw plan\n"); return 1; }
+        fftwf_plan iplan = fftwf_plan_dft_1d((int)nf,(fftwf_complex *)Fb,(fftwf_complex *)Yb,FFTW_BACKWARD,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in fir_ola_c: problem creating fftw plan\n"); return 1; }
+
+        //Get Hf (FFT of B, scaled), computed once for all blocks and vecs
+        for (size_t n=0u; n<2u*(Q+1u); ++n) { Xb[n] = B[n]; }
+        for (size_t n=2u*(Q+1u); n<2u*nf; ++n) { Xb[n] = 0.0f; }
+        fftwf_execute(fplan);
+        for (size_t f=0u; f<2u*nf; ++f) { Hf[f] = sc * Fb[f]; }
+
+        if (L==N)
+        {
+            fir_ola_1d_c(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=2u*L, Y+=2u*L)
+                {
+                    fir_ola_1d_c(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,1u);
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=2u*BS*(L-1u), Y+=2u*BS*(L-1u))
+                {
+                    for (size_t bs=BS; bs>0u; --bs, X+=2, Y+=2)
+                    {
+                        fir_ola_1d_c(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,K);
+                    }
+                }
+            }
+        }
+        fftwf_free(Xb); fftwf_free(Fb); fftwf_free(Yb); fftwf_free(Hf);
+        fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int fir_ola_z (double *Y, const double *X, const double *B, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t nfft, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_ola_z: dim must be in [0 3]\n"); return 1; }
+    if (nfft>0u && nfft<=Q) { fprintf(stderr,"error in fir_ola_z: nfft must be > Q (or 0 to choose from Q)\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (Q==0u)
+    {
+        const double br = *B, bi = *(B+1);
+        double xr, xi;
+        for (size_t n=N; n>0u; --n)
+        {
+            xr = *X++; xi = *X++;
+            *Y++ = br*xr - bi*xi;
+            *Y++ = br*xi + bi*xr;
+        }
+    }
+    else
+    {
+        //Set block size
+        const size_t nf = (nfft>0u) ? nfft : fir_ola_get_nfft(L,Q);
+        const double sc = 1.0 / (double)nf;
+
+        //Initialize fftw
+        double *Xb, *Fb, *Yb, *Hf;
+        Xb = (double *)fftw_malloc(2u*nf*sizeof(double));
+        Fb = (double *)fftw_malloc(2u*nf*sizeof(double));
+        Yb = (double *)fftw_malloc(2u*nf*sizeof(double));
+        Hf = (double *)fftw_malloc(2u*nf*sizeof(double));
+        if (!Xb || !Fb || !Yb || !Hf) { fprintf(stderr,"error in fir_ola_z: problem with fftw_malloc\n"); return 1; }
+        fftw_plan fplan = fftw_plan_dft_1d((int)nf,(fftw_complex *)Xb,(fftw_complex *)Fb,FFTW_FORWARD,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in fir_ola_z: problem creating fftw plan\n"); return 1; }
+        fftw_plan iplan = fftw_plan_dft_1d((int)nf,(fftw_complex *)Fb,(fftw_complex *)Yb,FFTW_BACKWARD,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in fir_ola_z: problem creating fftw plan\n"); return 1; }
+
+        //Get Hf (FFT of B, scaled), computed once for all blocks and vecs
+        for (size_t n=0u; n<2u*(Q+1u); ++n) { Xb[n] = B[n]; }
+        for (size_t n=2u*(Q+1u); n<2u*nf; ++n) { Xb[n] = 0.0; }
+        fftw_execute(fplan);
+        for (size_t f=0u; f<2u*nf; ++f) { Hf[f] = sc * Fb[f]; }
+
+        if (L==N)
+        {
+            fir_ola_1d_z(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=2u*L, Y+=2u*L)
+                {
+                    fir_ola_1d_z(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,1u);
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=2u*BS*(L-1u), Y+=2u*BS*(L-1u))
+                {
+                    for (size_t bs=BS; bs>0u; --bs, X+=2, Y+=2)
+                    {
+                        fir_ola_1d_z(Y,X,Hf,Xb,Fb,Yb,fplan,iplan,L,Q,nf,K);
+                    }
+                }
+            }
+        }
+        fftw_free(Xb); fftw_free(Fb); fftw_free(Yb); fftw_free(Hf);
+        fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
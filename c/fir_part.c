@@ -0,0 +1,358 @@
+//Causal FIR filtering of each vector in X along dim,
+//using uniformly-partitioned overlap-save convolution (UPOLS).
+//FIR impulse response is given in vector B with length Q+1.
+
+//This is meant for long FIR filters (e.g., room impulse responses)
+//where both low latency and throughput are required.
+//B is split into P = ceil((Q+1)/Lb) partitions of length Lb (the block size),
+//and each input block of Lb samples is transformed once (nfft = 2*Lb).
+//The spectra of the last P input blocks are kept in a frequency-domain
+//delay line (FDL), and each output block is the IFFT of the sum of
+//FDL[p] .* Hp[p] over partitions. So the latency is one block (Lb samples),
+//and the cost per sample is about O(log Lb) for the FFTs plus O(P) for the MACs.
+
+//The output is identical to fir (up to float precision) for any Lb.
+
+//Use fir_part_init first to get Hp, the spectra of the partitions of B.
+//Hp has length 2*(Lb+1)*P, and can be reused across calls.
+
+//Z is the state carried between calls (for streaming), or NULL.
+//If NULL, each vector starts from zero initial conditions.
+//If not NULL, Z has length V*(Lb+2*(Lb+1)*P+1), where V is the number of vectors,
+//and must be zeros before the first call. For each vector, this holds the previous
+//input block, the FDL, and the index of the front of the FDL (which is circular,
+//so that each block only overwrites the oldest spectrum). It is updated on return,
+//so the next call continues each vector where this one stopped.
+//For streaming, each call must give a multiple of Lb samples per vector,
+//except for the last call.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fftw3.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void fir_part_1d_s (float *Y, const float *X, const float *Hp, float *Z, float *Xb, float *Fb, float *Yb, const fftwf_plan fplan, const fftwf_plan iplan, const size_t L, const size_t Lb, const size_t P, const size_t K);
+static void fir_part_1d_d (double *Y, const double *X, const double *Hp, double *Z, double *Xb, double *Fb, double *Yb, const fftw_plan fplan, const fftw_plan iplan, const size_t L, const size_t Lb, const size_t P, const size_t K);
+
+int fir_part_init_s (float *Hp, const float *B, const size_t Q, const size_t Lb);
+int fir_part_init_d (double *Hp, const double *B, const size_t Q, const size_t Lb);
+int fir_part_s (float *Y, const float *X, const float *Hp, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t Lb, const size_t dim);
+int fir_part_d (double *Y, const double *X, const double *Hp, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t Lb, const size_t dim);
+
+
+static void fir_part_1d_s (float *Y, const float *X, const float *Hp, float *Z, float *Xb, float *Fb, float *Yb, const fftwf_plan fplan, const fftwf_plan iplan, const size_t L, const size_t Lb, const size_t P, const size_t K)
+{
+    const size_t F2 = 2u*(Lb+1u);
+    float *fdl = Z + Lb, *Xh;
+    float xr, xi, hr, hi;
+    size_t h = (size_t)Z[Lb+F2*P];
+
+    for (size_t l=0u; l<L; l+=Lb)
+    {
+        const size_t Mb = (L-l<Lb) ? L-l : Lb;
+
+        //Previous block and this block of inputs
+        for (size_t n=0u; n<Lb; ++n) { Xb[n] = Z[n]; }
+        for (size_t n=Lb; n<Lb+Mb; ++n, X+=K) { Xb[n] = *X; }
+        for (size_t n=Lb+Mb; n<2u*Lb; ++n) { Xb[n] = 0.0f; }
+        for (size_t n=0u; n<Lb; ++n) { Z[n] = Xb[n+Lb]; }
+
+        //Put the spectrum of this block at the front of the FDL (circular, h is the front)
+        fftwf_execute(fplan);
+        h = (h==0u) ? P-1u : h-1u;
+        Xh = fdl + h*F2;
+        for (size_t f=0u; f<F2; ++f) { Xh[f] = Fb[f]; }
+
+        //Multiply-accumulate over partitions
+        for (size_t f=0u; f<F2; f+=2u)
+        {
+            xr = Xh[f]; xi = Xh[f+1u];
+            hr = Hp[f]; hi = Hp[f+1u];
+            Fb[f] = hr*xr - hi*xi;
+            Fb[f+1u] = hr*xi + hi*xr;
+        }
+        for (size_t p=1u, q=h+1u; p<P; ++p, ++q)
+        {
+            if (q==P) { q = 0u; }
+            const float *Xp = fdl + q*F2, *Hq = Hp + p*F2;
+            for (size_t f=0u; f<F2; f+=2u)
+            {
+                xr = Xp[f]; xi = Xp[f+1u];
+                hr = Hq[f]; hi = Hq[f+1u];
+                Fb[f] += hr*xr - hi*xi;
+                Fb[f+1u] += hr*xi + hi*xr;
+            }
+        }
+        fftwf_execute(iplan);
+
+        //Keep the last Lb outputs
+        for (size_t n=Lb; n<Lb+Mb; ++n, Y+=K) { *Y = Yb[n]; }
+    }
+
+    Z[Lb+F2*P] = (float)h;
+}
+
+
+static void fir_part_1d_d (double *Y, const double *X, const double *Hp, double *Z, double *Xb, double *Fb, double *Yb, const fftw_plan fplan, const fftw_plan iplan, const size_t L, const size_t Lb, const size_t P, const size_t K)
+{
+    const size_t F2 = 2u*(Lb+1u);
+    double *fdl = Z + Lb, *Xh;
+    double xr, xi, hr, hi;
+    size_t h = (size_t)Z[Lb+F2*P];
+
+    for (size_t l=0u; l<L; l+=Lb)
+    {
+        const size_t Mb = (L-l<Lb) ? L-l : Lb;
+
+        //Previous block and this block of inputs
+        for (size_t n=0u; n<Lb; ++n) { Xb[n] = Z[n]; }
+        for (size_t n=Lb; n<Lb+Mb; ++n, X+=K) { Xb[n] = *X; }
+        for (size_t n=Lb+Mb; n<2u*Lb; ++n) { Xb[n] = 0.0; }
+        for (size_t n=0u; n<Lb; ++n) { Z[n] = Xb[n+Lb]; }
+
+        //Put the spectrum of this block at the front of the FDL (circular, h is the front)
+        fftw_execute(fplan);
+        h = (h==0u) ? P-1u : h-1u;
+        Xh = fdl + h*F2;
+        for (size_t f=0u; f<F2; ++f) { Xh[f] = Fb[f]; }
+
+        //Multiply-accumulate over partitions
+        for (size_t f=0u; f<F2; f+=2u)
+        {
+            xr = Xh[f]; xi = Xh[f+1u];
+            hr = Hp[f]; hi = Hp[f+1u];
+            Fb[f] = hr*xr - hi*xi;
+            Fb[f+1u] = hr*xi + hi*xr;
+        }
+        for (size_t p=1u, q=h+1u; p<P; ++p, ++q)
+        {
+            if (q==P) { q = 0u; }
+            const double *Xp = fdl + q*F2, *Hq = Hp + p*F2;
+            for (size_t f=0u; f<F2; f+=2u)
+            {
+                xr = Xp[f]; xi = Xp[f+1u];
+                hr = Hq[f]; hi = Hq[f+1u];
+                Fb[f] += hr*xr - hi*xi;
+                Fb[f+1u] += hr*xi + hi*xr;
+            }
+        }
+        fftw_execute(iplan);
+
+        //Keep the last Lb outputs
+        for (size_t n=Lb; n<Lb+Mb; ++n, Y+=K) { *Y = Yb[n]; }
+    }
+
+    Z[Lb+F2*P] = (double)h;
+}
+
+
+int fir_part_init_s (float *Hp, const float *B, const size_t Q, const size_t Lb)
+{
+    if (Lb<1u) { fprintf(stderr,"error in fir_part_init_s: Lb (block size) must be positive\n"); return 1; }
+
+    const size_t P = (Q+Lb)/Lb, nfft = 2u*Lb, F2 = 2u*(Lb+1u);
+    const float sc = 1.0f / (float)nfft;
+
+    //Initialize fftw
+    float *Xb, *Fb;
+    Xb = (float *)fftwf_malloc(nfft*sizeof(float));
+    Fb = (float *)fftwf_malloc(F2*sizeof(float));
+    if (!Xb || !Fb) { fprintf(stderr,"error in fir_part_init_s: problem with fftwf_malloc\n"); return 1; }
+    fftwf_plan fplan = fftwf_plan_dft_r2c_1d((int)nfft,Xb,(fftwf_complex *)Fb,FFTW_ESTIMATE);
+    if (!fplan) { fprintf(stderr,"error in fir_part_init_s: problem creating fftw plan\n"); return 1; }
+
+    //FFT of each partition of B (zero-padded to nfft), scaled for the IFFT
+    for (size_t p=0u, q=0u; p<P; ++p, Hp+=F2)
+    {
+        for (size_t n=0u; n<Lb; ++n, ++q) { Xb[n] = (q<=Q) ? B[q] : 0.0f; }
+        for (size_t n=Lb; n<nfft; ++n) { Xb[n] = 0.0f; }
+        fftwf_execute(fplan);
+        for (size_t f=0u; f<F2; ++f) { Hp[f] = sc * Fb[f]; }
+    }
+
+    fftwf_free(Xb); fftwf_free(Fb); fftwf_destroy_plan(fplan);
+
+    return 0;
+}
+
+
+int fir_part_init_d (double *Hp, const double *B, const size_t Q, const size_t Lb)
+{
+    if (Lb<1u) { fprintf(stderr,"error in fir_part_init_d: Lb (block size) must be positive\n"); return 1; }
+
+    const size_t P = (Q+Lb)/Lb, nfft = 2u*Lb, F2 = 2u*(Lb+1u);
+    const double sc = 1.0 / (double)nfft;
+
+    //Initialize fftw
+    double *Xb, *Fb;
+    Xb = (double *)fftw_malloc(nfft*sizeof(double));
+    Fb = (double *)fftw_malloc(F2*sizeof(double));
+    if (!Xb || !Fb) { fprintf(stderr,"error in fir_part_init_d: problem with fftw_malloc\n"); return 1; }
+    fftw_plan fplan = fftw_plan_dft_r2c_1d((int)nfft,Xb,(fftw_complex *)Fb,FFTW_ESTIMATE);
+    if (!fplan) { fprintf(stderr,"error in fir_part_init_d: problem creating fftw plan\n"); return 1; }
+
+    //FFT of each partition of B (zero-padded to nfft), scaled for the IFFT
+    for (size_t p=0u, q=0u; p<P; ++p, Hp+=F2)
+    {
+        for (size_t n=0u; n<Lb; ++n, ++q) { Xb[n] = (q<=Q) ? B[q] : 0.0; }
+        for (size_t n=Lb; n<nfft; ++n) { Xb[n] = 0.0; }
+        fftw_execute(fplan);
+        for (size_t f=0u; f<F2; ++f) { Hp[f] = sc * Fb[f]; }
+    }
+
+    fftw_free(Xb); fftw_free(Fb); fftw_destroy_plan(fplan);
+
+    return 0;
+}
+
+
+int fir_part_s (float *Y, const float *X, const float *Hp, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t Lb, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_part_s: dim must be in [0 3]\n"); return 1; }
+    if (Lb<1u) { fprintf(stderr,"error in fir_part_s: Lb (block size) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t P = (Q+Lb)/Lb, nfft = 2u*Lb, F2 = 2u*(Lb+1u);
+        const size_t nz = Lb + F2*P + 1u;
+
+        //Initialize fftw
+        float *Xb, *Fb, *Yb, *Zv, *Zw = NULL;
+        Xb = (float *)fftwf_malloc(nfft*sizeof(float));
+        Fb = (float *)fftwf_malloc(F2*sizeof(float));
+        Yb = (float *)fftwf_malloc(nfft*sizeof(float));
+        if (!Xb || !Fb || !Yb) { fprintf(stderr,"error in fir_part_s: problem with fftwf_malloc\n"); return 1; }
+        fftwf_plan fplan = fftwf_plan_dft_r2c_1d((int)nfft,Xb,(fftwf_complex *)Fb,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in fir_part_s: problem creating fftw plan\n"); return 1; }
+        fftwf_plan iplan = fftwf_plan_dft_c2r_1d((int)nfft,(fftwf_complex *)Fb,Yb,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in fir_part_s: problem creating fftw plan\n"); return 1; }
+
+        //Zero state if not carried
+        if (Z) { Zv = Z; }
+        else
+        {
+            if (!(Zw=(float *)calloc(nz,sizeof(float)))) { fprintf(stderr,"error in fir_part_s: problem with calloc\n"); return 1; }
+            Zv = Zw;
+        }
+
+        if (L==N)
+        {
+            fir_part_1d_s(Y,X,Hp,Zv,Xb,Fb,Yb,fplan,iplan,L,Lb,P,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=L)
+                {
+                    fir_part_1d_s(Y,X,Hp,Zv,Xb,Fb,Yb,fplan,iplan,L,Lb,P,1u);
+                    if (Z) { Zv += nz; } else { for (size_t n=0u; n<nz; ++n) { Zw[n] = 0.0f; } }
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=BS*(L-1u), Y+=BS*(L-1u))
+                {
+                    for (size_t bs=BS; bs>0u; --bs, ++X, ++Y)
+                    {
+                        fir_part_1d_s(Y,X,Hp,Zv,Xb,Fb,Yb,fplan,iplan,L,Lb,P,K);
+                        if (Z) { Zv += nz; } else { for (size_t n=0u; n<nz; ++n) { Zw[n] = 0.0f; } }
+                    }
+                }
+            }
+        }
+        fftwf_free(Xb); fftwf_free(Fb); fftwf_free(Yb); free(Zw);
+        fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int fir_part_d (double *Y, const double *X, const double *Hp, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Q, const size_t Lb, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in fir_part_d: dim must be in [0 3]\n"); return 1; }
+    if (Lb<1u) { fprintf(stderr,"error in fir_part_d: Lb (block size) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t P = (Q+Lb)/Lb, nfft = 2u*Lb, F2 = 2u*(Lb+1u);
+        const size_t nz = Lb + F2*P + 1u;
+
+        //Initialize fftw
+        double *Xb, *Fb, *Yb, *Zv, *Zw = NULL;
+        Xb = (double *)fftw_malloc(nfft*sizeof(double));
+        Fb = (double *)fftw_malloc(F2*sizeof(double));
+        Yb = (double *)fftw_malloc(nfft*sizeof(double));
+        if (!Xb || !Fb || !Yb) { fprintf(stderr,"error in fir_part_d: problem with fftw_malloc\n"); return 1; }
+        fftw_plan fplan = fftw_plan_dft_r2c_1d((int)nfft,Xb,(fftw_complex *)Fb,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in fir_part_d: problem creating fftw plan\n"); return 1; }
+        fftw_plan iplan = fftw_plan_dft_c2r_1d((int)nfft,(fftw_complex *)Fb,Yb,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in fir_part_d: problem creating fftw plan\n"); return 1; }
+
+        //Zero state if not carried
+        if (Z) { Zv = Z; }
+        else
+        {
+            if (!(Zw=(double *)calloc(nz,sizeof(double)))) { fprintf(stderr,"error in fir_part_d: problem with calloc\n"); return 1; }
+            Zv = Zw;
+        }
+
+        if (L==N)
+        {
+            fir_part_1d_d(Y,X,Hp,Zv,Xb,Fb,Yb,fplan,iplan,L,Lb,P,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=L)
+                {
+                    fir_part_1d_d(Y,X,Hp,Zv,Xb,Fb,Yb,fplan,iplan,L,Lb,P,1u);
+                    if (Z) { Zv += nz; } else { for (size_t n=0u; n<nz; ++n) { Zw[n] = 0.0; } }
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=BS*(L-1u), Y+=BS*(L-1u))
+                {
+                    for (size_t bs=BS; bs>0u; --bs, ++X, ++Y)
+                    {
+                        fir_part_1d_d(Y,X,Hp,Zv,Xb,Fb,Yb,fplan,iplan,L,Lb,P,K);
+                        if (Z) { Zv += nz; } else { for (size_t n=0u; n<nz; ++n) { Zw[n] = 0.0; } }
+                    }
+                }
+            }
+        }
+        fftw_free(Xb); fftw_free(Fb); fftw_free(Yb); free(Zw);
+        fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,298 @@
+//Gammatone filterbank: filters vector X by NB gammatone filters,
+//with center frequencies spaced uniformly on the ERB-rate scale from fmin to fmax (Hz).
+
+//This uses the recursive complex one-pole cascade (Holdsworth et al. 1988):
+//each channel is frequency-shifted to 0 Hz implicitly by using a complex pole
+//a = exp(-2*pi*bw/fs) * exp(i*2*pi*cf/fs), and ord identical one-pole stages
+//y_k[n] = y_{k-1}[n] + a*y_k[n-1] are cascaded (ord=4 is the usual gammatone order).
+//So the cost is O(ord) per sample per channel, instead of a long FIR per channel.
+//The inner loops run across channels (the states of all channels are contiguous),
+//so they vectorize over channels.
+
+//The bandwidth is bw = ERB(cf)/c(ord), with ERB(f) = 24.7 + 0.108*f (Glasberg & Moore 1990),
+//and c(ord) = pi*(2*ord-2)!*2^(2-2*ord)/((ord-1)!)^2, so bw = 1.019*ERB for ord=4.
+//Each channel is normalized to unity gain at its center frequency.
+
+//otyp gives the output type:
+//otyp==0: bandpass output (real part of the complex output)
+//otyp==1: envelope (magnitude of the complex output, i.e. the Hilbert envelope)
+//otyp==2: half-wave rectified bandpass output
+
+//As in fir_bank, samples from one channel are always contiguous in memory,
+//so Y has size NB x N if row-major, and N x NB if col-major.
+
+//Z is the state carried between calls (for streaming), or NULL.
+//If not NULL, Z has length 2*ord*NB (complex states), and must be zeros before the first call.
+
+//gammatone_cfs gives the NB center freqs (Hz) used here, in increasing order.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#ifndef M_PI
+   #define M_PI 3.141592653589793238462643383279502884
+#endif
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static double gammatone_bwc (const size_t ord);
+
+int gammatone_cfs_s (float *cfs, const size_t NB, const float fmin, const float fmax);
+int gammatone_cfs_d (double *cfs, const size_t NB, const double fmin, const double fmax);
+int gammatone_s (float *Y, const float *X, float *Z, const size_t N, const size_t NB, const float fs, const float fmin, const float fmax, const size_t ord, const size_t otyp);
+int gammatone_d (double *Y, const double *X, double *Z, const size_t N, const size_t NB, const double fs, const double fmin, const double fmax, const size_t ord, const size_t otyp);
+
+
+static double gammatone_bwc (const size_t ord)
+{
+    //c(ord) = pi * (2*ord-2)! * 2^(2-2*ord) / ((ord-1)!)^2
+    double c = M_PI;
+    for (size_t k=1u; k<ord; ++k) { c *= (double)(2u*k-1u)*(double)(2u*k) / (4.0*(double)k*(double)k); }
+    return c;
+}
+
+
+int gammatone_cfs_s (float *cfs, const size_t NB, const float fmin, const float fmax)
+{
+    if (fmin<=0.0f) { fprintf(stderr,"error in gammatone_cfs_s: fmin must be positive\n"); return 1; }
+    if (fmax<fmin) { fprintf(stderr,"error in gammatone_cfs_s: fmax must be >= fmin\n"); return 1; }
+
+    if (NB==1u) { *cfs = fmin; }
+    else if (NB>1u)
+    {
+        //Uniform on the ERB-rate scale: E(f) = 21.4*log10(1+0.00437*f)
+        const double e1 = 21.4*log10(1.0+0.00437*(double)fmin), e2 = 21.4*log10(1.0+0.00437*(double)fmax);
+        const double de = (e2-e1) / (double)(NB-1u);
+        for (size_t b=0u; b<NB; ++b, ++cfs)
+        {
+            *cfs = (float)((pow(10.0,(e1+(double)b*de)/21.4)-1.0)/0.00437);
+        }
+    }
+
+    return 0;
+}
+
+
+int gammatone_cfs_d (double *cfs, const size_t NB, const double fmin, const double fmax)
+{
+    if (fmin<=0.0) { fprintf(stderr,"error in gammatone_cfs_d: fmin must be positive\n"); return 1; }
+    if (fmax<fmin) { fprintf(stderr,"error in gammatone_cfs_d: fmax must be >= fmin\n"); return 1; }
+
+    if (NB==1u) { *cfs = fmin; }
+    else if (NB>1u)
+    {
+        //Uniform on the ERB-rate scale: E(f) = 21.4*log10(1+0.00437*f)
+        const double e1 = 21.4*log10(1.0+0.00437*(double)fmin), e2 = 21.4*log10(1.0+0.00437*(double)fmax);
+        const double de = (e2-e1) / (double)(NB-1u);
+        for (size_t b=0u; b<NB; ++b, ++cfs)
+        {
+            *cfs = (double)((pow(10.0,(e1+(double)b*de)/21.4)-1.0)/0.00437);
+        }
+    }
+
+    return 0;
+}
+
+
+int gammatone_s (float *Y, const float *X, float *Z, const size_t N, const size_t NB, const float fs, const float fmin, const float fmax, const size_t ord, const size_t otyp)
+{
+    if (fs<=0.0f) { fprintf(stderr,"error in gammatone_s: fs (sample rate) must be positive\n"); return 1; }
+    if (fmax>=0.5f*fs) { fprintf(stderr,"error in gammatone_s: fmax must be < fs/2\n"); return 1; }
+    if (ord<1u) { fprintf(stderr,"error in gammatone_s: ord (filter order) must be positive\n"); return 1; }
+    if (otyp>2u) { fprintf(stderr,"error in gammatone_s: otyp must be in {0,1,2}\n"); return 1; }
+
+    if (N==0u || NB==0u) {}
+    else
+    {
+        const size_t NT = 64u;             //samples per block of the output transpose
+        float *cfs, *ar, *ai, *g, *zr, *zi, *T;
+        if (!(cfs=(float *)malloc(NB*sizeof(float)))) { fprintf(stderr,"error in gammatone_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(ar=(float *)malloc(NB*sizeof(float)))) { fprintf(stderr,"error in gammatone_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(ai=(float *)malloc(NB*sizeof(float)))) { fprintf(stderr,"error in gammatone_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(g=(float *)malloc(NB*sizeof(float)))) { fprintf(stderr,"error in gammatone_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(zr=(float *)malloc(ord*NB*sizeof(float)))) { fprintf(stderr,"error in gammatone_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(zi=(float *)malloc(ord*NB*sizeof(float)))) { fprintf(stderr,"error in gammatone_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(T=(float *)malloc(NT*NB*sizeof(float)))) { fprintf(stderr,"error in gammatone_s: problem with malloc. "); perror("malloc"); return 1; }
+
+        //Get poles and gains
+        if (gammatone_cfs_s(cfs,NB,fmin,fmax)) { fprintf(stderr,"error in gammatone_s: problem with gammatone_cfs_s\n"); return 1; }
+        const double bwc = gammatone_bwc(ord);
+        for (size_t b=0u; b<NB; ++b)
+        {
+            const double bw = (24.7+0.108*(double)cfs[b]) / bwc;
+            const double r = exp(-2.0*M_PI*bw/(double)fs), w = 2.0*M_PI*(double)cfs[b]/(double)fs;
+            ar[b] = (float)(r*cos(w)); ai[b] = (float)(r*sin(w));
+            g[b] = (float)(2.0*pow(1.0-r,(double)ord));
+        }
+
+        //Initialize states
+        if (Z) { for (size_t k=0u; k<ord*NB; ++k) { zr[k] = Z[2u*k]; zi[k] = Z[2u*k+1u]; } }
+        else { for (size_t k=0u; k<ord*NB; ++k) { zr[k] = zi[k] = 0.0f; } }
+
+        for (size_t n0=0u; n0<N; n0+=NT)
+        {
+            const size_t nt = (N-n0<NT) ? N-n0 : NT;
+
+            for (size_t n=0u; n<nt; ++n)
+            {
+                //First stage (real input)
+                const float x = X[n0+n];
+                for (size_t b=0u; b<NB; ++b)
+                {
+                    const float tr = x + ar[b]*zr[b] - ai[b]*zi[b];
+                    zi[b] = ar[b]*zi[b] + ai[b]*zr[b];
+                    zr[b] = tr;
+                }
+
+                //Other stages (input is the new output of the previous stage)
+                for (size_t k=1u; k<ord; ++k)
+                {
+                    const float *ur = &zr[(k-1u)*NB], *ui = &zi[(k-1u)*NB];
+                    float *vr = &zr[k*NB], *vi = &zi[k*NB];
+                    for (size_t b=0u; b<NB; ++b)
+                    {
+                        const float tr = ur[b] + ar[b]*vr[b] - ai[b]*vi[b];
+                        vi[b] = ui[b] + ar[b]*vi[b] + ai[b]*vr[b];
+                        vr[b] = tr;
+                    }
+                }
+
+                //Output of the last stage
+                const float *ur = &zr[(ord-1u)*NB], *ui = &zi[(ord-1u)*NB];
+                float *t = &T[n*NB];
+                if (otyp==0u)
+                {
+                    for (size_t b=0u; b<NB; ++b) { t[b] = g[b] * ur[b]; }
+                }
+                else if (otyp==1u)
+                {
+                    for (size_t b=0u; b<NB; ++b) { t[b] = g[b] * sqrtf(ur[b]*ur[b]+ui[b]*ui[b]); }
+                }
+                else
+                {
+                    for (size_t b=0u; b<NB; ++b) { t[b] = (ur[b]>0.0f) ? g[b]*ur[b] : 0.0f; }
+                }
+            }
+
+            //Transpose the block into Y (each channel contiguous)
+            for (size_t b=0u; b<NB; ++b)
+            {
+                for (size_t n=0u; n<nt; ++n) { Y[b*N+n0+n] = T[n*NB+b]; }
+            }
+        }
+
+        //Save states
+        if (Z) { for (size_t k=0u; k<ord*NB; ++k) { Z[2u*k] = zr[k]; Z[2u*k+1u] = zi[k]; } }
+
+        free(cfs); free(ar); free(ai); free(g); free(zr); free(zi); free(T);
+    }
+
+    return 0;
+}
+
+
+int gammatone_d (double *Y, const double *X, double *Z, const size_t N, const size_t NB, const double fs, const double fmin, const double fmax, const size_t ord, const size_t otyp)
+{
+    if (fs<=0.0) { fprintf(stderr,"error in gammatone_d: fs (sample rate) must be positive\n"); return 1; }
+    if (fmax>=0.5*fs) { fprintf(stderr,"error in gammatone_d: fmax must be < fs/2\n"); return 1; }
+    if (ord<1u) { fprintf(stderr,"error in gammatone_d: ord (filter order) must be positive\n"); return 1; }
+    if (otyp>2u) { fprintf(stderr,"error in gammatone_d: otyp must be in {0,1,2}\n"); return 1; }
+
+    if (N==0u || NB==0u) {}
+    else
+    {
+        const size_t NT = 64u;             //samples per block of the output transpose
+        double *cfs, *ar, *ai, *g, *zr, *zi, *T;
+        if (!(cfs=(double *)malloc(NB*sizeof(double)))) { fprintf(stderr,"error in gammatone_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(ar=(double *)malloc(NB*sizeof(double)))) { fprintf(stderr,"error in gammatone_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(ai=(double *)malloc(NB*sizeof(double)))) { fprintf(stderr,"error in gammatone_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(g=(double *)malloc(NB*sizeof(double)))) { fprintf(stderr,"error in gammatone_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(zr=(double *)malloc(ord*NB*sizeof(double)))) { fprintf(stderr,"error in gammatone_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(zi=(double *)malloc(ord*NB*sizeof(double)))) { fprintf(stderr,"error in gammatone_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(T=(double *)malloc(NT*NB*sizeof(double)))) { fprintf(stderr,"error in gammatone_d: problem with malloc. "); perror("malloc"); return 1; }
+
+        //Get poles and gains
+        if (gammatone_cfs_d(cfs,NB,fmin,fmax)) { fprintf(stderr,"error in gammatone_d: problem with gammatone_cfs_d\n"); return 1; }
+        const double bwc = gammatone_bwc(ord);
+        for (size_t b=0u; b<NB; ++b)
+        {
+            const double bw = (24.7+0.108*(double)cfs[b]) / bwc;
+            const double r = exp(-2.0*M_PI*bw/(double)fs), w = 2.0*M_PI*(double)cfs[b]/(double)fs;
+            ar[b] = (double)(r*cos(w)); ai[b] = (double)(r*sin(w));
+            g[b] = (double)(2.0*pow(1.0-r,(double)ord));
+        }
+
+        //Initialize states
+        if (Z) { for (size_t k=0u; k<ord*NB; ++k) { zr[k] = Z[2u*k]; zi[k] = Z[2u*k+1u]; } }
+        else { for (size_t k=0u; k<ord*NB; ++k) { zr[k] = zi[k] = 0.0; } }
+
+        for (size_t n0=0u; n0<N; n0+=NT)
+        {
+            const size_t nt = (N-n0<NT) ? N-n0 : NT;
+
+            for (size_t n=0u; n<nt; ++n)
+            {
+                //First stage (real input)
+                const double x = X[n0+n];
+                for (size_t b=0u; b<NB; ++b)
+                {
+                    const double tr = x + ar[b]*zr[b] - ai[b]*zi[b];
+                    zi[b] = ar[b]*zi[b] + ai[b]*zr[b];
+                    zr[b] = tr;
+                }
+
+                //Other stages (input is the new output of the previous stage)
+                for (size_t k=1u; k<ord; ++k)
+                {
+                    const double *ur = &zr[(k-1u)*NB], *ui = &zi[(k-1u)*NB];
+                    double *vr = &zr[k*NB], *vi = &zi[k*NB];
+                    for (size_t b=0u; b<NB; ++b)
+                    {
+                        const double tr = ur[b] + ar[b]*vr[b] - ai[b]*vi[b];
+                        vi[b] = ui[b] + ar[b]*vi[b] + ai[b]*vr[b];
+                        vr[b] = tr;
+                    }
+                }
+
+                //Output of the last stage
+                const double *ur = &zr[(ord-1u)*NB], *ui = &zi[(ord-1u)*NB];
+                double *t = &T[n*NB];
+                if (otyp==0u)
+                {
+                    for (size_t b=0u; b<NB; ++b) { t[b] = g[b] * ur[b]; }
+                }
+                else if (otyp==1u)
+                {
+                    for (size_t b=0u; b<NB; ++b) { t[b] = g[b] * sqrt(ur[b]*ur[b]+ui[b]*ui[b]); }
+                }
+                else
+                {
+                    for (size_t b=0u; b<NB; ++b) { t[b] = (ur[b]>0.0) ? g[b]*ur[b] : 0.0; }
+                }
+            }
+
+            //Transpose the block into Y (each channel contiguous)
+            for (size_t b=0u; b<NB; ++b)
+            {
+                for (size_t n=0u; n<nt; ++n) { Y[b*N+n0+n] = T[n*NB+b]; }
+            }
+        }
+
+        //Save states
+        if (Z) { for (size_t k=0u; k<ord*NB; ++k) { Z[2u*k] = zr[k]; Z[2u*k+1u] = zi[k]; } }
+
+        free(cfs); free(ar); free(ai); free(g); free(zr); free(zi); free(T);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,383 @@
+//GCC-PHAT (generalized cross-correlation with phase transform) time-delay estimation,
+//for each pair of channels in X, frame-by-frame, as for the TDOAs of a microphone array.
+
+//X has Nch channels of length N, and each channel is framed and windowed as in stft,
+//using window Wn (length L), step size stp, and the Kaldi snip_edges convention.
+//The samples of each channel must be contiguous in memory, i.e. memory order is Nch x N.
+
+//For each frame, all channels are transformed (FFT) in one plan_many batch.
+//Then, for each pair of channels i<j, in the order (0,1) (0,2) ... (0,Nch-1) (1,2) ... (Nch-2,Nch-1),
+//the weighted cross-spectrum is formed: G = Xi.*conj(Xj) * wt,
+//where the weighting (wt) is one of:
+//0: none (plain cross-correlation)
+//1: PHAT (phase transform), wt = 1/|Xi.*conj(Xj)|
+//2: SCOT (smoothed coherence transform), wt = 1/sqrt(Pi.*Pj),
+//   where Pi is the power spectrum of channel i averaged over all frames (this takes an extra pass).
+//The cross-spectra are inverse transformed in batches of up to 16 pairs (one plan_many IFFT each).
+
+//The TDOA is the lag m in [-M M] that maximizes the GCC: Rij[m] = sum_n xi[n+m]*xj[n].
+//So a positive TDOA means that channel i is delayed relative to channel j.
+//The peak is refined to a sub-sample lag by interp:
+//0: none (integer lag)
+//1: parabolic interpolation through the 3 samples around the peak
+//2: sinc (band-limited) interpolation, by Newton iterations on R(tau) evaluated from G directly,
+//   starting from the parabolic estimate.
+
+//Y has memory order W x P, where W is the number of frames (as in stft), and P = Nch*(Nch-1)/2.
+//So the TDOAs (in samples) of one frame are contiguous in memory.
+
+//The FFT length nfft must be >= L, and >= 2*M+2.
+//Use nfft >= L+M to avoid circular wrap of the GCC within the lag window.
+
+#include <stdio.h>
+#include <math.h>
+#include <fftw3.h>
+
+#ifndef M_PI
+   #define M_PI 3.141592653589793238462643383279502884
+#endif
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void gcc_phat_frame_s (float *Xw, const float *X, const float *Wn, const size_t N, const size_t L, const size_t nfft, const int ss);
+static void gcc_phat_frame_d (double *Xw, const double *X, const double *Wn, const size_t N, const size_t L, const size_t nfft, const int ss);
+static float gcc_phat_peak_s (const float *R, const float *G, const size_t nfft, const size_t M, const int interp);
+static double gcc_phat_peak_d (const double *R, const double *G, const size_t nfft, const size_t M, const int interp);
+
+int gcc_phat_s (float *Y, const float *X, const float *Wn, const size_t Nch, const size_t N, const size_t L, const size_t nfft, const size_t stp, const int snip_edges, const size_t M, const int wt, const int interp);
+int gcc_phat_d (double *Y, const double *X, const double *Wn, const size_t Nch, const size_t N, const size_t L, const size_t nfft, const size_t stp, const int snip_edges, const size_t M, const int wt, const int interp);
+
+
+static void gcc_phat_frame_s (float *Xw, const float *X, const float *Wn, const size_t N, const size_t L, const size_t nfft, const int ss)
+{
+    if (ss<0 || ss+(int)L>(int)N)
+    {
+        for (size_t l=0u; l<L; ++l)
+        {
+            int n = ss + (int)l; //This ensures extrapolation by signal reversal to any length
+            while (n<0 || n>=(int)N) { n = (n<0) ? -n-1 : 2*(int)N-1-n; }
+            Xw[l] = X[n] * Wn[l];
+        }
+    }
+    else
+    {
+        X += ss;
+        for (size_t l=0u; l<L; ++l) { Xw[l] = X[l] * Wn[l]; }
+    }
+    for (size_t l=L; l<nfft; ++l) { Xw[l] = 0.0f; }
+}
+
+
+static void gcc_phat_frame_d (double *Xw, const double *X, const double *Wn, const size_t N, const size_t L, const size_t nfft, const int ss)
+{
+    if (ss<0 || ss+(int)L>(int)N)
+    {
+        for (size_t l=0u; l<L; ++l)
+        {
+            int n = ss + (int)l; //This ensures extrapolation by signal reversal to any length
+            while (n<0 || n>=(int)N) { n = (n<0) ? -n-1 : 2*(int)N-1-n; }
+            Xw[l] = X[n] * Wn[l];
+        }
+    }
+    else
+    {
+        X += ss;
+        for (size_t l=0u; l<L; ++l) { Xw[l] = X[l] * Wn[l]; }
+    }
+    for (size_t l=L; l<nfft; ++l) { Xw[l] = 0.0; }
+}
+
+
+static float gcc_phat_peak_s (const float *R, const float *G, const size_t nfft, const size_t M, const int interp)
+{
+    //Integer peak over lags -M to M (lag m is at R[m] or R[nfft+m])
+    size_t mx = 0u;
+    float rmx = R[0];
+    for (size_t m=1u; m<=M; ++m)
+    {
+        if (R[m]>rmx) { rmx = R[m]; mx = m; }
+        if (R[nfft-m]>rmx) { rmx = R[nfft-m]; mx = nfft-m; }
+    }
+    float tau = (mx<=M) ? (float)mx : -(float)(nfft-mx);
+    if (interp==0) { return tau; }
+
+    //Parabolic
+    const float ra = R[(mx+nfft-1u)%nfft], rb = R[(mx+1u)%nfft];
+    const float den = ra - 2.0f*rmx + rb;
+    const float d = (den<0.0f) ? 0.5f*(ra-rb)/den : 0.0f;
+    if (interp==1) { return tau + d; }
+
+    //Sinc: Newton iterations on R(t) = sum_f a_f*Re(G[f]*exp(j*dw*f*t)), with a_f = 1 (DC, and Nyquist if nfft is even) or 2.
+    //The exp(j*dw*f*t) are made by a rotation recurrence, so there is one cos/sin per iteration.
+    const size_t F = nfft/2u + 1u;
+    const float dw = (float)(2.0*M_PI) / (float)nfft;
+    const float m0 = tau;
+    float t = tau + d, zr, zi, er, ei, cr, ci, tmp, r1, r2, af;
+    for (int it=0; it<3; ++it)
+    {
+        er = cosf(dw*t); ei = sinf(dw*t);
+        cr = 1.0f; ci = 0.0f;
+        r1 = r2 = 0.0f;
+        for (size_t f=0u; f<F; ++f)
+        {
+            af = (f==0u || (nfft%2u==0u && f==F-1u)) ? (float)f : 2.0f*(float)f;
+            zr = G[2u*f]*cr - G[2u*f+1u]*ci;
+            zi = G[2u*f]*ci + G[2u*f+1u]*cr;
+            r1 -= af * zi;
+            r2 -= af * (float)f * zr;
+            tmp = cr*er - ci*ei; ci = cr*ei + ci*er; cr = tmp;
+        }
+        if (r2>=0.0f) { break; }
+        t -= r1 / (dw*r2);
+        if (t<m0-1.0f) { t = m0 - 1.0f; }
+        else if (t>m0+1.0f) { t = m0 + 1.0f; }
+    }
+
+    return t;
+}
+
+
+static double gcc_phat_peak_d (const double *R, const double *G, const size_t nfft, const size_t M, const int interp)
+{
+    //Integer peak over lags -M to M (lag m is at R[m] or R[nfft+m])
+    size_t mx = 0u;
+    double rmx = R[0];
+    for (size_t m=1u; m<=M; ++m)
+    {
+        if (R[m]>rmx) { rmx = R[m]; mx = m; }
+        if (R[nfft-m]>rmx) { rmx = R[nfft-m]; mx = nfft-m; }
+    }
+    double tau = (mx<=M) ? (double)mx : -(double)(nfft-mx);
+    if (interp==0) { return tau; }
+
+    //Parabolic
+    const double ra = R[(mx+nfft-1u)%nfft], rb = R[(mx+1u)%nfft];
+    const double den = ra - 2.0*rmx + rb;
+    const double d = (den<0.0) ? 0.5*(ra-rb)/den : 0.0;
+    if (interp==1) { return tau + d; }
+
+    //Sinc: Newton iterations on R(t) = sum_f a_f*Re(G[f]*exp(j*dw*f*t)), with a_f = 1 (DC, and Nyquist if nfft is even) or 2.
+    //The exp(j*dw*f*t) are made by a rotation recurrence, so there is one cos/sin per iteration.
+    const size_t F = nfft/2u + 1u;
+    const double dw = (double)(2.0*M_PI) / (double)nfft;
+    const double m0 = tau;
+    double t = tau + d, zr, zi, er, ei, cr, ci, tmp, r1, r2, af;
+    for (int it=0; it<3; ++it)
+    {
+        er = cos(dw*t); ei = sin(dw*t);
+        cr = 1.0; ci = 0.0;
+        r1 = r2 = 0.0;
+        for (size_t f=0u; f<F; ++f)
+        {
+            af = (f==0u || (nfft%2u==0u && f==F-1u)) ? (double)f : 2.0*(double)f;
+            zr = G[2u*f]*cr - G[2u*f+1u]*ci;
+            zi = G[2u*f]*ci + G[2u*f+1u]*cr;
+            r1 -= af * zi;
+            r2 -= af * (double)f * zr;
+            tmp = cr*er - ci*ei; ci = cr*ei + ci*er; cr = tmp;
+        }
+        if (r2>=0.0) { break; }
+        t -= r1 / (dw*r2);
+        if (t<m0-1.0) { t = m0 - 1.0; }
+        else if (t>m0+1.0) { t = m0 + 1.0; }
+    }
+
+    return t;
+}
+
+
+int gcc_phat_s (float *Y, const float *X, const float *Wn, const size_t Nch, const size_t N, const size_t L, const size_t nfft, const size_t stp, const int snip_edges, const size_t M, const int wt, const int interp)
+{
+    if (Nch<2u) { fprintf(stderr,"error in gcc_phat_s: Nch (num channels) must be > 1\n"); return 1; }
+    if (L<1u) { fprintf(stderr,"error in gcc_phat_s: L (winlength) must be positive\n"); return 1; }
+    if (stp<1u) { fprintf(stderr,"error in gcc_phat_s: stp (step size) must be positive\n"); return 1; }
+    if (nfft<L) { fprintf(stderr,"error in gcc_phat_s: nfft must be >= L (winlength)\n"); return 1; }
+    if (2u*M+2u>nfft) { fprintf(stderr,"error in gcc_phat_s: nfft must be >= 2*M+2\n"); return 1; }
+    if (snip_edges && L>N) { fprintf(stderr,"error in gcc_phat_s: L must be <= N if snip_edges\n"); return 1; }
+    if (wt<0 || wt>2) { fprintf(stderr,"error in gcc_phat_s: wt must be in {0,1,2}\n"); return 1; }
+    if (interp<0 || interp>2) { fprintf(stderr,"error in gcc_phat_s: interp must be in {0,1,2}\n"); return 1; }
+
+    //Set number of frames (W), as in stft
+    const size_t W = (snip_edges) ? 1u+(N-L)/stp : (N+stp/2u)/stp;
+
+    if (W==0u || N==0u) {}
+    else
+    {
+        const size_t F = nfft/2u + 1u, P = Nch*(Nch-1u)/2u;
+        const size_t NT = (P<16u) ? P : 16u;
+        const int n[1] = {(int)nfft};
+        const int ss0 = (snip_edges) ? 0 : (int)(stp/2u) - (int)(L/2u);
+        float xr, xi, yr, yi, gr, gi, g;
+
+        //Initialize FFTs
+        float *Xb, *Fx, *Fy, *Yb, *Sc = NULL;
+        Xb = (float *)fftwf_malloc(Nch*nfft*sizeof(float));
+        Fx = (float *)fftwf_malloc(Nch*2u*F*sizeof(float));
+        Fy = (float *)fftwf_malloc(NT*2u*F*sizeof(float));
+        Yb = (float *)fftwf_malloc(NT*nfft*sizeof(float));
+        if (!Xb || !Fx || !Fy || !Yb) { fprintf(stderr,"error in gcc_phat_s: problem with fftwf_malloc. "); perror("fftwf_malloc"); return 1; }
+        fftwf_plan fplan = fftwf_plan_many_dft_r2c(1,n,(int)Nch,Xb,NULL,1,(int)nfft,(fftwf_complex *)Fx,NULL,1,(int)F,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in gcc_phat_s: problem creating fftw plan"); return 1; }
+        fftwf_plan iplan = fftwf_plan_many_dft_c2r(1,n,(int)NT,(fftwf_complex *)Fy,NULL,1,(int)F,Yb,NULL,1,(int)nfft,(interp==2) ? FFTW_ESTIMATE|FFTW_PRESERVE_INPUT : FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in gcc_phat_s: problem creating fftw plan"); return 1; }
+        for (size_t f=0u; f<NT*2u*F; ++f) { Fy[f] = 0.0f; }
+
+        //SCOT: 1/sqrt of mean power spectrum of each channel (extra pass over frames)
+        if (wt==2)
+        {
+            if (!(Sc=(float *)fftwf_malloc(Nch*F*sizeof(float)))) { fprintf(stderr,"error in gcc_phat_s: problem with fftwf_malloc. "); perror("fftwf_malloc"); return 1; }
+            for (size_t f=0u; f<Nch*F; ++f) { Sc[f] = 0.0f; }
+            for (size_t w=0u; w<W; ++w)
+            {
+                for (size_t c=0u; c<Nch; ++c) { gcc_phat_frame_s(&Xb[c*nfft],&X[c*N],Wn,N,L,nfft,ss0+(int)(w*stp)); }
+                fftwf_execute(fplan);
+                for (size_t f=0u; f<Nch*F; ++f) { Sc[f] += Fx[2u*f]*Fx[2u*f] + Fx[2u*f+1u]*Fx[2u*f+1u]; }
+            }
+            for (size_t f=0u; f<Nch*F; ++f) { Sc[f] = (Sc[f]>0.0f) ? 1.0f/sqrtf(Sc[f]/(float)W) : 0.0f; }
+        }
+
+        for (size_t w=0u; w<W; ++w)
+        {
+            //FFT of all channels
+            for (size_t c=0u; c<Nch; ++c) { gcc_phat_frame_s(&Xb[c*nfft],&X[c*N],Wn,N,L,nfft,ss0+(int)(w*stp)); }
+            fftwf_execute(fplan);
+
+            //Weighted cross-spectra and IFFT in batches of NT pairs
+            size_t b = 0u;
+            for (size_t i=0u; i<Nch-1u; ++i)
+            {
+                for (size_t j=i+1u; j<Nch; ++j)
+                {
+                    const float *fi = &Fx[2u*i*F], *fj = &Fx[2u*j*F];
+                    float *fy = &Fy[2u*b*F];
+                    for (size_t f=0u; f<F; ++f)
+                    {
+                        xr = fi[2u*f]; xi = fi[2u*f+1u];
+                        yr = fj[2u*f]; yi = fj[2u*f+1u];
+                        gr = xr*yr + xi*yi; gi = xi*yr - xr*yi;
+                        if (wt==1) { g = sqrtf(gr*gr+gi*gi); g = (g>0.0f) ? 1.0f/g : 0.0f; }
+                        else if (wt==2) { g = Sc[i*F+f] * Sc[j*F+f]; }
+                        else { g = 1.0f; }
+                        fy[2u*f] = g * gr; fy[2u*f+1u] = g * gi;
+                    }
+                    if (++b==NT || i==Nch-2u)
+                    {
+                        if (i==Nch-2u && b<NT) { for (size_t f=2u*b*F; f<NT*2u*F; ++f) { Fy[f] = 0.0f; } }
+                        fftwf_execute(iplan);
+                        for (size_t t=0u; t<b; ++t, ++Y) { *Y = gcc_phat_peak_s(&Yb[t*nfft],&Fy[2u*t*F],nfft,M,interp); }
+                        b = 0u;
+                    }
+                }
+            }
+        }
+
+        fftwf_free(Xb); fftwf_free(Fx); fftwf_free(Fy); fftwf_free(Yb);
+        if (wt==2) { fftwf_free(Sc); }
+        fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int gcc_phat_d (double *Y, const double *X, const double *Wn, const size_t Nch, const size_t N, const size_t L, const size_t nfft, const size_t stp, const int snip_edges, const size_t M, const int wt, const int interp)
+{
+    if (Nch<2u) { fprintf(stderr,"error in gcc_phat_d: Nch (num channels) must be > 1\n"); return 1; }
+    if (L<1u) { fprintf(stderr,"error in gcc_phat_d: L (winlength) must be positive\n"); return 1; }
+    if (stp<1u) { fprintf(stderr,"error in gcc_phat_d: stp (step size) must be positive\n"); return 1; }
+    if (nfft<L) { fprintf(stderr,"error in gcc_phat_d: nfft must be >= L (winlength)\n"); return 1; }
+    if (2u*M+2u>nfft) { fprintf(stderr,"error in gcc_phat_d: nfft must be >= 2*M+2\n"); return 1; }
+    if (snip_edges && L>N) { fprintf(stderr,"error in gcc_phat_d: L must be <= N if snip_edges\n"); return 1; }
+    if (wt<0 || wt>2) { fprintf(stderr,"error in gcc_phat_d: wt must be in {0,1,2}\n"); return 1; }
+    if (interp<0 || interp>2) { fprintf(stderr,"error in gcc_phat_d: interp must be in {0,1,2}\n"); return 1; }
+
+    //Set number of frames (W), as in stft
+    const size_t W = (snip_edges) ? 1u+(N-L)/stp : (N+stp/2u)/stp;
+
+    if (W==0u || N==0u) {}
+    else
+    {
+        const size_t F = nfft/2u + 1u, P = Nch*(Nch-1u)/2u;
+        const size_t NT = (P<16u) ? P : 16u;
+        const int n[1] = {(int)nfft};
+        const int ss0 = (snip_edges) ? 0 : (int)(stp/2u) - (int)(L/2u);
+        double xr, xi, yr, yi, gr, gi, g;
+
+        //Initialize FFTs
+        double *Xb, *Fx, *Fy, *Yb, *Sc = NULL;
+        Xb = (double *)fftw_malloc(Nch*nfft*sizeof(double));
+        Fx = (double *)fftw_malloc(Nch*2u*F*sizeof(double));
+        Fy = (double *)fftw_malloc(NT*2u*F*sizeof(double));
+        Yb = (double *)fftw_malloc(NT*nfft*sizeof(double));
+        if (!Xb || !Fx || !Fy || !Yb) { fprintf(stderr,"error in gcc_phat_d: problem with fftw_malloc. "); perror("fftw_malloc"); return 1; }
+        fftw_plan fplan = fftw_plan_many_dft_r2c(1,n,(int)Nch,Xb,NULL,1,(int)nfft,(fftw_complex *)Fx,NULL,1,(int)F,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in gcc_phat_d: problem creating fftw plan"); return 1; }
+        fftw_plan iplan = fftw_plan_many_dft_c2r(1,n,(int)NT,(fftw_complex *)Fy,NULL,1,(int)F,Yb,NULL,1,(int)nfft,(interp==2) ? FFTW_ESTIMATE|FFTW_PRESERVE_INPUT : FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in gcc_phat_d: problem creating fftw plan"); return 1; }
+        for (size_t f=0u; f<NT*2u*F; ++f) { Fy[f] = 0.0; }
+
+        //SCOT: 1/sqrt of mean power spectrum of each channel (extra pass over frames)
+        if (wt==2)
+        {
+            if (!(Sc=(double *)fftw_malloc(Nch*F*sizeof(double)))) { fprintf(stderr,"error in gcc_phat_d: problem with fftw_malloc. "); perror("fftw_malloc"); return 1; }
+            for (size_t f=0u; f<Nch*F; ++f) { Sc[f] = 0.0; }
+            for (size_t w=0u; w<W; ++w)
+            {
+                for (size_t c=0u; c<Nch; ++c) { gcc_phat_frame_d(&Xb[c*nfft],&X[c*N],Wn,N,L,nfft,ss0+(int)(w*stp)); }
+                fftw_execute(fplan);
+                for (size_t f=0u; f<Nch*F; ++f) { Sc[f] += Fx[2u*f]*Fx[2u*f] + Fx[2u*f+1u]*Fx[2u*f+1u]; }
+            }
+            for (size_t f=0u; f<Nch*F; ++f) { Sc[f] = (Sc[f]>0.0) ? 1.0/sqrt(Sc[f]/(double)W) : 0.0; }
+        }
+
+        for (size_t w=0u; w<W; ++w)
+        {
+            //FFT of all channels
+            for (size_t c=0u; c<Nch; ++c) { gcc_phat_frame_d(&Xb[c*nfft],&X[c*N],Wn,N,L,nfft,ss0+(int)(w*stp)); }
+            fftw_execute(fplan);
+
+            //Weighted cross-spectra and IFFT in batches of NT pairs
+            size_t b = 0u;
+            for (size_t i=0u; i<Nch-1u; ++i)
+            {
+                for (size_t j=i+1u; j<Nch; ++j)
+                {
+                    const double *fi = &Fx[2u*i*F], *fj = &Fx[2u*j*F];
+                    double *fy = &Fy[2u*b*F];
+                    for (size_t f=0u; f<F; ++f)
+                    {
+                        xr = fi[2u*f]; xi = fi[2u*f+1u];
+                        yr = fj[2u*f]; yi = fj[2u*f+1u];
+                        gr = xr*yr + xi*yi; gi = xi*yr - xr*yi;
+                        if (wt==1) { g = sqrt(gr*gr+gi*gi); g = (g>0.0) ? 1.0/g : 0.0; }
+                        else if (wt==2) { g = Sc[i*F+f] * Sc[j*F+f]; }
+                        else { g = 1.0; }
+                        fy[2u*f] = g * gr; fy[2u*f+1u] = g * gi;
+                    }
+                    if (++b==NT || i==Nch-2u)
+                    {
+                        if (i==Nch-2u && b<NT) { for (size_t f=2u*b*F; f<NT*2u*F; ++f) { Fy[f] = 0.0; } }
+                        fftw_execute(iplan);
+                        for (size_t t=0u; t<b; ++t, ++Y) { *Y = gcc_phat_peak_d(&Yb[t*nfft],&Fy[2u*t*F],nfft,M,interp); }
+                        b = 0u;
+                    }
+                }
+            }
+        }
+
+        fftw_free(Xb); fftw_free(Fx); fftw_free(Fy); fftw_free(Yb);
+        if (wt==2) { fftw_free(Sc); }
+        fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,379 @@
+//Band-limited interpolation of each vector in X along dim,
+//by zero-padding (or truncating) in the frequency domain.
+//This emulates interpft of Octave, and resample of SciPy (without window).
+
+//Each vector in X has length L, and each vector in Y has length Ly,
+//where Ly can be any positive integer (so any fractional upsampling
+//or downsampling ratio Ly/L). Non-power-of-2 lengths are fine.
+//For even lengths, the Nyquist bin is split (upsampling) or folded (downsampling)
+//so that the output is real for real X and exactly periodic.
+
+//The FFTs are batched over vectors (one forward and one inverse plan_many per call),
+//so interpolation of many short vectors costs 2 batched FFTs instead of sinc loops.
+//For vectors interleaved in memory (e.g., rows of a col-major matrix),
+//the batch uses the stride of the data, so no transposes are needed.
+
+#include <stdio.h>
+#include <fftw3.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+int interp1ft_s (float *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Ly, const size_t dim);
+int interp1ft_d (double *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Ly, const size_t dim);
+int interp1ft_c (float *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Ly, const size_t dim);
+int interp1ft_z (double *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Ly, const size_t dim);
+
+
+int interp1ft_s (float *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Ly, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in interp1ft_s: dim must be in [0 3]\n"); return 1; }
+    if (Ly<1u) { fprintf(stderr,"error in interp1ft_s: Ly (length of vecs in Y) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t V = N/L;
+        const size_t Fx = L/2u + 1u, Fy = Ly/2u + 1u;
+        const size_t Nn = (L<Ly) ? L : Ly, nyq = Nn/2u + 1u;
+        const float sc = 1.0f / (float)L;
+        size_t st, hm, nb;      //stride, howmany and number of batches
+
+        //Set batch layout
+        if (L==N) { st = 1u; hm = 1u; nb = 1u; }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t G = V/BS;
+            if (K==1u && (G==1u || BS==1u)) { st = 1u; hm = V; nb = 1u; }
+            else { st = K; hm = K; nb = G; }
+        }
+        const size_t xd = (st==1u) ? L : 1u, yd = (st==1u) ? Ly : 1u;
+        const size_t fxd = (st==1u) ? Fx : 1u, fyd = (st==1u) ? Fy : 1u;
+
+        //Initialize fftwf
+        float *Xb, *Fxb, *Fyb, *Yb;
+        Xb = (float *)fftwf_malloc(L*hm*sizeof(float));
+        Fxb = (float *)fftwf_malloc(2u*Fx*hm*sizeof(float));
+        Fyb = (float *)fftwf_malloc(2u*Fy*hm*sizeof(float));
+        Yb = (float *)fftwf_malloc(Ly*hm*sizeof(float));
+        if (!Xb || !Fxb || !Fyb || !Yb) { fprintf(stderr,"error in interp1ft_s: problem with fftwf_malloc\n"); return 1; }
+        const int nx = (int)L, ny = (int)Ly;
+        fftwf_plan fplan = fftwf_plan_many_dft_r2c(1,&nx,(int)hm,Xb,NULL,(int)st,(int)xd,(fftwf_complex *)Fxb,NULL,(int)st,(int)fxd,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in interp1ft_s: problem creating fftw plan\n"); return 1; }
+        fftwf_plan iplan = fftwf_plan_many_dft_c2r(1,&ny,(int)hm,(fftwf_complex *)Fyb,NULL,(int)st,(int)fyd,Yb,NULL,(int)st,(int)yd,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in interp1ft_s: problem creating fftw plan\n"); return 1; }
+
+        for (size_t b=nb; b>0u; --b, X+=L*hm, Y+=Ly*hm)
+        {
+            for (size_t n=0u; n<L*hm; ++n) { Xb[n] = X[n]; }
+            fftwf_execute(fplan);
+
+            //Zero-pad or truncate the spectrum of each vector
+            for (size_t f=0u; f<Fy; ++f)
+            {
+                float *fy = Fyb + 2u*f*st;
+                if (f<nyq)
+                {
+                    const float *fx = Fxb + 2u*f*st;
+                    for (size_t h=0u; h<hm; ++h) { fy[2u*h*fyd] = fx[2u*h*fxd]; fy[2u*h*fyd+1u] = fx[2u*h*fxd+1u]; }
+                }
+                else
+                {
+                    for (size_t h=0u; h<hm; ++h) { fy[2u*h*fyd] = fy[2u*h*fyd+1u] = 0.0f; }
+                }
+            }
+
+            //Nyquist bin
+            if (Nn%2u==0u && L!=Ly)
+            {
+                float *fy = Fyb + Nn*st;
+                const float g = (Ly<L) ? 2.0f : 0.5f;
+                for (size_t h=0u; h<hm; ++h) { fy[2u*h*fyd] *= g; fy[2u*h*fyd+1u] *= g; }
+            }
+
+            fftwf_execute(iplan);
+            for (size_t n=0u; n<Ly*hm; ++n) { Y[n] = sc * Yb[n]; }
+        }
+
+        fftwf_free(Xb); fftwf_free(Fxb); fftwf_free(Fyb); fftwf_free(Yb);
+        fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int interp1ft_d (double *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Ly, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in interp1ft_d: dim must be in [0 3]\n"); return 1; }
+    if (Ly<1u) { fprintf(stderr,"error in interp1ft_d: Ly (length of vecs in Y) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t V = N/L;
+        const size_t Fx = L/2u + 1u, Fy = Ly/2u + 1u;
+        const size_t Nn = (L<Ly) ? L : Ly, nyq = Nn/2u + 1u;
+        const double sc = 1.0 / (double)L;
+        size_t st, hm, nb;      //stride, howmany and number of batches
+
+        //Set batch layout
+        if (L==N) { st = 1u; hm = 1u; nb = 1u; }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t G = V/BS;
+            if (K==1u && (G==1u || BS==1u)) { st = 1u; hm = V; nb = 1u; }
+            else { st = K; hm = K; nb = G; }
+        }
+        const size_t xd = (st==1u) ? L : 1u, yd = (st==1u) ? Ly : 1u;
+        const size_t fxd = (st==1u) ? Fx : 1u, fyd = (st==1u) ? Fy : 1u;
+
+        //Initialize fftwf
+        double *Xb, *Fxb, *Fyb, *Yb;
+        Xb = (double *)fftw_malloc(L*hm*sizeof(double));
+        Fxb = (double *)fftw_malloc(2u*Fx*hm*sizeof(double));
+        Fyb = (double *)fftw_malloc(2u*Fy*hm*sizeof(double));
+        Yb = (double *)fftw_malloc(Ly*hm*sizeof(double));
+        if (!Xb || !Fxb || !Fyb || !Yb) { fprintf(stderr,"error in interp1ft_d: problem with fftw_malloc\n"); return 1; }
+        const int nx = (int)L, ny = (int)Ly;
+        fftw_plan fplan = fftw_plan_many_dft_r2c(1,&nx,(int)hm,Xb,NULL,(int)st,(int)xd,(fftw_complex *)Fxb,NULL,(int)st,(int)fxd,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in interp1ft_d: problem creating fftw plan\n"); return 1; }
+        fftw_plan iplan = fftw_plan_many_dft_c2r(1,&ny,(int)hm,(fftw_complex *)Fyb,NULL,(int)st,(int)fyd,Yb,NULL,(int)st,(int)yd,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in interp1ft_d: problem creating fftw plan\n"); return 1; }
+
+        for (size_t b=nb; b>0u; --b, X+=L*hm, Y+=Ly*hm)
+        {
+            for (size_t n=0u; n<L*hm; ++n) { Xb[n] = X[n]; }
+            fftw_execute(fplan);
+
+            //Zero-pad or truncate the spectrum of each vector
+            for (size_t f=0u; f<Fy; ++f)
+            {
+                double *fy = Fyb + 2u*f*st;
+                if (f<nyq)
+                {
+                    const double *fx = Fxb + 2u*f*st;
+                    for (size_t h=0u; h<hm; ++h) { fy[2u*h*fyd] = fx[2u*h*fxd]; fy[2u*h*fyd+1u] = fx[2u*h*fxd+1u]; }
+                }
+                else
+                {
+                    for (size_t h=0u; h<hm; ++h) { fy[2u*h*fyd] = fy[2u*h*fyd+1u] = 0.0; }
+                }
+            }
+
+            //Nyquist bin
+            if (Nn%2u==0u && L!=Ly)
+            {
+                double *fy = Fyb + Nn*st;
+                const double g = (Ly<L) ? 2.0 : 0.5;
+                for (size_t h=0u; h<hm; ++h) { fy[2u*h*fyd] *= g; fy[2u*h*fyd+1u] *= g; }
+            }
+
+            fftw_execute(iplan);
+            for (size_t n=0u; n<Ly*hm; ++n) { Y[n] = sc * Yb[n]; }
+        }
+
+        fftw_free(Xb); fftw_free(Fxb); fftw_free(Fyb); fftw_free(Yb);
+        fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int interp1ft_c (float *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Ly, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in interp1ft_c: dim must be in [0 3]\n"); return 1; }
+    if (Ly<1u) { fprintf(stderr,"error in interp1ft_c: Ly (length of vecs in Y) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t V = N/L;
+        const size_t Nn = (L<Ly) ? L : Ly, nyq = Nn/2u + 1u, nng = (Nn-1u)/2u;
+        const float sc = 1.0f / (float)L;
+        size_t st, hm, nb;      //stride, howmany and number of batches
+
+        //Set batch layout
+        if (L==N) { st = 1u; hm = 1u; nb = 1u; }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t G = V/BS;
+            if (K==1u && (G==1u || BS==1u)) { st = 1u; hm = V; nb = 1u; }
+            else { st = K; hm = K; nb = G; }
+        }
+        const size_t xd = (st==1u) ? L : 1u, yd = (st==1u) ? Ly : 1u;
+
+        //Initialize fftwf
+        float *Xb, *Fxb, *Fyb, *Yb;
+        Xb = (float *)fftwf_malloc(2u*L*hm*sizeof(float));
+        Fxb = (float *)fftwf_malloc(2u*L*hm*sizeof(float));
+        Fyb = (float *)fftwf_malloc(2u*Ly*hm*sizeof(float));
+        Yb = (float *)fftwf_malloc(2u*Ly*hm*sizeof(float));
+        if (!Xb || !Fxb || !Fyb || !Yb) { fprintf(stderr,"error in interp1ft_c: problem with fftwf_malloc\n"); return 1; }
+        const int nx = (int)L, ny = (int)Ly;
+        fftwf_plan fplan = fftwf_plan_many_dft(1,&nx,(int)hm,(fftwf_complex *)Xb,NULL,(int)st,(int)xd,(fftwf_complex *)Fxb,NULL,(int)st,(int)xd,FFTW_FORWARD,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in interp1ft_c: problem creating fftw plan\n"); return 1; }
+        fftwf_plan iplan = fftwf_plan_many_dft(1,&ny,(int)hm,(fftwf_complex *)Fyb,NULL,(int)st,(int)yd,(fftwf_complex *)Yb,NULL,(int)st,(int)yd,FFTW_BACKWARD,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in interp1ft_c: problem creating fftw plan\n"); return 1; }
+
+        for (size_t b=nb; b>0u; --b, X+=2u*L*hm, Y+=2u*Ly*hm)
+        {
+            for (size_t n=0u; n<2u*L*hm; ++n) { Xb[n] = X[n]; }
+            fftwf_execute(fplan);
+
+            //Zero-pad or truncate the spectrum of each vector (pos freqs, then neg freqs)
+            for (size_t f=0u; f<Ly; ++f)
+            {
+                float *fy = Fyb + 2u*f*st;
+                if (f<nyq || Ly-f<=nng)
+                {
+                    const float *fx = Fxb + 2u*((f<nyq) ? f : L-(Ly-f))*st;
+                    for (size_t h=0u; h<hm; ++h) { fy[2u*h*yd] = fx[2u*h*xd]; fy[2u*h*yd+1u] = fx[2u*h*xd+1u]; }
+                }
+                else
+                {
+                    for (size_t h=0u; h<hm; ++h) { fy[2u*h*yd] = fy[2u*h*yd+1u] = 0.0f; }
+                }
+            }
+
+            //Nyquist bin
+            if (Nn%2u==0u && Ly<L)
+            {
+                float *fy = Fyb + Nn*st;
+                const float *fx = Fxb + 2u*(L-Nn/2u)*st;
+                for (size_t h=0u; h<hm; ++h) { fy[2u*h*yd] += fx[2u*h*xd]; fy[2u*h*yd+1u] += fx[2u*h*xd+1u]; }
+            }
+            else if (Nn%2u==0u && L<Ly)
+            {
+                float *fy = Fyb + Nn*st, *fn = Fyb + 2u*(Ly-Nn/2u)*st;
+                for (size_t h=0u; h<hm; ++h)
+                {
+                    fy[2u*h*yd] *= 0.5f; fy[2u*h*yd+1u] *= 0.5f;
+                    fn[2u*h*yd] = fy[2u*h*yd]; fn[2u*h*yd+1u] = fy[2u*h*yd+1u];
+                }
+            }
+
+            fftwf_execute(iplan);
+            for (size_t n=0u; n<2u*Ly*hm; ++n) { Y[n] = sc * Yb[n]; }
+        }
+
+        fftwf_free(Xb); fftwf_free(Fxb); fftwf_free(Fyb); fftwf_free(Yb);
+        fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int interp1ft_z (double *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Ly, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in interp1ft_z: dim must be in [0 3]\n"); return 1; }
+    if (Ly<1u) { fprintf(stderr,"error in interp1ft_z: Ly (length of vecs in Y) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t V = N/L;
+        const size_t Nn = (L<Ly) ? L : Ly, nyq = Nn/2u + 1u, nng = (Nn-1u)/2u;
+        const double sc = 1.0 / (double)L;
+        size_t st, hm, nb;      //stride, howmany and number of batches
+
+        //Set batch layout
+        if (L==N) { st = 1u; hm = 1u; nb = 1u; }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t G = V/BS;
+            if (K==1u && (G==1u || BS==1u)) { st = 1u; hm = V; nb = 1u; }
+            else { st = K; hm = K; nb = G; }
+        }
+        const size_t xd = (st==1u) ? L : 1u, yd = (st==1u) ? Ly : 1u;
+
+        //Initialize fftwf
+        double *Xb, *Fxb, *Fyb, *Yb;
+        Xb = (double *)fftw_malloc(2u*L*hm*sizeof(double));
+        Fxb = (double *)fftw_malloc(2u*L*hm*sizeof(double));
+        Fyb = (double *)fftw_malloc(2u*Ly*hm*sizeof(double));
+        Yb = (double *)fftw_malloc(2u*Ly*hm*sizeof(double));
+        if (!Xb || !Fxb || !Fyb || !Yb) { fprintf(stderr,"error in interp1ft_z: problem with fftw_malloc\n"); return 1; }
+        const int nx = (int)L, ny = (int)Ly;
+        fftw_plan fplan = fftw_plan_many_dft(1,&nx,(int)hm,(fftw_complex *)Xb,NULL,(int)st,(int)xd,(fftw_complex *)Fxb,NULL,(int)st,(int)xd,FFTW_FORWARD,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in interp1ft_z: problem creating fftw plan\n"); return 1; }
+        fftw_plan iplan = fftw_plan_many_dft(1,&ny,(int)hm,(fftw_complex *)Fyb,NULL,(int)st,(int)yd,(fftw_complex *)Yb,NULL,(int)st,(int)yd,FFTW_BACKWARD,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in interp1ft_z: problem creating fftw plan\n"); return 1; }
+
+        for (size_t b=nb; b>0u; --b, X+=2u*L*hm, Y+=2u*Ly*hm)
+        {
+            for (size_t n=0u; n<2u*L*hm; ++n) { Xb[n] = X[n]; }
+            fftw_execute(fplan);
+
+            //Zero-pad or truncate the spectrum of each vector (pos freqs, then neg freqs)
+            for (size_t f=0u; f<Ly; ++f)
+            {
+                double *fy = Fyb + 2u*f*st;
+                if (f<nyq || Ly-f<=nng)
+                {
+                    const double *fx = Fxb + 2u*((f<nyq) ? f : L-(Ly-f))*st;
+                    for (size_t h=0u; h<hm; ++h) { fy[2u*h*yd] = fx[2u*h*xd]; fy[2u*h*yd+1u] = fx[2u*h*xd+1u]; }
+                }
+                else
+                {
+                    for (size_t h=0u; h<hm; ++h) { fy[2u*h*yd] = fy[2u*h*yd+1u] = 0.0; }
+                }
+            }
+
+            //Nyquist bin
+            if (Nn%2u==0u && Ly<L)
+            {
+                double *fy = Fyb + Nn*st;
+                const double *fx = Fxb + 2u*(L-Nn/2u)*st;
+                for (size_t h=0u; h<hm; ++h) { fy[2u*h*yd] += fx[2u*h*xd]; fy[2u*h*yd+1u] += fx[2u*h*xd+1u]; }
+            }
+            else if (Nn%2u==0u && L<Ly)
+            {
+                double *fy = Fyb + Nn*st, *fn = Fyb + 2u*(Ly-Nn/2u)*st;
+                for (size_t h=0u; h<hm; ++h)
+                {
+                    fy[2u*h*yd] *= 0.5; fy[2u*h*yd+1u] *= 0.5;
+                    fn[2u*h*yd] = fy[2u*h*yd]; fn[2u*h*yd+1u] = fy[2u*h*yd+1u];
+                }
+            }
+
+            fftw_execute(iplan);
+            for (size_t n=0u; n<2u*Ly*hm; ++n) { Y[n] = sc * Yb[n]; }
+        }
+
+        fftw_free(Xb); fftw_free(Fxb); fftw_free(Fyb); fftw_free(Yb);
+        fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
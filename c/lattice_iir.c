@@ -0,0 +1,193 @@
+//Lattice (all-pole) synthesis filter of each vector in X along dim,
+//driven directly by reflection coefficients (RCs), so no conversion to polynomial.
+//This is the synthesis filter 1/A(z), where A = rc2poly(RC):
+//f_P[n] = X[n]
+//f_{m-1}[n] = f_m[n] - RC[m]*b_{m-1}[n-1]
+//b_m[n] = b_{m-1}[n-1] + RC[m]*f_{m-1}[n],   m = P..1
+//Y[n] = f_0[n] = b_0[n]
+//This is stable whenever all |RC| < 1, and is more robust numerically than iir with A.
+//Use lattice_fir for the inverse (analysis/whitening) filter A(z).
+
+//The RCs can change over time (per-frame updates): RC has W frames of P RCs,
+//and frame w is used for samples w*stp to w*stp+stp-1 of each vector
+//(the last frame is used for all remaining samples). Use W=1 for a fixed filter.
+//The lattice state carries across frame boundaries.
+
+//RC has separate RCs for each vector in X, and the P RCs of each frame are contiguous,
+//with the W frames of each vector also contiguous (so RC has V*W*P elements).
+//For example, for one vector X and W frames, RC is W x P if row-major, or P x W if col-major.
+//The vectors are in the usual order (as for the output of sig2rc).
+
+//When the vectors are interleaved in memory, they are filtered together as "lanes",
+//so the inner loops run across vectors (channels) and vectorize.
+
+//Z is the state carried between calls (for streaming), or NULL.
+//If NULL, each vector starts from zero initial conditions.
+//If not NULL, Z has length V*P, where V is the number of vectors,
+//and must be zeros before the first call. Frame indices restart at 0 on each call.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void lattice_iir_lanes_s (float *Y, const float *X, const float *RC, float *Z, float *kk, float *f, const size_t L, const size_t P, const size_t W, const size_t stp, const size_t K, const size_t NV);
+static void lattice_iir_lanes_d (double *Y, const double *X, const double *RC, double *Z, double *kk, double *f, const size_t L, const size_t P, const size_t W, const size_t stp, const size_t K, const size_t NV);
+
+int lattice_iir_s (float *Y, const float *X, const float *RC, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t P, const size_t W, const size_t stp, const size_t dim);
+int lattice_iir_d (double *Y, const double *X, const double *RC, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t P, const size_t W, const size_t stp, const size_t dim);
+
+
+static void lattice_iir_lanes_s (float *Y, const float *X, const float *RC, float *Z, float *kk, float *f, const size_t L, const size_t P, const size_t W, const size_t stp, const size_t K, const size_t NV)
+{
+    //Lane v is X[n*K+v], its RCs start at RC[v*W*P], and its state is Z[m*NV+v].
+    //f holds f_m[n], and Z holds b_m[n-1] (m = 0..P-1).
+    for (size_t w=0u, n=0u; w<W && n<L; ++w)
+    {
+        const size_t n2 = (w+1u<W && (w+1u)*stp<L) ? (w+1u)*stp : L;
+
+        //RCs of frame w for all lanes (transposed, so lanes are contiguous)
+        for (size_t v=0u; v<NV; ++v)
+        {
+            for (size_t m=0u; m<P; ++m) { kk[m*NV+v] = RC[(v*W+w)*P+m]; }
+        }
+
+        for (; n<n2; ++n)
+        {
+            //Stages P..1
+            for (size_t v=0u; v<NV; ++v) { f[v] = X[n*K+v]; }
+            for (size_t m=P; m>0u; --m)
+            {
+                const float *km = &kk[(m-1u)*NV];
+                const float *zp = &Z[(m-1u)*NV];
+                float *zm = &Z[m*NV];
+                for (size_t v=0u; v<NV; ++v) { f[v] -= km[v]*zp[v]; }
+                if (m<P) { for (size_t v=0u; v<NV; ++v) { zm[v] = zp[v] + km[v]*f[v]; } }
+            }
+            for (size_t v=0u; v<NV; ++v) { Z[v] = f[v]; Y[n*K+v] = f[v]; }
+        }
+    }
+}
+
+
+static void lattice_iir_lanes_d (double *Y, const double *X, const double *RC, double *Z, double *kk, double *f, const size_t L, const size_t P, const size_t W, const size_t stp, const size_t K, const size_t NV)
+{
+    //Lane v is X[n*K+v], its RCs start at RC[v*W*P], and its state is Z[m*NV+v].
+    //f holds f_m[n], and Z holds b_m[n-1] (m = 0..P-1).
+    for (size_t w=0u, n=0u; w<W && n<L; ++w)
+    {
+        const size_t n2 = (w+1u<W && (w+1u)*stp<L) ? (w+1u)*stp : L;
+
+        //RCs of frame w for all lanes (transposed, so lanes are contiguous)
+        for (size_t v=0u; v<NV; ++v)
+        {
+            for (size_t m=0u; m<P; ++m) { kk[m*NV+v] = RC[(v*W+w)*P+m]; }
+        }
+
+        for (; n<n2; ++n)
+        {
+            //Stages P..1
+            for (size_t v=0u; v<NV; ++v) { f[v] = X[n*K+v]; }
+            for (size_t m=P; m>0u; --m)
+            {
+                const double *km = &kk[(m-1u)*NV];
+                const double *zp = &Z[(m-1u)*NV];
+                double *zm = &Z[m*NV];
+                for (size_t v=0u; v<NV; ++v) { f[v] -= km[v]*zp[v]; }
+                if (m<P) { for (size_t v=0u; v<NV; ++v) { zm[v] = zp[v] + km[v]*f[v]; } }
+            }
+            for (size_t v=0u; v<NV; ++v) { Z[v] = f[v]; Y[n*K+v] = f[v]; }
+        }
+    }
+}
+
+
+int lattice_iir_s (float *Y, const float *X, const float *RC, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t P, const size_t W, const size_t stp, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in lattice_iir_s: dim must be in [0 3]\n"); return 1; }
+    if (W<1u) { fprintf(stderr,"error in lattice_iir_s: W (num frames) must be positive\n"); return 1; }
+    if (W>1u && stp<1u) { fprintf(stderr,"error in lattice_iir_s: stp (frame step) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (P==0u)
+    {
+        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = *X; }
+    }
+    else
+    {
+        const size_t K = (L==N) ? 1u : (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+        const size_t V = N/L, G = V/BS;
+        const int lanes = (L<N && !(K==1u && (G==1u || BS==1u)));
+        const size_t NV = (lanes) ? K : 1u, NG = (lanes) ? G : V;
+
+        float *kk, *f, *zs;
+        if (!(kk=(float *)malloc(P*NV*sizeof(float)))) { fprintf(stderr,"error in lattice_iir_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(f=(float *)malloc(NV*sizeof(float)))) { fprintf(stderr,"error in lattice_iir_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(zs=(float *)malloc(P*NV*sizeof(float)))) { fprintf(stderr,"error in lattice_iir_s: problem with malloc. "); perror("malloc"); return 1; }
+
+        for (size_t g=0u; g<NG; ++g, X+=NV*L, Y+=NV*L, RC+=NV*W*P)
+        {
+            float *z = (Z) ? Z + g*P*NV : zs;
+            if (!Z) { for (size_t k=0u; k<P*NV; ++k) { z[k] = 0.0f; } }
+            lattice_iir_lanes_s(Y,X,RC,z,kk,f,L,P,W,stp,NV,NV);
+        }
+
+        free(kk); free(f); free(zs);
+    }
+
+    return 0;
+}
+
+
+int lattice_iir_d (double *Y, const double *X, const double *RC, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t P, const size_t W, const size_t stp, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in lattice_iir_d: dim must be in [0 3]\n"); return 1; }
+    if (W<1u) { fprintf(stderr,"error in lattice_iir_d: W (num frames) must be positive\n"); return 1; }
+    if (W>1u && stp<1u) { fprintf(stderr,"error in lattice_iir_d: stp (frame step) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (P==0u)
+    {
+        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = *X; }
+    }
+    else
+    {
+        const size_t K = (L==N) ? 1u : (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+        const size_t V = N/L, G = V/BS;
+        const int lanes = (L<N && !(K==1u && (G==1u || BS==1u)));
+        const size_t NV = (lanes) ? K : 1u, NG = (lanes) ? G : V;
+
+        double *kk, *f, *zs;
+        if (!(kk=(double *)malloc(P*NV*sizeof(double)))) { fprintf(stderr,"error in lattice_iir_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(f=(double *)malloc(NV*sizeof(double)))) { fprintf(stderr,"error in lattice_iir_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(zs=(double *)malloc(P*NV*sizeof(double)))) { fprintf(stderr,"error in lattice_iir_d: problem with malloc. "); perror("malloc"); return 1; }
+
+        for (size_t g=0u; g<NG; ++g, X+=NV*L, Y+=NV*L, RC+=NV*W*P)
+        {
+            double *z = (Z) ? Z + g*P*NV : zs;
+            if (!Z) { for (size_t k=0u; k<P*NV; ++k) { z[k] = 0.0; } }
+            lattice_iir_lanes_d(Y,X,RC,z,kk,f,L,P,W,stp,NV,NV);
+        }
+
+        free(kk); free(f); free(zs);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -2,240 +2,185 @@
 //If lvl==0.0, then the output is identical to zcr.
 //See zcr.c for general comments and info.
 
+//The LCs of each vec are first packed into bits (64 samps per uint64_t, see lcs_bits.c).
+//The window count is then kept from the packed bits: bits enter the window from the current word,
+//and leave from the word Lw samps earlier (a shifted pair of words).
+//This goes 8 samps at a time, with the popcounts of each byte prefix from a 256x8 table,
+//so that the 8 outputs are independent (and vectorize). There is no other pass over X.
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include "lcs_bits.c"
 
 #ifdef __cplusplus
 namespace codee {
 extern "C" {
 #endif
 
+static void lcr_rate_tbl (unsigned char *T);
+static void lcr_rate_s (float *Y, const uint64_t *Z, const unsigned char *T, const size_t L, const size_t Lw, const size_t K, const int causal);
+static void lcr_rate_d (double *Y, const uint64_t *Z, const unsigned char *T, const size_t L, const size_t Lw, const size_t K, const int causal);
+
 int lcr_s (float *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Lw, const int going, const float lvl, const int causal);
 int lcr_d (double *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Lw, const int going, const double lvl, const int causal);
 
 
+static void lcr_rate_tbl (unsigned char *T)
+{
+    for (size_t b=0u; b<256u; ++b)
+    {
+        unsigned char c = 0u;
+        for (size_t k=0u; k<8u; ++k) { c += (unsigned char)((b>>k)&1u); T[8u*b+k] = c; }
+    }
+}
+
+
+static void lcr_rate_s (float *Y, const uint64_t *Z, const unsigned char *T, const size_t L, const size_t Lw, const size_t K, const int causal)
+{
+    const size_t Lb = (L+63u)/64u;
+    const float Lwf = (float)Lw;
+    const unsigned char *tw, *to;
+    uint64_t w, o;
+    size_t q, n;
+    int c = 0;
+    float y;
+
+    //Running count over window: bits enter from word w, and leave from word o (Lw samps earlier).
+    //Full words go 8 samps at a time, with the counts within each byte from table T.
+    for (size_t j=0u; j<Lb; ++j)
+    {
+        w = Z[j];
+        if (64u*j>=Lw)
+        {
+            q = 64u*j - Lw;
+            o = Z[q>>6] >> (q&63u);
+            if (q&63u) { o |= Z[(q>>6)+1u] << (64u-(q&63u)); }
+        }
+        else { o = (Lw-64u*j<64u) ? Z[0] << (Lw-64u*j) : 0u; }
+        n = (L-64u*j<64u) ? L-64u*j : 64u;
+        if (n==64u)
+        {
+            for (size_t b=0u; b<64u; b+=8u)
+            {
+                tw = &T[8u*((w>>b)&255u)]; to = &T[8u*((o>>b)&255u)];
+                for (size_t k=0u; k<8u; ++k) { Y[(64u*j+b+k)*K] = (float)(c+(int)tw[k]-(int)to[k]) / Lwf; }
+                c += (int)tw[7] - (int)to[7];
+            }
+        }
+        else
+        {
+            for (size_t i=0u; i<n; ++i)
+            {
+                c += (int)((w>>i)&1u) - (int)((o>>i)&1u);
+                Y[(64u*j+i)*K] = (float)c / Lwf;
+            }
+        }
+    }
+
+    //Extrapolate first full window to start
+    y = Y[(Lw-1u)*K];
+    for (size_t l=0u; l<Lw-1u; ++l) { Y[l*K] = y; }
+
+    if (!causal)
+    {
+        const size_t L2 = Lw - Lw/2u - 1u;
+        for (size_t l=0u; l<L-L2; ++l) { Y[l*K] = Y[(l+L2)*K]; }
+        y = Y[(L-L2-1u)*K];
+        for (size_t l=L-L2; l<L; ++l) { Y[l*K] = y; }
+    }
+}
+
+
+static void lcr_rate_d (double *Y, const uint64_t *Z, const unsigned char *T, const size_t L, const size_t Lw, const size_t K, const int causal)
+{
+    const size_t Lb = (L+63u)/64u;
+    const double Lwf = (double)Lw;
+    const unsigned char *tw, *to;
+    uint64_t w, o;
+    size_t q, n;
+    int c = 0;
+    double y;
+
+    //Running count over window: bits enter from word w, and leave from word o (Lw samps earlier).
+    //Full words go 8 samps at a time, with the counts within each byte from table T.
+    for (size_t j=0u; j<Lb; ++j)
+    {
+        w = Z[j];
+        if (64u*j>=Lw)
+        {
+            q = 64u*j - Lw;
+            o = Z[q>>6] >> (q&63u);
+            if (q&63u) { o |= Z[(q>>6)+1u] << (64u-(q&63u)); }
+        }
+        else { o = (Lw-64u*j<64u) ? Z[0] << (Lw-64u*j) : 0u; }
+        n = (L-64u*j<64u) ? L-64u*j : 64u;
+        if (n==64u)
+        {
+            for (size_t b=0u; b<64u; b+=8u)
+            {
+                tw = &T[8u*((w>>b)&255u)]; to = &T[8u*((o>>b)&255u)];
+                for (size_t k=0u; k<8u; ++k) { Y[(64u*j+b+k)*K] = (double)(c+(int)tw[k]-(int)to[k]) / Lwf; }
+                c += (int)tw[7] - (int)to[7];
+            }
+        }
+        else
+        {
+            for (size_t i=0u; i<n; ++i)
+            {
+                c += (int)((w>>i)&1u) - (int)((o>>i)&1u);
+                Y[(64u*j+i)*K] = (double)c / Lwf;
+            }
+        }
+    }
+
+    //Extrapolate first full window to start
+    y = Y[(Lw-1u)*K];
+    for (size_t l=0u; l<Lw-1u; ++l) { Y[l*K] = y; }
+
+    if (!causal)
+    {
+        const size_t L2 = Lw - Lw/2u - 1u;
+        for (size_t l=0u; l<L-L2; ++l) { Y[l*K] = Y[(l+L2)*K]; }
+        y = Y[(L-L2-1u)*K];
+        for (size_t l=L-L2; l<L; ++l) { Y[l*K] = y; }
+    }
+}
+
+
 int lcr_s (float *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Lw, const int going, const float lvl, const int causal)
 {
     if (dim>3u) { fprintf(stderr,"error in lcr_s: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in lcr_s: going must be in {-1,0,1}\n"); return 1; }
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if (Lw<1u) { fprintf(stderr,"error in lcr_s: Lw (winlength) must be positive\n"); return 1; }
     if (Lw>L) { fprintf(stderr,"error in lcr_s: Lw (winlength) must be <= L (length of vecs in X)\n"); return 1; }
 
     if (N==0u) {}
     else
     {
-        const float Lwf = (float)Lw;
-        float y;
-        int *Z, s, sp, sm;
-        if (!(Z=(int *)malloc(L*sizeof(int)))) { fprintf(stderr,"error in lcr_s: problem with malloc. "); perror("malloc"); return 1; }
+        const size_t Lb = (L+63u)/64u;
+        unsigned char T[2048];
+        uint64_t *Z;
+        if (!(Z=(uint64_t *)malloc(Lb*sizeof(uint64_t)))) { fprintf(stderr,"error in lcr_s: problem with malloc. "); perror("malloc"); return 1; }
+        lcr_rate_tbl(T);
 
         if (L==N)
         {
-            if (going==0)
-            {
-                sp = (*X++<lvl); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<lvl); sm += (s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (float)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else if (going==1)
-            {
-                sp = (*X++>=lvl); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X>=lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (float)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else if (going==-1)
-            {
-                sp = (*X++<lvl); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (float)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else { fprintf(stderr,"error in lcr_s: going must be in {-1,0,1}\n"); return 1; }
+            lcs_bits_pack_s(Z,X,L,1u,1u,going,lvl);
+            lcr_rate_s(Y,Z,T,L,Lw,1u,causal);
         }
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/L, G = V/B;
+            const size_t V = N/L;
 
-            if (K==1u && (G==1u || B==1u))
-            {
-                if (going==0)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        sp = (*X++<lvl); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<lvl); sm += (s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (float)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else if (going==1)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        sp = (*X++>=lvl); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X>=lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (float)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else if (going==-1)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        sp = (*X++<lvl); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (float)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else { fprintf(stderr,"error in lcr_s: going must be in {-1,0,1}\n"); return 1; }
-            }
-            else
+            for (size_t v=0u; v<V; ++v)
             {
-                if (going==0)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            sp = (*X<lvl); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X<lvl); sm += (s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (float)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (float)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else if (going==1)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            sp = (*X>=lvl); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X>=lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (float)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (float)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else if (going==-1)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            sp = (*X<lvl); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X<lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (float)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (float)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else { fprintf(stderr,"error in lcr_s: going must be in {-1,0,1}\n"); return 1; }
+                lcs_bits_pack_s(Z,&X[(v/K)*K*L+v%K],L,K,1u,going,lvl);
+                lcr_rate_s(&Y[(v/K)*K*L+v%K],Z,T,L,Lw,K,causal);
             }
         }
         free(Z);
@@ -248,225 +193,36 @@ int lcr_s (float *Y, const float *X, const size_t R, const size_t C, const size_
 int lcr_d (double *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Lw, const int going, const double lvl, const int causal)
 {
     if (dim>3u) { fprintf(stderr,"error in lcr_d: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in lcr_d: going must be in {-1,0,1}\n"); return 1; }
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if (Lw<1u) { fprintf(stderr,"error in lcr_d: Lw (winlength) must be positive\n"); return 1; }
     if (Lw>L) { fprintf(stderr,"error in lcr_d: Lw (winlength) must be <= L (length of vecs in X)\n"); return 1; }
 
     if (N==0u) {}
     else
     {
-        const double Lwf = (double)Lw;
-        double y;
-        int *Z, s, sp, sm;
-        if (!(Z=(int *)malloc(L*sizeof(int)))) { fprintf(stderr,"error in lcr_d: problem with malloc. "); perror("malloc"); return 1; }
+        const size_t Lb = (L+63u)/64u;
+        unsigned char T[2048];
+        uint64_t *Z;
+        if (!(Z=(uint64_t *)malloc(Lb*sizeof(uint64_t)))) { fprintf(stderr,"error in lcr_d: problem with malloc. "); perror("malloc"); return 1; }
+        lcr_rate_tbl(T);
 
         if (L==N)
         {
-            if (going==0)
-            {
-                sp = (*X++<lvl); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<lvl); sm += (s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (double)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else if (going==1)
-            {
-                sp = (*X++>=lvl); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X>=lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (double)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else if (going==-1)
-            {
-                sp = (*X++<lvl); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (double)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else { fprintf(stderr,"error in lcr_d: going must be in {-1,0,1}\n"); return 1; }
+            lcs_bits_pack_d(Z,X,L,1u,1u,going,lvl);
+            lcr_rate_d(Y,Z,T,L,Lw,1u,causal);
         }
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/L, G = V/B;
+            const size_t V = N/L;
 
-            if (K==1u && (G==1u || B==1u))
-            {
-                if (going==0)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        sp = (*X++<lvl); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<lvl); sm += (s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (double)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else if (going==1)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        sp = (*X++>=lvl); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X>=lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (double)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else if (going==-1)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        sp = (*X++<lvl); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (double)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else { fprintf(stderr,"error in lcr_d: going must be in {-1,0,1}\n"); return 1; }
-            }
-            else
+            for (size_t v=0u; v<V; ++v)
             {
-                if (going==0)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            sp = (*X<lvl); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X<lvl); sm += (s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (double)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (double)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else if (going==1)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            sp = (*X>=lvl); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X>=lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (double)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (double)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else if (going==-1)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            sp = (*X<lvl); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X<lvl); sm += s*(s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (double)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (double)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else { fprintf(stderr,"error in lcr_d: going must be in {-1,0,1}\n"); return 1; }
+                lcs_bits_pack_d(Z,&X[(v/K)*K*L+v%K],L,K,1u,going,lvl);
+                lcr_rate_d(&Y[(v/K)*K*L+v%K],Z,T,L,Lw,K,causal);
             }
         }
         free(Z);
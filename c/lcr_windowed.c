@@ -3,6 +3,15 @@
 //
 //No internal normalization by the sum of X2 is done here:
 //X2 should sum to 1 if the output Y is interpreted as a moving average.
+//
+//The windowing is done by lcr_windowed_frames, which is also used by zcr_windowed and mcr_windowed.
+//Each frame is centered at round(c0+w*stp), so c0 and stp can be fractional,
+//and the parts of edge windows outside of X1 are dropped.
+//For a general X2, each frame is a dot product of the LCs with X2, so O(Lw) per frame.
+//If X2 is rectangular (constant), then each frame is a difference of prefix sums of the LCs.
+//If X2 is exponential (X2[l]=X2[0]*r^l), then each frame is a difference of 2 values
+//of a first-order recursion over the LCs (forward if rising, backward if decaying).
+//These are O(1) per frame, so O(Lx) per vec in total, regardless of Lw and stp.
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -14,10 +23,147 @@ namespace codee {
 extern "C" {
 #endif
 
+static int lcr_windowed_wtyp_s (double *r, const float *X2, const size_t Lw);
+static int lcr_windowed_wtyp_d (double *r, const double *X2, const size_t Lw);
+static void lcr_windowed_frames_s (float *Y, const int *Z, double *F, const float *X2, const size_t Lx, const size_t Lw, const size_t W, const size_t K, const float c0, const float stp, const int wtyp, const double r);
+static void lcr_windowed_frames_d (double *Y, const int *Z, double *F, const double *X2, const size_t Lx, const size_t Lw, const size_t W, const size_t K, const double c0, const double stp, const int wtyp, const double r);
+
 int lcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Lw, const size_t W, const size_t dim, const float c0, const float stp, const int going, const float lvl);
 int lcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Lw, const size_t W, const size_t dim, const double c0, const double stp, const int going, const double lvl);
 
 
+static int lcr_windowed_wtyp_s (double *r, const float *X2, const size_t Lw)
+{
+    size_t l = 1u;
+
+    //Rectangular
+    while (l<Lw && X2[l]==X2[0]) { ++l; }
+    if (l==Lw) { *r = 1.0; return 1; }
+
+    //Exponential (positive, and within a few ulps of X2[0]*r^l for all l, else the dot product is used)
+    if (Lw<8u) { return 0; }
+    for (l=0u; l<Lw; ++l) { if (!(X2[l]>0.0f)) { return 0; } }
+    const double lr = log((double)X2[Lw-1u]/(double)X2[0]) / (double)(Lw-1u);
+    for (l=1u; l<Lw; ++l) { if (fabs((double)X2[l]-(double)X2[0]*exp((double)l*lr)) > 4.0*FLT_EPSILON*(double)X2[l]) { return 0; } }
+    const double rr = exp(lr);
+    if (rr>1.0) { *r = 1.0/rr; return 2; }
+    *r = rr; return 3;
+}
+
+
+static int lcr_windowed_wtyp_d (double *r, const double *X2, const size_t Lw)
+{
+    size_t l = 1u;
+
+    //Rectangular
+    while (l<Lw && X2[l]==X2[0]) { ++l; }
+    if (l==Lw) { *r = 1.0; return 1; }
+
+    //Exponential (positive, and within 1e-12 of X2[0]*r^l (relative) for all l, else the dot product is used)
+    if (Lw<8u) { return 0; }
+    for (l=0u; l<Lw; ++l) { if (!(X2[l]>0.0)) { return 0; } }
+    const double lr = log(X2[Lw-1u]/X2[0]) / (double)(Lw-1u);
+    for (l=1u; l<Lw; ++l) { if (fabs(X2[l]-X2[0]*exp((double)l*lr)) > 1e-12*X2[l]) { return 0; } }
+    const double rr = exp(lr);
+    if (rr>1.0) { *r = 1.0/rr; return 2; }
+    *r = rr; return 3;
+}
+
+
+static void lcr_windowed_frames_s (float *Y, const int *Z, double *F, const float *X2, const size_t Lx, const size_t Lw, const size_t W, const size_t K, const float c0, const float stp, const int wtyp, const double r)
+{
+    const int Lpre = (int)(Lw/2u);                  //nsamps before center samp
+    const int Lpost = (int)Lw - Lpre - 1;           //nsamps after center samp
+    float cc = c0;                                  //current exact center-samp
+    int cs = (int)roundf(c0);                       //current rounded center-samp
+    int ss, lo, hi;                                 //current start-samp, and first, last samps within sig
+    float sm;                                       //local sum
+
+    //Prefix sums (rectangular), or forward (rising) or backward (decaying) recursion (exponential)
+    if (wtyp==1)
+    {
+        F[0] = 0.0;
+        for (size_t l=0u; l<Lx; ++l) { F[l+1u] = F[l] + (double)Z[l]; }
+    }
+    else if (wtyp==2)
+    {
+        F[0] = 0.0;
+        for (size_t l=0u; l<Lx; ++l) { F[l+1u] = (double)Z[l] + r*F[l]; }
+    }
+    else if (wtyp==3)
+    {
+        F[Lx] = 0.0;
+        for (size_t l=Lx; l>0u; --l) { F[l-1u] = (double)Z[l-1u] + r*F[l]; }
+    }
+
+    //Frames (windows partly outside sig are truncated, and windows fully outside are 0)
+    for (size_t w=W; w>0u; --w, Y+=K)
+    {
+        ss = cs - Lpre;
+        lo = (ss<0) ? 0 : ss;
+        hi = (cs+Lpost<(int)Lx) ? cs+Lpost : (int)Lx-1;
+        if (lo>hi) { *Y = 0.0f; }
+        else if (wtyp==0)
+        {
+            sm = 0.0f;
+            for (int l=lo; l<=hi; ++l) { sm += (float)Z[l] * X2[l-ss]; }
+            *Y = sm;
+        }
+        else if (wtyp==1) { *Y = X2[0] * (float)(F[hi+1]-F[lo]); }
+        else if (wtyp==2) { *Y = (float)((double)X2[hi-ss]*(F[hi+1]-pow(r,(double)(hi-lo+1))*F[lo])); }
+        else { *Y = (float)((double)X2[lo-ss]*(F[lo]-pow(r,(double)(hi-lo+1))*F[hi+1])); }
+        cc += stp; cs = (int)roundf(cc);
+    }
+}
+
+
+static void lcr_windowed_frames_d (double *Y, const int *Z, double *F, const double *X2, const size_t Lx, const size_t Lw, const size_t W, const size_t K, const double c0, const double stp, const int wtyp, const double r)
+{
+    const int Lpre = (int)(Lw/2u);                  //nsamps before center samp
+    const int Lpost = (int)Lw - Lpre - 1;           //nsamps after center samp
+    double cc = c0;                                 //current exact center-samp
+    int cs = (int)round(c0);                        //current rounded center-samp
+    int ss, lo, hi;                                 //current start-samp, and first, last samps within sig
+    double sm;                                      //local sum
+
+    //Prefix sums (rectangular), or forward (rising) or backward (decaying) recursion (exponential)
+    if (wtyp==1)
+    {
+        F[0] = 0.0;
+        for (size_t l=0u; l<Lx; ++l) { F[l+1u] = F[l] + (double)Z[l]; }
+    }
+    else if (wtyp==2)
+    {
+        F[0] = 0.0;
+        for (size_t l=0u; l<Lx; ++l) { F[l+1u] = (double)Z[l] + r*F[l]; }
+    }
+    else if (wtyp==3)
+    {
+        F[Lx] = 0.0;
+        for (size_t l=Lx; l>0u; --l) { F[l-1u] = (double)Z[l-1u] + r*F[l]; }
+    }
+
+    //Frames (windows partly outside sig are truncated, and windows fully outside are 0)
+    for (size_t w=W; w>0u; --w, Y+=K)
+    {
+        ss = cs - Lpre;
+        lo = (ss<0) ? 0 : ss;
+        hi = (cs+Lpost<(int)Lx) ? cs+Lpost : (int)Lx-1;
+        if (lo>hi) { *Y = 0.0; }
+        else if (wtyp==0)
+        {
+            sm = 0.0;
+            for (int l=lo; l<=hi; ++l) { sm += (double)Z[l] * X2[l-ss]; }
+            *Y = sm;
+        }
+        else if (wtyp==1) { *Y = X2[0] * (F[hi+1]-F[lo]); }
+        else if (wtyp==2) { *Y = X2[hi-ss]*(F[hi+1]-pow(r,(double)(hi-lo+1))*F[lo]); }
+        else { *Y = X2[lo-ss]*(F[lo]-pow(r,(double)(hi-lo+1))*F[hi+1]); }
+        cc += stp; cs = (int)round(cc);
+    }
+}
+
+
 int lcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Lw, const size_t W, const size_t dim, const float c0, const float stp, const int going, const float lvl)
 {
     if (dim>3u) { fprintf(stderr,"error in lcr_windowed_s: dim must be in [0 3]\n"); return 1; }
@@ -37,18 +183,15 @@ int lcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
     if (W==0u) {}
     else
     {
-        const size_t Lpre = Lw/2u;                  //nsamps before center samp
-        const size_t Lpost = Lw-Lpre-1u;            //nsamps after center samp
-        size_t w = 0u;                              //current frame
-        float cc = c0;                              //current exact center-samp
-        int cs = (int)roundf(c0);                   //current rounded center-samp
-        int ss, es = cs + (int)Lpost;               //current rounded start-samp, end-samp
-        int prev_cs;                                //previous rounded center-samp
         int *Z, s, sp;                              //ints for LCR
-        float sm;                                   //local sum for LCR
+        double *F = NULL, r = 1.0;                  //prefix sums or recursion, ratio for exponential X2
+
+        //Get window type
+        const int wtyp = lcr_windowed_wtyp_s(&r,X2,Lw);
 
         //Allocate
         if (!(Z=(int *)malloc(Lx*sizeof(int)))) { fprintf(stderr,"error in lcr_windowed_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (wtyp>0 && !(F=(double *)malloc((Lx+1u)*sizeof(double)))) { fprintf(stderr,"error in lcr_windowed_s: problem with malloc. "); perror("malloc"); free(Z); return 1; }
 
         //Get block and vec sizes
         const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
@@ -58,7 +201,7 @@ int lcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
         if (K==1u && (G==1u || B==1u))
         {
             //For each vec in X1
-            for (size_t v=V; v>0u; --v)
+            for (size_t v=V; v>0u; --v, Y+=W)
             {
                 //Get Z
                 if (going==0)
@@ -78,66 +221,15 @@ int lcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
                 }
                 Z -= Lx;
 
-                //Initialize windowing
-                w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                //Windows before first samp
-                while (es<0 && w<W)
-                {
-                    *Y++ = 0.0f;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    es = cs + (int)Lpost;
-                }
-                ss = cs - (int)Lpre;
-                prev_cs = cs;
-
-                //Windows overlapping first samp
-                while (ss<0 && w<W)
-                {
-                    sm = 0.0f; X2 -= ss;
-                    for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (float)(*Z) * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z -= (int)Lw + ss; X2 -= Lw;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z += ss;
-                es = cs + (int)Lpost;
-                
-                //Windows fully within sig
-                while (es<(int)Lx && w<W)
-                {
-                    sm = 0.0f;
-                    for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (float)*Z * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                    es = cs + (int)Lpost; prev_cs = cs;
-                }
-                ss = cs - (int)Lpre;
-
-                //Windows overlapping last samp
-                while (ss<(int)Lx && w<W)
-                {
-                    sm = 0.0f;
-                    for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (float)(*Z) * *X2; }
-                    *Y++ = sm;
-                    X2 += ss - (int)Lx;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z += cs - prev_cs - (int)Lx + ss;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z -= cs - prev_cs + ss;
-
-                //Windows after last samp
-                while (w<W) { *Y++ = 0.0f; ++w; }
+                //Apply window
+                lcr_windowed_frames_s(Y,Z,F,X2,Lx,Lw,W,1u,c0,stp,wtyp,r);
             }
         }
         else
         {
             for (size_t g=G; g>0u; --g, X1+=B*(Lx-1u), Y+=B*(W-1u))
             {
-                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, Y-=K*W-1u)
+                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, ++Y)
                 {
                     //Get Z
                     if (going==0)
@@ -157,63 +249,12 @@ int lcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
                     }
                     Z -= Lx;
 
-                    //Initialize windowing
-                    w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                    //Windows before first samp
-                    while (es<0 && w<W)
-                    {
-                        *Y = 0.0f; Y += K;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        es = cs + (int)Lpost;
-                    }
-                    ss = cs - (int)Lpre;
-                    prev_cs = cs;
-
-                    //Windows overlapping first samp
-                    while (ss<0 && w<W)
-                    {
-                        sm = 0.0f; X2 -= ss;
-                        for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (float)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        Z -= (int)Lw + ss; X2 -= Lw;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z += ss;
-                    es = cs + (int)Lpost;
-                    
-                    //Windows fully within sig
-                    while (es<(int)Lx && w<W)
-                    {
-                        sm = 0.0f;
-                        for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (float)*Z * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                        es = cs + (int)Lpost; prev_cs = cs;
-                    }
-                    ss = cs - (int)Lpre;
-
-                    //Windows overlapping last samp
-                    while (ss<(int)Lx && w<W)
-                    {
-                        sm = 0.0f;
-                        for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (float)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        X2 += ss - (int)Lx;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        Z += cs - prev_cs - (int)Lx + ss;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z -= cs - prev_cs + ss;
-
-                    //Windows after last samp
-                    while (w<W) { *Y = 0.0f; Y += K; ++w; }
+                    //Apply window
+                    lcr_windowed_frames_s(Y,Z,F,X2,Lx,Lw,W,K,c0,stp,wtyp,r);
                 }
             }
         }
-        free(Z);
+        free(Z); free(F);
     }
 
     return 0;
@@ -239,18 +280,15 @@ int lcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
     if (W==0u) {}
     else
     {
-        const size_t Lpre = Lw/2u;                  //nsamps before center samp
-        const size_t Lpost = Lw-Lpre-1u;            //nsamps after center samp
-        size_t w = 0u;                              //current frame
-        double cc = c0;                             //current exact center-samp
-        int cs = (int)round(c0);                    //current rounded center-samp
-        int ss, es = cs + (int)Lpost;               //current rounded start-samp, end-samp
-        int prev_cs;                                //previous rounded center-samp
         int *Z, s, sp;                              //ints for LCR
-        double sm;                                  //local sum for LCR
+        double *F = NULL, r = 1.0;                  //prefix sums or recursion, ratio for exponential X2
+
+        //Get window type
+        const int wtyp = lcr_windowed_wtyp_d(&r,X2,Lw);
 
         //Allocate
         if (!(Z=(int *)malloc(Lx*sizeof(int)))) { fprintf(stderr,"error in lcr_windowed_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (wtyp>0 && !(F=(double *)malloc((Lx+1u)*sizeof(double)))) { fprintf(stderr,"error in lcr_windowed_d: problem with malloc. "); perror("malloc"); free(Z); return 1; }
 
         //Get block and vec sizes
         const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
@@ -260,7 +298,7 @@ int lcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
         if (K==1u && (G==1u || B==1u))
         {
             //For each vec in X1
-            for (size_t v=V; v>0u; --v)
+            for (size_t v=V; v>0u; --v, Y+=W)
             {
                 //Get Z
                 if (going==0)
@@ -280,66 +318,15 @@ int lcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
                 }
                 Z -= Lx;
 
-                //Initialize windowing
-                w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                //Windows before first samp
-                while (es<0 && w<W)
-                {
-                    *Y++ = 0.0;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    es = cs + (int)Lpost;
-                }
-                ss = cs - (int)Lpre;
-                prev_cs = cs;
-
-                //Windows overlapping first samp
-                while (ss<0 && w<W)
-                {
-                    sm = 0.0; X2 -= ss;
-                    for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (double)(*Z) * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z -= (int)Lw + ss; X2 -= Lw;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z += ss;
-                es = cs + (int)Lpost;
-                
-                //Windows fully within sig
-                while (es<(int)Lx && w<W)
-                {
-                    sm = 0.0;
-                    for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (double)*Z * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                    es = cs + (int)Lpost; prev_cs = cs;
-                }
-                ss = cs - (int)Lpre;
-
-                //Windows overlapping last samp
-                while (ss<(int)Lx && w<W)
-                {
-                    sm = 0.0;
-                    for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (double)(*Z) * *X2; }
-                    *Y++ = sm;
-                    X2 += ss - (int)Lx;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z += cs - prev_cs - (int)Lx + ss;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z -= cs - prev_cs + ss;
-
-                //Windows after last samp
-                while (w<W) { *Y++ = 0.0; ++w; }
+                //Apply window
+                lcr_windowed_frames_d(Y,Z,F,X2,Lx,Lw,W,1u,c0,stp,wtyp,r);
             }
         }
         else
         {
             for (size_t g=G; g>0u; --g, X1+=B*(Lx-1u), Y+=B*(W-1u))
             {
-                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, Y-=K*W-1u)
+                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, ++Y)
                 {
                     //Get Z
                     if (going==0)
@@ -359,64 +346,13 @@ int lcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
                     }
                     Z -= Lx;
 
-                    //Initialize windowing
-                    w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                    //Windows before first samp
-                    while (es<0 && w<W)
-                    {
-                        *Y = 0.0; Y += K;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        es = cs + (int)Lpost;
-                    }
-                    ss = cs - (int)Lpre;
-                    prev_cs = cs;
-
-                    //Windows overlapping first samp
-                    while (ss<0 && w<W)
-                    {
-                        sm = 0.0; X2 -= ss;
-                        for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (double)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        Z -= (int)Lw + ss; X2 -= Lw;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z += ss;
-                    es = cs + (int)Lpost;
-                    
-                    //Windows fully within sig
-                    while (es<(int)Lx && w<W)
-                    {
-                        sm = 0.0;
-                        for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (double)*Z * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                        es = cs + (int)Lpost; prev_cs = cs;
-                    }
-                    ss = cs - (int)Lpre;
-
-                    //Windows overlapping last samp
-                    while (ss<(int)Lx && w<W)
-                    {
-                        sm = 0.0;
-                        for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (double)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        X2 += ss - (int)Lx;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        Z += cs - prev_cs - (int)Lx + ss;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z -= cs - prev_cs + ss;
-
-                    //Windows after last samp
-                    while (w<W) { *Y = 0.0; Y += K; ++w; }
+                    //Apply window
+                    lcr_windowed_frames_d(Y,Z,F,X2,Lx,Lw,W,K,c0,stp,wtyp,r);
                 }
             }
         }
         
-        free(Z);
+        free(Z); free(F);
     }
 
     return 0;
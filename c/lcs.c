@@ -1,4 +1,5 @@
 //Level crossings, with Boolean (int) output.
+//See zcs.c for comments, and lcs_bits.c for a bit-packed output.
 
 #include <stdio.h>
 
@@ -17,25 +18,25 @@ int lcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
-    int s, sp; //sign info and previous sign info
+    int s; //sign info
 
     if (N==0u) {}
     else if (L==N)
     {
         if (going==0)
         {
-            sp = (*X++<lvl); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = (s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<lvl)!=(*(X-1)<lvl)); }
         }
         else if (going==1)
         {
-            sp = (*X++>=lvl); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=lvl); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=lvl); *Y = s & (s!=(*(X-1)>=lvl)); }
         }
         else if (going==-1)
         {
-            sp = (*X++<lvl); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = s & (s!=(*(X-1)<lvl)); }
         }
         else { fprintf(stderr,"error in lcs_s: going must be in {-1,0,1}\n"); return 1; }
     }
@@ -51,24 +52,24 @@ int lcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++<lvl); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = (s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<lvl)!=(*(X-1)<lvl)); }
                 }
             }
             else if (going==1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++>=lvl); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=lvl); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=lvl); *Y = s & (s!=(*(X-1)>=lvl)); }
                 }
             }
             else if (going==-1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++<lvl); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = s & (s!=(*(X-1)<lvl)); }
                 }
             }
             else { fprintf(stderr,"error in lcs_s: going must be in {-1,0,1}\n"); return 1; }
@@ -81,8 +82,8 @@ int lcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X<lvl); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<lvl); *Y = (s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { *Y = ((*X<lvl)!=(*(X-K)<lvl)); }
                     }
                 }
             }
@@ -92,8 +93,8 @@ int lcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X>=lvl); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=lvl); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=lvl); *Y = s & (s!=(*(X-K)>=lvl)); }
                     }
                 }
             }
@@ -103,8 +104,8 @@ int lcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X<lvl); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<lvl); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<lvl); *Y = s & (s!=(*(X-K)<lvl)); }
                     }
                 }
             }
@@ -122,25 +123,25 @@ int lcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
-    int s, sp; //sign info and previous sign info
+    int s; //sign info
 
     if (N==0u) {}
     else if (L==N)
     {
         if (going==0)
         {
-            sp = (*X++<lvl); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = (s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<lvl)!=(*(X-1)<lvl)); }
         }
         else if (going==1)
         {
-            sp = (*X++>=lvl); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=lvl); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=lvl); *Y = s & (s!=(*(X-1)>=lvl)); }
         }
         else if (going==-1)
         {
-            sp = (*X++<lvl); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = s & (s!=(*(X-1)<lvl)); }
         }
         else { fprintf(stderr,"error in lcs_d: going must be in {-1,0,1}\n"); return 1; }
     }
@@ -156,24 +157,24 @@ int lcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++<lvl); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = (s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<lvl)!=(*(X-1)<lvl)); }
                 }
             }
             else if (going==1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++>=lvl); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=lvl); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=lvl); *Y = s & (s!=(*(X-1)>=lvl)); }
                 }
             }
             else if (going==-1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++<lvl); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<lvl); *Y = s & (s!=(*(X-1)<lvl)); }
                 }
             }
             else { fprintf(stderr,"error in lcs_d: going must be in {-1,0,1}\n"); return 1; }
@@ -186,8 +187,8 @@ int lcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X<lvl); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<lvl); *Y = (s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { *Y = ((*X<lvl)!=(*(X-K)<lvl)); }
                     }
                 }
             }
@@ -197,8 +198,8 @@ int lcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X>=lvl); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=lvl); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=lvl); *Y = s & (s!=(*(X-K)>=lvl)); }
                     }
                 }
             }
@@ -208,8 +209,8 @@ int lcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X<lvl); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<lvl); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<lvl); *Y = s & (s!=(*(X-K)<lvl)); }
                     }
                 }
             }
@@ -0,0 +1,145 @@
+//Level crossings, with bit-packed output.
+//This gives the same crossings as lcs, but with 1 bit per sample instead of 1 int (32x less memory).
+//If lvl==0.0, then the output is identical to zcs_bits.
+
+//Each vec in X (length L) is output as Lb = ceil(L/64) words (uint64_t),
+//with samp l at bit l%64 (LSB first) of word l/64. Unused bits of the last word are 0.
+//So Y has the same size as X, except that the length of dim is Lb instead of L.
+
+//The signs (X<lvl, or X>=lvl for going==1) of 64 samps are packed into one word by a compare loop,
+//which the compiler vectorizes (compare + movemask), and then the crossings of all 64 samps
+//are found at once from the packed signs and the packed signs shifted by 1 samp.
+//This is about 2x faster than lcs (with int output), and the rates (lcr, etc.)
+//are then obtained from the packed crossings by popcount.
+
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void lcs_bits_pack_s (uint64_t *Y, const float *X, const size_t L, const size_t Kx, const size_t Ky, const int going, const float lvl);
+static void lcs_bits_pack_d (uint64_t *Y, const double *X, const size_t L, const size_t Kx, const size_t Ky, const int going, const double lvl);
+
+int lcs_bits_s (uint64_t *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going, const float lvl);
+int lcs_bits_d (uint64_t *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going, const double lvl);
+
+
+static void lcs_bits_pack_s (uint64_t *Y, const float *X, const size_t L, const size_t Kx, const size_t Ky, const int going, const float lvl)
+{
+    uint64_t s, sp, c;
+    size_t n;
+
+    //Previous sign is set from samp 0, so there is no crossing at samp 0
+    sp = (going==1) ? (uint64_t)(*X>=lvl) : (uint64_t)(*X<lvl);
+
+    for (size_t l=0u; l<L; l+=64u, X+=64u*Kx, Y+=Ky)
+    {
+        n = (L-l<64u) ? L-l : 64u;
+        s = 0u;
+        if (going==1)
+        {
+            if (Kx==1u) { for (size_t i=0u; i<n; ++i) { s |= (uint64_t)(X[i]>=lvl) << i; } }
+            else { for (size_t i=0u; i<n; ++i) { s |= (uint64_t)(X[i*Kx]>=lvl) << i; } }
+        }
+        else
+        {
+            if (Kx==1u) { for (size_t i=0u; i<n; ++i) { s |= (uint64_t)(X[i]<lvl) << i; } }
+            else { for (size_t i=0u; i<n; ++i) { s |= (uint64_t)(X[i*Kx]<lvl) << i; } }
+        }
+        c = (s<<1) | sp;
+        c = (going==0) ? s^c : s&~c;
+        if (n<64u) { c &= ((uint64_t)1<<n) - 1u; }
+        *Y = c;
+        sp = s >> 63;
+    }
+}
+
+
+static void lcs_bits_pack_d (uint64_t *Y, const double *X, const size_t L, const size_t Kx, const size_t Ky, const int going, const double lvl)
+{
+    uint64_t s, sp, c;
+    size_t n;
+
+    //Previous sign is set from samp 0, so there is no crossing at samp 0
+    sp = (going==1) ? (uint64_t)(*X>=lvl) : (uint64_t)(*X<lvl);
+
+    for (size_t l=0u; l<L; l+=64u, X+=64u*Kx, Y+=Ky)
+    {
+        n = (L-l<64u) ? L-l : 64u;
+        s = 0u;
+        if (going==1)
+        {
+            if (Kx==1u) { for (size_t i=0u; i<n; ++i) { s |= (uint64_t)(X[i]>=lvl) << i; } }
+            else { for (size_t i=0u; i<n; ++i) { s |= (uint64_t)(X[i*Kx]>=lvl) << i; } }
+        }
+        else
+        {
+            if (Kx==1u) { for (size_t i=0u; i<n; ++i) { s |= (uint64_t)(X[i]<lvl) << i; } }
+            else { for (size_t i=0u; i<n; ++i) { s |= (uint64_t)(X[i*Kx]<lvl) << i; } }
+        }
+        c = (s<<1) | sp;
+        c = (going==0) ? s^c : s&~c;
+        if (n<64u) { c &= ((uint64_t)1<<n) - 1u; }
+        *Y = c;
+        sp = s >> 63;
+    }
+}
+
+
+int lcs_bits_s (uint64_t *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going, const float lvl)
+{
+    if (dim>3u) { fprintf(stderr,"error in lcs_bits_s: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in lcs_bits_s: going must be in {-1,0,1}\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (L==N) { lcs_bits_pack_s(Y,X,L,1u,1u,going,lvl); }
+    else
+    {
+        const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t V = N/L, Lb = (L+63u)/64u;
+
+        for (size_t v=0u; v<V; ++v)
+        {
+            lcs_bits_pack_s(&Y[(v/K)*K*Lb+v%K],&X[(v/K)*K*L+v%K],L,K,K,going,lvl);
+        }
+    }
+
+    return 0;
+}
+
+
+int lcs_bits_d (uint64_t *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going, const double lvl)
+{
+    if (dim>3u) { fprintf(stderr,"error in lcs_bits_d: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in lcs_bits_d: going must be in {-1,0,1}\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (L==N) { lcs_bits_pack_d(Y,X,L,1u,1u,going,lvl); }
+    else
+    {
+        const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t V = N/L, Lb = (L+63u)/64u;
+
+        for (size_t v=0u; v<V; ++v)
+        {
+            lcs_bits_pack_d(&Y[(v/K)*K*Lb+v%K],&X[(v/K)*K*L+v%K],L,K,K,going,lvl);
+        }
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,105 @@
+//Batched Levinson-Durbin recursion for the real-valued case,
+//used by ac2ar, ac2rc, ac2poly, sig2ar, sig2rc, sig2poly and sig2psd when X has more than one vector.
+
+//The scalar recursion cannot be vectorized, since each step depends on the previous one,
+//and the inner loops are only of length p < P (usually P is 12-24).
+//But the vectors (frames) are independent, so this runs the recursion for LEVDURB_NL vecs at once.
+//The ACs of the vecs are first transposed into lane-major order (AC[l*NL+n] is lag l of vec n),
+//so that every step of the recursion is an inner loop over the NL lanes, which the compiler vectorizes.
+//The arithmetic within each lane is in the same order as the scalar recursion.
+
+//The callers gather NL vecs at a time into the AC block, and scatter the outputs back.
+//A final partial block is padded by repeating its first vec (and the extra lanes are discarded).
+
+//The outputs are the AR params (AR), optionally the RCs (RC, or NULL), and the error vars (E).
+//AR and RC are also in lane-major order, and A is scratch of size P*NL.
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+#define LEVDURB_NL 8u
+
+static void levdurb_lanes_s (float *AR, float *RC, float *E, const float *AC, float *A, const size_t P);
+static void levdurb_lanes_d (double *AR, double *RC, double *E, const double *AC, double *A, const size_t P);
+
+
+static void levdurb_lanes_s (float *AR, float *RC, float *E, const float *AC, float *A, const size_t P)
+{
+    const size_t NL = LEVDURB_NL;
+    float a[LEVDURB_NL], e[LEVDURB_NL];
+
+    //First step
+    for (size_t n=0u; n<NL; ++n)
+    {
+        e[n] = AC[n];
+        AR[n] = AC[NL+n] / e[n]; a[n] = -AR[n];
+        e[n] += a[n] * AC[NL+n];
+    }
+    if (RC) { for (size_t n=0u; n<NL; ++n) { RC[n] = a[n]; } }
+
+    //Remaining steps
+    for (size_t p=1u; p<P; ++p)
+    {
+        for (size_t n=0u; n<NL; ++n) { a[n] = AC[(p+1u)*NL+n]; }
+        for (size_t q=0u; q<p; ++q)
+        {
+            for (size_t n=0u; n<NL; ++n) { a[n] -= AC[(p-q)*NL+n] * AR[q*NL+n]; }
+        }
+        for (size_t n=0u; n<NL; ++n) { a[n] /= -e[n]; AR[p*NL+n] = -a[n]; }
+        if (RC) { for (size_t n=0u; n<NL; ++n) { RC[p*NL+n] = a[n]; } }
+        for (size_t q=0u; q<p*NL; ++q) { A[q] = AR[q]; }
+        for (size_t q=0u; q<p; ++q)
+        {
+            for (size_t n=0u; n<NL; ++n) { AR[q*NL+n] += a[n] * A[(p-1u-q)*NL+n]; }
+        }
+        for (size_t n=0u; n<NL; ++n) { e[n] *= 1.0f - a[n]*a[n]; }
+    }
+
+    for (size_t n=0u; n<NL; ++n) { E[n] = e[n]; }
+}
+
+
+static void levdurb_lanes_d (double *AR, double *RC, double *E, const double *AC, double *A, const size_t P)
+{
+    const size_t NL = LEVDURB_NL;
+    double a[LEVDURB_NL], e[LEVDURB_NL];
+
+    //First step
+    for (size_t n=0u; n<NL; ++n)
+    {
+        e[n] = AC[n];
+        AR[n] = AC[NL+n] / e[n]; a[n] = -AR[n];
+        e[n] += a[n] * AC[NL+n];
+    }
+    if (RC) { for (size_t n=0u; n<NL; ++n) { RC[n] = a[n]; } }
+
+    //Remaining steps
+    for (size_t p=1u; p<P; ++p)
+    {
+        for (size_t n=0u; n<NL; ++n) { a[n] = AC[(p+1u)*NL+n]; }
+        for (size_t q=0u; q<p; ++q)
+        {
+            for (size_t n=0u; n<NL; ++n) { a[n] -= AC[(p-q)*NL+n] * AR[q*NL+n]; }
+        }
+        for (size_t n=0u; n<NL; ++n) { a[n] /= -e[n]; AR[p*NL+n] = -a[n]; }
+        if (RC) { for (size_t n=0u; n<NL; ++n) { RC[p*NL+n] = a[n]; } }
+        for (size_t q=0u; q<p*NL; ++q) { A[q] = AR[q]; }
+        for (size_t q=0u; q<p; ++q)
+        {
+            for (size_t n=0u; n<NL; ++n) { AR[q*NL+n] += a[n] * A[(p-1u-q)*NL+n]; }
+        }
+        for (size_t n=0u; n<NL; ++n) { e[n] *= 1.0 - a[n]*a[n]; }
+    }
+
+    for (size_t n=0u; n<NL; ++n) { E[n] = e[n]; }
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,193 @@
+//Time-varying (frame-wise) LPC filtering of vector X, with per-frame polynomial coeffs in A.
+//This is for LPC residuals (inverse filtering) and resynthesis with the output of sig2poly,
+//without splitting X into frames: the filter runs continuously over X with carried state,
+//so there are no edge discontinuities at frame boundaries, and there is only one call.
+
+//A has W frames of P+1 polynomial coeffs (a0 a1 ... aP), usually with a0=1.
+//The P+1 coeffs of each frame are contiguous in memory (as in frame_univar),
+//so A has size W x (P+1) if row-major, or (P+1) x W if col-major.
+//Frame w is used for samples w*stp to w*stp+stp-1 (the last frame is used to the end of X).
+
+//If syn==0, this is the inverse (analysis) filter A(z), giving the residual:
+//Y[n] = (a0*X[n] + a1*X[n-1] + ... + aP*X[n-P]) / a0
+//If syn!=0, this is the synthesis filter 1/A(z):
+//Y[n] = X[n] - (a1*Y[n-1] + ... + aP*Y[n-P]) / a0
+//So the synthesis of the residual with the same A gives back X (up to float precision).
+
+//If interp!=0, the coeffs are linearly interpolated over each hop,
+//starting at frame w (at sample w*stp) and reaching frame w+1 (at sample w*stp+stp).
+//This avoids abrupt changes at frame boundaries.
+//(Interpolated polynomials are not guaranteed stable for synthesis, but are for small changes.)
+
+//Z is the state carried between calls (for streaming), or NULL.
+//If NULL, X starts from zero initial conditions.
+//If not NULL, Z has length P, and must be zeros before the first call.
+//It holds the last P inputs (syn==0) or outputs (syn!=0), most recent first.
+//Frame indices restart at 0 on each call, so each call should start at a frame boundary.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+int lpc_filt_s (float *Y, const float *X, const float *A, float *Z, const size_t N, const size_t W, const size_t P, const size_t stp, const int syn, const int interp);
+int lpc_filt_d (double *Y, const double *X, const double *A, double *Z, const size_t N, const size_t W, const size_t P, const size_t stp, const int syn, const int interp);
+
+
+int lpc_filt_s (float *Y, const float *X, const float *A, float *Z, const size_t N, const size_t W, const size_t P, const size_t stp, const int syn, const int interp)
+{
+    if (W<1u) { fprintf(stderr,"error in lpc_filt_s: W (num frames) must be positive\n"); return 1; }
+    if (stp<1u) { fprintf(stderr,"error in lpc_filt_s: stp (frame step) must be positive\n"); return 1; }
+
+    if (N==0u) {}
+    else
+    {
+        const size_t P1 = P + 1u;
+        const float dt = 1.0f / (float)stp;
+        float *hb, *da, s, d, t;
+
+        //History buffer: P past samples (oldest first), then up to stp new samples
+        if (!(hb=(float *)malloc((P+stp)*sizeof(float)))) { fprintf(stderr,"error in lpc_filt_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(da=(float *)malloc(P1*sizeof(float)))) { fprintf(stderr,"error in lpc_filt_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (Z) { for (size_t p=0u; p<P; ++p) { hb[P-1u-p] = Z[p]; } }
+        else { for (size_t p=0u; p<P; ++p) { hb[p] = 0.0f; } }
+
+        for (size_t n0=0u; n0<N; n0+=stp)
+        {
+            //Frame and number of samples in this hop
+            const size_t w = (n0/stp<W) ? n0/stp : W-1u;
+            const size_t nh = (N-n0<stp) ? N-n0 : stp;
+            const float *a = &A[w*P1];
+            const int ip = (interp && w+1u<W);
+
+            //Coeff change over this hop (for interpolation)
+            if (ip) { for (size_t p=0u; p<P1; ++p) { da[p] = A[(w+1u)*P1+p] - a[p]; } }
+
+            if (!syn)
+            {
+                for (size_t n=0u; n<nh; ++n) { hb[P+n] = X[n0+n]; }
+                for (size_t n=0u; n<nh; ++n)
+                {
+                    s = 0.0f;
+                    for (size_t p=0u; p<P1; ++p) { s += a[p]*hb[P+n-p]; }
+                    if (ip)
+                    {
+                        d = 0.0f; t = (float)n * dt;
+                        for (size_t p=0u; p<P1; ++p) { d += da[p]*hb[P+n-p]; }
+                        Y[n0+n] = (s+t*d) / (a[0]+t*da[0]);
+                    }
+                    else { Y[n0+n] = s / a[0]; }
+                }
+            }
+            else
+            {
+                for (size_t n=0u; n<nh; ++n)
+                {
+                    s = 0.0f;
+                    for (size_t p=1u; p<P1; ++p) { s += a[p]*hb[P+n-p]; }
+                    if (ip)
+                    {
+                        d = 0.0f; t = (float)n * dt;
+                        for (size_t p=1u; p<P1; ++p) { d += da[p]*hb[P+n-p]; }
+                        hb[P+n] = X[n0+n] - (s+t*d)/(a[0]+t*da[0]);
+                    }
+                    else { hb[P+n] = X[n0+n] - s/a[0]; }
+                    Y[n0+n] = hb[P+n];
+                }
+            }
+
+            //Slide the last P samples to the front
+            for (size_t p=0u; p<P; ++p) { hb[p] = hb[p+nh]; }
+        }
+
+        if (Z) { for (size_t p=0u; p<P; ++p) { Z[p] = hb[P-1u-p]; } }
+
+        free(hb); free(da);
+    }
+
+    return 0;
+}
+
+
+int lpc_filt_d (double *Y, const double *X, const double *A, double *Z, const size_t N, const size_t W, const size_t P, const size_t stp, const int syn, const int interp)
+{
+    if (W<1u) { fprintf(stderr,"error in lpc_filt_d: W (num frames) must be positive\n"); return 1; }
+    if (stp<1u) { fprintf(stderr,"error in lpc_filt_d: stp (frame step) must be positive\n"); return 1; }
+
+    if (N==0u) {}
+    else
+    {
+        const size_t P1 = P + 1u;
+        const double dt = 1.0 / (double)stp;
+        double *hb, *da, s, d, t;
+
+        //History buffer: P past samples (oldest first), then up to stp new samples
+        if (!(hb=(double *)malloc((P+stp)*sizeof(double)))) { fprintf(stderr,"error in lpc_filt_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(da=(double *)malloc(P1*sizeof(double)))) { fprintf(stderr,"error in lpc_filt_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (Z) { for (size_t p=0u; p<P; ++p) { hb[P-1u-p] = Z[p]; } }
+        else { for (size_t p=0u; p<P; ++p) { hb[p] = 0.0; } }
+
+        for (size_t n0=0u; n0<N; n0+=stp)
+        {
+            //Frame and number of samples in this hop
+            const size_t w = (n0/stp<W) ? n0/stp : W-1u;
+            const size_t nh = (N-n0<stp) ? N-n0 : stp;
+            const double *a = &A[w*P1];
+            const int ip = (interp && w+1u<W);
+
+            //Coeff change over this hop (for interpolation)
+            if (ip) { for (size_t p=0u; p<P1; ++p) { da[p] = A[(w+1u)*P1+p] - a[p]; } }
+
+            if (!syn)
+            {
+                for (size_t n=0u; n<nh; ++n) { hb[P+n] = X[n0+n]; }
+                for (size_t n=0u; n<nh; ++n)
+                {
+                    s = 0.0;
+                    for (size_t p=0u; p<P1; ++p) { s += a[p]*hb[P+n-p]; }
+                    if (ip)
+                    {
+                        d = 0.0; t = (double)n * dt;
+                        for (size_t p=0u; p<P1; ++p) { d += da[p]*hb[P+n-p]; }
+                        Y[n0+n] = (s+t*d) / (a[0]+t*da[0]);
+                    }
+                    else { Y[n0+n] = s / a[0]; }
+                }
+            }
+            else
+            {
+                for (size_t n=0u; n<nh; ++n)
+                {
+                    s = 0.0;
+                    for (size_t p=1u; p<P1; ++p) { s += a[p]*hb[P+n-p]; }
+                    if (ip)
+                    {
+                        d = 0.0; t = (double)n * dt;
+                        for (size_t p=1u; p<P1; ++p) { d += da[p]*hb[P+n-p]; }
+                        hb[P+n] = X[n0+n] - (s+t*d)/(a[0]+t*da[0]);
+                    }
+                    else { hb[P+n] = X[n0+n] - s/a[0]; }
+                    Y[n0+n] = hb[P+n];
+                }
+            }
+
+            //Slide the last P samples to the front
+            for (size_t p=0u; p<P; ++p) { hb[p] = hb[p+nh]; }
+        }
+
+        if (Z) { for (size_t p=0u; p<P; ++p) { Z[p] = hb[P-1u-p]; } }
+
+        free(hb); free(da);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -1,8 +1,11 @@
 //This gets MCs as usual, and then averages over (rectangular) window of length Lw.
 //See mcs.c and zcr.c for general comments and info.
+//The MCs are packed into bits and counted by popcount; see lcr.c and lcs_bits.c.
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include "lcr.c"
 
 #ifdef __cplusplus
 namespace codee {
@@ -16,252 +19,44 @@ int mcr_d (double *Y, const double *X, const size_t R, const size_t C, const siz
 int mcr_s (float *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Lw, const int going, const int causal)
 {
     if (dim>3u) { fprintf(stderr,"error in mcr_s: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in mcr_s: going must be in {-1,0,1}\n"); return 1; }
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if (Lw<1u) { fprintf(stderr,"error in mcr_s: Lw (winlength) must be positive\n"); return 1; }
     if (Lw>L) { fprintf(stderr,"error in mcr_s: Lw (winlength) must be <= L (length of vecs in X)\n"); return 1; }
 
     if (N==0u) {}
     else
     {
-        const float Lwf = (float)Lw;
-        float y, mn;
-        int *Z, s, sp, sm;
-        if (!(Z=(int *)malloc(L*sizeof(int)))) { fprintf(stderr,"error in mcr_s: problem with malloc. "); perror("malloc"); return 1; }
+        const size_t Lb = (L+63u)/64u;
+        unsigned char T[2048];
+        uint64_t *Z;
+        float mn;
+        if (!(Z=(uint64_t *)malloc(Lb*sizeof(uint64_t)))) { fprintf(stderr,"error in mcr_s: problem with malloc. "); perror("malloc"); return 1; }
+        lcr_rate_tbl(T);
 
         if (L==N)
         {
-            //Mean
             mn = 0.0f;
-            for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
-            mn /= (float)L; X -= L;
-
-            //MCR
-            if (going==0)
-            {
-                sp = (*X++<mn); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<mn); sm += (s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (float)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else if (going==1)
-            {
-                sp = (*X++>=mn); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X>=mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (float)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else if (going==-1)
-            {
-                sp = (*X++<mn); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (float)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else { fprintf(stderr,"error in mcr_s: going must be in {-1,0,1}\n"); return 1; }
+            for (size_t l=0u; l<L; ++l) { mn += X[l]; }
+            mn /= (float)L;
+            lcs_bits_pack_s(Z,X,L,1u,1u,going,mn);
+            lcr_rate_s(Y,Z,T,L,Lw,1u,causal);
         }
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/L, G = V/B;
-
-            if (K==1u && (G==1u || B==1u))
-            {
-                if (going==0)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        mn = 0.0f;
-                        for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
-                        mn /= (float)L; X -= L;
+            const size_t V = N/L;
 
-                        sp = (*X++<mn); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<mn); sm += (s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (float)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else if (going==1)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        mn = 0.0f;
-                        for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
-                        mn /= (float)L; X -= L;
-
-                        sp = (*X++>=mn); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X>=mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (float)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else if (going==-1)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        mn = 0.0f;
-                        for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
-                        mn /= (float)L; X -= L;
-
-                        sp = (*X++<mn); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (float)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (float)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else { fprintf(stderr,"error in mcr_s: going must be in {-1,0,1}\n"); return 1; }
-            }
-            else
+            for (size_t v=0u; v<V; ++v)
             {
-                if (going==0)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            mn = 0.0f;
-                            for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
-                            mn /= (float)L; X -= K*L;
-                            sp = (*X<mn); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X<mn); sm += (s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (float)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (float)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else if (going==1)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            mn = 0.0f;
-                            for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
-                            mn /= (float)L; X -= K*L;
-                            sp = (*X>=mn); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X>=mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (float)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (float)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else if (going==-1)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            mn = 0.0f;
-                            for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
-                            mn /= (float)L; X -= K*L;
-                            sp = (*X<mn); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X<mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (float)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (float)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else { fprintf(stderr,"error in mcr_s: going must be in {-1,0,1}\n"); return 1; }
+                const float *x = &X[(v/K)*K*L+v%K];
+                mn = 0.0f;
+                for (size_t l=0u; l<L; ++l) { mn += x[l*K]; }
+                mn /= (float)L;
+                lcs_bits_pack_s(Z,x,L,K,1u,going,mn);
+                lcr_rate_s(&Y[(v/K)*K*L+v%K],Z,T,L,Lw,K,causal);
             }
         }
         free(Z);
@@ -274,250 +69,44 @@ int mcr_s (float *Y, const float *X, const size_t R, const size_t C, const size_
 int mcr_d (double *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Lw, const int going, const int causal)
 {
     if (dim>3u) { fprintf(stderr,"error in mcr_d: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in mcr_d: going must be in {-1,0,1}\n"); return 1; }
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if (Lw<1u) { fprintf(stderr,"error in mcr_d: Lw (winlength) must be positive\n"); return 1; }
     if (Lw>L) { fprintf(stderr,"error in mcr_d: Lw (winlength) must be <= L (length of vecs in X)\n"); return 1; }
 
     if (N==0u) {}
     else
     {
-        const double Lwf = (double)Lw;
-        double y, mn;
-        int *Z, s, sp, sm;
-        if (!(Z=(int *)malloc(L*sizeof(int)))) { fprintf(stderr,"error in mcr_d: problem with malloc. "); perror("malloc"); return 1; }
+        const size_t Lb = (L+63u)/64u;
+        unsigned char T[2048];
+        uint64_t *Z;
+        double mn;
+        if (!(Z=(uint64_t *)malloc(Lb*sizeof(uint64_t)))) { fprintf(stderr,"error in mcr_d: problem with malloc. "); perror("malloc"); return 1; }
+        lcr_rate_tbl(T);
 
         if (L==N)
         {
             mn = 0.0;
-            for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
-            mn /= (double)L; X -= L;
-
-            if (going==0)
-            {
-                sp = (*X++<mn); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<mn); sm += (s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (double)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else if (going==1)
-            {
-                sp = (*X++>=mn); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X>=mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (double)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else if (going==-1)
-            {
-                sp = (*X++<mn); *Z++ = sm = 0;
-                for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                y = (double)(*Z) / Lwf;
-                for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                Z -= L;
-                if (!causal)
-                {
-                    const size_t L2 = Lw - Lw/2u - 1u;
-                    Y -= L;
-                    for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                    y = *(Y-1);
-                    for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                }
-            }
-            else { fprintf(stderr,"error in mcr_d: going must be in {-1,0,1}\n"); return 1; }
+            for (size_t l=0u; l<L; ++l) { mn += X[l]; }
+            mn /= (double)L;
+            lcs_bits_pack_d(Z,X,L,1u,1u,going,mn);
+            lcr_rate_d(Y,Z,T,L,Lw,1u,causal);
         }
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/L, G = V/B;
-
-            if (K==1u && (G==1u || B==1u))
-            {
-                if (going==0)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        mn = 0.0;
-                        for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
-                        mn /= (double)L; X -= L;
+            const size_t V = N/L;
 
-                        sp = (*X++<mn); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<mn); sm += (s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (double)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else if (going==1)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        mn = 0.0;
-                        for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
-                        mn /= (double)L; X -= L;
-
-                        sp = (*X++>=mn); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X>=mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (double)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else if (going==-1)
-                {
-                    for (size_t v=V; v>0u; --v)
-                    {
-                        mn = 0.0;
-                        for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
-                        mn /= (double)L; X -= L;
-
-                        sp = (*X++<mn); *Z++ = sm = 0;
-                        for (size_t l=L; l>1u; --l, ++X, ++Z) { s = (*X<mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                        for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                        y = (double)(*Z) / Lwf;
-                        for (size_t l=Lw-1u; l>0u; --l, ++Y) { *Y = y; }
-                        for (size_t l=L-Lw+1u; l>0u; --l, ++Y, ++Z) { *Y = (double)(*Z) / Lwf; }
-                        Z -= L;
-                        if (!causal)
-                        {
-                            const size_t L2 = Lw - Lw/2u - 1u;
-                            Y -= L;
-                            for (size_t l=L-L2; l>0u; --l, ++Y) { *Y = *(Y+L2); }
-                            y = *(Y-1);
-                            for (size_t l=L2; l>0u; --l, ++Y) { *Y = y; }
-                        }
-                    }
-                }
-                else { fprintf(stderr,"error in mcr_d: going must be in {-1,0,1}\n"); return 1; }
-            }
-            else
+            for (size_t v=0u; v<V; ++v)
             {
-                if (going==0)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            mn = 0.0;
-                            for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
-                            mn /= (double)L; X -= K*L;
-                            sp = (*X<mn); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X<mn); sm += (s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (double)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (double)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else if (going==1)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            mn = 0.0;
-                            for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
-                            mn /= (double)L; X -= K*L;
-                            sp = (*X>=mn); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X>=mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (double)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (double)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else if (going==-1)
-                {
-                    for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
-                    {
-                        for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
-                        {
-                            mn = 0.0;
-                            for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
-                            mn /= (double)L; X -= K*L;
-                            sp = (*X<mn); X+=K; *Z++ = sm = 0;
-                            for (size_t l=L; l>1u; --l, X+=K, ++Z) { s = (*X<mn); sm += s*(s!=sp); *Z = sm; sp = s; }
-                            for (size_t l=L-Lw+1u; l>0u; --l) { --Z; *Z -= *(Z-Lw); }
-                            y = (double)(*Z) / Lwf;
-                            for (size_t l=Lw-1u; l>0u; --l, Y+=K) { *Y = y; }
-                            for (size_t l=L-Lw+1u; l>0u; --l, Y+=K, ++Z) { *Y = (double)(*Z) / Lwf; }
-                            Z -= L;
-                            if (!causal)
-                            {
-                                const size_t L2 = Lw - Lw/2u - 1u;
-                                Y -= K*L;
-                                for (size_t l=L-L2; l>0u; --l, Y+=K) { *Y = *(Y+K*L2); }
-                                y = *(Y-K);
-                                for (size_t l=L2; l>0u; --l, Y+=K) { *Y = y; }
-                            }
-                        }
-                    }
-                }
-                else { fprintf(stderr,"error in mcr_d: going must be in {-1,0,1}\n"); return 1; }
+                const double *x = &X[(v/K)*K*L+v%K];
+                mn = 0.0;
+                for (size_t l=0u; l<L; ++l) { mn += x[l*K]; }
+                mn /= (double)L;
+                lcs_bits_pack_d(Z,x,L,K,1u,going,mn);
+                lcr_rate_d(&Y[(v/K)*K*L+v%K],Z,T,L,Lw,K,causal);
             }
         }
         free(Z);
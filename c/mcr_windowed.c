@@ -3,11 +3,13 @@
 //
 //No internal normalization by the sum of X2 is done here:
 //X2 should sum to 1 if the output Y is interpreted as a moving average.
+//See lcr_windowed.c for the windowing (O(1) per frame for rectangular or exponential X2).
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <float.h>
 #include <math.h>
+#include "lcr_windowed.c"
 
 #ifdef __cplusplus
 namespace codee {
@@ -37,18 +39,16 @@ int mcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
     if (W==0u) {}
     else
     {
-        const size_t Lpre = Lw/2u;                  //nsamps before center samp
-        const size_t Lpost = Lw-Lpre-1u;            //nsamps after center samp
-        size_t w = 0u;                              //current frame
-        float cc = c0;                              //current exact center-samp
-        int cs = (int)roundf(c0);                   //current rounded center-samp
-        int ss, es = cs + (int)Lpost;               //current rounded start-samp, end-samp
-        int prev_cs;                                //previous rounded center-samp
         int *Z, s, sp;                              //ints for MCR
-        float sm, mn;                               //local sum, mean for MCR
+        double *F = NULL, r = 1.0;                  //prefix sums or recursion, ratio for exponential X2
+        float mn;                                   //mean for MCR
+
+        //Get window type
+        const int wtyp = lcr_windowed_wtyp_s(&r,X2,Lw);
 
         //Allocate
         if (!(Z=(int *)malloc(Lx*sizeof(int)))) { fprintf(stderr,"error in mcr_windowed_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (wtyp>0 && !(F=(double *)malloc((Lx+1u)*sizeof(double)))) { fprintf(stderr,"error in mcr_windowed_s: problem with malloc. "); perror("malloc"); free(Z); return 1; }
 
         //Get block and vec sizes
         const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
@@ -58,7 +58,7 @@ int mcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
         if (K==1u && (G==1u || B==1u))
         {
             //For each vec in X1
-            for (size_t v=V; v>0u; --v)
+            for (size_t v=V; v>0u; --v, Y+=W)
             {
                 //Mean
                 mn = 0.0f;
@@ -83,66 +83,15 @@ int mcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
                 }
                 Z -= Lx;
 
-                //Initialize windowing
-                w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                //Windows before first samp
-                while (es<0 && w<W)
-                {
-                    *Y++ = 0.0f;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    es = cs + (int)Lpost;
-                }
-                ss = cs - (int)Lpre;
-                prev_cs = cs;
-
-                //Windows overlapping first samp
-                while (ss<0 && w<W)
-                {
-                    sm = 0.0f; X2 -= ss;
-                    for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (float)(*Z) * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z -= (int)Lw + ss; X2 -= Lw;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z += ss;
-                es = cs + (int)Lpost;
-                
-                //Windows fully within sig
-                while (es<(int)Lx && w<W)
-                {
-                    sm = 0.0f;
-                    for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (float)*Z * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                    es = cs + (int)Lpost; prev_cs = cs;
-                }
-                ss = cs - (int)Lpre;
-
-                //Windows overlapping last samp
-                while (ss<(int)Lx && w<W)
-                {
-                    sm = 0.0f;
-                    for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (float)(*Z) * *X2; }
-                    *Y++ = sm;
-                    X2 += ss - (int)Lx;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z += cs - prev_cs - (int)Lx + ss;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z -= cs - prev_cs + ss;
-
-                //Windows after last samp
-                while (w<W) { *Y++ = 0.0f; ++w; }
+                //Apply window
+                lcr_windowed_frames_s(Y,Z,F,X2,Lx,Lw,W,1u,c0,stp,wtyp,r);
             }
         }
         else
         {
             for (size_t g=G; g>0u; --g, X1+=B*(Lx-1u), Y+=B*(W-1u))
             {
-                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, Y-=K*W-1u)
+                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, ++Y)
                 {
                     //Mean
                     mn = 0.0f;
@@ -167,64 +116,13 @@ int mcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
                     }
                     Z -= Lx;
 
-                    //Initialize windowing
-                    w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                    //Windows before first samp
-                    while (es<0 && w<W)
-                    {
-                        *Y = 0.0f; Y += K;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        es = cs + (int)Lpost;
-                    }
-                    ss = cs - (int)Lpre;
-                    prev_cs = cs;
-
-                    //Windows overlapping first samp
-                    while (ss<0 && w<W)
-                    {
-                        sm = 0.0f; X2 -= ss;
-                        for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (float)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        Z -= (int)Lw + ss; X2 -= Lw;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z += ss;
-                    es = cs + (int)Lpost;
-                    
-                    //Windows fully within sig
-                    while (es<(int)Lx && w<W)
-                    {
-                        sm = 0.0f;
-                        for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (float)*Z * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                        es = cs + (int)Lpost; prev_cs = cs;
-                    }
-                    ss = cs - (int)Lpre;
-
-                    //Windows overlapping last samp
-                    while (ss<(int)Lx && w<W)
-                    {
-                        sm = 0.0f;
-                        for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (float)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        X2 += ss - (int)Lx;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        Z += cs - prev_cs - (int)Lx + ss;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z -= cs - prev_cs + ss;
-
-                    //Windows after last samp
-                    while (w<W) { *Y = 0.0f; Y += K; ++w; }
+                    //Apply window
+                    lcr_windowed_frames_s(Y,Z,F,X2,Lx,Lw,W,K,c0,stp,wtyp,r);
                 }
             }
         }
         
-        free(Z);
+        free(Z); free(F);
     }
 
     return 0;
@@ -250,18 +148,16 @@ int mcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
     if (W==0u) {}
     else
     {
-        const size_t Lpre = Lw/2u;                  //nsamps before center samp
-        const size_t Lpost = Lw-Lpre-1u;            //nsamps after center samp
-        size_t w = 0u;                              //current frame
-        double cc = c0;                             //current exact center-samp
-        int cs = (int)round(c0);                    //current rounded center-samp
-        int ss, es = cs + (int)Lpost;               //current rounded start-samp, end-samp
-        int prev_cs;                                //previous rounded center-samp
         int *Z, s, sp;                              //ints for MCR
-        double sm, mn;                              //local sum, mean for MCR
+        double *F = NULL, r = 1.0;                  //prefix sums or recursion, ratio for exponential X2
+        double mn;                                  //mean for MCR
+
+        //Get window type
+        const int wtyp = lcr_windowed_wtyp_d(&r,X2,Lw);
 
         //Allocate
         if (!(Z=(int *)malloc(Lx*sizeof(int)))) { fprintf(stderr,"error in mcr_windowed_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (wtyp>0 && !(F=(double *)malloc((Lx+1u)*sizeof(double)))) { fprintf(stderr,"error in mcr_windowed_d: problem with malloc. "); perror("malloc"); free(Z); return 1; }
 
         //Get block and vec sizes
         const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
@@ -271,7 +167,7 @@ int mcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
         if (K==1u && (G==1u || B==1u))
         {
             //For each vec in X1
-            for (size_t v=V; v>0u; --v)
+            for (size_t v=V; v>0u; --v, Y+=W)
             {
                 //Mean
                 mn = 0.0;
@@ -296,66 +192,15 @@ int mcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
                 }
                 Z -= Lx;
 
-                //Initialize windowing
-                w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                //Windows before first samp
-                while (es<0 && w<W)
-                {
-                    *Y++ = 0.0;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    es = cs + (int)Lpost;
-                }
-                ss = cs - (int)Lpre;
-                prev_cs = cs;
-
-                //Windows overlapping first samp
-                while (ss<0 && w<W)
-                {
-                    sm = 0.0; X2 -= ss;
-                    for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (double)(*Z) * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z -= (int)Lw + ss; X2 -= Lw;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z += ss;
-                es = cs + (int)Lpost;
-                
-                //Windows fully within sig
-                while (es<(int)Lx && w<W)
-                {
-                    sm = 0.0;
-                    for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (double)*Z * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                    es = cs + (int)Lpost; prev_cs = cs;
-                }
-                ss = cs - (int)Lpre;
-
-                //Windows overlapping last samp
-                while (ss<(int)Lx && w<W)
-                {
-                    sm = 0.0;
-                    for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (double)(*Z) * *X2; }
-                    *Y++ = sm;
-                    X2 += ss - (int)Lx;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z += cs - prev_cs - (int)Lx + ss;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z -= cs - prev_cs + ss;
-
-                //Windows after last samp
-                while (w<W) { *Y++ = 0.0; ++w; }
+                //Apply window
+                lcr_windowed_frames_d(Y,Z,F,X2,Lx,Lw,W,1u,c0,stp,wtyp,r);
             }
         }
         else
         {
             for (size_t g=G; g>0u; --g, X1+=B*(Lx-1u), Y+=B*(W-1u))
             {
-                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, Y-=K*W-1u)
+                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, ++Y)
                 {
                     //Mean
                     mn = 0.0;
@@ -380,64 +225,13 @@ int mcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
                     }
                     Z -= Lx;
 
-                    //Initialize windowing
-                    w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                    //Windows before first samp
-                    while (es<0 && w<W)
-                    {
-                        *Y = 0.0; Y += K;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        es = cs + (int)Lpost;
-                    }
-                    ss = cs - (int)Lpre;
-                    prev_cs = cs;
-
-                    //Windows overlapping first samp
-                    while (ss<0 && w<W)
-                    {
-                        sm = 0.0; X2 -= ss;
-                        for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (double)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        Z -= (int)Lw + ss; X2 -= Lw;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z += ss;
-                    es = cs + (int)Lpost;
-                    
-                    //Windows fully within sig
-                    while (es<(int)Lx && w<W)
-                    {
-                        sm = 0.0;
-                        for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (double)*Z * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                        es = cs + (int)Lpost; prev_cs = cs;
-                    }
-                    ss = cs - (int)Lpre;
-
-                    //Windows overlapping last samp
-                    while (ss<(int)Lx && w<W)
-                    {
-                        sm = 0.0;
-                        for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (double)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        X2 += ss - (int)Lx;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        Z += cs - prev_cs - (int)Lx + ss;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z -= cs - prev_cs + ss;
-
-                    //Windows after last samp
-                    while (w<W) { *Y = 0.0; Y += K; ++w; }
+                    //Apply window
+                    lcr_windowed_frames_d(Y,Z,F,X2,Lx,Lw,W,K,c0,stp,wtyp,r);
                 }
             }
         }
         
-        free(Z);
+        free(Z); free(F);
     }
 
     return 0;
@@ -1,5 +1,6 @@
 //Mean-crossings (MCs) by same method as zero-crossings (ZCs).
 //If mean happens to equal 0.0, then same output as zcs.
+//See mcs_bits.c for a bit-packed output.
 
 #include <stdio.h>
 
@@ -18,7 +19,7 @@ int mcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
-    int s, sp;
+    int s;
     float mn;
 
     if (N==0u) {}
@@ -31,18 +32,18 @@ int mcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
 
         if (going==0)
         {
-            sp = (*X++<mn); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = (s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<mn)!=(*(X-1)<mn)); }
         }
         else if (going==1)
         {
-            sp = (*X++>=mn); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=mn); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=mn); *Y = s & (s!=(*(X-1)>=mn)); }
         }
         else if (going==-1)
         {
-            sp = (*X++<mn); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = s & (s!=(*(X-1)<mn)); }
         }
         else { fprintf(stderr,"error in mcs_s: going must be in {-1,0,1}\n"); return 1; }
     }
@@ -61,8 +62,8 @@ int mcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                     mn = 0.0f;
                     for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
                     mn /= (float)L; X -= L;
-                    sp = (*X++<mn); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = (s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<mn)!=(*(X-1)<mn)); }
                 }
             }
             else if (going==1)
@@ -72,8 +73,8 @@ int mcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                     mn = 0.0f;
                     for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
                     mn /= (float)L; X -= L;
-                    sp = (*X++>=mn); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=mn); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=mn); *Y = s & (s!=(*(X-1)>=mn)); }
                 }
             }
             else if (going==-1)
@@ -83,8 +84,8 @@ int mcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                     mn = 0.0f;
                     for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
                     mn /= (float)L; X -= L;
-                    sp = (*X++<mn); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = s & (s!=(*(X-1)<mn)); }
                 }
             }
             else { fprintf(stderr,"error in mcs_s: going must be in {-1,0,1}\n"); return 1; }
@@ -100,8 +101,8 @@ int mcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                         mn = 0.0f;
                         for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
                         mn /= (float)L; X -= L*K;
-                        sp = (*X<mn); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<mn); *Y = (s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { *Y = ((*X<mn)!=(*(X-K)<mn)); }
                     }
                 }
             }
@@ -114,8 +115,8 @@ int mcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                         mn = 0.0f;
                         for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
                         mn /= (float)L; X -= L*K;
-                        sp = (*X>=mn); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=mn); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=mn); *Y = s & (s!=(*(X-K)>=mn)); }
                     }
                 }
             }
@@ -128,8 +129,8 @@ int mcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                         mn = 0.0f;
                         for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
                         mn /= (float)L; X -= L*K;
-                        sp = (*X<mn); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<mn); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<mn); *Y = s & (s!=(*(X-K)<mn)); }
                     }
                 }
             }
@@ -147,7 +148,7 @@ int mcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
-    int s, sp;
+    int s;
     double mn;
 
     if (N==0u) {}
@@ -160,18 +161,18 @@ int mcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
 
         if (going==0)
         {
-            sp = (*X++<mn); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = (s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<mn)!=(*(X-1)<mn)); }
         }
         else if (going==1)
         {
-            sp = (*X++>=mn); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=mn); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=mn); *Y = s & (s!=(*(X-1)>=mn)); }
         }
         else if (going==-1)
         {
-            sp = (*X++<mn); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = s & (s!=(*(X-1)<mn)); }
         }
         else { fprintf(stderr,"error in mcs_d: going must be in {-1,0,1}\n"); return 1; }
     }
@@ -190,8 +191,8 @@ int mcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                     mn = 0.0;
                     for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
                     mn /= (double)L; X -= L;
-                    sp = (*X++<mn); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = (s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<mn)!=(*(X-1)<mn)); }
                 }
             }
             else if (going==1)
@@ -201,8 +202,8 @@ int mcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                     mn = 0.0;
                     for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
                     mn /= (double)L; X -= L;
-                    sp = (*X++>=mn); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=mn); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=mn); *Y = s & (s!=(*(X-1)>=mn)); }
                 }
             }
             else if (going==-1)
@@ -212,8 +213,8 @@ int mcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                     mn = 0.0;
                     for (size_t l=L; l>0u; --l, ++X) { mn += *X; }
                     mn /= (double)L; X -= L;
-                    sp = (*X++<mn); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<mn); *Y = s & (s!=(*(X-1)<mn)); }
                 }
             }
             else { fprintf(stderr,"error in mcs_d: going must be in {-1,0,1}\n"); return 1; }
@@ -229,8 +230,8 @@ int mcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                         mn = 0.0;
                         for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
                         mn /= (double)L; X -= L*K;
-                        sp = (*X<mn); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<mn); *Y = (s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { *Y = ((*X<mn)!=(*(X-K)<mn)); }
                     }
                 }
             }
@@ -243,8 +244,8 @@ int mcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                         mn = 0.0;
                         for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
                         mn /= (double)L; X -= L*K;
-                        sp = (*X>=mn); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=mn); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=mn); *Y = s & (s!=(*(X-K)>=mn)); }
                     }
                 }
             }
@@ -257,8 +258,8 @@ int mcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                         mn = 0.0;
                         for (size_t l=L; l>0u; --l, X+=K) { mn += *X; }
                         mn /= (double)L; X -= L*K;
-                        sp = (*X<mn); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<mn); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<mn); *Y = s & (s!=(*(X-K)<mn)); }
                     }
                 }
             }
@@ -0,0 +1,93 @@
+//Mean crossings, with bit-packed output.
+//This gives the same crossings as mcs, but with 1 bit per sample instead of 1 int (32x less memory).
+//See lcs_bits.c for the packed format and method.
+
+#include <stdio.h>
+#include <stdint.h>
+#include "lcs_bits.c"
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+int mcs_bits_s (uint64_t *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going);
+int mcs_bits_d (uint64_t *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going);
+
+
+int mcs_bits_s (uint64_t *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going)
+{
+    if (dim>3u) { fprintf(stderr,"error in mcs_bits_s: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in mcs_bits_s: going must be in {-1,0,1}\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    float mn;
+
+    if (N==0u) {}
+    else if (L==N)
+    {
+        mn = 0.0f;
+        for (size_t l=0u; l<L; ++l) { mn += X[l]; }
+        mn /= (float)L;
+        lcs_bits_pack_s(Y,X,L,1u,1u,going,mn);
+    }
+    else
+    {
+        const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t V = N/L, Lb = (L+63u)/64u;
+
+        for (size_t v=0u; v<V; ++v)
+        {
+            const float *x = &X[(v/K)*K*L+v%K];
+            mn = 0.0f;
+            for (size_t l=0u; l<L; ++l) { mn += x[l*K]; }
+            mn /= (float)L;
+            lcs_bits_pack_s(&Y[(v/K)*K*Lb+v%K],x,L,K,K,going,mn);
+        }
+    }
+
+    return 0;
+}
+
+
+int mcs_bits_d (uint64_t *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going)
+{
+    if (dim>3u) { fprintf(stderr,"error in mcs_bits_d: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in mcs_bits_d: going must be in {-1,0,1}\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    double mn;
+
+    if (N==0u) {}
+    else if (L==N)
+    {
+        mn = 0.0;
+        for (size_t l=0u; l<L; ++l) { mn += X[l]; }
+        mn /= (double)L;
+        lcs_bits_pack_d(Y,X,L,1u,1u,going,mn);
+    }
+    else
+    {
+        const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t V = N/L, Lb = (L+63u)/64u;
+
+        for (size_t v=0u; v<V; ++v)
+        {
+            const double *x = &X[(v/K)*K*L+v%K];
+            mn = 0.0;
+            for (size_t l=0u; l<L; ++l) { mn += x[l*K]; }
+            mn /= (double)L;
+            lcs_bits_pack_d(&Y[(v/K)*K*Lb+v%K],x,L,K,K,going,mn);
+        }
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
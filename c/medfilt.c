@@ -0,0 +1,258 @@
+//Sliding median (or other order statistic) filter of each vector in X along dim.
+//This is like medfilt1 of Octave, and medfilt of SciPy, with zero-padding at the edges.
+
+//Each output Y[n] is the order statistic of rank k = round(p/100*(W-1))
+//of the W inputs X[n-h] ... X[n-h+W-1], where h = (W-1)/2 (so centered for odd W).
+//p is the percentile in [0 100], and p=50 gives the median (for even W, the lower median).
+
+//The window is kept in a pair of heaps (a max-heap of the k+1 smallest values,
+//and a min-heap of the others), and each new sample replaces the oldest one in place.
+//So each output costs O(log W), rather than O(W log W) to sort each window.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void medfilt_sift_s (size_t *hq, const size_t n, size_t i, const float *val, size_t *hp, const float sg);
+static void medfilt_sift_d (size_t *hq, const size_t n, size_t i, const double *val, size_t *hp, const double sg);
+static void medfilt_1d_s (float *Y, const float *X, float *val, size_t *hq, size_t *hp, char *hid, const size_t L, const size_t K, const size_t W, const size_t k);
+static void medfilt_1d_d (double *Y, const double *X, double *val, size_t *hq, size_t *hp, char *hid, const size_t L, const size_t K, const size_t W, const size_t k);
+
+int medfilt_s (float *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t W, const float p, const size_t dim);
+int medfilt_d (double *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t W, const double p, const size_t dim);
+
+
+static void medfilt_sift_s (size_t *hq, const size_t n, size_t i, const float *val, size_t *hp, const float sg)
+{
+    const size_t s = hq[i];
+    const float v = sg * val[s];
+    size_t j;
+
+    //Sift up
+    while (i>0u && v<sg*val[hq[(i-1u)/2u]]) { j = (i-1u)/2u; hq[i] = hq[j]; hp[hq[i]] = i; i = j; }
+
+    //Sift down
+    while ((j=2u*i+1u)<n)
+    {
+        if (j+1u<n && sg*val[hq[j+1u]]<sg*val[hq[j]]) { ++j; }
+        if (sg*val[hq[j]]<v) { hq[i] = hq[j]; hp[hq[i]] = i; i = j; }
+        else { break; }
+    }
+    hq[i] = s; hp[s] = i;
+}
+
+
+static void medfilt_sift_d (size_t *hq, const size_t n, size_t i, const double *val, size_t *hp, const double sg)
+{
+    const size_t s = hq[i];
+    const double v = sg * val[s];
+    size_t j;
+
+    //Sift up
+    while (i>0u && v<sg*val[hq[(i-1u)/2u]]) { j = (i-1u)/2u; hq[i] = hq[j]; hp[hq[i]] = i; i = j; }
+
+    //Sift down
+    while ((j=2u*i+1u)<n)
+    {
+        if (j+1u<n && sg*val[hq[j+1u]]<sg*val[hq[j]]) { ++j; }
+        if (sg*val[hq[j]]<v) { hq[i] = hq[j]; hp[hq[i]] = i; i = j; }
+        else { break; }
+    }
+    hq[i] = s; hp[s] = i;
+}
+
+
+static void medfilt_1d_s (float *Y, const float *X, float *val, size_t *hq, size_t *hp, char *hid, const size_t L, const size_t K, const size_t W, const size_t k)
+{
+    const size_t nlo = k + 1u, nhi = W - nlo;
+    const size_t h = (W-1u)/2u, D = W - 1u - h;
+    size_t *lo = hq, *hi = hq + nlo;
+    size_t s = 0u, t;
+    float x;
+
+    //Init window to zeros
+    for (size_t w=0u; w<W; ++w) { val[w] = 0.0f; }
+    for (size_t w=0u; w<nlo; ++w) { lo[w] = w; hp[w] = w; hid[w] = 0; }
+    for (size_t w=nlo; w<W; ++w) { hi[w-nlo] = w; hp[w] = w - nlo; hid[w] = 1; }
+
+    for (size_t j=0u; j<L+D; ++j)
+    {
+        //Replace the oldest sample
+        if (j<L) { x = *X; X += K; } else { x = 0.0f; }
+        val[s] = x;
+        if (hid[s]) { medfilt_sift_s(hi,nhi,hp[s],val,hp,1.0f); }
+        else { medfilt_sift_s(lo,nlo,hp[s],val,hp,-1.0f); }
+        if (nhi>0u && val[lo[0]]>val[hi[0]])
+        {
+            t = lo[0]; lo[0] = hi[0]; hi[0] = t;
+            hid[lo[0]] = 0; hid[hi[0]] = 1;
+            medfilt_sift_s(lo,nlo,0u,val,hp,-1.0f);
+            medfilt_sift_s(hi,nhi,0u,val,hp,1.0f);
+        }
+        if (++s==W) { s = 0u; }
+
+        //Output
+        if (j>=D) { *Y = val[lo[0]]; Y += K; }
+    }
+}
+
+
+static void medfilt_1d_d (double *Y, const double *X, double *val, size_t *hq, size_t *hp, char *hid, const size_t L, const size_t K, const size_t W, const size_t k)
+{
+    const size_t nlo = k + 1u, nhi = W - nlo;
+    const size_t h = (W-1u)/2u, D = W - 1u - h;
+    size_t *lo = hq, *hi = hq + nlo;
+    size_t s = 0u, t;
+    double x;
+
+    //Init window to zeros
+    for (size_t w=0u; w<W; ++w) { val[w] = 0.0; }
+    for (size_t w=0u; w<nlo; ++w) { lo[w] = w; hp[w] = w; hid[w] = 0; }
+    for (size_t w=nlo; w<W; ++w) { hi[w-nlo] = w; hp[w] = w - nlo; hid[w] = 1; }
+
+    for (size_t j=0u; j<L+D; ++j)
+    {
+        //Replace the oldest sample
+        if (j<L) { x = *X; X += K; } else { x = 0.0; }
+        val[s] = x;
+        if (hid[s]) { medfilt_sift_d(hi,nhi,hp[s],val,hp,1.0); }
+        else { medfilt_sift_d(lo,nlo,hp[s],val,hp,-1.0); }
+        if (nhi>0u && val[lo[0]]>val[hi[0]])
+        {
+            t = lo[0]; lo[0] = hi[0]; hi[0] = t;
+            hid[lo[0]] = 0; hid[hi[0]] = 1;
+            medfilt_sift_d(lo,nlo,0u,val,hp,-1.0);
+            medfilt_sift_d(hi,nhi,0u,val,hp,1.0);
+        }
+        if (++s==W) { s = 0u; }
+
+        //Output
+        if (j>=D) { *Y = val[lo[0]]; Y += K; }
+    }
+}
+
+
+int medfilt_s (float *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t W, const float p, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in medfilt_s: dim must be in [0 3]\n"); return 1; }
+    if (W<1u) { fprintf(stderr,"error in medfilt_s: W (window length) must be positive\n"); return 1; }
+    if (p<0.0f || p>100.0f) { fprintf(stderr,"error in medfilt_s: p (percentile) must be in [0 100]\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    const size_t k = (size_t)(0.01f*p*(float)(W-1u) + 0.5f);
+
+    if (N==0u) {}
+    else if (W==1u)
+    {
+        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = *X; }
+    }
+    else
+    {
+        float *val; size_t *hq, *hp; char *hid;
+        if (!(val=(float *)malloc(W*sizeof(float)))) { fprintf(stderr,"error in medfilt_s: problem with malloc\n"); return 1; }
+        if (!(hq=(size_t *)malloc(2u*W*sizeof(size_t)))) { fprintf(stderr,"error in medfilt_s: problem with malloc\n"); return 1; }
+        if (!(hid=(char *)malloc(W*sizeof(char)))) { fprintf(stderr,"error in medfilt_s: problem with malloc\n"); return 1; }
+        hp = hq + W;
+
+        if (L==N)
+        {
+            medfilt_1d_s(Y,X,val,hq,hp,hid,L,1u,W,k);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/B;
+
+            if (K==1u && (G==1u || B==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=L)
+                {
+                    medfilt_1d_s(Y,X,val,hq,hp,hid,L,1u,W,k);
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
+                {
+                    for (size_t b=B; b>0u; --b, ++X, ++Y)
+                    {
+                        medfilt_1d_s(Y,X,val,hq,hp,hid,L,K,W,k);
+                    }
+                }
+            }
+        }
+        free(val); free(hq); free(hid);
+    }
+
+    return 0;
+}
+
+
+int medfilt_d (double *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t W, const double p, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in medfilt_d: dim must be in [0 3]\n"); return 1; }
+    if (W<1u) { fprintf(stderr,"error in medfilt_d: W (window length) must be positive\n"); return 1; }
+    if (p<0.0 || p>100.0) { fprintf(stderr,"error in medfilt_d: p (percentile) must be in [0 100]\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    const size_t k = (size_t)(0.01*p*(double)(W-1u) + 0.5);
+
+    if (N==0u) {}
+    else if (W==1u)
+    {
+        for (size_t n=N; n>0u; --n, ++X, ++Y) { *Y = *X; }
+    }
+    else
+    {
+        double *val; size_t *hq, *hp; char *hid;
+        if (!(val=(double *)malloc(W*sizeof(double)))) { fprintf(stderr,"error in medfilt_d: problem with malloc\n"); return 1; }
+        if (!(hq=(size_t *)malloc(2u*W*sizeof(size_t)))) { fprintf(stderr,"error in medfilt_d: problem with malloc\n"); return 1; }
+        if (!(hid=(char *)malloc(W*sizeof(char)))) { fprintf(stderr,"error in medfilt_d: problem with malloc\n"); return 1; }
+        hp = hq + W;
+
+        if (L==N)
+        {
+            medfilt_1d_d(Y,X,val,hq,hp,hid,L,1u,W,k);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/B;
+
+            if (K==1u && (G==1u || B==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=L)
+                {
+                    medfilt_1d_d(Y,X,val,hq,hp,hid,L,1u,W,k);
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=B*(L-1u), Y+=B*(L-1u))
+                {
+                    for (size_t b=B; b>0u; --b, ++X, ++Y)
+                    {
+                        medfilt_1d_d(Y,X,val,hq,hp,hid,L,K,W,k);
+                    }
+                }
+            }
+        }
+        free(val); free(hq); free(hid);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,376 @@
+//Sliding normalized cross-correlation (NCC) of each of Nt templates in T with the signal X,
+//as for template matching (pattern detection) of many templates against one long signal.
+
+//X is a vector of length N, and each template has length L (L <= N).
+//For each template k and each position n = 0 to N-L (i.e. shape 'valid'):
+//Y[k][n] = sum_l (X[n+l]-mx[n]) * (T[k][l]-mt[k]) / sqrt(sum_l (X[n+l]-mx[n])^2 * sum_l (T[k][l]-mt[k])^2),
+//where mx[n] is the mean of X[n:n+L-1], and mt[k] is the mean of template k.
+//This is the Pearson correlation coefficient at each lag, in [-1 1].
+//Where X or a template is constant over the window (zero variance), Y is set to 0.
+
+//Since the templates are centered (mean subtracted) first, the numerator is the raw xcorr
+//of X with the centered template, so it is computed without centering X.
+//The denominators for X use sums and sums-of-squares (in double precision), shared by all templates.
+//These are not running sums (adding X[n+L-1] and subtracting X[n] drifts after a loud part of X).
+//Instead, X is split into blocks of L: each window is a suffix sum of one block plus a prefix sum
+//of the next, both accumulated from 0 within the block, so no sample is ever subtracted.
+//This still costs O(1) per position.
+
+//The numerators are computed by direct summation or by overlap-save FFT,
+//chosen with the same cost model as xcorr_auto (see auto_cost.h).
+//For the FFT method, the templates are transformed once (one plan_many batch),
+//then each block of X is transformed once and multiplied by all template spectra,
+//which are inverse transformed in batches of up to 16 templates.
+
+//The following convention is forced here (as in conv1d_multi):
+//Samples from one template are always contiguous in memory, i.e. memory order of T is Nt x L.
+//Likewise, Y has memory order Nt x (N-L+1).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <fftw3.h>
+#include "auto_cost.h"
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static size_t ncc_nfft (const size_t N, const size_t L);
+static int ncc_fft (const size_t N, const size_t Nt, const size_t L, const double cdir, const double cfft, const double cplan);
+static int ncc_xnorm_s (float *Dx, const float *X, const size_t N, const size_t L);
+static int ncc_xnorm_d (double *Dx, const double *X, const size_t N, const size_t L);
+
+int ncc_s (float *Y, const float *X, const float *T, const size_t N, const size_t Nt, const size_t L);
+int ncc_d (double *Y, const double *X, const double *T, const size_t N, const size_t Nt, const size_t L);
+
+
+static size_t ncc_nfft (const size_t N, const size_t L)
+{
+    //Block FFT length for overlap-save: about 4L (so each block gives >= 3L outputs), but no more than needed for N
+    size_t nfft = 1u;
+    while (nfft<4u*L && nfft<N) { nfft *= 2u; }
+    while (nfft<L) { nfft *= 2u; }
+    return nfft;
+}
+
+
+static int ncc_fft (const size_t N, const size_t Nt, const size_t L, const double cdir, const double cfft, const double cplan)
+{
+    const size_t nfft = ncc_nfft(N,L), Ny = N - L + 1u;
+    const size_t B = nfft - L + 1u, nb = (Ny+B-1u) / B;
+    const double dir = cdir * (double)Nt * (double)Ny * (double)L;
+    const double fft = 3.0*cplan + cfft * (double)nfft * log2((double)nfft) * ((double)Nt + (double)nb*(double)(1u+Nt));
+    return (fft<dir);
+}
+
+
+static int ncc_xnorm_s (float *Dx, const float *X, const size_t N, const size_t L)
+{
+    //Inverse norms of the centered windows of X, for n = 0 to N-L
+    const size_t Ny = N - L + 1u;
+    double sx, sxx, px, pxx, d;
+    double *Sx;
+    if (!(Sx=(double *)malloc(2u*L*sizeof(double)))) { fprintf(stderr,"error in ncc_s: problem with malloc. "); perror("malloc"); return 1; }
+
+    for (size_t b=0u; b<Ny; b+=L)
+    {
+        const size_t nb = (Ny-b<L) ? Ny-b : L;
+        sx = sxx = 0.0;
+        for (size_t l=L; l>0u; --l)
+        {
+            sx += (double)X[b+l-1u]; sxx += (double)X[b+l-1u]*(double)X[b+l-1u];
+            Sx[2u*(l-1u)] = sx; Sx[2u*(l-1u)+1u] = sxx;
+        }
+        px = pxx = 0.0;
+        for (size_t j=0u; j<nb; ++j)
+        {
+            if (j>0u) { px += (double)X[b+L+j-1u]; pxx += (double)X[b+L+j-1u]*(double)X[b+L+j-1u]; }
+            sx = Sx[2u*j] + px; sxx = Sx[2u*j+1u] + pxx;
+            d = sxx - sx*sx/(double)L;
+            Dx[b+j] = (d>1e-12*sxx && d>0.0) ? (float)(1.0/sqrt(d)) : 0.0f;
+        }
+    }
+
+    free(Sx);
+    return 0;
+}
+
+
+static int ncc_xnorm_d (double *Dx, const double *X, const size_t N, const size_t L)
+{
+    //Inverse norms of the centered windows of X, for n = 0 to N-L
+    const size_t Ny = N - L + 1u;
+    double sx, sxx, px, pxx, d;
+    double *Sx;
+    if (!(Sx=(double *)malloc(2u*L*sizeof(double)))) { fprintf(stderr,"error in ncc_d: problem with malloc. "); perror("malloc"); return 1; }
+
+    for (size_t b=0u; b<Ny; b+=L)
+    {
+        const size_t nb = (Ny-b<L) ? Ny-b : L;
+        sx = sxx = 0.0;
+        for (size_t l=L; l>0u; --l)
+        {
+            sx += X[b+l-1u]; sxx += X[b+l-1u]*X[b+l-1u];
+            Sx[2u*(l-1u)] = sx; Sx[2u*(l-1u)+1u] = sxx;
+        }
+        px = pxx = 0.0;
+        for (size_t j=0u; j<nb; ++j)
+        {
+            if (j>0u) { px += X[b+L+j-1u]; pxx += X[b+L+j-1u]*X[b+L+j-1u]; }
+            sx = Sx[2u*j] + px; sxx = Sx[2u*j+1u] + pxx;
+            d = sxx - sx*sx/(double)L;
+            Dx[b+j] = (d>1e-12*sxx && d>0.0) ? 1.0/sqrt(d) : 0.0;
+        }
+    }
+
+    free(Sx);
+    return 0;
+}
+
+
+int ncc_s (float *Y, const float *X, const float *T, const size_t N, const size_t Nt, const size_t L)
+{
+    if (L<1u) { fprintf(stderr,"error in ncc_s: L (length of templates) must be positive\n"); return 1; }
+    if (L>N) { fprintf(stderr,"error in ncc_s: L (length of templates) must be <= N (length of X)\n"); return 1; }
+
+    if (Nt==0u) {}
+    else
+    {
+        const size_t Ny = N - L + 1u;
+        double sx, sxx, d;
+        float *Tc, *tn, *Dx;
+
+        //Centered templates and their inverse norms
+        if (!(Tc=(float *)malloc(Nt*L*sizeof(float)))) { fprintf(stderr,"error in ncc_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(tn=(float *)malloc(Nt*sizeof(float)))) { fprintf(stderr,"error in ncc_s: problem with malloc. "); perror("malloc"); return 1; }
+        for (size_t k=0u; k<Nt; ++k)
+        {
+            sx = 0.0;
+            for (size_t l=0u; l<L; ++l) { sx += (double)T[k*L+l]; }
+            sx /= (double)L; sxx = 0.0;
+            for (size_t l=0u; l<L; ++l) { d = (double)T[k*L+l] - sx; Tc[k*L+l] = (float)d; sxx += d*d; }
+            tn[k] = (sxx>0.0) ? (float)(1.0/sqrt(sxx)) : 0.0f;
+        }
+
+        //Inverse norms of the centered windows of X
+        if (!(Dx=(float *)malloc(Ny*sizeof(float)))) { fprintf(stderr,"error in ncc_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (ncc_xnorm_s(Dx,X,N,L)) { return 1; }
+
+        //Numerators
+        if (!ncc_fft(N,Nt,L,AUTO_COST_CONV1D_S,AUTO_COST_FFT_S,AUTO_COST_PLAN_S))
+        {
+            float sm;
+            for (size_t k=0u; k<Nt; ++k)
+            {
+                const float *tc = &Tc[k*L];
+                for (size_t n=0u; n<Ny; ++n)
+                {
+                    sm = 0.0f;
+                    for (size_t l=0u; l<L; ++l) { sm += X[n+l] * tc[l]; }
+                    Y[k*Ny+n] = sm;
+                }
+            }
+        }
+        else
+        {
+            const size_t nfft = ncc_nfft(N,L), F = nfft/2u + 1u;
+            const size_t B = nfft - L + 1u, NT = (Nt<16u) ? Nt : 16u;
+            const float sc = 1.0f / (float)nfft;
+            const int n[1] = {(int)nfft};
+            size_t nx, ny;
+
+            //Initialize FFTs
+            float *Xb, *Fx, *Ft, *Fy, *Yb;
+            Xb = (float *)fftwf_malloc(Nt*nfft*sizeof(float));
+            Fx = (float *)fftwf_malloc(2u*F*sizeof(float));
+            Ft = (float *)fftwf_malloc(Nt*2u*F*sizeof(float));
+            Fy = (float *)fftwf_malloc(NT*2u*F*sizeof(float));
+            Yb = (float *)fftwf_malloc(NT*nfft*sizeof(float));
+            if (!Xb || !Fx || !Ft || !Fy || !Yb) { fprintf(stderr,"error in ncc_s: problem with fftwf_malloc. "); perror("fftwf_malloc"); return 1; }
+            fftwf_plan tplan = fftwf_plan_many_dft_r2c(1,n,(int)Nt,Xb,NULL,1,(int)nfft,(fftwf_complex *)Ft,NULL,1,(int)F,FFTW_ESTIMATE);
+            if (!tplan) { fprintf(stderr,"error in ncc_s: problem creating fftw plan"); return 1; }
+            fftwf_plan fplan = fftwf_plan_dft_r2c_1d((int)nfft,Xb,(fftwf_complex *)Fx,FFTW_ESTIMATE);
+            if (!fplan) { fprintf(stderr,"error in ncc_s: problem creating fftw plan"); return 1; }
+            fftwf_plan iplan = fftwf_plan_many_dft_c2r(1,n,(int)NT,(fftwf_complex *)Fy,NULL,1,(int)F,Yb,NULL,1,(int)nfft,FFTW_ESTIMATE);
+            if (!iplan) { fprintf(stderr,"error in ncc_s: problem creating fftw plan"); return 1; }
+
+            //FFT of all templates (once), scaled by 1/nfft
+            for (size_t k=0u; k<Nt; ++k)
+            {
+                for (size_t l=0u; l<L; ++l) { Xb[k*nfft+l] = sc * Tc[k*L+l]; }
+                for (size_t l=L; l<nfft; ++l) { Xb[k*nfft+l] = 0.0f; }
+            }
+            fftwf_execute(tplan);
+
+            //Overlap-save over blocks of B outputs
+            for (size_t n0=0u; n0<Ny; n0+=B)
+            {
+                nx = (N-n0<nfft) ? N-n0 : nfft;
+                ny = (Ny-n0<B) ? Ny-n0 : B;
+                for (size_t l=0u; l<nx; ++l) { Xb[l] = X[n0+l]; }
+                for (size_t l=nx; l<nfft; ++l) { Xb[l] = 0.0f; }
+                fftwf_execute(fplan);
+                for (size_t k0=0u; k0<Nt; k0+=NT)
+                {
+                    const size_t nt = (Nt-k0<NT) ? Nt-k0 : NT;
+                    for (size_t t=0u; t<nt; ++t)
+                    {
+                        const float *ft = &Ft[2u*(k0+t)*F];
+                        float *fy = &Fy[2u*t*F];
+                        for (size_t f=0u; f<2u*F; f+=2u)
+                        {
+                            fy[f] = Fx[f]*ft[f] + Fx[f+1u]*ft[f+1u];
+                            fy[f+1u] = Fx[f+1u]*ft[f] - Fx[f]*ft[f+1u];
+                        }
+                    }
+                    fftwf_execute(iplan);
+                    for (size_t t=0u; t<nt; ++t)
+                    {
+                        for (size_t l=0u; l<ny; ++l) { Y[(k0+t)*Ny+n0+l] = Yb[t*nfft+l]; }
+                    }
+                }
+            }
+
+            fftwf_free(Xb); fftwf_free(Fx); fftwf_free(Ft); fftwf_free(Fy); fftwf_free(Yb);
+            fftwf_destroy_plan(tplan); fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+        }
+
+        //Normalize
+        for (size_t k=0u; k<Nt; ++k)
+        {
+            for (size_t n=0u; n<Ny; ++n) { Y[k*Ny+n] *= tn[k] * Dx[n]; }
+        }
+
+        free(Tc); free(tn); free(Dx);
+    }
+
+    return 0;
+}
+
+
+int ncc_d (double *Y, const double *X, const double *T, const size_t N, const size_t Nt, const size_t L)
+{
+    if (L<1u) { fprintf(stderr,"error in ncc_d: L (length of templates) must be positive\n"); return 1; }
+    if (L>N) { fprintf(stderr,"error in ncc_d: L (length of templates) must be <= N (length of X)\n"); return 1; }
+
+    if (Nt==0u) {}
+    else
+    {
+        const size_t Ny = N - L + 1u;
+        double sx, sxx, d;
+        double *Tc, *tn, *Dx;
+
+        //Centered templates and their inverse norms
+        if (!(Tc=(double *)malloc(Nt*L*sizeof(double)))) { fprintf(stderr,"error in ncc_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (!(tn=(double *)malloc(Nt*sizeof(double)))) { fprintf(stderr,"error in ncc_d: problem with malloc. "); perror("malloc"); return 1; }
+        for (size_t k=0u; k<Nt; ++k)
+        {
+            sx = 0.0;
+            for (size_t l=0u; l<L; ++l) { sx += (double)T[k*L+l]; }
+            sx /= (double)L; sxx = 0.0;
+            for (size_t l=0u; l<L; ++l) { d = (double)T[k*L+l] - sx; Tc[k*L+l] = d; sxx += d*d; }
+            tn[k] = (sxx>0.0) ? 1.0/sqrt(sxx) : 0.0;
+        }
+
+        //Inverse norms of the centered windows of X
+        if (!(Dx=(double *)malloc(Ny*sizeof(double)))) { fprintf(stderr,"error in ncc_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (ncc_xnorm_d(Dx,X,N,L)) { return 1; }
+
+        //Numerators
+        if (!ncc_fft(N,Nt,L,AUTO_COST_CONV1D_D,AUTO_COST_FFT_D,AUTO_COST_PLAN_D))
+        {
+            double sm;
+            for (size_t k=0u; k<Nt; ++k)
+            {
+                const double *tc = &Tc[k*L];
+                for (size_t n=0u; n<Ny; ++n)
+                {
+                    sm = 0.0;
+                    for (size_t l=0u; l<L; ++l) { sm += X[n+l] * tc[l]; }
+                    Y[k*Ny+n] = sm;
+                }
+            }
+        }
+        else
+        {
+            const size_t nfft = ncc_nfft(N,L), F = nfft/2u + 1u;
+            const size_t B = nfft - L + 1u, NT = (Nt<16u) ? Nt : 16u;
+            const double sc = 1.0 / (double)nfft;
+            const int n[1] = {(int)nfft};
+            size_t nx, ny;
+
+            //Initialize FFTs
+            double *Xb, *Fx, *Ft, *Fy, *Yb;
+            Xb = (double *)fftw_malloc(Nt*nfft*sizeof(double));
+            Fx = (double *)fftw_malloc(2u*F*sizeof(double));
+            Ft = (double *)fftw_malloc(Nt*2u*F*sizeof(double));
+            Fy = (double *)fftw_malloc(NT*2u*F*sizeof(double));
+            Yb = (double *)fftw_malloc(NT*nfft*sizeof(double));
+            if (!Xb || !Fx || !Ft || !Fy || !Yb) { fprintf(stderr,"error in ncc_d: problem with fftw_malloc. "); perror("fftw_malloc"); return 1; }
+            fftw_plan tplan = fftw_plan_many_dft_r2c(1,n,(int)Nt,Xb,NULL,1,(int)nfft,(fftw_complex *)Ft,NULL,1,(int)F,FFTW_ESTIMATE);
+            if (!tplan) { fprintf(stderr,"error in ncc_d: problem creating fftw plan"); return 1; }
+            fftw_plan fplan = fftw_plan_dft_r2c_1d((int)nfft,Xb,(fftw_complex *)Fx,FFTW_ESTIMATE);
+            if (!fplan) { fprintf(stderr,"error in ncc_d: problem creating fftw plan"); return 1; }
+            fftw_plan iplan = fftw_plan_many_dft_c2r(1,n,(int)NT,(fftw_complex *)Fy,NULL,1,(int)F,Yb,NULL,1,(int)nfft,FFTW_ESTIMATE);
+            if (!iplan) { fprintf(stderr,"error in ncc_d: problem creating fftw plan"); return 1; }
+
+            //FFT of all templates (once), scaled by 1/nfft
+            for (size_t k=0u; k<Nt; ++k)
+            {
+                for (size_t l=0u; l<L; ++l) { Xb[k*nfft+l] = sc * Tc[k*L+l]; }
+                for (size_t l=L; l<nfft; ++l) { Xb[k*nfft+l] = 0.0; }
+            }
+            fftw_execute(tplan);
+
+            //Overlap-save over blocks of B outputs
+            for (size_t n0=0u; n0<Ny; n0+=B)
+            {
+                nx = (N-n0<nfft) ? N-n0 : nfft;
+                ny = (Ny-n0<B) ? Ny-n0 : B;
+                for (size_t l=0u; l<nx; ++l) { Xb[l] = X[n0+l]; }
+                for (size_t l=nx; l<nfft; ++l) { Xb[l] = 0.0; }
+                fftw_execute(fplan);
+                for (size_t k0=0u; k0<Nt; k0+=NT)
+                {
+                    const size_t nt = (Nt-k0<NT) ? Nt-k0 : NT;
+                    for (size_t t=0u; t<nt; ++t)
+                    {
+                        const double *ft = &Ft[2u*(k0+t)*F];
+                        double *fy = &Fy[2u*t*F];
+                        for (size_t f=0u; f<2u*F; f+=2u)
+                        {
+                            fy[f] = Fx[f]*ft[f] + Fx[f+1u]*ft[f+1u];
+                            fy[f+1u] = Fx[f+1u]*ft[f] - Fx[f]*ft[f+1u];
+                        }
+                    }
+                    fftw_execute(iplan);
+                    for (size_t t=0u; t<nt; ++t)
+                    {
+                        for (size_t l=0u; l<ny; ++l) { Y[(k0+t)*Ny+n0+l] = Yb[t*nfft+l]; }
+                    }
+                }
+            }
+
+            fftw_free(Xb); fftw_free(Fx); fftw_free(Ft); fftw_free(Fy); fftw_free(Yb);
+            fftw_destroy_plan(tplan); fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+        }
+
+        //Normalize
+        for (size_t k=0u; k<Nt; ++k)
+        {
+            for (size_t n=0u; n<Ny; ++n) { Y[k*Ny+n] *= tn[k] * Dx[n]; }
+        }
+
+        free(Tc); free(tn); free(Dx);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,329 @@
+//Partitioned-block frequency-domain adaptive filter (PBFDAF, also called MDF),
+//with NLMS-type step-size normalization per frequency bin.
+//This is the usual adaptive filter for acoustic echo cancellation (AEC).
+
+//X is the far-end reference signal (vector of length N),
+//and D is the near-end (microphone) signal (vector of length N).
+//The adaptive FIR filter W (length Q+1) models the echo path from X to D,
+//and E = D - W*X is the error (echo-cancelled) output:
+//E[n] = D[n] - (W[0]*X[n] + W[1]*X[n-1] + ... + W[Q]*X[n-Q])
+
+//The filter is run as in fir_part (uniformly-partitioned overlap-save),
+//with P = ceil((Q+1)/Lb) partitions of block size Lb (nfft = 2*Lb),
+//and a frequency-domain delay line (FDL) of the last P input spectra.
+//Each block costs 3 FFTs for filtering and the error spectrum, plus 2 FFTs
+//for the constraint (zeroing the circular tail of the filter partitions),
+//which is applied to one partition per block in turn (alternating constraint, as in Speex MDF).
+//So the cost per sample is O(log Lb) for the FFTs plus O(P) for the MACs,
+//instead of O(Q) per sample for time-domain NLMS.
+
+//The step size in each bin f is mu / (P*Pw[f] + delta*nfft),
+//where Pw[f] is the smoothed power of X in bin f (fast attack, slow decay),
+//and delta is a regularization in units of signal power (e.g. 1e-6).
+//mu is in (0 1], where smaller mu is slower but more robust to near-end talk.
+
+//W is output as the final filter (length Q+1), in the time domain.
+//The filter starts from zeros (or from the filter held in Z, if streaming).
+
+//Z is the state carried between calls (for streaming), or NULL.
+//If NULL, the signals and the filter start from zeros.
+//If not NULL, Z has length Lb + 4*(Lb+1)*P + Lb+1 + 1,
+//and must be zeros before the first call. It holds the last input block,
+//the FDL, the filter spectra, the smoothed powers and the block counter.
+//For streaming, each call must give a multiple of Lb samples, except for the last call.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <fftw3.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+int pbfdaf_s (float *E, float *W, const float *X, const float *D, float *Z, const size_t N, const size_t Q, const size_t Lb, const float mu, const float delta);
+int pbfdaf_d (double *E, double *W, const double *X, const double *D, double *Z, const size_t N, const size_t Q, const size_t Lb, const double mu, const double delta);
+
+
+int pbfdaf_s (float *E, float *W, const float *X, const float *D, float *Z, const size_t N, const size_t Q, const size_t Lb, const float mu, const float delta)
+{
+    if (Lb<1u) { fprintf(stderr,"error in pbfdaf_s: Lb (block size) must be positive\n"); return 1; }
+    if (mu<=0.0f) { fprintf(stderr,"error in pbfdaf_s: mu (step size) must be positive\n"); return 1; }
+    if (delta<0.0f) { fprintf(stderr,"error in pbfdaf_s: delta (regularization) must be nonnegative\n"); return 1; }
+
+    if (N==0u) {}
+    else
+    {
+        const size_t P = (Q+Lb)/Lb, nfft = 2u*Lb, F = Lb+1u, F2 = 2u*F;
+        const size_t NZ = Lb + 2u*F2*P + F + 1u;
+        const float sc = 1.0f / (float)nfft, dl = delta * (float)nfft, Pf = (float)P;
+        const float bet = 0.9f;            //power smoothing (decay) per block
+        float xr, xi, hr, hi, pw;
+
+        //Initialize state
+        float *Zb;
+        if (Z) { Zb = Z; }
+        else
+        {
+            if (!(Zb=(float *)calloc(NZ,sizeof(float)))) { fprintf(stderr,"error in pbfdaf_s: problem with calloc. "); perror("calloc"); return 1; }
+        }
+        float *xp = Zb, *fdl = Zb + Lb, *Wf = fdl + F2*P, *Pw = Wf + F2*P;
+        size_t cnt = (size_t)Pw[F];
+
+        //Initialize fftw
+        float *Xb, *Fb, *Yb, *Gb;
+        Xb = (float *)fftwf_malloc(nfft*sizeof(float));
+        Fb = (float *)fftwf_malloc(F2*sizeof(float));
+        Yb = (float *)fftwf_malloc(nfft*sizeof(float));
+        Gb = (float *)fftwf_malloc(F2*sizeof(float));
+        if (!Xb || !Fb || !Yb || !Gb) { fprintf(stderr,"error in pbfdaf_s: problem with fftwf_malloc\n"); return 1; }
+        fftwf_plan fplan = fftwf_plan_dft_r2c_1d((int)nfft,Xb,(fftwf_complex *)Fb,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in pbfdaf_s: problem creating fftw plan\n"); return 1; }
+        fftwf_plan iplan = fftwf_plan_dft_c2r_1d((int)nfft,(fftwf_complex *)Fb,Yb,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in pbfdaf_s: problem creating fftw plan\n"); return 1; }
+        fftwf_plan gplan = fftwf_plan_dft_c2r_1d((int)nfft,(fftwf_complex *)Gb,Yb,FFTW_ESTIMATE);
+        if (!gplan) { fprintf(stderr,"error in pbfdaf_s: problem creating fftw plan\n"); return 1; }
+        fftwf_plan hplan = fftwf_plan_dft_r2c_1d((int)nfft,Yb,(fftwf_complex *)Gb,FFTW_ESTIMATE);
+        if (!hplan) { fprintf(stderr,"error in pbfdaf_s: problem creating fftw plan\n"); return 1; }
+
+        for (size_t l=0u; l<N; l+=Lb, ++cnt)
+        {
+            const size_t Mb = (N-l<Lb) ? N-l : Lb;
+
+            //Previous block and this block of X
+            for (size_t n=0u; n<Lb; ++n) { Xb[n] = xp[n]; }
+            for (size_t n=0u; n<Mb; ++n) { Xb[Lb+n] = X[l+n]; }
+            for (size_t n=Lb+Mb; n<nfft; ++n) { Xb[n] = 0.0f; }
+            for (size_t n=0u; n<Lb; ++n) { xp[n] = Xb[n+Lb]; }
+
+            //Push the spectrum of this block onto the front of the FDL
+            fftwf_execute(fplan);
+            for (size_t n=F2*P; n>F2; --n) { fdl[n-1u] = fdl[n-1u-F2]; }
+            for (size_t f=0u; f<F2; ++f) { fdl[f] = Fb[f]; }
+
+            //Update the smoothed power in each bin (fast attack, slow decay)
+            for (size_t f=0u; f<F; ++f)
+            {
+                pw = fdl[2u*f]*fdl[2u*f] + fdl[2u*f+1u]*fdl[2u*f+1u];
+                Pw[f] = (pw>Pw[f]) ? pw : bet*Pw[f] + (1.0f-bet)*pw;
+            }
+
+            //Filter output (multiply-accumulate over partitions)
+            for (size_t f=0u; f<F2; ++f) { Fb[f] = 0.0f; }
+            for (size_t p=0u; p<P; ++p)
+            {
+                const float *Xp = fdl + p*F2, *Wp = Wf + p*F2;
+                for (size_t f=0u; f<F2; f+=2u)
+                {
+                    xr = Xp[f]; xi = Xp[f+1u];
+                    hr = Wp[f]; hi = Wp[f+1u];
+                    Fb[f] += hr*xr - hi*xi;
+                    Fb[f+1u] += hr*xi + hi*xr;
+                }
+            }
+            fftwf_execute(iplan);
+
+            //Error (the last Lb outputs are valid)
+            for (size_t n=0u; n<Mb; ++n) { E[l+n] = D[l+n] - sc*Yb[Lb+n]; }
+
+            //Normalized error spectrum
+            for (size_t n=0u; n<Lb; ++n) { Xb[n] = 0.0f; }
+            for (size_t n=0u; n<Mb; ++n) { Xb[Lb+n] = E[l+n]; }
+            for (size_t n=Lb+Mb; n<nfft; ++n) { Xb[n] = 0.0f; }
+            fftwf_execute(fplan);
+            for (size_t f=0u; f<F; ++f)
+            {
+                pw = mu / (Pf*Pw[f]+dl);
+                Fb[2u*f] *= pw; Fb[2u*f+1u] *= pw;
+            }
+
+            //Gradient conj(X_p).*E for each partition (unconstrained)
+            for (size_t p=0u; p<P; ++p)
+            {
+                const float *Xp = fdl + p*F2;
+                float *Wp = Wf + p*F2;
+                for (size_t f=0u; f<F2; f+=2u)
+                {
+                    xr = Xp[f]; xi = Xp[f+1u];
+                    hr = Fb[f]; hi = Fb[f+1u];
+                    Wp[f] += xr*hr + xi*hi;
+                    Wp[f+1u] += xr*hi - xi*hr;
+                }
+            }
+
+            //Constrain one partition per block in turn (zero its circular tail)
+            {
+                const size_t p = cnt % P, Lp = (p+1u<P) ? Lb : Q+1u-p*Lb;
+                float *Wp = Wf + p*F2;
+                for (size_t f=0u; f<F2; ++f) { Gb[f] = Wp[f]; }
+                fftwf_execute(gplan);
+                for (size_t n=0u; n<Lp; ++n) { Yb[n] *= sc; }
+                for (size_t n=Lp; n<nfft; ++n) { Yb[n] = 0.0f; }
+                fftwf_execute(hplan);
+                for (size_t f=0u; f<F2; ++f) { Wp[f] = Gb[f]; }
+            }
+        }
+
+        //Output W in the time domain (first Lb samples of each partition)
+        for (size_t p=0u, q=0u; p<P; ++p)
+        {
+            for (size_t f=0u; f<F2; ++f) { Fb[f] = Wf[p*F2+f]; }
+            fftwf_execute(iplan);
+            for (size_t n=0u; n<Lb && q<=Q; ++n, ++q) { W[q] = sc * Yb[n]; }
+        }
+
+        //Save the block counter (for the rotating constraint)
+        Pw[F] = (float)(cnt%P);
+
+        fftwf_free(Xb); fftwf_free(Fb); fftwf_free(Yb); fftwf_free(Gb);
+        fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan); fftwf_destroy_plan(gplan); fftwf_destroy_plan(hplan);
+        if (!Z) { free(Zb); }
+    }
+
+    return 0;
+}
+
+
+int pbfdaf_d (double *E, double *W, const double *X, const double *D, double *Z, const size_t N, const size_t Q, const size_t Lb, const double mu, const double delta)
+{
+    if (Lb<1u) { fprintf(stderr,"error in pbfdaf_d: Lb (block size) must be positive\n"); return 1; }
+    if (mu<=0.0) { fprintf(stderr,"error in pbfdaf_d: mu (step size) must be positive\n"); return 1; }
+    if (delta<0.0) { fprintf(stderr,"error in pbfdaf_d: delta (regularization) must be nonnegative\n"); return 1; }
+
+    if (N==0u) {}
+    else
+    {
+        const size_t P = (Q+Lb)/Lb, nfft = 2u*Lb, F = Lb+1u, F2 = 2u*F;
+        const size_t NZ = Lb + 2u*F2*P + F + 1u;
+        const double sc = 1.0 / (double)nfft, dl = delta * (double)nfft, Pf = (double)P;
+        const double bet = 0.9;            //power smoothing (decay) per block
+        double xr, xi, hr, hi, pw;
+
+        //Initialize state
+        double *Zb;
+        if (Z) { Zb = Z; }
+        else
+        {
+            if (!(Zb=(double *)calloc(NZ,sizeof(double)))) { fprintf(stderr,"error in pbfdaf_d: problem with calloc. "); perror("calloc"); return 1; }
+        }
+        double *xp = Zb, *fdl = Zb + Lb, *Wf = fdl + F2*P, *Pw = Wf + F2*P;
+        size_t cnt = (size_t)Pw[F];
+
+        //Initialize fftw
+        double *Xb, *Fb, *Yb, *Gb;
+        Xb = (double *)fftw_malloc(nfft*sizeof(double));
+        Fb = (double *)fftw_malloc(F2*sizeof(double));
+        Yb = (double *)fftw_malloc(nfft*sizeof(double));
+        Gb = (double *)fftw_malloc(F2*sizeof(double));
+        if (!Xb || !Fb || !Yb || !Gb) { fprintf(stderr,"error in pbfdaf_d: problem with fftw_malloc\n"); return 1; }
+        fftw_plan fplan = fftw_plan_dft_r2c_1d((int)nfft,Xb,(fftw_complex *)Fb,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in pbfdaf_d: problem creating fftw plan\n"); return 1; }
+        fftw_plan iplan = fftw_plan_dft_c2r_1d((int)nfft,(fftw_complex *)Fb,Yb,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in pbfdaf_d: problem creating fftw plan\n"); return 1; }
+        fftw_plan gplan = fftw_plan_dft_c2r_1d((int)nfft,(fftw_complex *)Gb,Yb,FFTW_ESTIMATE);
+        if (!gplan) { fprintf(stderr,"error in pbfdaf_d: problem creating fftw plan\n"); return 1; }
+        fftw_plan hplan = fftw_plan_dft_r2c_1d((int)nfft,Yb,(fftw_complex *)Gb,FFTW_ESTIMATE);
+        if (!hplan) { fprintf(stderr,"error in pbfdaf_d: problem creating fftw plan\n"); return 1; }
+
+        for (size_t l=0u; l<N; l+=Lb, ++cnt)
+        {
+            const size_t Mb = (N-l<Lb) ? N-l : Lb;
+
+            //Previous block and this block of X
+            for (size_t n=0u; n<Lb; ++n) { Xb[n] = xp[n]; }
+            for (size_t n=0u; n<Mb; ++n) { Xb[Lb+n] = X[l+n]; }
+            for (size_t n=Lb+Mb; n<nfft; ++n) { Xb[n] = 0.0; }
+            for (size_t n=0u; n<Lb; ++n) { xp[n] = Xb[n+Lb]; }
+
+            //Push the spectrum of this block onto the front of the FDL
+            fftw_execute(fplan);
+            for (size_t n=F2*P; n>F2; --n) { fdl[n-1u] = fdl[n-1u-F2]; }
+            for (size_t f=0u; f<F2; ++f) { fdl[f] = Fb[f]; }
+
+            //Update the smoothed power in each bin (fast attack, slow decay)
+            for (size_t f=0u; f<F; ++f)
+            {
+                pw = fdl[2u*f]*fdl[2u*f] + fdl[2u*f+1u]*fdl[2u*f+1u];
+                Pw[f] = (pw>Pw[f]) ? pw : bet*Pw[f] + (1.0-bet)*pw;
+            }
+
+            //Filter output (multiply-accumulate over partitions)
+            for (size_t f=0u; f<F2; ++f) { Fb[f] = 0.0; }
+            for (size_t p=0u; p<P; ++p)
+            {
+                const double *Xp = fdl + p*F2, *Wp = Wf + p*F2;
+                for (size_t f=0u; f<F2; f+=2u)
+                {
+                    xr = Xp[f]; xi = Xp[f+1u];
+                    hr = Wp[f]; hi = Wp[f+1u];
+                    Fb[f] += hr*xr - hi*xi;
+                    Fb[f+1u] += hr*xi + hi*xr;
+                }
+            }
+            fftw_execute(iplan);
+
+            //Error (the last Lb outputs are valid)
+            for (size_t n=0u; n<Mb; ++n) { E[l+n] = D[l+n] - sc*Yb[Lb+n]; }
+
+            //Normalized error spectrum
+            for (size_t n=0u; n<Lb; ++n) { Xb[n] = 0.0; }
+            for (size_t n=0u; n<Mb; ++n) { Xb[Lb+n] = E[l+n]; }
+            for (size_t n=Lb+Mb; n<nfft; ++n) { Xb[n] = 0.0; }
+            fftw_execute(fplan);
+            for (size_t f=0u; f<F; ++f)
+            {
+                pw = mu / (Pf*Pw[f]+dl);
+                Fb[2u*f] *= pw; Fb[2u*f+1u] *= pw;
+            }
+
+            //Gradient conj(X_p).*E for each partition (unconstrained)
+            for (size_t p=0u; p<P; ++p)
+            {
+                const double *Xp = fdl + p*F2;
+                double *Wp = Wf + p*F2;
+                for (size_t f=0u; f<F2; f+=2u)
+                {
+                    xr = Xp[f]; xi = Xp[f+1u];
+                    hr = Fb[f]; hi = Fb[f+1u];
+                    Wp[f] += xr*hr + xi*hi;
+                    Wp[f+1u] += xr*hi - xi*hr;
+                }
+            }
+
+            //Constrain one partition per block in turn (zero its circular tail)
+            {
+                const size_t p = cnt % P, Lp = (p+1u<P) ? Lb : Q+1u-p*Lb;
+                double *Wp = Wf + p*F2;
+                for (size_t f=0u; f<F2; ++f) { Gb[f] = Wp[f]; }
+                fftw_execute(gplan);
+                for (size_t n=0u; n<Lp; ++n) { Yb[n] *= sc; }
+                for (size_t n=Lp; n<nfft; ++n) { Yb[n] = 0.0; }
+                fftw_execute(hplan);
+                for (size_t f=0u; f<F2; ++f) { Wp[f] = Gb[f]; }
+            }
+        }
+
+        //Output W in the time domain (first Lb samples of each partition)
+        for (size_t p=0u, q=0u; p<P; ++p)
+        {
+            for (size_t f=0u; f<F2; ++f) { Fb[f] = Wf[p*F2+f]; }
+            fftw_execute(iplan);
+            for (size_t n=0u; n<Lb && q<=Q; ++n, ++q) { W[q] = sc * Yb[n]; }
+        }
+
+        //Save the block counter (for the rotating constraint)
+        Pw[F] = (double)(cnt%P);
+
+        fftw_free(Xb); fftw_free(Fb); fftw_free(Yb); fftw_free(Gb);
+        fftw_destroy_plan(fplan); fftw_destroy_plan(iplan); fftw_destroy_plan(gplan); fftw_destroy_plan(hplan);
+        if (!Z) { free(Zb); }
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
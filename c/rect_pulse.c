@@ -7,6 +7,9 @@
 //For the complex case, the real part is the rect_pulse,
 //and the imaginary part is left at 0.
 
+//The _events function gives the output as an event list of length 6+2*width (see densify.c),
+//where the dense signal has size R x C x S x H (with N=R*C*S*H).
+
 #include <stdio.h>
 
 #ifdef __cplusplus
@@ -18,6 +21,7 @@ int rect_pulse_s (float *Y, const size_t N, const size_t samp, const size_t widt
 int rect_pulse_d (double *Y, const size_t N, const size_t samp, const size_t width, const double amp);
 int rect_pulse_c (float *Y, const size_t N, const size_t samp, const size_t width, const float amp);
 int rect_pulse_z (double *Y, const size_t N, const size_t samp, const size_t width, const double amp);
+int rect_pulse_events (double *Y, const size_t R, const size_t C, const size_t S, const size_t H, const size_t samp, const size_t width, const double amp);
 
 
 int rect_pulse_s (float *Y, const size_t N, const size_t samp, const size_t width, const float amp)
@@ -73,6 +77,19 @@ int rect_pulse_z (double *Y, const size_t N, const size_t samp, const size_t wid
 }
 
 
+int rect_pulse_events (double *Y, const size_t R, const size_t C, const size_t S, const size_t H, const size_t samp, const size_t width, const double amp)
+{
+    const size_t N = R*C*S*H;
+    if (samp+width>=N) { fprintf(stderr, "error in rect_pulse_events: samp+width must be less than N\n"); return 1; }
+
+    Y[0] = (double)R; Y[1] = (double)C; Y[2] = (double)S; Y[3] = (double)H;
+    Y[4] = (double)width; Y[5] = 1.0;
+    for (size_t w=0u; w<width; ++w) { Y[6u+w] = (double)(samp+w); Y[6u+width+w] = amp; }
+
+    return 0;
+}
+
+
 #ifdef __cplusplus
 }
 }
@@ -0,0 +1,458 @@
+//Rational resampling of each vector in X along dim by the factor p/q,
+//using a polyphase FIR filter (as in resample_poly of SciPy).
+
+//Conceptually, X is upsampled by p (zeros inserted), filtered by B,
+//and downsampled by q. But the polyphase method computes only the kept outputs,
+//so the cost per output sample is about Lb/p multiply-adds (Lb is the length of B).
+//Each vector in Y has length Ly = ceil(L*p/q), where L is the length of vecs in X.
+//p and q are first divided by their gcd (e.g., 44100->16000 uses p=160, q=441).
+
+//Use resample_design first to get B, a Kaiser-windowed sinc lowpass filter.
+//This has length Lb = 2*Nz*max(p,q) + 1, where Nz is the number of zero-crossings
+//on each side (the quality; 10 is typical), and beta is the Kaiser parameter (5 is typical).
+//B includes the gain of p, and it can be reused for any X with the same (p,q,Nz,beta).
+//Any other FIR filter (designed at the upsampled rate) can also be given as B.
+
+//Z is the state carried between calls (for streaming), or NULL.
+//If NULL, the filter delay of (Lb-1)/2 is compensated (zero-phase output),
+//and each vector starts and ends with zeros outside of X.
+//If not NULL, the filter is causal (so the output is delayed by (Lb-1)/2 samples
+//at the upsampled rate), and Z has length V*(ceil(Lb/p)-1) (2x that for complex),
+//where V is the number of vectors. Z holds the last inputs of each vector,
+//and must be zeros before the first call. For streaming, each call must give
+//a multiple of q samples per vector, except for the last call.
+
+//Vectors that are interleaved in memory (e.g., channels of a row-major frame)
+//are processed together, so the inner loops are across channels.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#ifndef M_PI
+   #define M_PI 3.141592653589793238462643383279502884
+#endif
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static size_t resample_gcd (size_t a, size_t b);
+static double resample_besseli0 (const double x);
+static void resample_lanes_s (float *Y, const float *X, const float *Hp, float *Z, const size_t L, const size_t Ly, const size_t p, const size_t q, const size_t Kp, const size_t D, const size_t K, const size_t NV);
+static void resample_lanes_d (double *Y, const double *X, const double *Hp, double *Z, const size_t L, const size_t Ly, const size_t p, const size_t q, const size_t Kp, const size_t D, const size_t K, const size_t NV);
+
+int resample_design_s (float *B, const size_t p, const size_t q, const size_t Nz, const float beta);
+int resample_design_d (double *B, const size_t p, const size_t q, const size_t Nz, const double beta);
+int resample_s (float *Y, const float *X, const float *B, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Lb, const size_t p, const size_t q, const size_t dim);
+int resample_d (double *Y, const double *X, const double *B, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Lb, const size_t p, const size_t q, const size_t dim);
+int resample_c (float *Y, const float *X, const float *B, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Lb, const size_t p, const size_t q, const size_t dim);
+int resample_z (double *Y, const double *X, const double *B, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Lb, const size_t p, const size_t q, const size_t dim);
+
+
+static size_t resample_gcd (size_t a, size_t b)
+{
+    size_t t;
+    while (b>0u) { t = a%b; a = b; b = t; }
+    return a;
+}
+
+
+static double resample_besseli0 (const double x)
+{
+    double sm = 1.0, trm = 1.0;
+    const double x2 = 0.25*x*x;
+    for (size_t k=1u; k<100u && trm>1e-17*sm; ++k) { trm *= x2/(double)(k*k); sm += trm; }
+    return sm;
+}
+
+
+static void resample_lanes_s (float *Y, const float *X, const float *Hp, float *Z, const size_t L, const size_t Ly, const size_t p, const size_t q, const size_t Kp, const size_t D, const size_t K, const size_t NV)
+{
+    const size_t Nh = Kp - 1u;
+    size_t t, n0, jlo, jhi;
+    float hj;
+
+    for (size_t m=0u; m<Ly; ++m, Y+=K)
+    {
+        t = m*q + D; n0 = t/p;
+        const float *h = Hp + (t%p)*Kp;
+        for (size_t v=0u; v<NV; ++v) { Y[v] = 0.0f; }
+
+        //Taps within X
+        jlo = (n0<L) ? 0u : n0-L+1u;
+        jhi = (n0<Nh) ? n0 : Nh;
+        for (size_t j=jlo; j<jhi+1u; ++j)
+        {
+            const float *x = X + (n0-j)*K;
+            hj = h[j];
+            for (size_t v=0u; v<NV; ++v) { Y[v] += hj * x[v]; }
+        }
+
+        //Taps before X (from the carried state)
+        if (Z)
+        {
+            for (size_t j=n0+1u; j<Kp; ++j)
+            {
+                const float *z = Z + Nh + n0 - j;
+                hj = h[j];
+                for (size_t v=0u; v<NV; ++v) { Y[v] += hj * z[v*Nh]; }
+            }
+        }
+    }
+
+    //Update state to the last Nh inputs
+    if (Z && Nh>0u)
+    {
+        if (L>=Nh)
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Nh; ++i) { Z[v*Nh+i] = X[(L-Nh+i)*K+v]; }
+            }
+        }
+        else
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Nh-L; ++i) { Z[v*Nh+i] = Z[v*Nh+i+L]; }
+                for (size_t i=0u; i<L; ++i) { Z[v*Nh+Nh-L+i] = X[i*K+v]; }
+            }
+        }
+    }
+}
+
+
+static void resample_lanes_d (double *Y, const double *X, const double *Hp, double *Z, const size_t L, const size_t Ly, const size_t p, const size_t q, const size_t Kp, const size_t D, const size_t K, const size_t NV)
+{
+    const size_t Nh = Kp - 1u;
+    size_t t, n0, jlo, jhi;
+    double hj;
+
+    for (size_t m=0u; m<Ly; ++m, Y+=K)
+    {
+        t = m*q + D; n0 = t/p;
+        const double *h = Hp + (t%p)*Kp;
+        for (size_t v=0u; v<NV; ++v) { Y[v] = 0.0; }
+
+        //Taps within X
+        jlo = (n0<L) ? 0u : n0-L+1u;
+        jhi = (n0<Nh) ? n0 : Nh;
+        for (size_t j=jlo; j<jhi+1u; ++j)
+        {
+            const double *x = X + (n0-j)*K;
+            hj = h[j];
+            for (size_t v=0u; v<NV; ++v) { Y[v] += hj * x[v]; }
+        }
+
+        //Taps before X (from the carried state)
+        if (Z)
+        {
+            for (size_t j=n0+1u; j<Kp; ++j)
+            {
+                const double *z = Z + Nh + n0 - j;
+                hj = h[j];
+                for (size_t v=0u; v<NV; ++v) { Y[v] += hj * z[v*Nh]; }
+            }
+        }
+    }
+
+    //Update state to the last Nh inputs
+    if (Z && Nh>0u)
+    {
+        if (L>=Nh)
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Nh; ++i) { Z[v*Nh+i] = X[(L-Nh+i)*K+v]; }
+            }
+        }
+        else
+        {
+            for (size_t v=0u; v<NV; ++v)
+            {
+                for (size_t i=0u; i<Nh-L; ++i) { Z[v*Nh+i] = Z[v*Nh+i+L]; }
+                for (size_t i=0u; i<L; ++i) { Z[v*Nh+Nh-L+i] = X[i*K+v]; }
+            }
+        }
+    }
+}
+
+
+int resample_design_s (float *B, const size_t p, const size_t q, const size_t Nz, const float beta)
+{
+    if (p<1u) { fprintf(stderr,"error in resample_design_s: p (upsample factor) must be positive\n"); return 1; }
+    if (q<1u) { fprintf(stderr,"error in resample_design_s: q (downsample factor) must be positive\n"); return 1; }
+    if (Nz<1u) { fprintf(stderr,"error in resample_design_s: Nz (num zero-crossings) must be positive\n"); return 1; }
+    if (beta<0.0f) { fprintf(stderr,"error in resample_design_s: beta must be nonnegative\n"); return 1; }
+
+    const size_t g = resample_gcd(p,q), P = p/g, Q = q/g;
+    const size_t M = (P>Q) ? P : Q, c = Nz*M, Lb = 2u*c + 1u;
+    const double fc = 1.0/(double)M, den = resample_besseli0((double)beta);
+    double x, r;
+
+    for (size_t l=0u; l<Lb; ++l, ++B)
+    {
+        x = fc * ((double)l-(double)c);
+        r = ((double)l-(double)c) / (double)c;
+        *B = (float)((double)P * fc * ((l==c) ? 1.0 : sin(M_PI*x)/(M_PI*x)) * resample_besseli0((double)beta*sqrt(1.0-r*r)) / den);
+    }
+
+    return 0;
+}
+
+
+int resample_design_d (double *B, const size_t p, const size_t q, const size_t Nz, const double beta)
+{
+    if (p<1u) { fprintf(stderr,"error in resample_design_d: p (upsample factor) must be positive\n"); return 1; }
+    if (q<1u) { fprintf(stderr,"error in resample_design_d: q (downsample factor) must be positive\n"); return 1; }
+    if (Nz<1u) { fprintf(stderr,"error in resample_design_d: Nz (num zero-crossings) must be positive\n"); return 1; }
+    if (beta<0.0) { fprintf(stderr,"error in resample_design_d: beta must be nonnegative\n"); return 1; }
+
+    const size_t g = resample_gcd(p,q), P = p/g, Q = q/g;
+    const size_t M = (P>Q) ? P : Q, c = Nz*M, Lb = 2u*c + 1u;
+    const double fc = 1.0/(double)M, den = resample_besseli0((double)beta);
+    double x, r;
+
+    for (size_t l=0u; l<Lb; ++l, ++B)
+    {
+        x = fc * ((double)l-(double)c);
+        r = ((double)l-(double)c) / (double)c;
+        *B = (double)((double)P * fc * ((l==c) ? 1.0 : sin(M_PI*x)/(M_PI*x)) * resample_besseli0((double)beta*sqrt(1.0-r*r)) / den);
+    }
+
+    return 0;
+}
+
+
+int resample_s (float *Y, const float *X, const float *B, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Lb, const size_t p, const size_t q, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in resample_s: dim must be in [0 3]\n"); return 1; }
+    if (p<1u) { fprintf(stderr,"error in resample_s: p (upsample factor) must be positive\n"); return 1; }
+    if (q<1u) { fprintf(stderr,"error in resample_s: q (downsample factor) must be positive\n"); return 1; }
+    if (Lb<1u) { fprintf(stderr,"error in resample_s: Lb (length of B) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t g = resample_gcd(p,q), P = p/g, Q = q/g;
+        const size_t Ly = (L*P+Q-1u) / Q, Kp = (Lb+P-1u) / P, Nh = Kp - 1u;
+        const size_t D = (Z) ? 0u : (Lb-1u)/2u;
+
+        //Polyphase components of B
+        float *Hp;
+        if (!(Hp=(float *)calloc(P*Kp,sizeof(float)))) { fprintf(stderr,"error in resample_s: problem with calloc\n"); return 1; }
+        for (size_t l=0u; l<Lb; ++l) { Hp[(l%P)*Kp+l/P] = B[l]; }
+
+        if (L==N)
+        {
+            resample_lanes_s(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,1u,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=Ly)
+                {
+                    resample_lanes_s(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,1u,1u);
+                    if (Z) { Z += Nh; }
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=K*L, Y+=K*Ly)
+                {
+                    resample_lanes_s(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,K,K);
+                    if (Z) { Z += K*Nh; }
+                }
+            }
+        }
+        free(Hp);
+    }
+
+    return 0;
+}
+
+
+int resample_d (double *Y, const double *X, const double *B, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Lb, const size_t p, const size_t q, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in resample_d: dim must be in [0 3]\n"); return 1; }
+    if (p<1u) { fprintf(stderr,"error in resample_d: p (upsample factor) must be positive\n"); return 1; }
+    if (q<1u) { fprintf(stderr,"error in resample_d: q (downsample factor) must be positive\n"); return 1; }
+    if (Lb<1u) { fprintf(stderr,"error in resample_d: Lb (length of B) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t g = resample_gcd(p,q), P = p/g, Q = q/g;
+        const size_t Ly = (L*P+Q-1u) / Q, Kp = (Lb+P-1u) / P, Nh = Kp - 1u;
+        const size_t D = (Z) ? 0u : (Lb-1u)/2u;
+
+        //Polyphase components of B
+        double *Hp;
+        if (!(Hp=(double *)calloc(P*Kp,sizeof(double)))) { fprintf(stderr,"error in resample_d: problem with calloc\n"); return 1; }
+        for (size_t l=0u; l<Lb; ++l) { Hp[(l%P)*Kp+l/P] = B[l]; }
+
+        if (L==N)
+        {
+            resample_lanes_d(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,1u,1u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=L, Y+=Ly)
+                {
+                    resample_lanes_d(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,1u,1u);
+                    if (Z) { Z += Nh; }
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=K*L, Y+=K*Ly)
+                {
+                    resample_lanes_d(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,K,K);
+                    if (Z) { Z += K*Nh; }
+                }
+            }
+        }
+        free(Hp);
+    }
+
+    return 0;
+}
+
+
+int resample_c (float *Y, const float *X, const float *B, float *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Lb, const size_t p, const size_t q, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in resample_c: dim must be in [0 3]\n"); return 1; }
+    if (p<1u) { fprintf(stderr,"error in resample_c: p (upsample factor) must be positive\n"); return 1; }
+    if (q<1u) { fprintf(stderr,"error in resample_c: q (downsample factor) must be positive\n"); return 1; }
+    if (Lb<1u) { fprintf(stderr,"error in resample_c: Lb (length of B) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t g = resample_gcd(p,q), P = p/g, Q = q/g;
+        const size_t Ly = (L*P+Q-1u) / Q, Kp = (Lb+P-1u) / P, Nh = Kp - 1u;
+        const size_t D = (Z) ? 0u : (Lb-1u)/2u;
+
+        //Polyphase components of B
+        float *Hp;
+        if (!(Hp=(float *)calloc(P*Kp,sizeof(float)))) { fprintf(stderr,"error in resample_c: problem with calloc\n"); return 1; }
+        for (size_t l=0u; l<Lb; ++l) { Hp[(l%P)*Kp+l/P] = B[l]; }
+
+        //The real and imag parts are processed as 2 interleaved lanes
+        if (L==N)
+        {
+            resample_lanes_s(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,2u,2u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=2u*L, Y+=2u*Ly)
+                {
+                    resample_lanes_s(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,2u,2u);
+                    if (Z) { Z += 2u*Nh; }
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=2u*K*L, Y+=2u*K*Ly)
+                {
+                    resample_lanes_s(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,2u*K,2u*K);
+                    if (Z) { Z += 2u*K*Nh; }
+                }
+            }
+        }
+        free(Hp);
+    }
+
+    return 0;
+}
+
+
+int resample_z (double *Y, const double *X, const double *B, double *Z, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t Lb, const size_t p, const size_t q, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in resample_z: dim must be in [0 3]\n"); return 1; }
+    if (p<1u) { fprintf(stderr,"error in resample_z: p (upsample factor) must be positive\n"); return 1; }
+    if (q<1u) { fprintf(stderr,"error in resample_z: q (downsample factor) must be positive\n"); return 1; }
+    if (Lb<1u) { fprintf(stderr,"error in resample_z: Lb (length of B) must be positive\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else
+    {
+        const size_t g = resample_gcd(p,q), P = p/g, Q = q/g;
+        const size_t Ly = (L*P+Q-1u) / Q, Kp = (Lb+P-1u) / P, Nh = Kp - 1u;
+        const size_t D = (Z) ? 0u : (Lb-1u)/2u;
+
+        //Polyphase components of B
+        double *Hp;
+        if (!(Hp=(double *)calloc(P*Kp,sizeof(double)))) { fprintf(stderr,"error in resample_z: problem with calloc\n"); return 1; }
+        for (size_t l=0u; l<Lb; ++l) { Hp[(l%P)*Kp+l/P] = B[l]; }
+
+        //The real and imag parts are processed as 2 interleaved lanes
+        if (L==N)
+        {
+            resample_lanes_d(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,2u,2u);
+        }
+        else
+        {
+            const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+            const size_t BS = (iscolmajor && dim==0u) ? C*S*H : K;
+            const size_t V = N/L, G = V/BS;
+
+            if (K==1u && (G==1u || BS==1u))
+            {
+                for (size_t v=V; v>0u; --v, X+=2u*L, Y+=2u*Ly)
+                {
+                    resample_lanes_d(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,2u,2u);
+                    if (Z) { Z += 2u*Nh; }
+                }
+            }
+            else
+            {
+                for (size_t g=G; g>0u; --g, X+=2u*K*L, Y+=2u*K*Ly)
+                {
+                    resample_lanes_d(Y,X,Hp,Z,L,Ly,P,Q,Kp,D,2u*K,2u*K);
+                    if (Z) { Z += 2u*K*Nh; }
+                }
+            }
+        }
+        free(Hp);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,115 @@
+//Gets autocorrelation (AC) function for each vector in X along dim.
+//This is a front door for sig2ac and sig2ac_fft, which give the same output (see those for more info).
+//The faster method is chosen from a simple cost model, which uses L, Ly, the number of vecs,
+//and the data type (real or complex), with constants from auto_cost.h.
+
+//The direct method costs ~Ly*L - Ly*(Ly-1)/2 multiply-accumulates per vec.
+//The FFT method costs ~2 FFTs of length nfft ~ L+Ly per vec (nfft chosen as in sig2ac_fft), plus 2 fftw plans.
+//So the FFT method is chosen for long vecs with many lags.
+//As with sig2ac, X may be modified in place if mnz is true.
+//The constants in auto_cost.h can be calibrated for the current machine by "make calib".
+
+#include <stdio.h>
+#include <math.h>
+#include "auto_cost.h"
+#include "sig2ac.c"
+#include "sig2ac_fft.c"
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static int sig2ac_auto_fft (const size_t N, const size_t L, const size_t Ly, const int cplx, const double cdir, const double cfft, const double cplan);
+
+int sig2ac_auto_s (float *Y, float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Ly, const int mnz, const int unbiased, const int corr);
+int sig2ac_auto_d (double *Y, double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Ly, const int mnz, const int unbiased, const int corr);
+int sig2ac_auto_c (float *Y, float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Ly, const int mnz, const int unbiased, const int corr);
+int sig2ac_auto_z (double *Y, double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Ly, const int mnz, const int unbiased, const int corr);
+
+
+static int sig2ac_auto_fft (const size_t N, const size_t L, const size_t Ly, const int cplx, const double cdir, const double cfft, const double cplan)
+{
+    const double V = (double)(N/L);
+    const size_t Lc = (Ly<L) ? Ly : L;
+    const double dir = ((cplx) ? 4.0 : 1.0) * cdir * V * ((double)Lc*(double)L - 0.5*(double)Lc*(double)(Lc-1u));
+    size_t nfft = L + Ly;
+    if (nfft>16384u) { nfft += nfft%2u; }
+    else { size_t f = 1u; while (f<nfft) { f *= 2u; } nfft = f; }
+    const double fft = 2.0*cplan + ((cplx) ? 2.0 : 1.0) * cfft * (double)nfft * log2((double)nfft) * 2.0*V;
+    return (fft<dir);
+}
+
+
+int sig2ac_auto_s (float *Y, float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Ly, const int mnz, const int unbiased, const int corr)
+{
+    if (dim>3u) { fprintf(stderr,"error in sig2ac_auto_s: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N>0u && sig2ac_auto_fft(N,L,Ly,0,AUTO_COST_SIG2AC_S,AUTO_COST_FFT_S,AUTO_COST_PLAN_S))
+    {
+        return sig2ac_fft_s(Y,X,R,C,S,H,iscolmajor,dim,Ly,mnz,unbiased,corr);
+    }
+    else
+    {
+        return sig2ac_s(Y,X,R,C,S,H,iscolmajor,dim,Ly,mnz,unbiased,corr);
+    }
+}
+
+
+int sig2ac_auto_d (double *Y, double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Ly, const int mnz, const int unbiased, const int corr)
+{
+    if (dim>3u) { fprintf(stderr,"error in sig2ac_auto_d: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N>0u && sig2ac_auto_fft(N,L,Ly,0,AUTO_COST_SIG2AC_D,AUTO_COST_FFT_D,AUTO_COST_PLAN_D))
+    {
+        return sig2ac_fft_d(Y,X,R,C,S,H,iscolmajor,dim,Ly,mnz,unbiased,corr);
+    }
+    else
+    {
+        return sig2ac_d(Y,X,R,C,S,H,iscolmajor,dim,Ly,mnz,unbiased,corr);
+    }
+}
+
+
+int sig2ac_auto_c (float *Y, float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Ly, const int mnz, const int unbiased, const int corr)
+{
+    if (dim>3u) { fprintf(stderr,"error in sig2ac_auto_c: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N>0u && sig2ac_auto_fft(N,L,Ly,1,AUTO_COST_SIG2AC_S,AUTO_COST_FFT_S,AUTO_COST_PLAN_S))
+    {
+        return sig2ac_fft_c(Y,X,R,C,S,H,iscolmajor,dim,Ly,mnz,unbiased,corr);
+    }
+    else
+    {
+        return sig2ac_c(Y,X,R,C,S,H,iscolmajor,dim,Ly,mnz,unbiased,corr);
+    }
+}
+
+
+int sig2ac_auto_z (double *Y, double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const size_t Ly, const int mnz, const int unbiased, const int corr)
+{
+    if (dim>3u) { fprintf(stderr,"error in sig2ac_auto_z: dim must be in [0 3]\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N>0u && sig2ac_auto_fft(N,L,Ly,1,AUTO_COST_SIG2AC_D,AUTO_COST_FFT_D,AUTO_COST_PLAN_D))
+    {
+        return sig2ac_fft_z(Y,X,R,C,S,H,iscolmajor,dim,Ly,mnz,unbiased,corr);
+    }
+    else
+    {
+        return sig2ac_z(Y,X,R,C,S,H,iscolmajor,dim,Ly,mnz,unbiased,corr);
+    }
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
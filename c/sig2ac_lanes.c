@@ -0,0 +1,112 @@
+//Gets the autocovariance (AC) of one vector (with stride K in X) into one lane of a lane-major AC block,
+//i.e. AC[l*LEVDURB_NL] is lag l, for lags 0 to L-1. See levdurb_lanes.c.
+//Used by sig2ar, sig2rc, sig2poly and sig2psd, with the same options (mnz, unbiased) and arithmetic.
+
+#include <stdio.h>
+#include "levdurb_lanes.c"
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void sig2ac_lanes_s (float *AC, float *X, const size_t Lx, const size_t K, const size_t L, const int mnz, const int unbiased);
+static void sig2ac_lanes_d (double *AC, double *X, const size_t Lx, const size_t K, const size_t L, const int mnz, const int unbiased);
+
+
+static void sig2ac_lanes_s (float *AC, float *X, const size_t Lx, const size_t K, const size_t L, const int mnz, const int unbiased)
+{
+    const size_t NL = LEVDURB_NL;
+    float sm;
+
+    //Subtract mean
+    if (mnz)
+    {
+        float mn = 0.0f;
+        for (size_t l=0u; l<Lx; ++l) { mn += X[l*K]; }
+        mn /= (float)Lx;
+        for (size_t l=0u; l<Lx; ++l) { X[l*K] -= mn; }
+    }
+
+    //Get ACF
+    if (K==1u)
+    {
+        for (size_t l=0u; l<L; ++l)
+        {
+            sm = 0.0f;
+            for (size_t n=0u; n<Lx-l; ++n) { sm += X[n] * X[n+l]; }
+            AC[l*NL] = sm;
+        }
+    }
+    else
+    {
+        for (size_t l=0u; l<L; ++l)
+        {
+            sm = 0.0f;
+            for (size_t n=0u; n<Lx-l; ++n) { sm += X[n*K] * X[(n+l)*K]; }
+            AC[l*NL] = sm;
+        }
+    }
+
+    //Normalize ACF
+    if (unbiased)
+    {
+        for (size_t l=0u; l<L; ++l) { AC[l*NL] /= (float)(Lx-l); }
+    }
+    else
+    {
+        for (size_t l=0u; l<L; ++l) { AC[l*NL] /= (float)Lx; }
+    }
+}
+
+
+static void sig2ac_lanes_d (double *AC, double *X, const size_t Lx, const size_t K, const size_t L, const int mnz, const int unbiased)
+{
+    const size_t NL = LEVDURB_NL;
+    double sm;
+
+    //Subtract mean
+    if (mnz)
+    {
+        double mn = 0.0;
+        for (size_t l=0u; l<Lx; ++l) { mn += X[l*K]; }
+        mn /= (double)Lx;
+        for (size_t l=0u; l<Lx; ++l) { X[l*K] -= mn; }
+    }
+
+    //Get ACF
+    if (K==1u)
+    {
+        for (size_t l=0u; l<L; ++l)
+        {
+            sm = 0.0;
+            for (size_t n=0u; n<Lx-l; ++n) { sm += X[n] * X[n+l]; }
+            AC[l*NL] = sm;
+        }
+    }
+    else
+    {
+        for (size_t l=0u; l<L; ++l)
+        {
+            sm = 0.0;
+            for (size_t n=0u; n<Lx-l; ++n) { sm += X[n*K] * X[(n+l)*K]; }
+            AC[l*NL] = sm;
+        }
+    }
+
+    //Normalize ACF
+    if (unbiased)
+    {
+        for (size_t l=0u; l<L; ++l) { AC[l*NL] /= (double)(Lx-l); }
+    }
+    else
+    {
+        for (size_t l=0u; l<L; ++l) { AC[l*NL] /= (double)Lx; }
+    }
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
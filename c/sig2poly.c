@@ -13,12 +13,14 @@
 
 //After getting the AC, Levinson-Durbin recursion is used to get the polynomial params (Y)
 //and the error variance (E).
+//For more than one vec, this is done for 8 vecs at once (see levdurb_lanes.c).
 
 //This matches Octave in tests. For complex case, the sign of the imaginary part depends
 //on whether the positive or negative lags of the ACF are taken.
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "sig2ac_lanes.c"
 
 #ifdef __cplusplus
 namespace codee {
@@ -159,112 +161,40 @@ int sig2poly_s (float *Y, float *E, float *X, const size_t R, const size_t C, co
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/Lx, G = V/B;
+            const size_t V = N/Lx, NL = LEVDURB_NL;
+            size_t v;
+            float *ACb, *ARb, *Ab, Eb[LEVDURB_NL];
+            if (!(ACb=(float *)malloc(L*NL*sizeof(float)))) { fprintf(stderr,"error in sig2poly_s: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(ARb=(float *)malloc(P*NL*sizeof(float)))) { fprintf(stderr,"error in sig2poly_s: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(Ab=(float *)malloc(P*NL*sizeof(float)))) { fprintf(stderr,"error in sig2poly_s: problem with malloc. "); perror("malloc"); return 1; }
 
-            if (K==1u && (G==1u || B==1u))
+            for (size_t v0=0u; v0<V; v0+=NL)
             {
-                for (size_t v=V; v>0u; --v, X+=Lx, Y+=P, ++E)
+                //Get ACFs of NL vecs into lane-major order (a partial block repeats its first vec)
+                for (size_t n=0u; n<NL; ++n)
                 {
-                    //Subtract mean
-                    if (mnz)
+                    if (v0+n<V)
                     {
-                        float mn = 0.0f;
-                        for (size_t l=Lx; l>0u; --l, ++X) { mn += *X; }
-                        mn /= (float)Lx;
-                        for (size_t l=Lx; l>0u; --l) { *--X -= mn; }
+                        v = v0 + n;
+                        sig2ac_lanes_s(&ACb[n],&X[(v/K)*K*Lx+v%K],Lx,K,L,mnz,unbiased);
                     }
-
-                    //Get ACF
-                    for (size_t l=0u; l<L; ++l, X-=Lx-l+1u, ++AC)
-                    {
-                        sm = 0.0f;
-                        for (size_t n=Lx-l; n>0u; --n, ++X) { sm += *X * *(X+l); }
-                        *AC = sm;
-                    }
-
-                    //Normalize ACF
-                    if (unbiased)
-                    {
-                        for (size_t l=L; l>0u; --l) { *--AC /= (float)(Lx-l+1u); }
-                    }
-                    else
-                    {
-                        for (size_t l=L; l>0u; --l) { *--AC /= (float)Lx; }
-                    }
-
-                    //Get poly params and error var (Lev-Durb)
-                    *Y++ = 1.0f;
-                    e = *AC++;
-                    a = -*AC / e; *Y = a;
-                    e += a * *AC++;
-                    for (size_t p=1u; p<P; ++p, AC+=p)
-                    {
-                        a = *AC;
-                        for (size_t q=p; q>0u; --q, ++Y) { --AC; a += *AC * *Y; }
-                        a /= -e; *Y = a;
-                        for (size_t q=p; q>0u; --q, ++A) { --Y; *A = *Y; }
-                        Y += p;
-                        for (size_t q=p; q>0u; --q) { --A; --Y; *Y += a * *A; }
-                        e *= 1.0f - a*a;
-                    }
-                    AC -= L;
-                    *E = e;
+                    else { for (size_t l=0u; l<L; ++l) { ACb[l*NL+n] = ACb[l*NL]; } }
                 }
-            }
-            else
-            {
-                for (size_t g=G; g>0u; --g, X+=B*(Lx-1u), Y+=B*(L-1u))
-                {
-                    for (size_t b=B; b>0u; --b, ++X, Y-=K-1u, ++E)
-                    {
-                        //Subtract mean
-                        if (mnz)
-                        {
-                            float mn = 0.0f;
-                            for (size_t l=Lx; l>0u; --l, X+=K) { mn += *X; }
-                            mn /= (float)Lx;
-                            for (size_t l=Lx; l>0u; --l) { X-=K; *X -= mn; }
-                        }
-
-                        //Get ACF
-                        for (size_t l=0u; l<L; ++l, X-=K*(Lx-l+1u), ++AC)
-                        {
-                            sm = 0.0f;
-                            for (size_t n=Lx-l; n>0u; --n, X+=K) { sm += *X * *(X+l*K); }
-                            *AC = sm;
-                        }
 
-                        //Normalize ACF
-                        if (unbiased)
-                        {
-                            for (size_t l=L; l>0u; --l) { *--AC /= (float)(Lx-l+1u); }
-                        }
-                        else
-                        {
-                            for (size_t l=L; l>0u; --l) { *--AC /= (float)Lx; }
-                        }
+                //Get polynomial params and error vars (Lev-Durb)
+                levdurb_lanes_s(ARb,NULL,Eb,ACb,Ab,P);
 
-                        //Get poly params and error var (Lev-Durb)
-                        *Y = 1.0f; Y += K;
-                        e = *AC++;
-                        a = -*AC / e; *Y = a;
-                        e += a * *AC++;
-                        for (size_t p=1u; p<P; ++p, AC+=p)
-                        {
-                            a = *AC;
-                            for (size_t q=p; q>0u; --q, Y+=K) { --AC; a += *AC * *Y; }
-                            a /= -e; *Y = a;
-                            for (size_t q=p; q>0u; --q, ++A) { Y-=K; *A = *Y; }
-                            Y += p*K;
-                            for (size_t q=p; q>0u; --q) { --A; Y-=K; *Y += a * *A; }
-                            e *= 1.0f - a*a;
-                        }
-                        AC -= L;
-                        *E = e;
-                    }
+                //Transpose back to Y and E
+                for (size_t n=0u; n<NL && v0+n<V; ++n)
+                {
+                    v = v0 + n;
+                    float *Yv = &Y[(v/K)*K*(P+1u)+v%K];
+                    Yv[0] = 1.0f;
+                    for (size_t p=0u; p<P; ++p) { Yv[(p+1u)*K] = -ARb[p*NL+n]; }
+                    E[v] = Eb[n];
                 }
             }
+            free(ACb); free(ARb); free(Ab);
         }
         free(AC); free(A);
     }
@@ -401,112 +331,40 @@ int sig2poly_d (double *Y, double *E, double *X, const size_t R, const size_t C,
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/Lx, G = V/B;
+            const size_t V = N/Lx, NL = LEVDURB_NL;
+            size_t v;
+            double *ACb, *ARb, *Ab, Eb[LEVDURB_NL];
+            if (!(ACb=(double *)malloc(L*NL*sizeof(double)))) { fprintf(stderr,"error in sig2poly_d: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(ARb=(double *)malloc(P*NL*sizeof(double)))) { fprintf(stderr,"error in sig2poly_d: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(Ab=(double *)malloc(P*NL*sizeof(double)))) { fprintf(stderr,"error in sig2poly_d: problem with malloc. "); perror("malloc"); return 1; }
 
-            if (K==1u && (G==1u || B==1u))
+            for (size_t v0=0u; v0<V; v0+=NL)
             {
-                for (size_t v=V; v>0u; --v, X+=Lx, Y+=P, ++E)
+                //Get ACFs of NL vecs into lane-major order (a partial block repeats its first vec)
+                for (size_t n=0u; n<NL; ++n)
                 {
-                    //Subtract mean
-                    if (mnz)
+                    if (v0+n<V)
                     {
-                        double mn = 0.0;
-                        for (size_t l=Lx; l>0u; --l, ++X) { mn += *X; }
-                        mn /= (double)Lx;
-                        for (size_t l=Lx; l>0u; --l) { *--X -= mn; }
+                        v = v0 + n;
+                        sig2ac_lanes_d(&ACb[n],&X[(v/K)*K*Lx+v%K],Lx,K,L,mnz,unbiased);
                     }
-
-                    //Get ACF
-                    for (size_t l=0u; l<L; ++l, X-=Lx-l+1u, ++AC)
-                    {
-                        sm = 0.0;
-                        for (size_t n=Lx-l; n>0u; --n, ++X) { sm += *X * *(X+l); }
-                        *AC = sm;
-                    }
-
-                    //Normalize ACF
-                    if (unbiased)
-                    {
-                        for (size_t l=L; l>0u; --l) { *--AC /= (double)(Lx-l+1u); }
-                    }
-                    else
-                    {
-                        for (size_t l=L; l>0u; --l) { *--AC /= (double)Lx; }
-                    }
-
-                    //Get poly params and error var (Lev-Durb)
-                    *Y++ = 1.0;
-                    e = *AC++;
-                    a = -*AC / e; *Y = a;
-                    e += a * *AC++;
-                    for (size_t p=1u; p<P; ++p, AC+=p)
-                    {
-                        a = *AC;
-                        for (size_t q=p; q>0u; --q, ++Y) { --AC; a += *AC * *Y; }
-                        a /= -e; *Y = a;
-                        for (size_t q=p; q>0u; --q, ++A) { --Y; *A = *Y; }
-                        Y += p;
-                        for (size_t q=p; q>0u; --q) { --A; --Y; *Y += a * *A; }
-                        e *= 1.0 - a*a;
-                    }
-                    AC -= L;
-                    *E = e;
+                    else { for (size_t l=0u; l<L; ++l) { ACb[l*NL+n] = ACb[l*NL]; } }
                 }
-            }
-            else
-            {
-                for (size_t g=G; g>0u; --g, X+=B*(Lx-1u), Y+=B*(L-1u))
-                {
-                    for (size_t b=B; b>0u; --b, ++X, Y-=K-1u, ++E)
-                    {
-                        //Subtract mean
-                        if (mnz)
-                        {
-                            double mn = 0.0;
-                            for (size_t l=Lx; l>0u; --l, X+=K) { mn += *X; }
-                            mn /= (double)Lx;
-                            for (size_t l=Lx; l>0u; --l) { X-=K; *X -= mn; }
-                        }
-
-                        //Get ACF
-                        for (size_t l=0u; l<L; ++l, X-=K*(Lx-l+1u), ++AC)
-                        {
-                            sm = 0.0;
-                            for (size_t n=Lx-l; n>0u; --n, X+=K) { sm += *X * *(X+l*K); }
-                            *AC = sm;
-                        }
 
-                        //Normalize ACF
-                        if (unbiased)
-                        {
-                            for (size_t l=L; l>0u; --l) { *--AC /= (double)(Lx-l+1u); }
-                        }
-                        else
-                        {
-                            for (size_t l=L; l>0u; --l) { *--AC /= (double)Lx; }
-                        }
+                //Get polynomial params and error vars (Lev-Durb)
+                levdurb_lanes_d(ARb,NULL,Eb,ACb,Ab,P);
 
-                        //Get poly params and error var (Lev-Durb)
-                        *Y = 1.0; Y += K;
-                        e = *AC++;
-                        a = -*AC / e; *Y = a;
-                        e += a * *AC++;
-                        for (size_t p=1u; p<P; ++p, AC+=p)
-                        {
-                            a = *AC;
-                            for (size_t q=p; q>0u; --q, Y+=K) { --AC; a += *AC * *Y; }
-                            a /= -e; *Y = a;
-                            for (size_t q=p; q>0u; --q, ++A) { Y-=K; *A = *Y; }
-                            Y += p*K;
-                            for (size_t q=p; q>0u; --q) { --A; Y-=K; *Y += a * *A; }
-                            e *= 1.0 - a*a;
-                        }
-                        AC -= L;
-                        *E = e;
-                    }
+                //Transpose back to Y and E
+                for (size_t n=0u; n<NL && v0+n<V; ++n)
+                {
+                    v = v0 + n;
+                    double *Yv = &Y[(v/K)*K*(P+1u)+v%K];
+                    Yv[0] = 1.0;
+                    for (size_t p=0u; p<P; ++p) { Yv[(p+1u)*K] = -ARb[p*NL+n]; }
+                    E[v] = Eb[n];
                 }
             }
+            free(ACb); free(ARb); free(Ab);
         }
         free(AC); free(A);
     }
@@ -9,9 +9,11 @@
 //This first gets the AC (autocovariance) of each sig,
 //and then obtains AR (autoregressive) coeffs by Levinson-Durbin recursion,
 //and finally uses the complex E matrix to get the parametric PSD.
+//For more than one vec, the AC and AR steps are done for 8 vecs at once (see levdurb_lanes.c).
 
 #include <stdio.h>
 #include <stdlib.h>
+#include "sig2ac_lanes.c"
 #include <math.h>
 
 #ifdef __cplusplus
@@ -92,7 +94,7 @@ int sig2psd_s (float *Y, float *X, const float *W, const size_t F, const size_t
 
             //AC-to-AR
             e = *AC++;
-            *A1 = *X / e; a = -*A1;
+            *A1 = *AC / e; a = -*A1;
             e += a * *AC++;
             for (size_t p=1u; p<P; ++p, AC+=p)
             {
@@ -123,59 +125,37 @@ int sig2psd_s (float *Y, float *X, const float *W, const size_t F, const size_t
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/Lx, G = V/B;
+            const size_t V = N/Lx, NL = LEVDURB_NL;
+            size_t v;
+            float *ACb, *ARb, *Ab, Eb[LEVDURB_NL];
+            if (!(ACb=(float *)malloc(L*NL*sizeof(float)))) { fprintf(stderr,"error in sig2psd_s: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(ARb=(float *)malloc(P*NL*sizeof(float)))) { fprintf(stderr,"error in sig2psd_s: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(Ab=(float *)malloc(P*NL*sizeof(float)))) { fprintf(stderr,"error in sig2psd_s: problem with malloc. "); perror("malloc"); return 1; }
 
-            if (K==1u && (G==1u || B==1u))
+            for (size_t v0=0u; v0<V; v0+=NL)
             {
-                for (size_t v=V; v>0u; --v, X+=Lx)
+                //Get ACFs of NL vecs into lane-major order (a partial block repeats its first vec)
+                for (size_t n=0u; n<NL; ++n)
                 {
-                    //Subtract mean
-                    if (mnz)
+                    if (v0+n<V)
                     {
-                        float mn = 0.0f;
-                        for (size_t l=Lx; l>0u; --l, ++X) { mn += *X; }
-                        mn /= (float)Lx;
-                        for (size_t l=Lx; l>0u; --l) { *--X -= mn; }
-                    }
-
-                    //Get ACF
-                    for (size_t l=0u; l<L; ++l, X-=Lx-l+1u, ++AC)
-                    {
-                        sm = 0.0f;
-                        for (size_t n=Lx-l; n>0u; --n, ++X) { sm += *X * *(X+l); }
-                        *AC = sm;
+                        v = v0 + n;
+                        sig2ac_lanes_s(&ACb[n],&X[(v/K)*K*Lx+v%K],Lx,K,L,mnz,unbiased);
                     }
+                    else { for (size_t l=0u; l<L; ++l) { ACb[l*NL+n] = ACb[l*NL]; } }
+                }
 
-                    //Normalize ACF
-                    if (unbiased)
-                    {
-                        for (size_t l=L; l>0u; --l) { *--AC /= (float)(Lx-l+1u); }
-                    }
-                    else
-                    {
-                        for (size_t l=L; l>0u; --l) { *--AC /= (float)Lx; }
-                    }
+                //Get AR params and error vars (Lev-Durb)
+                levdurb_lanes_s(ARb,NULL,Eb,ACb,Ab,P);
 
-                    //AC-to-AR
-                    e = *AC++;
-                    *A1 = *X / e; a = -*A1;
-                    e += a * *AC++;
-                    for (size_t p=1u; p<P; ++p, AC+=p)
-                    {
-                        a = *AC;
-                        for (size_t q=p; q>0u; --q, ++A1) { --AC; a -= *AC * *A1; }
-                        a /= -e; *A1 = -a;
-                        for (size_t q=p; q>0u; --q, ++A2) { --A1; *A2 = *A1; }
-                        A1 += p;
-                        for (size_t q=p; q>0u; --q) { --A2; --A1; *A1 += a * *A2; }
-                        e *= 1.0f - a*a;
-                    }
-                    AC -= L;
-                    
-                    //AR-to-PSD
-                    e *= 2.0f;
-                    for (size_t f=F; f>0u; --f, A1-=P, ++Y)
+                //AR-to-PSD
+                for (size_t n=0u; n<NL && v0+n<V; ++n)
+                {
+                    v = v0 + n;
+                    float *Yv = &Y[(v/K)*K*F+v%K];
+                    for (size_t p=0u; p<P; ++p) { A1[p] = ARb[p*NL+n]; }
+                    e = 2.0f * Eb[n];
+                    for (size_t f=F; f>0u; --f, A1-=P, Yv+=K)
                     {
                         yr = 1.0f; yi = 0.0f;
                         for (size_t p=P; p>0u; --p, ++A1, ++Er, ++Ei)
@@ -183,76 +163,12 @@ int sig2psd_s (float *Y, float *X, const float *W, const size_t F, const size_t
                             yr += *A1 * *Er;
                             yi += *A1 * *Ei;
                         }
-                        *Y = e / (yr*yr+yi*yi);
+                        *Yv = e / (yr*yr+yi*yi);
                     }
                     Er -= FP; Ei -= FP;
                 }
             }
-            else
-            {
-                for (size_t g=G; g>0u; --g, X+=B*(Lx-1u), Y+=B*(F-1u))
-                {
-                    for (size_t b=B; b>0u; --b, ++X, Y-=K*F-1u)
-                    {
-                        //Subtract mean
-                        if (mnz)
-                        {
-                            float mn = 0.0f;
-                            for (size_t l=Lx; l>0u; --l, X+=K) { mn += *X; }
-                            mn /= (float)Lx;
-                            for (size_t l=Lx; l>0u; --l) { X-=K; *X -= mn; }
-                        }
-
-                        //Get ACF
-                        for (size_t l=0u; l<L; ++l, X-=K*(Lx-l+1u), ++AC)
-                        {
-                            sm = 0.0f;
-                            for (size_t n=Lx-l; n>0u; --n, X+=K) { sm += *X * *(X+l*K); }
-                            *AC = sm;
-                        }
-
-                        //Normalize ACF
-                        if (unbiased)
-                        {
-                            for (size_t l=L; l>0u; --l) { *--AC /= (float)(Lx-l+1u); }
-                        }
-                        else
-                        {
-                            for (size_t l=L; l>0u; --l) { *--AC /= (float)Lx; }
-                        }
-
-                        //AC-to-AR
-                        e = *AC++;
-                        *A1 = *X / e; a = -*A1;
-                        e += a * *AC++;
-                        for (size_t p=1u; p<P; ++p, AC+=p)
-                        {
-                            a = *AC;
-                            for (size_t q=p; q>0u; --q, ++A1) { --AC; a -= *AC * *A1; }
-                            a /= -e; *A1 = -a;
-                            for (size_t q=p; q>0u; --q, ++A2) { --A1; *A2 = *A1; }
-                            A1 += p;
-                            for (size_t q=p; q>0u; --q) { --A2; --A1; *A1 += a * *A2; }
-                            e *= 1.0f - a*a;
-                        }
-                        AC -= L;
-
-                        //AR-to-PSD
-                        e *= 2.0f;
-                        for (size_t f=F; f>0u; --f, A1-=P, Y+=K)
-                        {
-                            yr = 1.0f; yi = 0.0f;
-                            for (size_t p=P; p>0u; --p, ++A1, ++Er, ++Ei)
-                            {
-                                yr += *A1 * *Er;
-                                yi += *A1 * *Ei;
-                            }
-                            *Y = e / (yr*yr+yi*yi);
-                        }
-                        Er -= FP; Ei -= FP;
-                    }
-                }
-            }
+            free(ACb); free(ARb); free(Ab);
         }
         free(A1); free(A2); free(Er); free(Ei);
     }
@@ -328,7 +244,7 @@ int sig2psd_d (double *Y, double *X, const double *W, const size_t F, const size
 
             //AC-to-AR
             e = *AC++;
-            *A1 = *X / e; a = -*A1;
+            *A1 = *AC / e; a = -*A1;
             e += a * *AC++;
             for (size_t p=1u; p<P; ++p, AC+=p)
             {
@@ -359,59 +275,37 @@ int sig2psd_d (double *Y, double *X, const double *W, const size_t F, const size
         else
         {
             const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
-            const size_t B = (iscolmajor && dim==0u) ? C*S*H : K;
-            const size_t V = N/Lx, G = V/B;
+            const size_t V = N/Lx, NL = LEVDURB_NL;
+            size_t v;
+            double *ACb, *ARb, *Ab, Eb[LEVDURB_NL];
+            if (!(ACb=(double *)malloc(L*NL*sizeof(double)))) { fprintf(stderr,"error in sig2psd_d: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(ARb=(double *)malloc(P*NL*sizeof(double)))) { fprintf(stderr,"error in sig2psd_d: problem with malloc. "); perror("malloc"); return 1; }
+            if (!(Ab=(double *)malloc(P*NL*sizeof(double)))) { fprintf(stderr,"error in sig2psd_d: problem with malloc. "); perror("malloc"); return 1; }
 
-            if (K==1u && (G==1u || B==1u))
+            for (size_t v0=0u; v0<V; v0+=NL)
             {
-                for (size_t v=V; v>0u; --v, X+=Lx)
+                //Get ACFs of NL vecs into lane-major order (a partial block repeats its first vec)
+                for (size_t n=0u; n<NL; ++n)
                 {
-                    //Subtract mean
-                    if (mnz)
+                    if (v0+n<V)
                     {
-                        double mn = 0.0;
-                        for (size_t l=Lx; l>0u; --l, ++X) { mn += *X; }
-                        mn /= (double)Lx;
-                        for (size_t l=Lx; l>0u; --l) { *--X -= mn; }
-                    }
-
-                    //Get ACF
-                    for (size_t l=0u; l<L; ++l, X-=Lx-l+1u, ++AC)
-                    {
-                        sm = 0.0;
-                        for (size_t n=Lx-l; n>0u; --n, ++X) { sm += *X * *(X+l); }
-                        *AC = sm;
+                        v = v0 + n;
+                        sig2ac_lanes_d(&ACb[n],&X[(v/K)*K*Lx+v%K],Lx,K,L,mnz,unbiased);
                     }
+                    else { for (size_t l=0u; l<L; ++l) { ACb[l*NL+n] = ACb[l*NL]; } }
+                }
 
-                    //Normalize ACF
-                    if (unbiased)
-                    {
-                        for (size_t l=L; l>0u; --l) { *--AC /= (double)(Lx-l+1u); }
-                    }
-                    else
-                    {
-                        for (size_t l=L; l>0u; --l) { *--AC /= (double)Lx; }
-                    }
+                //Get AR params and error vars (Lev-Durb)
+                levdurb_lanes_d(ARb,NULL,Eb,ACb,Ab,P);
 
-                    //AC-to-AR
-                    e = *AC++;
-                    *A1 = *X / e; a = -*A1;
-                    e += a * *AC++;
-                    for (size_t p=1u; p<P; ++p, AC+=p)
-                    {
-                        a = *AC;
-                        for (size_t q=p; q>0u; --q, ++A1) { --AC; a -= *AC * *A1; }
-                        a /= -e; *A1 = -a;
-                        for (size_t q=p; q>0u; --q, ++A2) { --A1; *A2 = *A1; }
-                        A1 += p;
-                        for (size_t q=p; q>0u; --q) { --A2; --A1; *A1 += a * *A2; }
-                        e *= 1.0 - a*a;
-                    }
-                    AC -= L;
-                    
-                    //AR-to-PSD
-                    e *= 2.0;
-                    for (size_t f=F; f>0u; --f, A1-=P, ++Y)
+                //AR-to-PSD
+                for (size_t n=0u; n<NL && v0+n<V; ++n)
+                {
+                    v = v0 + n;
+                    double *Yv = &Y[(v/K)*K*F+v%K];
+                    for (size_t p=0u; p<P; ++p) { A1[p] = ARb[p*NL+n]; }
+                    e = 2.0 * Eb[n];
+                    for (size_t f=F; f>0u; --f, A1-=P, Yv+=K)
                     {
                         yr = 1.0; yi = 0.0;
                         for (size_t p=P; p>0u; --p, ++A1, ++Er, ++Ei)
@@ -419,76 +313,12 @@ int sig2psd_d (double *Y, double *X, const double *W, const size_t F, const size
                             yr += *A1 * *Er;
                             yi += *A1 * *Ei;
                         }
-                        *Y = e / (yr*yr+yi*yi);
+                        *Yv = e / (yr*yr+yi*yi);
                     }
                     Er -= FP; Ei -= FP;
                 }
             }
-            else
-            {
-                for (size_t g=G; g>0u; --g, X+=B*(Lx-1u), Y+=B*(F-1u))
-                {
-                    for (size_t b=B; b>0u; --b, ++X, Y-=K*F-1u)
-                    {
-                        //Subtract mean
-                        if (mnz)
-                        {
-                            double mn = 0.0;
-                            for (size_t l=Lx; l>0u; --l, X+=K) { mn += *X; }
-                            mn /= (double)Lx;
-                            for (size_t l=Lx; l>0u; --l) { X-=K; *X -= mn; }
-                        }
-
-                        //Get ACF
-                        for (size_t l=0u; l<L; ++l, X-=K*(Lx-l+1u), ++AC)
-                        {
-                            sm = 0.0;
-                            for (size_t n=Lx-l; n>0u; --n, X+=K) { sm += *X * *(X+l*K); }
-                            *AC = sm;
-                        }
-
-                        //Normalize ACF
-                        if (unbiased)
-                        {
-                            for (size_t l=L; l>0u; --l) { *--AC /= (double)(Lx-l+1u); }
-                        }
-                        else
-                        {
-                            for (size_t l=L; l>0u; --l) { *--AC /= (double)Lx; }
-                        }
-
-                        //AC-to-AR
-                        e = *AC++;
-                        *A1 = *X / e; a = -*A1;
-                        e += a * *AC++;
-                        for (size_t p=1u; p<P; ++p, AC+=p)
-                        {
-                            a = *AC;
-                            for (size_t q=p; q>0u; --q, ++A1) { --AC; a -= *AC * *A1; }
-                            a /= -e; *A1 = -a;
-                            for (size_t q=p; q>0u; --q, ++A2) { --A1; *A2 = *A1; }
-                            A1 += p;
-                            for (size_t q=p; q>0u; --q) { --A2; --A1; *A1 += a * *A2; }
-                            e *= 1.0 - a*a;
-                        }
-                        AC -= L;
-
-                        //AR-to-PSD
-                        e *= 2.0;
-                        for (size_t f=F; f>0u; --f, A1-=P, Y+=K)
-                        {
-                            yr = 1.0; yi = 0.0;
-                            for (size_t p=P; p>0u; --p, ++A1, ++Er, ++Ei)
-                            {
-                                yr += *A1 * *Er;
-                                yi += *A1 * *Ei;
-                            }
-                            *Y = e / (yr*yr+yi*yi);
-                        }
-                        Er -= FP; Ei -= FP;
-                    }
-                }
-            }
+            free(ACb); free(ARb); free(Ab);
         }
         free(A1); free(A2); free(Er); free(Ei);
     }
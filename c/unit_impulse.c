@@ -8,6 +8,9 @@
 //For the complex case, the real part is the unit_impulse,
 //and the imaginary part is left at 0.
 
+//The _events function gives the output as an event list of length 7 (see densify.c),
+//where the dense signal has size R x C x S x H (with N=R*C*S*H).
+
 #include <stdio.h>
 
 #ifdef __cplusplus
@@ -19,6 +22,7 @@ int unit_impulse_s (float *Y, const size_t N, const size_t samp);
 int unit_impulse_d (double *Y, const size_t N, const size_t samp);
 int unit_impulse_c (float *Y, const size_t N, const size_t samp);
 int unit_impulse_z (double *Y, const size_t N, const size_t samp);
+int unit_impulse_events (double *Y, const size_t R, const size_t C, const size_t S, const size_t H, const size_t samp);
 
 
 int unit_impulse_s (float *Y, const size_t N, const size_t samp)
@@ -69,6 +73,19 @@ int unit_impulse_z (double *Y, const size_t N, const size_t samp)
 }
 
 
+int unit_impulse_events (double *Y, const size_t R, const size_t C, const size_t S, const size_t H, const size_t samp)
+{
+    const size_t N = R*C*S*H;
+    if (samp+1u>=N) { fprintf(stderr, "error in unit_impulse_events: samp (delay) must be less than N-1\n"); return 1; }
+
+    Y[0] = (double)R; Y[1] = (double)C; Y[2] = (double)S; Y[3] = (double)H;
+    Y[4] = 1.0; Y[5] = 0.0;
+    Y[6] = (double)samp;
+
+    return 0;
+}
+
+
 #ifdef __cplusplus
 }
 }
@@ -0,0 +1,183 @@
+//Winograd minimal filtering for 1D conv/xcorr with small kernels, used by conv1d, xcorr1d, conv1 and xcorr1.
+//This is an include-only file with static functions for the real-valued case.
+
+//The outputs of each tile of 4 use F(4,3) or F(4,5) for L2 in {3,5} (the usual small kernels),
+//with points 0,+-1,+-1/2,inf (and +-2 for F(4,5)).
+//This takes 6 or 8 multiplies per 4 outputs, instead of 12 or 20 (2x or 2.5x fewer).
+//Other L2 (and the leftover outputs) use direct summation.
+//(For L2=7, F(2,7) needed more adds than it saved in multiplies, so it is direct.)
+
+//The error is larger than for direct summation, since it scales with all of the inputs of a tile,
+//not with the products for each output. For each output of a tile with inputs d
+//(the 6 or 8 samps of X1 used by the tile), the first-order worst case is:
+//|error| <= c * eps * max|X2| * sum|d|, with c = 140 for F(4,3) and c = 330 for F(4,5).
+//In tests with uniform, mixed-magnitude (1e-4 to 1e4) and alternating-sign inputs,
+//the largest error found was about 16 (F(4,3)) and 29 (F(4,5)) in these units.
+//So a small output next to large inputs (within the same tile) can have a large relative error.
+
+//X2 is given in memory order, and flip=1 reverses it (for conv), or flip=0 uses it as is (for xcorr).
+//X1 and Y have stride K, and Y gets Ly outputs with X2 fully within X1.
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static void wino1d_s (float *Y, const float *X1, const float *X2, const size_t Ly, const size_t L2, const size_t K, const int flip);
+static void wino1d_d (double *Y, const double *X1, const double *X2, const size_t Ly, const size_t L2, const size_t K, const int flip);
+
+
+static void wino1d_s (float *Y, const float *X1, const float *X2, const size_t Ly, const size_t L2, const size_t K, const int flip)
+{
+    float h[5], u[8], d[8], v[8], e, o, s1, t1, s3, t3, s5, t5, sm;
+    size_t w = 0u;
+
+    //Kernel in cross-correlation order
+    for (size_t l=0u; l<L2; ++l) { h[l] = (flip) ? X2[L2-1u-l] : X2[l]; }
+
+    //Winograd tiles (filter transform u is done once)
+    if (L2==3u)
+    {
+        //F(4,3) with points 0,+-1,+-1/2,inf
+        u[0] = h[0];
+        u[1] = (1.0f/6.0f)*h[0] + (1.0f/6.0f)*h[1] + (1.0f/6.0f)*h[2];
+        u[2] = (1.0f/6.0f)*h[0] - (1.0f/6.0f)*h[1] + (1.0f/6.0f)*h[2];
+        u[3] = (4.0f/3.0f)*h[0] + (2.0f/3.0f)*h[1] + (1.0f/3.0f)*h[2];
+        u[4] = (4.0f/3.0f)*h[0] - (2.0f/3.0f)*h[1] + (1.0f/3.0f)*h[2];
+        u[5] = 0.25f*h[2];
+        for (; w+4u<=Ly; w+=4u, X1+=4u*K, Y+=4u*K)
+        {
+            for (size_t j=0u; j<6u; ++j) { d[j] = X1[j*K]; }
+            v[0] = u[0] * (d[0] - 5.0f*d[2] + 4.0f*d[4]);
+            e = -d[2] + 4.0f*d[4]; o = -d[1] + 4.0f*d[3];
+            v[1] = u[1] * (e+o); v[2] = u[2] * (e-o);
+            e = 2.0f*d[2] - 2.0f*d[4]; o = d[1] - d[3];
+            v[3] = u[3] * (e+o); v[4] = u[4] * (e-o);
+            v[5] = u[5] * (d[1] - 5.0f*d[3] + 4.0f*d[5]);
+            s1 = v[1] + v[2]; t1 = v[1] - v[2]; s3 = v[3] + v[4]; t3 = v[3] - v[4];
+            Y[0] = v[0] + s1 + s3;
+            Y[K] = t1 + 0.5f*t3;
+            Y[2u*K] = s1 + 0.25f*s3;
+            Y[3u*K] = t1 + 0.125f*t3 + v[5];
+        }
+    }
+    else if (L2==5u)
+    {
+        //F(4,5) with points 0,+-1,+-2,+-1/2,inf
+        u[0] = 0.25f*h[0];
+        u[1] = (1.0f/18.0f)*h[0] + (1.0f/18.0f)*h[1] + (1.0f/18.0f)*h[2] + (1.0f/18.0f)*h[3] + (1.0f/18.0f)*h[4];
+        u[2] = (1.0f/18.0f)*h[0] - (1.0f/18.0f)*h[1] + (1.0f/18.0f)*h[2] - (1.0f/18.0f)*h[3] + (1.0f/18.0f)*h[4];
+        u[3] = (1.0f/360.0f)*h[0] + (1.0f/180.0f)*h[1] + (1.0f/90.0f)*h[2] + (1.0f/45.0f)*h[3] + (2.0f/45.0f)*h[4];
+        u[4] = (1.0f/360.0f)*h[0] - (1.0f/180.0f)*h[1] + (1.0f/90.0f)*h[2] - (1.0f/45.0f)*h[3] + (2.0f/45.0f)*h[4];
+        u[5] = (16.0f/45.0f)*h[0] + (8.0f/45.0f)*h[1] + (4.0f/45.0f)*h[2] + (2.0f/45.0f)*h[3] + (1.0f/45.0f)*h[4];
+        u[6] = (16.0f/45.0f)*h[0] - (8.0f/45.0f)*h[1] + (4.0f/45.0f)*h[2] - (2.0f/45.0f)*h[3] + (1.0f/45.0f)*h[4];
+        u[7] = 0.25f*h[4];
+        for (; w+4u<=Ly; w+=4u, X1+=4u*K, Y+=4u*K)
+        {
+            for (size_t j=0u; j<8u; ++j) { d[j] = X1[j*K]; }
+            v[0] = u[0] * (4.0f*d[0] - 21.0f*d[2] + 21.0f*d[4] - 4.0f*d[6]);
+            e = -4.0f*d[2] + 17.0f*d[4] - 4.0f*d[6]; o = -4.0f*d[1] + 17.0f*d[3] - 4.0f*d[5];
+            v[1] = u[1] * (e+o); v[2] = u[2] * (e-o);
+            e = d[2] - 5.0f*d[4] + 4.0f*d[6]; o = 2.0f*d[1] - 10.0f*d[3] + 8.0f*d[5];
+            v[3] = u[3] * (e+o); v[4] = u[4] * (e-o);
+            e = 8.0f*d[2] - 10.0f*d[4] + 2.0f*d[6]; o = 4.0f*d[1] - 5.0f*d[3] + d[5];
+            v[5] = u[5] * (e+o); v[6] = u[6] * (e-o);
+            v[7] = u[7] * (-4.0f*d[1] + 21.0f*d[3] - 21.0f*d[5] + 4.0f*d[7]);
+            s1 = v[1] + v[2]; t1 = v[1] - v[2]; s3 = v[3] + v[4]; t3 = v[3] - v[4]; s5 = v[5] + v[6]; t5 = v[5] - v[6];
+            Y[0] = v[0] + s1 + s3 + s5;
+            Y[K] = t1 + 2.0f*t3 + 0.5f*t5;
+            Y[2u*K] = s1 + 4.0f*s3 + 0.25f*s5;
+            Y[3u*K] = t1 + 8.0f*t3 + 0.125f*t5 + v[7];
+        }
+    }
+
+    //Remaining outputs (direct)
+    for (; w<Ly; ++w, X1+=K, Y+=K)
+    {
+        sm = 0.0f;
+        for (size_t l=0u; l<L2; ++l) { sm += h[l] * X1[l*K]; }
+        *Y = sm;
+    }
+}
+
+
+static void wino1d_d (double *Y, const double *X1, const double *X2, const size_t Ly, const size_t L2, const size_t K, const int flip)
+{
+    double h[5], u[8], d[8], v[8], e, o, s1, t1, s3, t3, s5, t5, sm;
+    size_t w = 0u;
+
+    //Kernel in cross-correlation order
+    for (size_t l=0u; l<L2; ++l) { h[l] = (flip) ? X2[L2-1u-l] : X2[l]; }
+
+    //Winograd tiles (filter transform u is done once)
+    if (L2==3u)
+    {
+        //F(4,3) with points 0,+-1,+-1/2,inf
+        u[0] = h[0];
+        u[1] = (1.0/6.0)*h[0] + (1.0/6.0)*h[1] + (1.0/6.0)*h[2];
+        u[2] = (1.0/6.0)*h[0] - (1.0/6.0)*h[1] + (1.0/6.0)*h[2];
+        u[3] = (4.0/3.0)*h[0] + (2.0/3.0)*h[1] + (1.0/3.0)*h[2];
+        u[4] = (4.0/3.0)*h[0] - (2.0/3.0)*h[1] + (1.0/3.0)*h[2];
+        u[5] = 0.25*h[2];
+        for (; w+4u<=Ly; w+=4u, X1+=4u*K, Y+=4u*K)
+        {
+            for (size_t j=0u; j<6u; ++j) { d[j] = X1[j*K]; }
+            v[0] = u[0] * (d[0] - 5.0*d[2] + 4.0*d[4]);
+            e = -d[2] + 4.0*d[4]; o = -d[1] + 4.0*d[3];
+            v[1] = u[1] * (e+o); v[2] = u[2] * (e-o);
+            e = 2.0*d[2] - 2.0*d[4]; o = d[1] - d[3];
+            v[3] = u[3] * (e+o); v[4] = u[4] * (e-o);
+            v[5] = u[5] * (d[1] - 5.0*d[3] + 4.0*d[5]);
+            s1 = v[1] + v[2]; t1 = v[1] - v[2]; s3 = v[3] + v[4]; t3 = v[3] - v[4];
+            Y[0] = v[0] + s1 + s3;
+            Y[K] = t1 + 0.5*t3;
+            Y[2u*K] = s1 + 0.25*s3;
+            Y[3u*K] = t1 + 0.125*t3 + v[5];
+        }
+    }
+    else if (L2==5u)
+    {
+        //F(4,5) with points 0,+-1,+-2,+-1/2,inf
+        u[0] = 0.25*h[0];
+        u[1] = (1.0/18.0)*h[0] + (1.0/18.0)*h[1] + (1.0/18.0)*h[2] + (1.0/18.0)*h[3] + (1.0/18.0)*h[4];
+        u[2] = (1.0/18.0)*h[0] - (1.0/18.0)*h[1] + (1.0/18.0)*h[2] - (1.0/18.0)*h[3] + (1.0/18.0)*h[4];
+        u[3] = (1.0/360.0)*h[0] + (1.0/180.0)*h[1] + (1.0/90.0)*h[2] + (1.0/45.0)*h[3] + (2.0/45.0)*h[4];
+        u[4] = (1.0/360.0)*h[0] - (1.0/180.0)*h[1] + (1.0/90.0)*h[2] - (1.0/45.0)*h[3] + (2.0/45.0)*h[4];
+        u[5] = (16.0/45.0)*h[0] + (8.0/45.0)*h[1] + (4.0/45.0)*h[2] + (2.0/45.0)*h[3] + (1.0/45.0)*h[4];
+        u[6] = (16.0/45.0)*h[0] - (8.0/45.0)*h[1] + (4.0/45.0)*h[2] - (2.0/45.0)*h[3] + (1.0/45.0)*h[4];
+        u[7] = 0.25*h[4];
+        for (; w+4u<=Ly; w+=4u, X1+=4u*K, Y+=4u*K)
+        {
+            for (size_t j=0u; j<8u; ++j) { d[j] = X1[j*K]; }
+            v[0] = u[0] * (4.0*d[0] - 21.0*d[2] + 21.0*d[4] - 4.0*d[6]);
+            e = -4.0*d[2] + 17.0*d[4] - 4.0*d[6]; o = -4.0*d[1] + 17.0*d[3] - 4.0*d[5];
+            v[1] = u[1] * (e+o); v[2] = u[2] * (e-o);
+            e = d[2] - 5.0*d[4] + 4.0*d[6]; o = 2.0*d[1] - 10.0*d[3] + 8.0*d[5];
+            v[3] = u[3] * (e+o); v[4] = u[4] * (e-o);
+            e = 8.0*d[2] - 10.0*d[4] + 2.0*d[6]; o = 4.0*d[1] - 5.0*d[3] + d[5];
+            v[5] = u[5] * (e+o); v[6] = u[6] * (e-o);
+            v[7] = u[7] * (-4.0*d[1] + 21.0*d[3] - 21.0*d[5] + 4.0*d[7]);
+            s1 = v[1] + v[2]; t1 = v[1] - v[2]; s3 = v[3] + v[4]; t3 = v[3] - v[4]; s5 = v[5] + v[6]; t5 = v[5] - v[6];
+            Y[0] = v[0] + s1 + s3 + s5;
+            Y[K] = t1 + 2.0*t3 + 0.5*t5;
+            Y[2u*K] = s1 + 4.0*s3 + 0.25*s5;
+            Y[3u*K] = t1 + 8.0*t3 + 0.125*t5 + v[7];
+        }
+    }
+
+    //Remaining outputs (direct)
+    for (; w<Ly; ++w, X1+=K, Y+=K)
+    {
+        sm = 0.0;
+        for (size_t l=0u; l<L2; ++l) { sm += h[l] * X1[l*K]; }
+        *Y = sm;
+    }
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -8,7 +8,12 @@
 //This is like xcorr1d, except uses Ly directly instead of padding to control framing.
 //This is more flexible, intuitive, slightly faster, and allows BLAS-like usage.
 
+//For the real-valued case with str=1, dil=1 and L2 in {3,5} (the usual small kernels),
+//the outputs with X2 fully within X1 use Winograd minimal filtering F(4,3) or F(4,5).
+//See wino1d.c for the method and its error bound. All other cases use direct summation.
+
 #include <stdio.h>
+#include "wino1d.c"
 
 #ifdef __cplusplus
 namespace codee {
@@ -78,6 +83,12 @@ int xcorr1_s (float *Y, const float *X1, const float *X2, const size_t R, const
         }
         else            //X2 fully within X1
         {        
+            if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<Ly)
+            {
+                const size_t nw = ((size_t)((int)L1-es)<Ly-w) ? (size_t)((int)L1-es) : Ly-w;
+                wino1d_s(Y,X1,X2,nw,L2,1u,0);
+                X1 += nw; Y += nw; es += (int)nw; w += nw;
+            }
             while (es<(int)L1 && w<Ly)
             {
                 sm = 0.0f;
@@ -148,6 +159,12 @@ int xcorr1_s (float *Y, const float *X1, const float *X2, const size_t R, const
                 }
                 else            //X2 fully within X1
                 {        
+                    if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<Ly)
+                    {
+                        const size_t nw = ((size_t)((int)L1-es)<Ly-w) ? (size_t)((int)L1-es) : Ly-w;
+                        wino1d_s(Y,X1,X2,nw,L2,K,0);
+                        X1 += nw*K; Y += nw*K; es += (int)nw; w += nw;
+                    }
                     while (es<(int)L1 && w<Ly)
                     {
                         sm = 0.0f;
@@ -240,6 +257,12 @@ int xcorr1_d (double *Y, const double *X1, const double *X2, const size_t R, con
         }
         else            //X2 fully within X1
         {        
+            if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<Ly)
+            {
+                const size_t nw = ((size_t)((int)L1-es)<Ly-w) ? (size_t)((int)L1-es) : Ly-w;
+                wino1d_d(Y,X1,X2,nw,L2,1u,0);
+                X1 += nw; Y += nw; es += (int)nw; w += nw;
+            }
             while (es<(int)L1 && w<Ly)
             {
                 sm = 0.0;
@@ -310,6 +333,12 @@ int xcorr1_d (double *Y, const double *X1, const double *X2, const size_t R, con
                 }
                 else            //X2 fully within X1
                 {        
+                    if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<Ly)
+                    {
+                        const size_t nw = ((size_t)((int)L1-es)<Ly-w) ? (size_t)((int)L1-es) : Ly-w;
+                        wino1d_d(Y,X1,X2,nw,L2,K,0);
+                        X1 += nw*K; Y += nw*K; es += (int)nw; w += nw;
+                    }
                     while (es<(int)L1 && w<Ly)
                     {
                         sm = 0.0;
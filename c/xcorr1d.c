@@ -10,7 +10,16 @@
 //Each vector in X1 has length L_in, and each vector in Y has length L_out, set by:
 //L_out = floor[1 + (L_in + 2*pad - dil*(L2-1) - 1)/stride].
 
+//For the real-valued case with str=1, dil=1 and L2 in {3,5} (the usual small kernels),
+//the outputs with X2 fully within X1 use Winograd minimal filtering F(4,3) or F(4,5).
+//See wino1d.c for the method and its error bound. All other cases use direct summation.
+
+//For the real-valued case with dil>1 and contiguous vecs, the outputs with X2 fully within X1
+//use blocked direct summation with the taps in the outer loop (see dil1d.c).
+
 #include <stdio.h>
+#include "wino1d.c"
+#include "dil1d.c"
 
 #ifdef __cplusplus
 namespace codee {
@@ -92,6 +101,18 @@ int xcorr1d_s (float *Y, const float *X1, const float *X2, const size_t R, const
         }
         else            //X2 fully within X1
         {        
+            if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<W)
+            {
+                const size_t nw = ((size_t)((int)L1-es)<W-w) ? (size_t)((int)L1-es) : W-w;
+                wino1d_s(Y,X1,X2,nw,L2,1u,0);
+                X1 += nw; Y += nw; es += (int)nw; w += nw;
+            }
+            else if (dil>1u && es<(int)L1 && w<W)
+            {
+                const size_t nw = ((size_t)((int)L1-1-es)/str+1u<W-w) ? (size_t)((int)L1-1-es)/str+1u : W-w;
+                dil1d_s(Y,X1,X2,nw,L2,str,dil,0);
+                X1 += nw*str; Y += nw; es += (int)(nw*str); w += nw;
+            }
             while (es<(int)L1 && w<W)
             {
                 sm = 0.0f;
@@ -165,6 +186,18 @@ int xcorr1d_s (float *Y, const float *X1, const float *X2, const size_t R, const
                 }
                 else            //X2 fully within X1
                 {        
+                    if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<W)
+                    {
+                        const size_t nw = ((size_t)((int)L1-es)<W-w) ? (size_t)((int)L1-es) : W-w;
+                        wino1d_s(Y,X1,X2,nw,L2,K,0);
+                        X1 += nw*K; Y += nw*K; es += (int)nw; w += nw;
+                    }
+                    else if (K==1u && dil>1u && es<(int)L1 && w<W)
+                    {
+                        const size_t nw = ((size_t)((int)L1-1-es)/str+1u<W-w) ? (size_t)((int)L1-1-es)/str+1u : W-w;
+                        dil1d_s(Y,X1,X2,nw,L2,str,dil,0);
+                        X1 += nw*str; Y += nw; es += (int)(nw*str); w += nw;
+                    }
                     while (es<(int)L1 && w<W)
                     {
                         sm = 0.0f;
@@ -265,6 +298,18 @@ int xcorr1d_d (double *Y, const double *X1, const double *X2, const size_t R, co
         }
         else            //X2 fully within X1
         {        
+            if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<W)
+            {
+                const size_t nw = ((size_t)((int)L1-es)<W-w) ? (size_t)((int)L1-es) : W-w;
+                wino1d_d(Y,X1,X2,nw,L2,1u,0);
+                X1 += nw; Y += nw; es += (int)nw; w += nw;
+            }
+            else if (dil>1u && es<(int)L1 && w<W)
+            {
+                const size_t nw = ((size_t)((int)L1-1-es)/str+1u<W-w) ? (size_t)((int)L1-1-es)/str+1u : W-w;
+                dil1d_d(Y,X1,X2,nw,L2,str,dil,0);
+                X1 += nw*str; Y += nw; es += (int)(nw*str); w += nw;
+            }
             while (es<(int)L1 && w<W)
             {
                 sm = 0.0;
@@ -335,6 +380,18 @@ int xcorr1d_d (double *Y, const double *X1, const double *X2, const size_t R, co
                 }
                 else            //X2 fully within X1
                 {        
+                    if (str==1u && dil==1u && (L2==3u || L2==5u) && es<(int)L1 && w<W)
+                    {
+                        const size_t nw = ((size_t)((int)L1-es)<W-w) ? (size_t)((int)L1-es) : W-w;
+                        wino1d_d(Y,X1,X2,nw,L2,K,0);
+                        X1 += nw*K; Y += nw*K; es += (int)nw; w += nw;
+                    }
+                    else if (K==1u && dil>1u && es<(int)L1 && w<W)
+                    {
+                        const size_t nw = ((size_t)((int)L1-1-es)/str+1u<W-w) ? (size_t)((int)L1-1-es)/str+1u : W-w;
+                        dil1d_d(Y,X1,X2,nw,L2,str,dil,0);
+                        X1 += nw*str; Y += nw; es += (int)(nw*str); w += nw;
+                    }
                     while (es<(int)L1 && w<W)
                     {
                         sm = 0.0;
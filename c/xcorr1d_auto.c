@@ -0,0 +1,136 @@
+//1D cross-correlation of each vector in X1 by X2, with PyTorch-style framing (pad, stride, dilation).
+//This is a front door for xcorr1d and xcorr1d_fft, which give the same output (see those for more info).
+//The faster method is chosen from a simple cost model, which uses L1, L2, pad, stride, dilation,
+//the number of vecs, and the data type (real or complex), with constants from auto_cost.h.
+
+//The direct method costs ~Ly*L2 multiply-accumulates per vec.
+//For real data, xcorr1d_fft uses overlap-save with str phases: each block of nfft-M+1 outputs
+//costs str+1 FFTs of length nfft per vec, where M = ceil(N2/str), and nfft is chosen as in xcorr1d_fft.
+//For complex data, xcorr1d_fft uses ~2 FFTs of length nextpow2(N1+N2) per vec.
+//Negative pad is supported only by xcorr1d, so it is always direct.
+//The constants in auto_cost.h can be calibrated for the current machine by "make calib".
+
+#include <stdio.h>
+#include <math.h>
+#include "auto_cost.h"
+#include "xcorr1d.c"
+#include "xcorr1d_fft.c"
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static int xcorr1d_auto_fft (const size_t N, const size_t L1, const size_t L2, const int pad, const size_t str, const size_t dil, const int cplx, const double cdir, const double cfft, const double cplan);
+
+int xcorr1d_auto_s (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim);
+int xcorr1d_auto_d (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim);
+int xcorr1d_auto_c (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim);
+int xcorr1d_auto_z (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim);
+
+
+static int xcorr1d_auto_fft (const size_t N, const size_t L1, const size_t L2, const int pad, const size_t str, const size_t dil, const int cplx, const double cdir, const double cfft, const double cplan)
+{
+    if (pad<0) { return 0; }
+    const double V = (double)(N/L1);
+    const size_t N1 = L1 + 2u*(size_t)pad, N2 = dil*(L2-1u) + 1u;
+    const size_t Ly = 1u + (N1-N2)/str;
+    const double dir = ((cplx) ? 4.0 : 1.0) * cdir * V * (double)Ly * (double)L2;
+    double fft;
+    if (cplx)
+    {
+        size_t nfft = 1u;
+        while (nfft<N1+N2) { nfft *= 2u; }
+        fft = 3.0*cplan + 2.0 * cfft * (double)nfft * log2((double)nfft) * (1.0+2.0*V);
+    }
+    else
+    {
+        const size_t M = (N2+str-1u)/str;
+        const size_t nfft = xcorr1d_fft_get_nfft(M,str,Ly);
+        const double nblk = (double)((Ly+nfft-M)/(nfft-M+1u));
+        fft = 3.0*cplan + cfft * (double)nfft * log2((double)nfft) * ((double)str + V*nblk*(double)(str+1u));
+    }
+    return (fft<dir);
+}
+
+
+int xcorr1d_auto_s (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in xcorr1d_auto_s: dim must be in [0 3]\n"); return 1; }
+    if (str<1u || dil<1u) { fprintf(stderr,"error in xcorr1d_auto_s: str and dil must be positive\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if ((int)L1+2*pad<=(int)(dil*(L2-1u))) { fprintf(stderr,"error in xcorr1d_auto_s: L1+2*pad must be > dil*(L2-1)\n"); return 1; }
+
+    if (N>0u && L2>0u && xcorr1d_auto_fft(N,L1,L2,pad,str,dil,0,AUTO_COST_CONV1D_S,AUTO_COST_FFT_S,AUTO_COST_PLAN_S))
+    {
+        return xcorr1d_fft_s(Y,X1,X2,R,C,S,H,iscolmajor,L2,(size_t)pad,str,dil,dim);
+    }
+    else
+    {
+        return xcorr1d_s(Y,X1,X2,R,C,S,H,iscolmajor,L2,pad,str,dil,dim);
+    }
+}
+
+
+int xcorr1d_auto_d (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in xcorr1d_auto_d: dim must be in [0 3]\n"); return 1; }
+    if (str<1u || dil<1u) { fprintf(stderr,"error in xcorr1d_auto_d: str and dil must be positive\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if ((int)L1+2*pad<=(int)(dil*(L2-1u))) { fprintf(stderr,"error in xcorr1d_auto_d: L1+2*pad must be > dil*(L2-1)\n"); return 1; }
+
+    if (N>0u && L2>0u && xcorr1d_auto_fft(N,L1,L2,pad,str,dil,0,AUTO_COST_CONV1D_D,AUTO_COST_FFT_D,AUTO_COST_PLAN_D))
+    {
+        return xcorr1d_fft_d(Y,X1,X2,R,C,S,H,iscolmajor,L2,(size_t)pad,str,dil,dim);
+    }
+    else
+    {
+        return xcorr1d_d(Y,X1,X2,R,C,S,H,iscolmajor,L2,pad,str,dil,dim);
+    }
+}
+
+
+int xcorr1d_auto_c (float *Y, const float *X1, const float *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in xcorr1d_auto_c: dim must be in [0 3]\n"); return 1; }
+    if (str<1u || dil<1u) { fprintf(stderr,"error in xcorr1d_auto_c: str and dil must be positive\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if ((int)L1+2*pad<=(int)(dil*(L2-1u))) { fprintf(stderr,"error in xcorr1d_auto_c: L1+2*pad must be > dil*(L2-1)\n"); return 1; }
+
+    if (N>0u && L2>0u && xcorr1d_auto_fft(N,L1,L2,pad,str,dil,1,AUTO_COST_CONV1D_S,AUTO_COST_FFT_S,AUTO_COST_PLAN_S))
+    {
+        return xcorr1d_fft_c(Y,X1,X2,R,C,S,H,iscolmajor,L2,(size_t)pad,str,dil,dim);
+    }
+    else
+    {
+        return xcorr1d_c(Y,X1,X2,R,C,S,H,iscolmajor,L2,pad,str,dil,dim);
+    }
+}
+
+
+int xcorr1d_auto_z (double *Y, const double *X1, const double *X2, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t L2, const int pad, const size_t str, const size_t dil, const size_t dim)
+{
+    if (dim>3u) { fprintf(stderr,"error in xcorr1d_auto_z: dim must be in [0 3]\n"); return 1; }
+    if (str<1u || dil<1u) { fprintf(stderr,"error in xcorr1d_auto_z: str and dil must be positive\n"); return 1; }
+    const size_t N = R*C*S*H;
+    const size_t L1 = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+    if ((int)L1+2*pad<=(int)(dil*(L2-1u))) { fprintf(stderr,"error in xcorr1d_auto_z: L1+2*pad must be > dil*(L2-1)\n"); return 1; }
+
+    if (N>0u && L2>0u && xcorr1d_auto_fft(N,L1,L2,pad,str,dil,1,AUTO_COST_CONV1D_D,AUTO_COST_FFT_D,AUTO_COST_PLAN_D))
+    {
+        return xcorr1d_fft_z(Y,X1,X2,R,C,S,H,iscolmajor,L2,(size_t)pad,str,dil,dim);
+    }
+    else
+    {
+        return xcorr1d_z(Y,X1,X2,R,C,S,H,iscolmajor,L2,pad,str,dil,dim);
+    }
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
@@ -0,0 +1,433 @@
+//All-pairs cross-correlation of the Nch channels (vectors) in X,
+//as for the cross-correlation matrix of a microphone or sensor array.
+//Each channel has length L, and only lags -M to M are output (M is the max lag, M < L).
+//Use M = L-1 for all lags.
+
+//For each pair of channels i<=j, in the order (0,0) (0,1) ... (0,Nch-1) (1,1) (1,2) ... (Nch-1,Nch-1):
+//Yij[m] = sum_n Xi[n+m] * conj(Xj[n]), for m = -M to M.
+//This is the same as xcorr of Xi by Xj with shape 'full', restricted to lags -M to M.
+//The pairs j<i are not output, since Yji[m] = conj(Yij[-m]).
+
+//The following convention is forced here (as in conv1d_multi):
+//Samples from one channel are always contiguous in memory, i.e. memory order is Nch x L.
+//So, if X is row-major, then it has size Nch x L, but if X is col-major, then it has size L x Nch.
+//Likewise, Y has memory order P x (2M+1), where P = Nch*(Nch+1)/2 is the number of pairs.
+
+//For the FFT method, each channel is transformed only once (as one plan_many batch),
+//then the P cross-spectra Xi.*conj(Xj) are formed, and inverse transformed in batches of up to 16.
+//The FFT length is nfft = nextpow2(L+M), which is the minimum that avoids circular wrap of lags -M to M,
+//so a small max lag also reduces the FFT length (down to nextpow2(L), from nextpow2(2L-1) for all lags).
+//So the cost is Nch+P FFTs, instead of 3*P for separate xcorr_fft calls.
+
+//For small M, direct summation (of only the 2M+1 lags) is cheaper,
+//so the method is chosen with the same cost model as xcorr_auto (see auto_cost.h).
+
+#include <stdio.h>
+#include <math.h>
+#include <fftw3.h>
+#include "auto_cost.h"
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+static int xcorr_pairs_fft (const size_t Nch, const size_t L, const size_t M, const int cplx, const double cdir, const double cfft, const double cplan);
+
+int xcorr_pairs_s (float *Y, const float *X, const size_t Nch, const size_t L, const size_t M);
+int xcorr_pairs_d (double *Y, const double *X, const size_t Nch, const size_t L, const size_t M);
+int xcorr_pairs_c (float *Y, const float *X, const size_t Nch, const size_t L, const size_t M);
+int xcorr_pairs_z (double *Y, const double *X, const size_t Nch, const size_t L, const size_t M);
+
+
+static int xcorr_pairs_fft (const size_t Nch, const size_t L, const size_t M, const int cplx, const double cdir, const double cfft, const double cplan)
+{
+    const double P = 0.5 * (double)Nch * (double)(Nch+1u);
+    size_t nfft = 1u;
+    while (nfft<L+M) { nfft *= 2u; }
+    const double dir = ((cplx) ? 4.0 : 1.0) * cdir * P * ((double)L*(double)(2u*M+1u) - (double)M*(double)(M+1u));
+    const double fft = 2.0*cplan + ((cplx) ? 2.0 : 1.0) * cfft * (double)nfft * log2((double)nfft) * ((double)Nch+P);
+    return (fft<dir);
+}
+
+
+int xcorr_pairs_s (float *Y, const float *X, const size_t Nch, const size_t L, const size_t M)
+{
+    if (Nch<1u) { fprintf(stderr,"error in xcorr_pairs_s: Nch (num channels) must be positive\n"); return 1; }
+    if (L<1u) { fprintf(stderr,"error in xcorr_pairs_s: L (length of channels) must be positive\n"); return 1; }
+    if (M>=L) { fprintf(stderr,"error in xcorr_pairs_s: M (max lag) must be < L\n"); return 1; }
+
+    const size_t P = Nch*(Nch+1u)/2u, Ly = 2u*M + 1u;
+
+    if (!xcorr_pairs_fft(Nch,L,M,0,AUTO_COST_CONV_S,AUTO_COST_FFT_S,AUTO_COST_PLAN_S))
+    {
+        float sm;
+        for (size_t i=0u; i<Nch; ++i)
+        {
+            for (size_t j=i; j<Nch; ++j)
+            {
+                const float *xi = &X[i*L], *xj = &X[j*L];
+                for (size_t l=0u; l<Ly; ++l, ++Y)
+                {
+                    const size_t n0 = (l<M) ? M-l : 0u;         //lag m = l-M
+                    const size_t n1 = (l>M) ? L+M-l : L;
+                    sm = 0.0f;
+                    for (size_t n=n0; n<n1; ++n) { sm += xi[n+l-M] * xj[n]; }
+                    *Y = sm;
+                }
+            }
+        }
+    }
+    else
+    {
+        size_t nfft = 1u;
+        while (nfft<L+M) { nfft *= 2u; }
+        const size_t F = nfft/2u + 1u;
+        const size_t NT = (P<16u) ? P : 16u;
+        const float sc = 1.0f / (float)nfft;
+        const int n[1] = {(int)nfft};
+
+        //Initialize FFTs
+        float *Xb, *Fx, *Fy, *Yb;
+        Xb = (float *)fftwf_malloc(Nch*nfft*sizeof(float));
+        Fx = (float *)fftwf_malloc(Nch*2u*F*sizeof(float));
+        Fy = (float *)fftwf_malloc(NT*2u*F*sizeof(float));
+        Yb = (float *)fftwf_malloc(NT*nfft*sizeof(float));
+        if (!Xb || !Fx || !Fy || !Yb) { fprintf(stderr,"error in xcorr_pairs_s: problem with fftwf_malloc. "); perror("fftwf_malloc"); return 1; }
+        fftwf_plan fplan = fftwf_plan_many_dft_r2c(1,n,(int)Nch,Xb,NULL,1,(int)nfft,(fftwf_complex *)Fx,NULL,1,(int)F,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in xcorr_pairs_s: problem creating fftw plan"); return 1; }
+        fftwf_plan iplan = fftwf_plan_many_dft_c2r(1,n,(int)NT,(fftwf_complex *)Fy,NULL,1,(int)F,Yb,NULL,1,(int)nfft,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in xcorr_pairs_s: problem creating fftw plan"); return 1; }
+        for (size_t f=0u; f<NT*2u*F; ++f) { Fy[f] = 0.0f; }
+
+        //FFT of all channels (once)
+        for (size_t c=0u; c<Nch; ++c)
+        {
+            for (size_t l=0u; l<L; ++l) { Xb[c*nfft+l] = X[c*L+l]; }
+            for (size_t l=L; l<nfft; ++l) { Xb[c*nfft+l] = 0.0f; }
+        }
+        fftwf_execute(fplan);
+
+        //Cross-spectra and IFFT in batches of NT pairs
+        size_t b = 0u;
+        for (size_t i=0u; i<Nch; ++i)
+        {
+            for (size_t j=i; j<Nch; ++j)
+            {
+                const float *fi = &Fx[2u*i*F], *fj = &Fx[2u*j*F];
+                float *fy = &Fy[2u*b*F];
+                for (size_t f=0u; f<2u*F; f+=2u)
+                {
+                    fy[f] = sc * (fi[f]*fj[f] + fi[f+1u]*fj[f+1u]);
+                    fy[f+1u] = sc * (fi[f+1u]*fj[f] - fi[f]*fj[f+1u]);
+                }
+                if (++b==NT || (i==Nch-1u && j==Nch-1u))
+                {
+                    fftwf_execute(iplan);
+                    for (size_t t=0u; t<b; ++t)
+                    {
+                        const float *yb = &Yb[t*nfft];
+                        for (size_t l=nfft-M; l<nfft; ++l, ++Y) { *Y = yb[l]; }
+                        for (size_t l=0u; l<=M; ++l, ++Y) { *Y = yb[l]; }
+                    }
+                    b = 0u;
+                }
+            }
+        }
+
+        fftwf_free(Xb); fftwf_free(Fx); fftwf_free(Fy); fftwf_free(Yb);
+        fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int xcorr_pairs_d (double *Y, const double *X, const size_t Nch, const size_t L, const size_t M)
+{
+    if (Nch<1u) { fprintf(stderr,"error in xcorr_pairs_d: Nch (num channels) must be positive\n"); return 1; }
+    if (L<1u) { fprintf(stderr,"error in xcorr_pairs_d: L (length of channels) must be positive\n"); return 1; }
+    if (M>=L) { fprintf(stderr,"error in xcorr_pairs_d: M (max lag) must be < L\n"); return 1; }
+
+    const size_t P = Nch*(Nch+1u)/2u, Ly = 2u*M + 1u;
+
+    if (!xcorr_pairs_fft(Nch,L,M,0,AUTO_COST_CONV_D,AUTO_COST_FFT_D,AUTO_COST_PLAN_D))
+    {
+        double sm;
+        for (size_t i=0u; i<Nch; ++i)
+        {
+            for (size_t j=i; j<Nch; ++j)
+            {
+                const double *xi = &X[i*L], *xj = &X[j*L];
+                for (size_t l=0u; l<Ly; ++l, ++Y)
+                {
+                    const size_t n0 = (l<M) ? M-l : 0u;         //lag m = l-M
+                    const size_t n1 = (l>M) ? L+M-l : L;
+                    sm = 0.0;
+                    for (size_t n=n0; n<n1; ++n) { sm += xi[n+l-M] * xj[n]; }
+                    *Y = sm;
+                }
+            }
+        }
+    }
+    else
+    {
+        size_t nfft = 1u;
+        while (nfft<L+M) { nfft *= 2u; }
+        const size_t F = nfft/2u + 1u;
+        const size_t NT = (P<16u) ? P : 16u;
+        const double sc = 1.0 / (double)nfft;
+        const int n[1] = {(int)nfft};
+
+        //Initialize FFTs
+        double *Xb, *Fx, *Fy, *Yb;
+        Xb = (double *)fftw_malloc(Nch*nfft*sizeof(double));
+        Fx = (double *)fftw_malloc(Nch*2u*F*sizeof(double));
+        Fy = (double *)fftw_malloc(NT*2u*F*sizeof(double));
+        Yb = (double *)fftw_malloc(NT*nfft*sizeof(double));
+        if (!Xb || !Fx || !Fy || !Yb) { fprintf(stderr,"error in xcorr_pairs_d: problem with fftw_malloc. "); perror("fftw_malloc"); return 1; }
+        fftw_plan fplan = fftw_plan_many_dft_r2c(1,n,(int)Nch,Xb,NULL,1,(int)nfft,(fftw_complex *)Fx,NULL,1,(int)F,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in xcorr_pairs_d: problem creating fftw plan"); return 1; }
+        fftw_plan iplan = fftw_plan_many_dft_c2r(1,n,(int)NT,(fftw_complex *)Fy,NULL,1,(int)F,Yb,NULL,1,(int)nfft,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in xcorr_pairs_d: problem creating fftw plan"); return 1; }
+        for (size_t f=0u; f<NT*2u*F; ++f) { Fy[f] = 0.0; }
+
+        //FFT of all channels (once)
+        for (size_t c=0u; c<Nch; ++c)
+        {
+            for (size_t l=0u; l<L; ++l) { Xb[c*nfft+l] = X[c*L+l]; }
+            for (size_t l=L; l<nfft; ++l) { Xb[c*nfft+l] = 0.0; }
+        }
+        fftw_execute(fplan);
+
+        //Cross-spectra and IFFT in batches of NT pairs
+        size_t b = 0u;
+        for (size_t i=0u; i<Nch; ++i)
+        {
+            for (size_t j=i; j<Nch; ++j)
+            {
+                const double *fi = &Fx[2u*i*F], *fj = &Fx[2u*j*F];
+                double *fy = &Fy[2u*b*F];
+                for (size_t f=0u; f<2u*F; f+=2u)
+                {
+                    fy[f] = sc * (fi[f]*fj[f] + fi[f+1u]*fj[f+1u]);
+                    fy[f+1u] = sc * (fi[f+1u]*fj[f] - fi[f]*fj[f+1u]);
+                }
+                if (++b==NT || (i==Nch-1u && j==Nch-1u))
+                {
+                    fftw_execute(iplan);
+                    for (size_t t=0u; t<b; ++t)
+                    {
+                        const double *yb = &Yb[t*nfft];
+                        for (size_t l=nfft-M; l<nfft; ++l, ++Y) { *Y = yb[l]; }
+                        for (size_t l=0u; l<=M; ++l, ++Y) { *Y = yb[l]; }
+                    }
+                    b = 0u;
+                }
+            }
+        }
+
+        fftw_free(Xb); fftw_free(Fx); fftw_free(Fy); fftw_free(Yb);
+        fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int xcorr_pairs_c (float *Y, const float *X, const size_t Nch, const size_t L, const size_t M)
+{
+    if (Nch<1u) { fprintf(stderr,"error in xcorr_pairs_c: Nch (num channels) must be positive\n"); return 1; }
+    if (L<1u) { fprintf(stderr,"error in xcorr_pairs_c: L (length of channels) must be positive\n"); return 1; }
+    if (M>=L) { fprintf(stderr,"error in xcorr_pairs_c: M (max lag) must be < L\n"); return 1; }
+
+    const size_t P = Nch*(Nch+1u)/2u, Ly = 2u*M + 1u;
+
+    if (!xcorr_pairs_fft(Nch,L,M,1,AUTO_COST_CONV_S,AUTO_COST_FFT_S,AUTO_COST_PLAN_S))
+    {
+        float smr, smi;
+        for (size_t i=0u; i<Nch; ++i)
+        {
+            for (size_t j=i; j<Nch; ++j)
+            {
+                const float *xi = &X[2u*i*L], *xj = &X[2u*j*L];
+                for (size_t l=0u; l<Ly; ++l, Y+=2)
+                {
+                    const size_t n0 = (l<M) ? M-l : 0u;         //lag m = l-M
+                    const size_t n1 = (l>M) ? L+M-l : L;
+                    smr = smi = 0.0f;
+                    for (size_t n=n0; n<n1; ++n)
+                    {
+                        const size_t k = 2u*(n+l-M);
+                        smr += xi[k]*xj[2u*n] + xi[k+1u]*xj[2u*n+1u];
+                        smi += xi[k+1u]*xj[2u*n] - xi[k]*xj[2u*n+1u];
+                    }
+                    *Y = smr; *(Y+1) = smi;
+                }
+            }
+        }
+    }
+    else
+    {
+        size_t nfft = 1u;
+        while (nfft<L+M) { nfft *= 2u; }
+        const size_t NT = (P<16u) ? P : 16u;
+        const float sc = 1.0f / (float)nfft;
+        const int n[1] = {(int)nfft};
+
+        //Initialize FFTs
+        float *Xb, *Fx, *Fy, *Yb;
+        Xb = (float *)fftwf_malloc(Nch*2u*nfft*sizeof(float));
+        Fx = (float *)fftwf_malloc(Nch*2u*nfft*sizeof(float));
+        Fy = (float *)fftwf_malloc(NT*2u*nfft*sizeof(float));
+        Yb = (float *)fftwf_malloc(NT*2u*nfft*sizeof(float));
+        if (!Xb || !Fx || !Fy || !Yb) { fprintf(stderr,"error in xcorr_pairs_c: problem with fftwf_malloc. "); perror("fftwf_malloc"); return 1; }
+        fftwf_plan fplan = fftwf_plan_many_dft(1,n,(int)Nch,(fftwf_complex *)Xb,NULL,1,(int)nfft,(fftwf_complex *)Fx,NULL,1,(int)nfft,FFTW_FORWARD,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in xcorr_pairs_c: problem creating fftw plan"); return 1; }
+        fftwf_plan iplan = fftwf_plan_many_dft(1,n,(int)NT,(fftwf_complex *)Fy,NULL,1,(int)nfft,(fftwf_complex *)Yb,NULL,1,(int)nfft,FFTW_BACKWARD,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in xcorr_pairs_c: problem creating fftw plan"); return 1; }
+        for (size_t f=0u; f<NT*2u*nfft; ++f) { Fy[f] = 0.0f; }
+
+        //FFT of all channels (once)
+        for (size_t c=0u; c<Nch; ++c)
+        {
+            for (size_t l=0u; l<2u*L; ++l) { Xb[2u*c*nfft+l] = X[2u*c*L+l]; }
+            for (size_t l=2u*L; l<2u*nfft; ++l) { Xb[2u*c*nfft+l] = 0.0f; }
+        }
+        fftwf_execute(fplan);
+
+        //Cross-spectra and IFFT in batches of NT pairs
+        size_t b = 0u;
+        for (size_t i=0u; i<Nch; ++i)
+        {
+            for (size_t j=i; j<Nch; ++j)
+            {
+                const float *fi = &Fx[2u*i*nfft], *fj = &Fx[2u*j*nfft];
+                float *fy = &Fy[2u*b*nfft];
+                for (size_t f=0u; f<2u*nfft; f+=2u)
+                {
+                    fy[f] = sc * (fi[f]*fj[f] + fi[f+1u]*fj[f+1u]);
+                    fy[f+1u] = sc * (fi[f+1u]*fj[f] - fi[f]*fj[f+1u]);
+                }
+                if (++b==NT || (i==Nch-1u && j==Nch-1u))
+                {
+                    fftwf_execute(iplan);
+                    for (size_t t=0u; t<b; ++t)
+                    {
+                        const float *yb = &Yb[2u*t*nfft];
+                        for (size_t l=2u*(nfft-M); l<2u*nfft; ++l, ++Y) { *Y = yb[l]; }
+                        for (size_t l=0u; l<2u*M+2u; ++l, ++Y) { *Y = yb[l]; }
+                    }
+                    b = 0u;
+                }
+            }
+        }
+
+        fftwf_free(Xb); fftwf_free(Fx); fftwf_free(Fy); fftwf_free(Yb);
+        fftwf_destroy_plan(fplan); fftwf_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+int xcorr_pairs_z (double *Y, const double *X, const size_t Nch, const size_t L, const size_t M)
+{
+    if (Nch<1u) { fprintf(stderr,"error in xcorr_pairs_z: Nch (num channels) must be positive\n"); return 1; }
+    if (L<1u) { fprintf(stderr,"error in xcorr_pairs_z: L (length of channels) must be positive\n"); return 1; }
+    if (M>=L) { fprintf(stderr,"error in xcorr_pairs_z: M (max lag) must be < L\n"); return 1; }
+
+    const size_t P = Nch*(Nch+1u)/2u, Ly = 2u*M + 1u;
+
+    if (!xcorr_pairs_fft(Nch,L,M,1,AUTO_COST_CONV_D,AUTO_COST_FFT_D,AUTO_COST_PLAN_D))
+    {
+        double smr, smi;
+        for (size_t i=0u; i<Nch; ++i)
+        {
+            for (size_t j=i; j<Nch; ++j)
+            {
+                const double *xi = &X[2u*i*L], *xj = &X[2u*j*L];
+                for (size_t l=0u; l<Ly; ++l, Y+=2)
+                {
+                    const size_t n0 = (l<M) ? M-l : 0u;         //lag m = l-M
+                    const size_t n1 = (l>M) ? L+M-l : L;
+                    smr = smi = 0.0;
+                    for (size_t n=n0; n<n1; ++n)
+                    {
+                        const size_t k = 2u*(n+l-M);
+                        smr += xi[k]*xj[2u*n] + xi[k+1u]*xj[2u*n+1u];
+                        smi += xi[k+1u]*xj[2u*n] - xi[k]*xj[2u*n+1u];
+                    }
+                    *Y = smr; *(Y+1) = smi;
+                }
+            }
+        }
+    }
+    else
+    {
+        size_t nfft = 1u;
+        while (nfft<L+M) { nfft *= 2u; }
+        const size_t NT = (P<16u) ? P : 16u;
+        const double sc = 1.0 / (double)nfft;
+        const int n[1] = {(int)nfft};
+
+        //Initialize FFTs
+        double *Xb, *Fx, *Fy, *Yb;
+        Xb = (double *)fftw_malloc(Nch*2u*nfft*sizeof(double));
+        Fx = (double *)fftw_malloc(Nch*2u*nfft*sizeof(double));
+        Fy = (double *)fftw_malloc(NT*2u*nfft*sizeof(double));
+        Yb = (double *)fftw_malloc(NT*2u*nfft*sizeof(double));
+        if (!Xb || !Fx || !Fy || !Yb) { fprintf(stderr,"error in xcorr_pairs_z: problem with fftw_malloc. "); perror("fftw_malloc"); return 1; }
+        fftw_plan fplan = fftw_plan_many_dft(1,n,(int)Nch,(fftw_complex *)Xb,NULL,1,(int)nfft,(fftw_complex *)Fx,NULL,1,(int)nfft,FFTW_FORWARD,FFTW_ESTIMATE);
+        if (!fplan) { fprintf(stderr,"error in xcorr_pairs_z: problem creating fftw plan"); return 1; }
+        fftw_plan iplan = fftw_plan_many_dft(1,n,(int)NT,(fftw_complex *)Fy,NULL,1,(int)nfft,(fftw_complex *)Yb,NULL,1,(int)nfft,FFTW_BACKWARD,FFTW_ESTIMATE);
+        if (!iplan) { fprintf(stderr,"error in xcorr_pairs_z: problem creating fftw plan"); return 1; }
+        for (size_t f=0u; f<NT*2u*nfft; ++f) { Fy[f] = 0.0; }
+
+        //FFT of all channels (once)
+        for (size_t c=0u; c<Nch; ++c)
+        {
+            for (size_t l=0u; l<2u*L; ++l) { Xb[2u*c*nfft+l] = X[2u*c*L+l]; }
+            for (size_t l=2u*L; l<2u*nfft; ++l) { Xb[2u*c*nfft+l] = 0.0; }
+        }
+        fftw_execute(fplan);
+
+        //Cross-spectra and IFFT in batches of NT pairs
+        size_t b = 0u;
+        for (size_t i=0u; i<Nch; ++i)
+        {
+            for (size_t j=i; j<Nch; ++j)
+            {
+                const double *fi = &Fx[2u*i*nfft], *fj = &Fx[2u*j*nfft];
+                double *fy = &Fy[2u*b*nfft];
+                for (size_t f=0u; f<2u*nfft; f+=2u)
+                {
+                    fy[f] = sc * (fi[f]*fj[f] + fi[f+1u]*fj[f+1u]);
+                    fy[f+1u] = sc * (fi[f+1u]*fj[f] - fi[f]*fj[f+1u]);
+                }
+                if (++b==NT || (i==Nch-1u && j==Nch-1u))
+                {
+                    fftw_execute(iplan);
+                    for (size_t t=0u; t<b; ++t)
+                    {
+                        const double *yb = &Yb[2u*t*nfft];
+                        for (size_t l=2u*(nfft-M); l<2u*nfft; ++l, ++Y) { *Y = yb[l]; }
+                        for (size_t l=0u; l<2u*M+2u; ++l, ++Y) { *Y = yb[l]; }
+                    }
+                    b = 0u;
+                }
+            }
+        }
+
+        fftw_free(Xb); fftw_free(Fx); fftw_free(Fy); fftw_free(Yb);
+        fftw_destroy_plan(fplan); fftw_destroy_plan(iplan);
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
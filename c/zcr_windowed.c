@@ -8,11 +8,14 @@
 //2. for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { if (*Z) { sm += *X2; } }
 //3. a while loop method.
 //1. was ~10% faster than 2., which was ~10% faster than 3.
+//1. is still used for general X2, but rectangular and exponential X2 are
+//done in O(1) per frame by prefix sums or recursion; see lcr_windowed.c.
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <float.h>
 #include <math.h>
+#include "lcr_windowed.c"
 
 #ifdef __cplusplus
 namespace codee {
@@ -44,18 +47,15 @@ int zcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
     if (W==0u) {}
     else
     {
-        const size_t Lpre = Lw/2u;                  //nsamps before center samp
-        const size_t Lpost = Lw-Lpre-1u;            //nsamps after center samp
-        size_t w = 0u;                              //current frame
-        float cc = c0;                              //current exact center-samp
-        int cs = (int)roundf(c0);                   //current rounded center-samp
-        int ss, es = cs + (int)Lpost;               //current rounded start-samp, end-samp
-        int prev_cs;                                //previous rounded center-samp
         int *Z, s, sp;                              //ints for ZCR
-        float sm;                                   //local sum for ZCR
+        double *F = NULL, r = 1.0;                  //prefix sums or recursion, ratio for exponential X2
+
+        //Get window type
+        const int wtyp = lcr_windowed_wtyp_s(&r,X2,Lw);
 
         //Allocate
         if (!(Z=(int *)malloc(Lx*sizeof(int)))) { fprintf(stderr,"error in zcr_windowed_s: problem with malloc. "); perror("malloc"); return 1; }
+        if (wtyp>0 && !(F=(double *)malloc((Lx+1u)*sizeof(double)))) { fprintf(stderr,"error in zcr_windowed_s: problem with malloc. "); perror("malloc"); free(Z); return 1; }
 
         //Get block and vec sizes
         const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
@@ -65,7 +65,7 @@ int zcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
         if (K==1u && (G==1u || B==1u))
         {
             //For each vec in X1
-            for (size_t v=V; v>0u; --v)
+            for (size_t v=V; v>0u; --v, Y+=W)
             {
                 //Get Z
                 if (going==0)
@@ -85,67 +85,15 @@ int zcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
                 }
                 Z -= Lx;
 
-                //Initialize windowing
-                w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                //Windows before first samp
-                while (es<0 && w<W)
-                {
-                    *Y++ = 0.0f;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    es = cs + (int)Lpost;
-                }
-                ss = cs - (int)Lpre;
-                prev_cs = cs;
-
-                //Windows overlapping first samp
-                while (ss<0 && w<W)
-                {
-                    sm = 0.0f; X2 -= ss;
-                    for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (float)(*Z) * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z -= (int)Lw + ss; X2 -= Lw;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z += ss;
-                es = cs + (int)Lpost;
-
-                //Windows fully within sig
-                while (es<(int)Lx && w<W)
-                {
-                    sm = 0.0f;
-                    //for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm = fmaf((float)*Z,*X2,sm); }
-                    for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (float)*Z * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                    es = cs + (int)Lpost; prev_cs = cs;
-                }
-                ss = cs - (int)Lpre;
-
-                //Windows overlapping last samp
-                while (ss<(int)Lx && w<W)
-                {
-                    sm = 0.0f;
-                    for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (float)(*Z) * *X2; }
-                    *Y++ = sm;
-                    X2 += ss - (int)Lx;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z += cs - prev_cs - (int)Lx + ss;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z -= cs - prev_cs + ss;
-
-                //Windows after last samp
-                while (w<W) { *Y++ = 0.0f; ++w; }
+                //Apply window
+                lcr_windowed_frames_s(Y,Z,F,X2,Lx,Lw,W,1u,c0,stp,wtyp,r);
             }
         }
         else
         {
             for (size_t g=G; g>0u; --g, X1+=B*(Lx-1u), Y+=B*(W-1u))
             {
-                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, Y-=K*W-1u)
+                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, ++Y)
                 {
                     //Get Z
                     if (going==0)
@@ -165,64 +113,13 @@ int zcr_windowed_s (float *Y, const float *X1, const float *X2, const size_t R,
                     }
                     Z -= Lx;
 
-                    //Initialize windowing
-                    w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                    //Windows before first samp
-                    while (es<0 && w<W)
-                    {
-                        *Y = 0.0f; Y += K;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        es = cs + (int)Lpost;
-                    }
-                    ss = cs - (int)Lpre;
-                    prev_cs = cs;
-
-                    //Windows overlapping first samp
-                    while (ss<0 && w<W)
-                    {
-                        sm = 0.0f; X2 -= ss;
-                        for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (float)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        Z -= (int)Lw + ss; X2 -= Lw;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z += ss;
-                    es = cs + (int)Lpost;
-                    
-                    //Windows fully within sig
-                    while (es<(int)Lx && w<W)
-                    {
-                        sm = 0.0f;
-                        for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (float)*Z * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                        es = cs + (int)Lpost; prev_cs = cs;
-                    }
-                    ss = cs - (int)Lpre;
-
-                    //Windows overlapping last samp
-                    while (ss<(int)Lx && w<W)
-                    {
-                        sm = 0.0f;
-                        for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (float)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        X2 += ss - (int)Lx;
-                        ++w; cc += stp; cs = (int)roundf(cc);
-                        Z += cs - prev_cs - (int)Lx + ss;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z -= cs - prev_cs + ss;
-
-                    //Windows after last samp
-                    while (w<W) { *Y = 0.0f; Y += K; ++w; }
+                    //Apply window
+                    lcr_windowed_frames_s(Y,Z,F,X2,Lx,Lw,W,K,c0,stp,wtyp,r);
                 }
             }
         }
         
-        free(Z);
+        free(Z); free(F);
     }
 
     return 0;
@@ -248,18 +145,15 @@ int zcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
     if (W==0u) {}
     else
     {
-        const size_t Lpre = Lw/2u;                  //nsamps before center samp
-        const size_t Lpost = Lw-Lpre-1u;            //nsamps after center samp
-        size_t w = 0u;                              //current frame
-        double cc = c0;                             //current exact center-samp
-        int cs = (int)round(c0);                    //current rounded center-samp
-        int ss, es = cs + (int)Lpost;               //current rounded start-samp, end-samp
-        int prev_cs;                                //previous rounded center-samp
         int *Z, s, sp;                              //ints for ZCR
-        double sm;                                  //local sum for ZCR
+        double *F = NULL, r = 1.0;                  //prefix sums or recursion, ratio for exponential X2
+
+        //Get window type
+        const int wtyp = lcr_windowed_wtyp_d(&r,X2,Lw);
 
         //Allocate
         if (!(Z=(int *)malloc(Lx*sizeof(int)))) { fprintf(stderr,"error in zcr_windowed_d: problem with malloc. "); perror("malloc"); return 1; }
+        if (wtyp>0 && !(F=(double *)malloc((Lx+1u)*sizeof(double)))) { fprintf(stderr,"error in zcr_windowed_d: problem with malloc. "); perror("malloc"); free(Z); return 1; }
 
         //Get block and vec sizes
         const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
@@ -269,7 +163,7 @@ int zcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
         if (K==1u && (G==1u || B==1u))
         {
             //For each vec in X1
-            for (size_t v=V; v>0u; --v)
+            for (size_t v=V; v>0u; --v, Y+=W)
             {
                 //Get Z
                 if (going==0)
@@ -289,66 +183,15 @@ int zcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
                 }
                 Z -= Lx;
 
-                //Initialize windowing
-                w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                //Windows before first samp
-                while (es<0 && w<W)
-                {
-                    *Y++ = 0.0;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    es = cs + (int)Lpost;
-                }
-                ss = cs - (int)Lpre;
-                prev_cs = cs;
-
-                //Windows overlapping first samp
-                while (ss<0 && w<W)
-                {
-                    sm = 0.0; X2 -= ss;
-                    for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (double)(*Z) * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z -= (int)Lw + ss; X2 -= Lw;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z += ss;
-                es = cs + (int)Lpost;
-                
-                //Windows fully within sig
-                while (es<(int)Lx && w<W)
-                {
-                    sm = 0.0;
-                    for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (double)*Z * *X2; }
-                    *Y++ = sm;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                    es = cs + (int)Lpost; prev_cs = cs;
-                }
-                ss = cs - (int)Lpre;
-
-                //Windows overlapping last samp
-                while (ss<(int)Lx && w<W)
-                {
-                    sm = 0.0;
-                    for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (double)(*Z) * *X2; }
-                    *Y++ = sm;
-                    X2 += ss - (int)Lx;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z += cs - prev_cs - (int)Lx + ss;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z -= cs - prev_cs + ss;
-
-                //Windows after last samp
-                while (w<W) { *Y++ = 0.0; ++w; }
+                //Apply window
+                lcr_windowed_frames_d(Y,Z,F,X2,Lx,Lw,W,1u,c0,stp,wtyp,r);
             }
         }
         else
         {
             for (size_t g=G; g>0u; --g, X1+=B*(Lx-1u), Y+=B*(W-1u))
             {
-                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, Y-=K*W-1u)
+                for (size_t b=B; b>0u; --b, X1-=K*Lx-1u, ++Y)
                 {
                     //Get Z
                     if (going==0)
@@ -368,64 +211,13 @@ int zcr_windowed_d (double *Y, const double *X1, const double *X2, const size_t
                     }
                     Z -= Lx;
 
-                    //Initialize windowing
-                    w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                    //Windows before first samp
-                    while (es<0 && w<W)
-                    {
-                        *Y = 0.0; Y += K;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        es = cs + (int)Lpost;
-                    }
-                    ss = cs - (int)Lpre;
-                    prev_cs = cs;
-
-                    //Windows overlapping first samp
-                    while (ss<0 && w<W)
-                    {
-                        sm = 0.0; X2 -= ss;
-                        for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (double)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        Z -= (int)Lw + ss; X2 -= Lw;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z += ss;
-                    es = cs + (int)Lpost;
-                    
-                    //Windows fully within sig
-                    while (es<(int)Lx && w<W)
-                    {
-                        sm = 0.0;
-                        for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (double)*Z * *X2; }
-                        *Y = sm; Y += K;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                        es = cs + (int)Lpost; prev_cs = cs;
-                    }
-                    ss = cs - (int)Lpre;
-
-                    //Windows overlapping last samp
-                    while (ss<(int)Lx && w<W)
-                    {
-                        sm = 0.0;
-                        for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (double)(*Z) * *X2; }
-                        *Y = sm; Y += K;
-                        X2 += ss - (int)Lx;
-                        ++w; cc += stp; cs = (int)round(cc);
-                        Z += cs - prev_cs - (int)Lx + ss;
-                        ss = cs - (int)Lpre; prev_cs = cs;
-                    }
-                    Z -= cs - prev_cs + ss;
-
-                    //Windows after last samp
-                    while (w<W) { *Y = 0.0; Y += K; ++w; }
+                    //Apply window
+                    lcr_windowed_frames_d(Y,Z,F,X2,Lx,Lw,W,K,c0,stp,wtyp,r);
                 }
             }
         }
         
-        free(Z);
+        free(Z); free(F);
     }
 
     return 0;
@@ -451,18 +243,15 @@ int zcr_windowed_c (float *Y, const float *X1, const float *X2, const size_t R,
     if (W==0u) {}
     else
     {
-        const size_t Lpre = Lw/2u;                  //nsamps before center samp
-        const size_t Lpost = Lw-Lpre-1u;            //nsamps after center samp
-        size_t w = 0u;                              //current frame
-        float cc = c0;                              //current exact center-samp
-        int cs = (int)roundf(c0);                   //current rounded center-samp
-        int ss, es = cs + (int)Lpost;               //current rounded start-samp, end-samp
-        int prev_cs;                                //previous rounded center-samp
         int *Z, s, sp;                              //ints for ZCR
-        float sm;                                   //local sum for ZCR
+        double *F = NULL, r = 1.0;                  //prefix sums or recursion, ratio for exponential X2
+
+        //Get window type
+        const int wtyp = lcr_windowed_wtyp_s(&r,X2,Lw);
 
         //Allocate
         if (!(Z=(int *)malloc(Lx*sizeof(int)))) { fprintf(stderr,"error in zcr_windowed_c: problem with malloc. "); perror("malloc"); return 1; }
+        if (wtyp>0 && !(F=(double *)malloc((Lx+1u)*sizeof(double)))) { fprintf(stderr,"error in zcr_windowed_c: problem with malloc. "); perror("malloc"); free(Z); return 1; }
 
         //Get block and vec sizes
         const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
@@ -474,7 +263,7 @@ int zcr_windowed_c (float *Y, const float *X1, const float *X2, const size_t R,
 
         for (size_t g=G; g>0u; --g, X1+=2u*B*(Lx-1u), Y+=B*(W-1u))
         {
-            for (size_t b=B; b>0u; --b, X1-=2u*K*Lx-2u, Y-=K*W-1u)
+            for (size_t b=B; b>0u; --b, X1-=2u*K*Lx-2u, ++Y)
             {
                 //Get Z
                 if (going==0)
@@ -494,63 +283,12 @@ int zcr_windowed_c (float *Y, const float *X1, const float *X2, const size_t R,
                 }
                 Z -= Lx;
 
-                //Initialize windowing
-                w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                //Windows before first samp
-                while (es<0 && w<W)
-                {
-                    *Y = 0.0f; Y += K;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    es = cs + (int)Lpost;
-                }
-                ss = cs - (int)Lpre;
-                prev_cs = cs;
-
-                //Windows overlapping first samp
-                while (ss<0 && w<W)
-                {
-                    sm = 0.0f; X2 -= ss;
-                    for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (float)(*Z) * *X2; }
-                    *Y = sm; Y += K;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z -= (int)Lw + ss; X2 -= Lw;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z += ss;
-                es = cs + (int)Lpost;
-                
-                //Windows fully within sig
-                while (es<(int)Lx && w<W)
-                {
-                    sm = 0.0f;
-                    for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (float)*Z * *X2; }
-                    *Y = sm; Y += K;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                    es = cs + (int)Lpost; prev_cs = cs;
-                }
-                ss = cs - (int)Lpre;
-
-                //Windows overlapping last samp
-                while (ss<(int)Lx && w<W)
-                {
-                    sm = 0.0f;
-                    for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (float)(*Z) * *X2; }
-                    *Y = sm; Y += K;
-                    X2 += ss - (int)Lx;
-                    ++w; cc += stp; cs = (int)roundf(cc);
-                    Z += cs - prev_cs - (int)Lx + ss;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z -= cs - prev_cs + ss;
-
-                //Windows after last samp
-                while (w<W) { *Y = 0.0f; Y += K; ++w; }
+                //Apply window
+                lcr_windowed_frames_s(Y,Z,F,X2,Lx,Lw,W,K,c0,stp,wtyp,r);
             }
         }
         
-        free(Z);
+        free(Z); free(F);
     }
 
     return 0;
@@ -576,18 +314,15 @@ int zcr_windowed_z (double *Y, const double *X1, const double *X2, const size_t
     if (W==0u) {}
     else
     {
-        const size_t Lpre = Lw/2u;                  //nsamps before center samp
-        const size_t Lpost = Lw-Lpre-1u;            //nsamps after center samp
-        size_t w = 0u;                              //current frame
-        double cc = c0;                              //current exact center-samp
-        int cs = (int)round(c0);                   //current rounded center-samp
-        int ss, es = cs + (int)Lpost;               //current rounded start-samp, end-samp
-        int prev_cs;                                //previous rounded center-samp
         int *Z, s, sp;                              //ints for ZCR
-        double sm;                                   //local sum for ZCR
+        double *F = NULL, r = 1.0;                  //prefix sums or recursion, ratio for exponential X2
+
+        //Get window type
+        const int wtyp = lcr_windowed_wtyp_d(&r,X2,Lw);
 
         //Allocate
         if (!(Z=(int *)malloc(Lx*sizeof(int)))) { fprintf(stderr,"error in zcr_windowed_z: problem with malloc. "); perror("malloc"); return 1; }
+        if (wtyp>0 && !(F=(double *)malloc((Lx+1u)*sizeof(double)))) { fprintf(stderr,"error in zcr_windowed_z: problem with malloc. "); perror("malloc"); free(Z); return 1; }
 
         //Get block and vec sizes
         const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
@@ -599,7 +334,7 @@ int zcr_windowed_z (double *Y, const double *X1, const double *X2, const size_t
 
         for (size_t g=G; g>0u; --g, X1+=2u*B*(Lx-1u), Y+=B*(W-1u))
         {
-            for (size_t b=B; b>0u; --b, X1-=2u*K*Lx-2u, Y-=K*W-1u)
+            for (size_t b=B; b>0u; --b, X1-=2u*K*Lx-2u, ++Y)
             {
                 //Get Z
                 if (going==0)
@@ -619,63 +354,12 @@ int zcr_windowed_z (double *Y, const double *X1, const double *X2, const size_t
                 }
                 Z -= Lx;
 
-                //Initialize windowing
-                w = 0u; cc = c0; cs = (int)round(c0); es = cs + (int)Lpost;
-
-                //Windows before first samp
-                while (es<0 && w<W)
-                {
-                    *Y = 0.0; Y += K;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    es = cs + (int)Lpost;
-                }
-                ss = cs - (int)Lpre;
-                prev_cs = cs;
-
-                //Windows overlapping first samp
-                while (ss<0 && w<W)
-                {
-                    sm = 0.0; X2 -= ss;
-                    for (size_t l=Lw-(size_t)(-ss); l>0u; --l, ++X2, ++Z) { sm += (double)(*Z) * *X2; }
-                    *Y = sm; Y += K;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z -= (int)Lw + ss; X2 -= Lw;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z += ss;
-                es = cs + (int)Lpost;
-                
-                //Windows fully within sig
-                while (es<(int)Lx && w<W)
-                {
-                    sm = 0.0;
-                    for (size_t l=Lw; l>0u; --l, ++Z, ++X2) { sm += (double)*Z * *X2; }
-                    *Y = sm; Y += K;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z += cs - prev_cs - (int)Lw; X2 -= Lw;
-                    es = cs + (int)Lpost; prev_cs = cs;
-                }
-                ss = cs - (int)Lpre;
-
-                //Windows overlapping last samp
-                while (ss<(int)Lx && w<W)
-                {
-                    sm = 0.0;
-                    for (size_t l=Lx-(size_t)ss; l>0u; --l, ++Z, ++X2) { sm += (double)(*Z) * *X2; }
-                    *Y = sm; Y += K;
-                    X2 += ss - (int)Lx;
-                    ++w; cc += stp; cs = (int)round(cc);
-                    Z += cs - prev_cs - (int)Lx + ss;
-                    ss = cs - (int)Lpre; prev_cs = cs;
-                }
-                Z -= cs - prev_cs + ss;
-
-                //Windows after last samp
-                while (w<W) { *Y = 0.0; Y += K; ++w; }
+                //Apply window
+                lcr_windowed_frames_d(Y,Z,F,X2,Lx,Lw,W,K,c0,stp,wtyp,r);
             }
         }
         
-        free(Z);
+        free(Z); free(F);
     }
 
     return 0;
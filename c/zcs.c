@@ -1,5 +1,8 @@
 //The signbit function was definitely slower.
 //Also slower was my original while loop idea, and a few other variations.
+//Comparing each samp to the previous samp (instead of carrying the previous sign)
+//lets the compiler vectorize the loops, which was ~1.5x faster.
+//See zcs_bits.c for a bit-packed output (1 bit per samp), which is faster again.
 
 //For complex numbers, I use zero-crossings of the imaginary part,
 //for which one imagines rotation of a vector around the complex plane.
@@ -23,25 +26,25 @@ int zcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
-    int s, sp; //sign info and previous sign info
+    int s; //sign info
 
     if (N==0u) {}
     else if (L==N)
     {
         if (going==0)
         {
-            sp = (*X++<0.0f); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0f); *Y = (s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<0.0f)!=(*(X-1)<0.0f)); }
         }
         else if (going==1)
         {
-            sp = (*X++>=0.0f); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=0.0f); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=0.0f); *Y = s & (s!=(*(X-1)>=0.0f)); }
         }
         else if (going==-1)
         {
-            sp = (*X++<0.0f); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0f); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0f); *Y = s & (s!=(*(X-1)<0.0f)); }
         }
         else { fprintf(stderr,"error in zcs_s: going must be in {-1,0,1}\n"); return 1; }
     }
@@ -57,24 +60,24 @@ int zcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++<0.0f); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0f); *Y = (s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<0.0f)!=(*(X-1)<0.0f)); }
                 }
             }
             else if (going==1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++>=0.0f); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=0.0f); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=0.0f); *Y = s & (s!=(*(X-1)>=0.0f)); }
                 }
             }
             else if (going==-1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++<0.0f); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0f); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0f); *Y = s & (s!=(*(X-1)<0.0f)); }
                 }
             }
             else { fprintf(stderr,"error in zcs_s: going must be in {-1,0,1}\n"); return 1; }
@@ -87,8 +90,8 @@ int zcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X<0.0f); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<0.0f); *Y = (s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { *Y = ((*X<0.0f)!=(*(X-K)<0.0f)); }
                     }
                 }
             }
@@ -98,8 +101,8 @@ int zcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X>=0.0f); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=0.0f); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=0.0f); *Y = s & (s!=(*(X-K)>=0.0f)); }
                     }
                 }
             }
@@ -109,8 +112,8 @@ int zcs_s (int *Y, const float *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X<0.0f); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<0.0f); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<0.0f); *Y = s & (s!=(*(X-K)<0.0f)); }
                     }
                 }
             }
@@ -128,25 +131,25 @@ int zcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
-    int s, sp; //sign info and previous sign info
+    int s; //sign info
 
     if (N==0u) {}
     else if (L==N)
     {
         if (going==0)
         {
-            sp = (*X++<0.0); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0); *Y = (s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<0.0)!=(*(X-1)<0.0)); }
         }
         else if (going==1)
         {
-            sp = (*X++>=0.0); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=0.0); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=0.0); *Y = s & (s!=(*(X-1)>=0.0)); }
         }
         else if (going==-1)
         {
-            sp = (*X++<0.0); *Y++ = 0;
-            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0); *Y = s*(s!=sp); sp = s; }
+            ++X; *Y++ = 0;
+            for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0); *Y = s & (s!=(*(X-1)<0.0)); }
         }
         else { fprintf(stderr,"error in zcs_d: going must be in {-1,0,1}\n"); return 1; }
     }
@@ -162,24 +165,24 @@ int zcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++<0.0); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0); *Y = (s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { *Y = ((*X<0.0)!=(*(X-1)<0.0)); }
                 }
             }
             else if (going==1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++>=0.0); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=0.0); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X>=0.0); *Y = s & (s!=(*(X-1)>=0.0)); }
                 }
             }
             else if (going==-1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*X++<0.0); *Y++ = 0;
-                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0); *Y = s*(s!=sp); sp = s; }
+                    ++X; *Y++ = 0;
+                    for (size_t l=L; l>1u; --l, ++X, ++Y) { s = (*X<0.0); *Y = s & (s!=(*(X-1)<0.0)); }
                 }
             }
             else { fprintf(stderr,"error in zcs_d: going must be in {-1,0,1}\n"); return 1; }
@@ -192,8 +195,8 @@ int zcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X<0.0); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<0.0); *Y = (s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { *Y = ((*X<0.0)!=(*(X-K)<0.0)); }
                     }
                 }
             }
@@ -203,8 +206,8 @@ int zcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X>=0.0); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=0.0); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X>=0.0); *Y = s & (s!=(*(X-K)>=0.0)); }
                     }
                 }
             }
@@ -214,8 +217,8 @@ int zcs_d (int *Y, const double *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=K*L-1u, Y-=K*L-1u)
                     {
-                        sp = (*X<0.0); *Y = 0; X+=K; Y+=K;
-                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<0.0); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=K; Y+=K;
+                        for (size_t l=L; l>1u; --l, X+=K, Y+=K) { s = (*X<0.0); *Y = s & (s!=(*(X-K)<0.0)); }
                     }
                 }
             }
@@ -233,25 +236,25 @@ int zcs_c (int *Y, const float *X, const size_t R, const size_t C, const size_t
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
-    int s, sp; //sign info and previous sign info
+    int s; //sign info
 
     if (N==0u) {}
     else if (L==N)
     {
         if (going==0)
         {
-            sp = (*++X<0.0f); *Y++ = 0; X+=2;
-            for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0f); *Y = (s!=sp); sp = s; }
+            *Y++ = 0; X+=3;
+            for (size_t l=L; l>1u; --l, X+=2, ++Y) { *Y = ((*X<0.0f)!=(*(X-2)<0.0f)); }
         }
         else if (going==1)
         {
-            sp = (*++X>=0.0f); *Y++ = 0; X+=2;
-            for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X>=0.0f); *Y = s*(s!=sp); sp = s; }
+            *Y++ = 0; X+=3;
+            for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X>=0.0f); *Y = s & (s!=(*(X-2)>=0.0f)); }
         }
         else if (going==-1)
         {
-            sp = (*++X<0.0f); *Y++ = 0; X+=2;
-            for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0f); *Y = s*(s!=sp); sp = s; }
+            *Y++ = 0; X+=3;
+            for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0f); *Y = s & (s!=(*(X-2)<0.0f)); }
         }
         else { fprintf(stderr,"error in zcs_c: going must be in {-1,0,1}\n"); return 1; }
     }
@@ -267,24 +270,24 @@ int zcs_c (int *Y, const float *X, const size_t R, const size_t C, const size_t
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*++X<0.0f); *Y++ = 0; X+=2;
-                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0f); *Y = (s!=sp); sp = s; }
+                    *Y++ = 0; X+=3;
+                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { *Y = ((*X<0.0f)!=(*(X-2)<0.0f)); }
                 }
             }
             else if (going==1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*++X>=0.0f); *Y++ = 0; X+=2;
-                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X>=0.0f); *Y = s*(s!=sp); sp = s; }
+                    *Y++ = 0; X+=3;
+                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X>=0.0f); *Y = s & (s!=(*(X-2)>=0.0f)); }
                 }
             }
             else if (going==-1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*++X<0.0f); *Y++ = 0; X+=2;
-                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0f); *Y = s*(s!=sp); sp = s; }
+                    *Y++ = 0; X+=3;
+                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0f); *Y = s & (s!=(*(X-2)<0.0f)); }
                 }
             }
             else { fprintf(stderr,"error in zcs_c: going must be in {-1,0,1}\n"); return 1; }
@@ -297,8 +300,8 @@ int zcs_c (int *Y, const float *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=2u*K*L-1u, Y-=2u*K*L-1u)
                     {
-                        sp = (*++X<0.0f); *Y = 0; X+=2u*K; Y+=2u*K;
-                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { s = (*X<0.0f); *Y = (s!=sp); sp = s; }
+                        *Y = 0; X+=2u*K+1u; Y+=2u*K;
+                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { *Y = ((*X<0.0f)!=(*(X-2u*K)<0.0f)); }
                     }
                 }
             }
@@ -308,8 +311,8 @@ int zcs_c (int *Y, const float *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=2u*K*L-1u, Y-=2u*K*L-1u)
                     {
-                        sp = (*++X>=0.0f); *Y = 0; X+=2u*K; Y+=2u*K;
-                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { s = (*X>=0.0f); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=2u*K+1u; Y+=2u*K;
+                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { s = (*X>=0.0f); *Y = s & (s!=(*(X-2u*K)>=0.0f)); }
                     }
                 }
             }
@@ -319,8 +322,8 @@ int zcs_c (int *Y, const float *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=2u*K*L-1u, Y-=2u*K*L-1u)
                     {
-                        sp = (*++X<0.0f); *Y = 0; X+=2u*K; Y+=2u*K;
-                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { s = (*X<0.0f); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=2u*K+1u; Y+=2u*K;
+                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { s = (*X<0.0f); *Y = s & (s!=(*(X-2u*K)<0.0f)); }
                     }
                 }
             }
@@ -338,25 +341,25 @@ int zcs_z (int *Y, const double *X, const size_t R, const size_t C, const size_t
 
     const size_t N = R*C*S*H;
     const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
-    int s, sp; //sign info and previous sign info
+    int s; //sign info
 
     if (N==0u) {}
     else if (L==N)
     {
         if (going==0)
         {
-            sp = (*++X<0.0); *Y++ = 0; X+=2;
-            for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0); *Y = (s!=sp); sp = s; }
+            *Y++ = 0; X+=3;
+            for (size_t l=L; l>1u; --l, X+=2, ++Y) { *Y = ((*X<0.0)!=(*(X-2)<0.0)); }
         }
         else if (going==1)
         {
-            sp = (*++X>=0.0); *Y++ = 0; X+=2;
-            for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X>=0.0); *Y = s*(s!=sp); sp = s; }
+            *Y++ = 0; X+=3;
+            for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X>=0.0); *Y = s & (s!=(*(X-2)>=0.0)); }
         }
         else if (going==-1)
         {
-            sp = (*++X<0.0); *Y++ = 0; X+=2;
-            for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0); *Y = s*(s!=sp); sp = s; }
+            *Y++ = 0; X+=3;
+            for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0); *Y = s & (s!=(*(X-2)<0.0)); }
         }
         else { fprintf(stderr,"error in zcs_z: going must be in {-1,0,1}\n"); return 1; }
     }
@@ -372,24 +375,24 @@ int zcs_z (int *Y, const double *X, const size_t R, const size_t C, const size_t
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*++X<0.0); *Y++ = 0; X+=2;
-                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0); *Y = (s!=sp); sp = s; }
+                    *Y++ = 0; X+=3;
+                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { *Y = ((*X<0.0)!=(*(X-2)<0.0)); }
                 }
             }
             else if (going==1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*++X>=0.0); *Y++ = 0; X+=2;
-                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X>=0.0); *Y = s*(s!=sp); sp = s; }
+                    *Y++ = 0; X+=3;
+                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X>=0.0); *Y = s & (s!=(*(X-2)>=0.0)); }
                 }
             }
             else if (going==-1)
             {
                 for (size_t v=V; v>0u; --v)
                 {
-                    sp = (*++X<0.0); *Y++ = 0; X+=2;
-                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0); *Y = s*(s!=sp); sp = s; }
+                    *Y++ = 0; X+=3;
+                    for (size_t l=L; l>1u; --l, X+=2, ++Y) { s = (*X<0.0); *Y = s & (s!=(*(X-2)<0.0)); }
                 }
             }
             else { fprintf(stderr,"error in zcs_z: going must be in {-1,0,1}\n"); return 1; }
@@ -402,8 +405,8 @@ int zcs_z (int *Y, const double *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=2u*K*L-1u, Y-=2u*K*L-1u)
                     {
-                        sp = (*++X<0.0); *Y = 0; X+=2u*K; Y+=2u*K;
-                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { s = (*X<0.0); *Y = (s!=sp); sp = s; }
+                        *Y = 0; X+=2u*K+1u; Y+=2u*K;
+                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { *Y = ((*X<0.0)!=(*(X-2u*K)<0.0)); }
                     }
                 }
             }
@@ -413,8 +416,8 @@ int zcs_z (int *Y, const double *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=2u*K*L-1u, Y-=2u*K*L-1u)
                     {
-                        sp = (*++X>=0.0); *Y = 0; X+=2u*K; Y+=2u*K;
-                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { s = (*X>=0.0); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=2u*K+1u; Y+=2u*K;
+                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { s = (*X>=0.0); *Y = s & (s!=(*(X-2u*K)>=0.0)); }
                     }
                 }
             }
@@ -424,8 +427,8 @@ int zcs_z (int *Y, const double *X, const size_t R, const size_t C, const size_t
                 {
                     for (size_t b=B; b>0u; --b, X-=2u*K*L-1u, Y-=2u*K*L-1u)
                     {
-                        sp = (*++X<0.0); *Y = 0; X+=2u*K; Y+=2u*K;
-                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { s = (*X<0.0); *Y = s*(s!=sp); sp = s; }
+                        *Y = 0; X+=2u*K+1u; Y+=2u*K;
+                        for (size_t l=L; l>1u; --l, X+=2u*K, Y+=2u*K) { s = (*X<0.0); *Y = s & (s!=(*(X-2u*K)<0.0)); }
                     }
                 }
             }
@@ -0,0 +1,125 @@
+//Zero crossings, with bit-packed output.
+//This gives the same crossings as zcs, but with 1 bit per sample instead of 1 int (32x less memory).
+//See lcs_bits.c for the packed format and method.
+
+//For complex numbers, zero-crossings of the imaginary part are used (as in zcs).
+
+#include <stdio.h>
+#include <stdint.h>
+#include "lcs_bits.c"
+
+#ifdef __cplusplus
+namespace codee {
+extern "C" {
+#endif
+
+int zcs_bits_s (uint64_t *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going);
+int zcs_bits_d (uint64_t *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going);
+int zcs_bits_c (uint64_t *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going);
+int zcs_bits_z (uint64_t *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going);
+
+
+int zcs_bits_s (uint64_t *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going)
+{
+    if (dim>3u) { fprintf(stderr,"error in zcs_bits_s: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in zcs_bits_s: going must be in {-1,0,1}\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (L==N) { lcs_bits_pack_s(Y,X,L,1u,1u,going,0.0f); }
+    else
+    {
+        const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t V = N/L, Lb = (L+63u)/64u;
+
+        for (size_t v=0u; v<V; ++v)
+        {
+            lcs_bits_pack_s(&Y[(v/K)*K*Lb+v%K],&X[(v/K)*K*L+v%K],L,K,K,going,0.0f);
+        }
+    }
+
+    return 0;
+}
+
+
+int zcs_bits_d (uint64_t *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going)
+{
+    if (dim>3u) { fprintf(stderr,"error in zcs_bits_d: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in zcs_bits_d: going must be in {-1,0,1}\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (L==N) { lcs_bits_pack_d(Y,X,L,1u,1u,going,0.0); }
+    else
+    {
+        const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t V = N/L, Lb = (L+63u)/64u;
+
+        for (size_t v=0u; v<V; ++v)
+        {
+            lcs_bits_pack_d(&Y[(v/K)*K*Lb+v%K],&X[(v/K)*K*L+v%K],L,K,K,going,0.0);
+        }
+    }
+
+    return 0;
+}
+
+
+int zcs_bits_c (uint64_t *Y, const float *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going)
+{
+    if (dim>3u) { fprintf(stderr,"error in zcs_bits_c: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in zcs_bits_c: going must be in {-1,0,1}\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (L==N) { lcs_bits_pack_s(Y,&X[1],L,2u,1u,going,0.0f); }
+    else
+    {
+        const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t V = N/L, Lb = (L+63u)/64u;
+
+        for (size_t v=0u; v<V; ++v)
+        {
+            lcs_bits_pack_s(&Y[(v/K)*K*Lb+v%K],&X[2u*((v/K)*K*L+v%K)+1u],L,2u*K,K,going,0.0f);
+        }
+    }
+
+    return 0;
+}
+
+
+int zcs_bits_z (uint64_t *Y, const double *X, const size_t R, const size_t C, const size_t S, const size_t H, const int iscolmajor, const size_t dim, const int going)
+{
+    if (dim>3u) { fprintf(stderr,"error in zcs_bits_z: dim must be in [0 3]\n"); return 1; }
+    if (going!=0 && going!=1 && going!=-1) { fprintf(stderr,"error in zcs_bits_z: going must be in {-1,0,1}\n"); return 1; }
+
+    const size_t N = R*C*S*H;
+    const size_t L = (dim==0u) ? R : (dim==1u) ? C : (dim==2u) ? S : H;
+
+    if (N==0u) {}
+    else if (L==N) { lcs_bits_pack_d(Y,&X[1],L,2u,1u,going,0.0); }
+    else
+    {
+        const size_t K = (iscolmajor) ? ((dim==0u) ? 1u : (dim==1u) ? R : (dim==2u) ? R*C : R*C*S) : ((dim==0u) ? C*S*H : (dim==1u) ? S*H : (dim==2u) ? H : 1u);
+        const size_t V = N/L, Lb = (L+63u)/64u;
+
+        for (size_t v=0u; v<V; ++v)
+        {
+            lcs_bits_pack_d(&Y[(v/K)*K*Lb+v%K],&X[2u*((v/K)*K*L+v%K)+1u],L,2u*K,K,going,0.0);
+        }
+    }
+
+    return 0;
+}
+
+
+#ifdef __cplusplus
+}
+}
+#endif
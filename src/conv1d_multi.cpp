@@ -0,0 +1,265 @@
+//@author Erik Edwards
+//@date 2018-present
+//@license BSD 3-clause
+
+
+#include <iostream>
+#include <fstream>
+#include <unistd.h>
+#include <string>
+#include <cstring>
+#include <valarray>
+#include <unordered_map>
+#include <argtable2.h>
+#include "cmli.hpp"
+#include "conv1d_multi.c"
+
+#ifdef I
+#undef I
+#endif
+
+
+int main(int argc, char *argv[])
+{
+    using namespace std;
+
+
+    //Declarations
+    int ret = 0;
+    const string errstr = ": \033[1;31merror:\033[0m ";
+    const string warstr = ": \033[1;35mwarning:\033[0m ";
+    const string progstr(__FILE__,string(__FILE__).find_last_of("/")+1,strlen(__FILE__)-string(__FILE__).find_last_of("/")-5);
+    const valarray<size_t> oktypes = {1u,2u};
+    const size_t I = 3u, O = 1u;
+    ifstream ifs1, ifs2, ifs3; ofstream ofs1;
+    int8_t stdi1, stdi2, stdi3, stdo1, wo1;
+    ioinfo i1, i2, i3, o1;
+    size_t L, Cin, Cout, NB, K, G, Lout, str, dil;
+    int pad, xc;
+
+
+    //Description
+    string descr;
+    descr += "1D multichannel convolution, as in a Conv1d layer of a neural network.\n";
+    descr += "Each of NB items in X has Cin input channels of length L,\n";
+    descr += "and each item in Y has Cout output channels of length Lout.\n";
+    descr += "\n";
+    descr += "W holds the weights, with memory order Cout x Cin/G x K,\n";
+    descr += "where K is the kernel_size, and G is the number of groups.\n";
+    descr += "B holds the biases, and has length Cout (use zeros for no bias).\n";
+    descr += "\n";
+    descr += "The samples of each channel must be contiguous in memory, so:\n";
+    descr += "If row-major, then X has size NB x Cin x L, or Cin x L for NB=1,\n";
+    descr += "and Y has size NB x Cout x Lout, or Cout x Lout for NB=1.\n";
+    descr += "If col-major, then X has size L x Cin x NB, and Y has size Lout x Cout x NB.\n";
+    descr += "\n";
+    descr += "Use -g (--groups) to give the number of groups [default=1].\n";
+    descr += "Cin and Cout must both be divisible by G.\n";
+    descr += "Use G = Cin for depthwise convolution.\n";
+    descr += "\n";
+    descr += "Use -s (--stride) to give the stride (step-size) in samples [default=1].\n";
+    descr += "\n";
+    descr += "Use -i (--dilation) to give the dilation factor [default=1].\n";
+    descr += "\n";
+    descr += "Use -p (--padding) to give the padding in samples [default=0]\n";
+    descr += "\n";
+    descr += "Lout = floor[1 + (L + 2*pad - 1 - dil*(K-1))/stride].\n";
+    descr += "\n";
+    descr += "As in conv1d, the kernel is flipped (true convolution).\n";
+    descr += "Include -x (--xcorr) to do cross-correlation instead (no flip).\n";
+    descr += "This is what PyTorch Conv1d does, so use -x for weights from PyTorch.\n";
+    descr += "\n";
+    descr += "Examples:\n";
+    descr += "$ conv1d_multi X W B -o Y \n";
+    descr += "$ conv1d_multi -x -p2 -s2 X W B > Y \n";
+    descr += "$ cat X | conv1d_multi -x -g16 - W B > Y \n";
+
+
+    //Argtable
+    int nerrs;
+    struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input files (X,W,B)");
+    struct arg_int    *a_g = arg_intn("g","groups","<uint>",0,1,"number of groups [default=1]");
+    struct arg_int  *a_str = arg_intn("s","step","<uint>",0,1,"step size in samps [default=1]");
+    struct arg_int  *a_dil = arg_intn("i","dilation","<uint>",0,1,"dilation factor [default=1]");
+    struct arg_int  *a_pad = arg_intn("p","padding","<uint>",0,1,"padding [default=0]");
+    struct arg_lit   *a_xc = arg_litn("x","xcorr",0,1,"cross-correlation (no flip) as in PyTorch");
+    struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+    struct arg_lit *a_help = arg_litn("h","help",0,1,"display this help and exit");
+    struct arg_end  *a_end = arg_end(5);
+    void *argtable[] = {a_fi, a_g, a_str, a_dil, a_pad, a_xc, a_fo, a_help, a_end};
+    if (arg_nullcheck(argtable)!=0) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating argtable" << endl; return 1; }
+    nerrs = arg_parse(argc, argv, argtable);
+    if (a_help->count>0)
+    {
+        cout << "Usage: " << progstr; arg_print_syntax(stdout, argtable, "\n");
+        cout << endl; arg_print_glossary(stdout, argtable, "  %-25s %s\n");
+        cout << endl << descr; return 1;
+    }
+    if (nerrs>0) { arg_print_errors(stderr,a_end,(progstr+": "+to_string(__LINE__)+errstr).c_str()); return 1; }
+
+
+    //Check stdin
+    stdi1 = (a_fi->count==0 || strlen(a_fi->filename[0])==0u || strcmp(a_fi->filename[0],"-")==0);
+    stdi2 = (a_fi->count<=1 || strlen(a_fi->filename[1])==0u || strcmp(a_fi->filename[1],"-")==0);
+    stdi3 = (a_fi->count<=2 || strlen(a_fi->filename[2])==0u || strcmp(a_fi->filename[2],"-")==0);
+    if (stdi1+stdi2+stdi3>1) { cerr << progstr+": " << __LINE__ << errstr << "can only use stdin for one input" << endl; return 1; }
+    if (stdi1+stdi2+stdi3>0 && isatty(fileno(stdin))) { cerr << progstr+": " << __LINE__ << errstr << "no stdin detected" << endl; return 1; }
+
+
+    //Check stdout
+    if (a_fo->count>0) { stdo1 = (strlen(a_fo->filename[0])==0u || strcmp(a_fo->filename[0],"-")==0); }
+    else { stdo1 = (!isatty(fileno(stdout))); }
+    wo1 = (stdo1 || a_fo->count>0);
+
+
+    //Open inputs
+    if (stdi1) { ifs1.copyfmt(cin); ifs1.basic_ios<char>::rdbuf(cin.rdbuf()); } else { ifs1.open(a_fi->filename[0]); }
+    if (!ifs1) { cerr << progstr+": " << __LINE__ << errstr << "problem opening input file 1" << endl; return 1; }
+    if (stdi2) { ifs2.copyfmt(cin); ifs2.basic_ios<char>::rdbuf(cin.rdbuf()); } else { ifs2.open(a_fi->filename[1]); }
+    if (!ifs2) { cerr << progstr+": " << __LINE__ << errstr << "problem opening input file 2" << endl; return 1; }
+    if (stdi3) { ifs3.copyfmt(cin); ifs3.basic_ios<char>::rdbuf(cin.rdbuf()); } else { ifs3.open(a_fi->filename[2]); }
+    if (!ifs3) { cerr << progstr+": " << __LINE__ << errstr << "problem opening input file 3" << endl; return 1; }
+
+
+    //Read input headers
+    if (!read_input_header(ifs1,i1)) { cerr << progstr+": " << __LINE__ << errstr << "problem reading header for input file 1" << endl; return 1; }
+    if (!read_input_header(ifs2,i2)) { cerr << progstr+": " << __LINE__ << errstr << "problem reading header for input file 2" << endl; return 1; }
+    if (!read_input_header(ifs3,i3)) { cerr << progstr+": " << __LINE__ << errstr << "problem reading header for input file 3" << endl; return 1; }
+    if ((i1.T==oktypes).sum()==0 || (i2.T==oktypes).sum()==0 || (i3.T==oktypes).sum()==0)
+    {
+        cerr << progstr+": " << __LINE__ << errstr << "input data type must be in " << "{";
+        for (auto o : oktypes) { cerr << int(o) << ((o==oktypes[oktypes.size()-1u]) ? "}" : ","); }
+        cerr << endl; return 1;
+    }
+
+
+    //Get options
+
+    //Get G
+    if (a_g->count==0) { G = 1u; }
+    else if (a_g->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "groups must be positive" << endl; return 1; }
+    else { G = size_t(a_g->ival[0]); }
+
+    //Get stride
+    if (a_str->count==0) { str = 1u; }
+    else if (a_str->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "stride must be positive" << endl; return 1; }
+    else { str = size_t(a_str->ival[0]); }
+
+    //Get dil
+    if (a_dil->count==0) { dil = 1u; }
+    else if (a_dil->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "dilation must be positive" << endl; return 1; }
+    else { dil = size_t(a_dil->ival[0]); }
+
+    //Get padding
+    if (a_pad->count==0) { pad = 0; }
+    else if (a_pad->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "padding must be nonnegative" << endl; return 1; }
+    else { pad = a_pad->ival[0]; }
+
+    //Get xc
+    xc = (a_xc->count>0);
+
+
+    //Checks
+    if (i1.T!=i2.T || i1.T!=i3.T) { cerr << progstr+": " << __LINE__ << errstr << "inputs must have the same data type" << endl; return 1; }
+    if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) found to be empty" << endl; return 1; }
+    if (i2.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (W) found to be empty" << endl; return 1; }
+    if (i3.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 3 (B) found to be empty" << endl; return 1; }
+    if (i1.H!=1u) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) must be a matrix or 3D tensor" << endl; return 1; }
+    if (!i3.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 3 (B) must be a vector" << endl; return 1; }
+    if (i1.isrowmajor() && i1.S==1u) { NB = 1u; Cin = i1.R; L = i1.C; }
+    else if (i1.isrowmajor()) { NB = i1.R; Cin = i1.C; L = i1.S; }
+    else { L = i1.R; Cin = i1.C; NB = i1.S; }
+    Cout = i3.N();
+    if (Cin%G) { cerr << progstr+": " << __LINE__ << errstr << "Cin (num input channels) must be divisible by G" << endl; return 1; }
+    if (Cout%G) { cerr << progstr+": " << __LINE__ << errstr << "Cout (length of B) must be divisible by G" << endl; return 1; }
+    if (i2.N()%(Cout*Cin/G)) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (W) must have Cout*Cin/G*K elements" << endl; return 1; }
+    K = i2.N() / (Cout*Cin/G);
+    if (int(L)+2*pad<=int(dil*(K-1u))) { cerr << progstr+": " << __LINE__ << errstr << "L+2*pad must be > dil*(K-1)" << endl; return 1; }
+
+
+    //Set output header info
+    Lout = 1u + (L + 2u*size_t(pad) - dil*(K-1u) - 1u) / str;
+    o1.F = i1.F; o1.T = i1.T;
+    o1.R = (i1.isrowmajor()) ? ((i1.S==1u) ? Cout : NB) : Lout;
+    o1.C = (i1.isrowmajor()) ? ((i1.S==1u) ? Lout : Cout) : Cout;
+    o1.S = (i1.isrowmajor()) ? ((i1.S==1u) ? 1u : Lout) : NB;
+    o1.H = 1u;
+
+
+    //Open output
+    if (wo1)
+    {
+        if (stdo1) { ofs1.copyfmt(cout); ofs1.basic_ios<char>::rdbuf(cout.rdbuf()); } else { ofs1.open(a_fo->filename[0]); }
+        if (!ofs1) { cerr << progstr+": " << __LINE__ << errstr << "problem opening output file 1" << endl; return 1; }
+    }
+
+
+    //Write output header
+    if (wo1 && !write_output_header(ofs1,o1)) { cerr << progstr+": " << __LINE__ << errstr << "problem writing header for output file 1" << endl; return 1; }
+
+
+    //Other prep
+    
+
+    //Process
+    if (i1.T==1u)
+    {
+        float *X, *W, *B, *Y;
+        try { X = new float[i1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+        try { W = new float[i2.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (W)" << endl; return 1; }
+        try { B = new float[i3.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 3 (B)" << endl; return 1; }
+        try { Y = new float[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+        try { ifs2.read(reinterpret_cast<char*>(W),i2.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (W)" << endl; return 1; }
+        try { ifs3.read(reinterpret_cast<char*>(B),i3.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 3 (B)" << endl; return 1; }
+        if (codee::conv1d_multi_s(Y,X,W,B,L,Cin,Cout,NB,K,G,pad,str,dil,xc))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; } 
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] W; delete[] B; delete[] Y;
+    }
+    else if (i1.T==2)
+    {
+        double *X, *W, *B, *Y;
+        try { X = new double[i1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+        try { W = new double[i2.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (W)" << endl; return 1; }
+        try { B = new double[i3.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 3 (B)" << endl; return 1; }
+        try { Y = new double[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+        try { ifs2.read(reinterpret_cast<char*>(W),i2.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (W)" << endl; return 1; }
+        try { ifs3.read(reinterpret_cast<char*>(B),i3.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 3 (B)" << endl; return 1; }
+        if (codee::conv1d_multi_d(Y,X,W,B,L,Cin,Cout,NB,K,G,pad,str,dil,xc))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; } 
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] W; delete[] B; delete[] Y;
+    }
+    else
+    {
+        cerr << progstr+": " << __LINE__ << errstr << "data type not supported" << endl; return 1;
+    }
+    
+
+    //Exit
+    return ret;
+}
@@ -0,0 +1,199 @@
+//@author Erik Edwards
+//@date 2018-present
+//@license BSD 3-clause
+
+
+#include <iostream>
+#include <fstream>
+#include <unistd.h>
+#include <string>
+#include <cstring>
+#include <valarray>
+#include <unordered_map>
+#include <argtable2.h>
+#include "cmli.hpp"
+#include "fir_decim.c"
+
+#ifdef I
+#undef I
+#endif
+
+
+int main(int argc, char *argv[])
+{
+    using namespace std;
+
+
+    //Declarations
+    int ret = 0;
+    const string errstr = ": \033[1;31merror:\033[0m ";
+    const string warstr = ": \033[1;35mwarning:\033[0m ";
+    const string progstr(__FILE__,string(__FILE__).find_last_of("/")+1,strlen(__FILE__)-string(__FILE__).find_last_of("/")-5);
+    const valarray<size_t> oktypes = {1u,2u};
+    const size_t I = 1u, O = 1u;
+    ifstream ifs1; ofstream ofs1;
+    int8_t stdi1, stdo1, wo1;
+    ioinfo i1, o1;
+    size_t dim, M, Lx, Ly;
+
+
+    //Description
+    string descr;
+    descr += "Decimation of each vector in X by an integer factor M,\n";
+    descr += "with an anti-aliasing lowpass filter (like decimate in Octave).\n";
+    descr += "\n";
+    descr += "For large M, this is done in multiple stages (each of factor <= 8),\n";
+    descr += "each with a Hamming-windowed sinc lowpass filter (order 20 x stage factor).\n";
+    descr += "Only the kept outputs of each stage are computed (polyphase decimator).\n";
+    descr += "The delay of each stage is compensated, so Y is aligned with X.\n";
+    descr += "\n";
+    descr += "Use -m (--M) to give the decimation factor [default=2].\n";
+    descr += "Each vector in Y has length Ly = ceil(L/M).\n";
+    descr += "\n";
+    descr += "Use -d (--dim) to give the dimension along which to decimate.\n";
+    descr += "Default is 0 (along cols), unless X is a row vector.\n";
+    descr += "\n";
+    descr += "If dim==0, then Y has size Ly x C x S x H.\n";
+    descr += "If dim==1, then Y has size R x Ly x S x H.\n";
+    descr += "If dim==2, then Y has size R x C x Ly x H.\n";
+    descr += "If dim==3, then Y has size R x C x S x Ly.\n";
+    descr += "\n";
+    descr += "Examples:\n";
+    descr += "$ decimate -m4 X -o Y \n";
+    descr += "$ decimate -d1 -m60 X > Y \n";
+    descr += "$ cat X | decimate -m10 > Y \n";
+
+
+    //Argtable
+    int nerrs;
+    struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input file (X)");
+    struct arg_int    *a_m = arg_intn("m","M","<uint>",0,1,"decimation factor [default=2]");
+    struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"dimension along which to decimate [default=0]");
+    struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+    struct arg_lit *a_help = arg_litn("h","help",0,1,"display this help and exit");
+    struct arg_end  *a_end = arg_end(5);
+    void *argtable[] = {a_fi, a_m, a_d, a_fo, a_help, a_end};
+    if (arg_nullcheck(argtable)!=0) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating argtable" << endl; return 1; }
+    nerrs = arg_parse(argc, argv, argtable);
+    if (a_help->count>0)
+    {
+        cout << "Usage: " << progstr; arg_print_syntax(stdout, argtable, "\n");
+        cout << endl; arg_print_glossary(stdout, argtable, "  %-25s %s\n");
+        cout << endl << descr; return 1;
+    }
+    if (nerrs>0) { arg_print_errors(stderr,a_end,(progstr+": "+to_string(__LINE__)+errstr).c_str()); return 1; }
+
+
+    //Check stdin
+    stdi1 = (a_fi->count==0 || strlen(a_fi->filename[0])==0u || strcmp(a_fi->filename[0],"-")==0);
+    if (stdi1>0 && isatty(fileno(stdin))) { cerr << progstr+": " << __LINE__ << errstr << "no stdin detected" << endl; return 1; }
+
+
+    //Check stdout
+    if (a_fo->count>0) { stdo1 = (strlen(a_fo->filename[0])==0u || strcmp(a_fo->filename[0],"-")==0); }
+    else { stdo1 = (!isatty(fileno(stdout))); }
+    wo1 = (stdo1 || a_fo->count>0);
+
+
+    //Open input
+    if (stdi1) { ifs1.copyfmt(cin); ifs1.basic_ios<char>::rdbuf(cin.rdbuf()); } else { ifs1.open(a_fi->filename[0]); }
+    if (!ifs1) { cerr << progstr+": " << __LINE__ << errstr << "problem opening input file" << endl; return 1; }
+
+
+    //Read input header
+    if (!read_input_header(ifs1,i1)) { cerr << progstr+": " << __LINE__ << errstr << "problem reading header for input file" << endl; return 1; }
+    if ((i1.T==oktypes).sum()==0)
+    {
+        cerr << progstr+": " << __LINE__ << errstr << "input data type must be in " << "{";
+        for (auto o : oktypes) { cerr << int(o) << ((o==oktypes[oktypes.size()-1u]) ? "}" : ","); }
+        cerr << endl; return 1;
+    }
+
+
+    //Get options
+
+    //Get dim
+    if (a_d->count==0) { dim = i1.isrowvec() ? 1u : 0u; }
+    else if (a_d->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "dim must be nonnegative" << endl; return 1; }
+    else { dim = size_t(a_d->ival[0]); }
+    if (dim>3u) { cerr << progstr+": " << __LINE__ << errstr << "dim must be in {0,1,2,3}" << endl; return 1; }
+
+    //Get M
+    if (a_m->count==0) { M = 2u; }
+    else if (a_m->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "M (decimation factor) must be positive" << endl; return 1; }
+    else { M = size_t(a_m->ival[0]); }
+
+
+    //Checks
+    if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) found to be empty" << endl; return 1; }
+
+
+    //Set output header info
+    Lx = (dim==0u) ? i1.R : (dim==1u) ? i1.C : (dim==2u) ? i1.S : i1.H;
+    Ly = (Lx+M-1u) / M;
+    o1.F = i1.F; o1.T = i1.T;
+    o1.R = (dim==0u) ? Ly : i1.R;
+    o1.C = (dim==1u) ? Ly : i1.C;
+    o1.S = (dim==2u) ? Ly : i1.S;
+    o1.H = (dim==3u) ? Ly : i1.H;
+
+
+    //Open output
+    if (wo1)
+    {
+        if (stdo1) { ofs1.copyfmt(cout); ofs1.basic_ios<char>::rdbuf(cout.rdbuf()); } else { ofs1.open(a_fo->filename[0]); }
+        if (!ofs1) { cerr << progstr+": " << __LINE__ << errstr << "problem opening output file 1" << endl; return 1; }
+    }
+
+
+    //Write output header
+    if (wo1 && !write_output_header(ofs1,o1)) { cerr << progstr+": " << __LINE__ << errstr << "problem writing header for output file 1" << endl; return 1; }
+
+
+    //Other prep
+    
+
+    //Process
+    if (i1.T==1u)
+    {
+        float *X, *Y;
+        try { X = new float[i1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+        try { Y = new float[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+        if (codee::decimate_s(Y,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),M,dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] Y;
+    }
+    else if (i1.T==2)
+    {
+        double *X, *Y;
+        try { X = new double[i1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+        try { Y = new double[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+        if (codee::decimate_d(Y,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),M,dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] Y;
+    }
+    else
+    {
+        cerr << progstr+": " << __LINE__ << errstr << "data type not supported" << endl; return 1;
+    }
+    
+
+    //Exit
+    return ret;
+}
@@ -0,0 +1,214 @@
+//@author Erik Edwards
+//@date 2018-present
+//@license BSD 3-clause
+
+
+#include <iostream>
+#include <fstream>
+#include <unistd.h>
+#include <string>
+#include <cstring>
+#include <valarray>
+#include <unordered_map>
+#include <argtable2.h>
+#include "cmli.hpp"
+#include "densify.c"
+
+#ifdef I
+#undef I
+#endif
+
+
+int main(int argc, char *argv[])
+{
+    using namespace std;
+
+
+    //Declarations
+    int ret = 0;
+    const string errstr = ": \033[1;31merror:\033[0m ";
+    const string warstr = ": \033[1;35mwarning:\033[0m ";
+    const string progstr(__FILE__,string(__FILE__).find_last_of("/")+1,strlen(__FILE__)-string(__FILE__).find_last_of("/")-5);
+    const valarray<size_t> oktypes = {2u};
+    const size_t I = 1u, O = 1u;
+    ifstream ifs1; ofstream ofs1;
+    int8_t stdi1, stdo1, wo1;
+    ioinfo i1, o1;
+    double *X;
+
+
+    //Description
+    string descr;
+    descr += "Densifies an event list X, giving the full (dense) tensor Y.\n";
+    descr += "Y has the event values at the event indices, and 0 elsewhere.\n";
+    descr += "\n";
+    descr += "This is for compatibility, since zcs, lcs, mcs, unit_impulse,\n";
+    descr += "delta_impulse and rect_pulse can output event lists (with -e).\n";
+    descr += "Y is then the same as those tools give without -e.\n";
+    descr += "\n";
+    descr += "X is a vector of doubles, with a 6-element header:\n";
+    descr += "R, C, S, H (the size of Y), E (the number of events),\n";
+    descr += "and 1 if values are included (or 0, then all values are 1).\n";
+    descr += "Then come the E indices into Y, and then the E values (if included).\n";
+    descr += "\n";
+    descr += "Use -t (--type) to give the output data type [default=1].\n";
+    descr += "Y has the same file format as X.\n";
+    descr += "\n";
+    descr += "Examples:\n";
+    descr += "$ densify X -o Y \n";
+    descr += "$ zcs -e X | densify > Y \n";
+    descr += "$ unit_impulse -n32 -s9 -e | densify -t2 > Y \n";
+
+
+    //Argtable
+    int nerrs;
+    struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input file (X)");
+    struct arg_int *a_otyp = arg_intn("t","type","<uint>",0,1,"output data type [default=1]");
+    struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+    struct arg_lit *a_help = arg_litn("h","help",0,1,"display this help and exit");
+    struct arg_end  *a_end = arg_end(5);
+    void *argtable[] = {a_fi, a_otyp, a_fo, a_help, a_end};
+    if (arg_nullcheck(argtable)!=0) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating argtable" << endl; return 1; }
+    nerrs = arg_parse(argc, argv, argtable);
+    if (a_help->count>0)
+    {
+        cout << "Usage: " << progstr; arg_print_syntax(stdout, argtable, "\n");
+        cout << endl; arg_print_glossary(stdout, argtable, "  %-25s %s\n");
+        cout << endl << descr; return 1;
+    }
+    if (nerrs>0) { arg_print_errors(stderr,a_end,(progstr+": "+to_string(__LINE__)+errstr).c_str()); return 1; }
+
+
+    //Check stdin
+    stdi1 = (a_fi->count==0 || strlen(a_fi->filename[0])==0 || strcmp(a_fi->filename[0],"-")==0);
+    if (stdi1>0 && isatty(fileno(stdin))) { cerr << progstr+": " << __LINE__ << errstr << "no stdin detected" << endl; return 1; }
+
+
+    //Check stdout
+    if (a_fo->count>0) { stdo1 = (strlen(a_fo->filename[0])==0 || strcmp(a_fo->filename[0],"-")==0); }
+    else { stdo1 = (!isatty(fileno(stdout))); }
+    wo1 = (stdo1 || a_fo->count>0);
+
+
+    //Open input
+    if (stdi1) { ifs1.copyfmt(cin); ifs1.basic_ios<char>::rdbuf(cin.rdbuf()); } else { ifs1.open(a_fi->filename[0]); }
+    if (!ifs1) { cerr << progstr+": " << __LINE__ << errstr << "problem opening input file" << endl; return 1; }
+
+
+    //Read input header
+    if (!read_input_header(ifs1,i1)) { cerr << progstr+": " << __LINE__ << errstr << "problem reading header for input file" << endl; return 1; }
+    if ((i1.T==oktypes).sum()==0)
+    {
+        cerr << progstr+": " << __LINE__ << errstr << "input data type must be in " << "{";
+        for (auto o : oktypes) { cerr << int(o) << ((o==oktypes[oktypes.size()-1u]) ? "}" : ","); }
+        cerr << endl; return 1;
+    }
+
+
+    //Get options
+
+    //Get o1.T
+    if (a_otyp->count==0) { o1.T = 1u; }
+    else if (a_otyp->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "data type must be positive int" << endl; return 1; }
+    else { o1.T = size_t(a_otyp->ival[0]); }
+    if (o1.T!=1u && o1.T!=2u && o1.T!=101u && o1.T!=102u) { cerr << progstr+": " << __LINE__ << errstr << "output data type must be in {1,2,101,102}" << endl; return 1; }
+
+
+    //Checks
+    if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) found to be empty" << endl; return 1; }
+    if (!i1.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) must be a vector" << endl; return 1; }
+    if (i1.N()<6u) { cerr << progstr+": " << __LINE__ << errstr << "input (X) must have at least 6 elements (header)" << endl; return 1; }
+
+
+    //Set output header info
+    //X is read here, since its header sets the output size
+    try { X = new double[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+    if (X[0]<1.0 || X[1]<1.0 || X[2]<1.0 || X[3]<1.0) { cerr << progstr+": " << __LINE__ << errstr << "input (X) has invalid header" << endl; return 1; }
+    o1.F = i1.F;
+    o1.R = size_t(X[0]); o1.C = size_t(X[1]); o1.S = size_t(X[2]); o1.H = size_t(X[3]);
+
+
+    //Open output
+    if (wo1)
+    {
+        if (stdo1) { ofs1.copyfmt(cout); ofs1.basic_ios<char>::rdbuf(cout.rdbuf()); } else { ofs1.open(a_fo->filename[0]); }
+        if (!ofs1) { cerr << progstr+": " << __LINE__ << errstr << "problem opening output file 1" << endl; return 1; }
+    }
+
+
+    //Write output header
+    if (wo1 && !write_output_header(ofs1,o1)) { cerr << progstr+": " << __LINE__ << errstr << "problem writing header for output file 1" << endl; return 1; }
+
+
+    //Other prep
+
+
+    //Process
+    if (o1.T==1u)
+    {
+        float *Y;
+        try { Y = new float[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        if (codee::densify_s(Y,X,i1.N()))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] Y;
+    }
+    else if (o1.T==2)
+    {
+        double *Y;
+        try { Y = new double[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        if (codee::densify_d(Y,X,i1.N()))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] Y;
+    }
+    else if (o1.T==101u)
+    {
+        float *Y;
+        try { Y = new float[2u*o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        if (codee::densify_c(Y,X,i1.N()))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] Y;
+    }
+    else if (o1.T==102u)
+    {
+        double *Y;
+        try { Y = new double[2u*o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        if (codee::densify_z(Y,X,i1.N()))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] Y;
+    }
+    else
+    {
+        cerr << progstr+": " << __LINE__ << errstr << "data type not supported" << endl; return 1;
+    }
+    
+
+    //Exit
+    return ret;
+}
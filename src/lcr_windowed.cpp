@@ -46,6 +46,9 @@ int main(int argc, char *argv[])
     descr += "\n";
     descr += "X2 is the output of a window function, e.g. hamming.\n";
     descr += "X2 should sum to 1 if the output Y is interpreted as a moving average.\n";
+    descr += "If X2 is rectangular (constant) or exponential (X2[l+1] = r*X2[l]),\n";
+    descr += "then each frame takes constant time (by prefix sums or recursion),\n";
+    descr += "so this is O(N) regardless of the window length and step size.\n";
     descr += "\n";
     descr += "Use -v (--level) to give the level of X to test for [default=0].\n";
     descr += "For -v0 [default], this is identical to zero crossings (ZCs).\n";
@@ -13,6 +13,8 @@
 #include <argtable2.h>
 #include "cmli.hpp"
 #include "mcs.c"
+#include "mcs_bits.c"
+#include "bits2events.c"
 
 #ifdef I
 #undef I
@@ -34,8 +36,9 @@ int main(int argc, char *argv[])
     ifstream ifs1; ofstream ofs1;
     int8_t stdi1, stdo1, wo1;
     ioinfo i1, o1;
-    size_t dim, Lx;
-    int g;
+    size_t dim, Lx, E;
+    int g, bits, ev;
+    uint64_t *P = nullptr;
 
 
     //Description
@@ -54,9 +57,23 @@ int main(int argc, char *argv[])
     descr += "Y has the same size and file format as X, with int data type,\n";
     descr += "since Y is Boolean (and int also found to be fastest).\n";
     descr += "\n";
+    descr += "Include -b (--bits) to output the MCs as packed bits instead,\n";
+    descr += "where each 64-bit int of Y holds the MCs of 64 consecutive samps along dim\n";
+    descr += "(first samp in the least-significant bit). This is 32x smaller, and faster.\n";
+    descr += "Y then has the same file format as X, with uint64 data type,\n";
+    descr += "and length ceil(L/64) along dim, where L is the length of X along dim.\n";
+    descr += "\n";
+    descr += "Include -e (--events) to output an event list instead (see densify),\n";
+    descr += "which has a 6-element header, and then the index of each MC.\n";
+    descr += "This is much smaller for long signals, since most samps are not MCs.\n";
+    descr += "Y is then a column vector of doubles, with the same file format as X.\n";
+    descr += "Use densify to get back the dense output.\n";
+    descr += "\n";
     descr += "Examples:\n";
     descr += "$ mcs X -o Y \n";
     descr += "$ mcs -d1 X > Y \n";
+    descr += "$ mcs -b X > Y \n";
+    descr += "$ mcs -e X > Y \n";
     descr += "$ cat X | mcs -g1 > Y \n";
 
 
@@ -65,10 +82,12 @@ int main(int argc, char *argv[])
     struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input file (X)");
     struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"dimension along which to operate [default=0]");
     struct arg_int    *a_g = arg_intn("g","going","<uint>",0,1,"if using positive- or negative-going MCs [default=0]");
+    struct arg_lit    *a_b = arg_litn("b","bits",0,1,"output packed bits (uint64) instead of int");
+    struct arg_lit    *a_e = arg_litn("e","events",0,1,"output event list (indices of MCs) instead of int");
     struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
     struct arg_lit *a_help = arg_litn("h","help",0,1,"display this help and exit");
     struct arg_end  *a_end = arg_end(5);
-    void *argtable[] = {a_fi, a_d, a_g, a_fo, a_help, a_end};
+    void *argtable[] = {a_fi, a_d, a_g, a_b, a_e, a_fo, a_help, a_end};
     if (arg_nullcheck(argtable)!=0) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating argtable" << endl; return 1; }
     nerrs = arg_parse(argc, argv, argtable);
     if (a_help->count>0)
@@ -118,6 +137,11 @@ int main(int argc, char *argv[])
     g = (a_g->count>0) ? a_g->ival[0] : 0;
     if (g!=0 && g!=1 && g!=-1) { cerr << progstr+": " << __LINE__ << errstr << "g must be in {-1,0,1}" << endl; return 1; }
 
+    //Get bits, ev
+    bits = (a_b->count>0);
+    ev = (a_e->count>0);
+    if (bits && ev) { cerr << progstr+": " << __LINE__ << errstr << "cannot use both -b and -e" << endl; return 1; }
+
 
     //Checks
     Lx = (dim==0u) ? i1.R : (dim==1u) ? i1.C : (dim==2u) ? i1.S : i1.H;
@@ -126,8 +150,46 @@ int main(int argc, char *argv[])
 
 
     //Set output header info
-    o1.F = i1.F; o1.T = 8u*sizeof(int);
-    o1.R = i1.R; o1.C = i1.C; o1.S = i1.S; o1.H = i1.H;
+    if (ev)
+    {
+        //The events are found here, since their number sets the output size
+        try { P = new uint64_t[(i1.N()/Lx)*((Lx+63u)/64u)]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for packed bits" << endl; return 1; }
+        if (i1.T==1u)
+        {
+            float *X;
+            try { X = new float[i1.N()]; }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+            try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+            if (codee::mcs_bits_s(P,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),dim,g))
+            { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+            delete[] X;
+        }
+        else if (i1.T==2u)
+        {
+            double *X;
+            try { X = new double[i1.N()]; }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+            try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+            if (codee::mcs_bits_d(P,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),dim,g))
+            { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+            delete[] X;
+        }
+        if (codee::bits2events_count(&E,P,i1.R,i1.C,i1.S,i1.H,dim))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        o1.F = i1.F; o1.T = 2u;
+        o1.R = 6u + E; o1.C = o1.S = o1.H = 1u;
+    }
+    else
+    {
+        o1.F = i1.F; o1.T = (bits) ? 8u*sizeof(uint64_t) : 8u*sizeof(int);
+        o1.R = (bits && dim==0u) ? (i1.R+63u)/64u : i1.R;
+        o1.C = (bits && dim==1u) ? (i1.C+63u)/64u : i1.C;
+        o1.S = (bits && dim==2u) ? (i1.S+63u)/64u : i1.S;
+        o1.H = (bits && dim==3u) ? (i1.H+63u)/64u : i1.H;
+    }
 
 
     //Open output
@@ -146,41 +208,71 @@ int main(int argc, char *argv[])
 
 
     //Process
-    if (i1.T==1)
+    if (ev)
     {
-        float *X; int *Y;
+        double *Y;
+        try { Y = new double[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        if (codee::bits2events(Y,P,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),dim))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] P; delete[] Y;
+    }
+    else if (i1.T==1)
+    {
+        float *X; int *Y = nullptr; uint64_t *B = nullptr;
         try { X = new float[i1.N()]; }
         catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
-        try { Y = new int[o1.N()]; }
+        try { if (bits) { B = new uint64_t[o1.N()]; } else { Y = new int[o1.N()]; } }
         catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
         try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
         catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
-        if (codee::mcs_s(Y,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),dim,g))
-        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (bits)
+        {
+            if (codee::mcs_bits_s(B,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),dim,g))
+            { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        }
+        else
+        {
+            if (codee::mcs_s(Y,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),dim,g))
+            { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        }
         if (wo1)
         {
-            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            try { ofs1.write((bits) ? reinterpret_cast<char*>(B) : reinterpret_cast<char*>(Y),o1.nbytes()); }
             catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
         }
-        delete[] X; delete[] Y;
+        delete[] X; delete[] Y; delete[] B;
     }
     else if (i1.T==2)
     {
-        double *X; int *Y;
+        double *X; int *Y = nullptr; uint64_t *B = nullptr;
         try { X = new double[i1.N()]; }
         catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
-        try { Y = new int[o1.N()]; }
+        try { if (bits) { B = new uint64_t[o1.N()]; } else { Y = new int[o1.N()]; } }
         catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
         try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
         catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
-        if (codee::mcs_d(Y,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),dim,g))
-        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (bits)
+        {
+            if (codee::mcs_bits_d(B,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),dim,g))
+            { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        }
+        else
+        {
+            if (codee::mcs_d(Y,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),dim,g))
+            { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        }
         if (wo1)
         {
-            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            try { ofs1.write((bits) ? reinterpret_cast<char*>(B) : reinterpret_cast<char*>(Y),o1.nbytes()); }
             catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
         }
-        delete[] X; delete[] Y;
+        delete[] X; delete[] Y; delete[] B;
     }
     else
     {
@@ -191,4 +283,3 @@ int main(int argc, char *argv[])
     //Exit
     return ret;
 }
-
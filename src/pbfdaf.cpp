@@ -0,0 +1,259 @@
+//@author Erik Edwards
+//@date 2018-present
+//@license BSD 3-clause
+
+
+#include <iostream>
+#include <fstream>
+#include <unistd.h>
+#include <string>
+#include <cstring>
+#include <valarray>
+#include <unordered_map>
+#include <argtable2.h>
+#include "cmli.hpp"
+#include <cfloat>
+#include "pbfdaf.c"
+
+#ifdef I
+#undef I
+#endif
+
+
+int main(int argc, char *argv[])
+{
+    using namespace std;
+
+
+    //Declarations
+    int ret = 0;
+    const string errstr = ": \033[1;31merror:\033[0m ";
+    const string warstr = ": \033[1;35mwarning:\033[0m ";
+    const string progstr(__FILE__,string(__FILE__).find_last_of("/")+1,strlen(__FILE__)-string(__FILE__).find_last_of("/")-5);
+    const valarray<size_t> oktypes = {1u,2u};
+    const size_t I = 2u, O = 2u;
+    ifstream ifs1, ifs2; ofstream ofs1, ofs2;
+    int8_t stdi1, stdi2, stdo1, stdo2, wo1, wo2;
+    ioinfo i1, i2, o1, o2;
+    size_t Q, Lb;
+    double mu, delta;
+
+
+    //Description
+    string descr;
+    descr += "Partitioned-block frequency-domain adaptive filter (PBFDAF or MDF),\n";
+    descr += "with NLMS step-size normalization in each frequency bin.\n";
+    descr += "This is the usual adaptive filter for acoustic echo cancellation.\n";
+    descr += "\n";
+    descr += "X is the far-end reference signal, and D is the near-end (mic) signal.\n";
+    descr += "The adaptive FIR filter W (length Q+1) models the echo path from X to D,\n";
+    descr += "and the error E = D - W*X is the echo-cancelled output.\n";
+    descr += "\n";
+    descr += "W is split into partitions of length Lb (the block size),\n";
+    descr += "so the cost per sample is O(log Lb) + O((Q+1)/Lb), instead of O(Q).\n";
+    descr += "The latency is Lb samples.\n";
+    descr += "\n";
+    descr += "Use -l (--L) to give the filter length Q+1 [default=1024].\n";
+    descr += "\n";
+    descr += "Use -b (--blocksize) to give the block (partition) length [default=256].\n";
+    descr += "\n";
+    descr += "Use -m (--mu) to give the step size in (0 1] [default=0.5].\n";
+    descr += "Smaller mu adapts slower, but is more robust to near-end talk.\n";
+    descr += "\n";
+    descr += "Use -r (--delta) to give the regularization (in units of signal power) [default=1e-6].\n";
+    descr += "\n";
+    descr += "The 1st output is E (same size as D),\n";
+    descr += "and the 2nd output is the final filter W (a vector of length Q+1).\n";
+    descr += "\n";
+    descr += "Examples:\n";
+    descr += "$ pbfdaf X D -o E -o W \n";
+    descr += "$ pbfdaf -l4096 -b512 -m0.3 X D -o E -o W \n";
+    descr += "$ cat D | pbfdaf X - > E \n";
+
+
+    //Argtable
+    int nerrs;
+    struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input files (X,D)");
+    struct arg_int    *a_l = arg_intn("l","L","<uint>",0,1,"filter length (Q+1) [default=1024]");
+    struct arg_int    *a_b = arg_intn("b","blocksize","<uint>",0,1,"block size (partition length) [default=256]");
+    struct arg_dbl    *a_m = arg_dbln("m","mu","<dbl>",0,1,"step size [default=0.5]");
+    struct arg_dbl    *a_r = arg_dbln("r","delta","<dbl>",0,1,"regularization [default=1e-6]");
+    struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output files (E,W)");
+    struct arg_lit *a_help = arg_litn("h","help",0,1,"display this help and exit");
+    struct arg_end  *a_end = arg_end(5);
+    void *argtable[] = {a_fi, a_l, a_b, a_m, a_r, a_fo, a_help, a_end};
+    if (arg_nullcheck(argtable)!=0) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating argtable" << endl; return 1; }
+    nerrs = arg_parse(argc, argv, argtable);
+    if (a_help->count>0)
+    {
+        cout << "Usage: " << progstr; arg_print_syntax(stdout, argtable, "\n");
+        cout << endl; arg_print_glossary(stdout, argtable, "  %-25s %s\n");
+        cout << endl << descr; return 1;
+    }
+    if (nerrs>0) { arg_print_errors(stderr,a_end,(progstr+": "+to_string(__LINE__)+errstr).c_str()); return 1; }
+
+
+    //Check stdin
+    stdi1 = (a_fi->count==0 || strlen(a_fi->filename[0])==0u || strcmp(a_fi->filename[0],"-")==0);
+    stdi2 = (a_fi->count<=1 || strlen(a_fi->filename[1])==0u || strcmp(a_fi->filename[1],"-")==0);
+    if (stdi1+stdi2>1) { cerr << progstr+": " << __LINE__ << errstr << "can only use stdin for one input" << endl; return 1; }
+    if (stdi1+stdi2>0 && isatty(fileno(stdin))) { cerr << progstr+": " << __LINE__ << errstr << "no stdin detected" << endl; return 1; }
+
+
+    //Check stdout
+    if (a_fo->count>0) { stdo1 = (strlen(a_fo->filename[0])==0u || strcmp(a_fo->filename[0],"-")==0); }
+    else { stdo1 = (!isatty(fileno(stdout))); }
+    if (a_fo->count>1) { stdo2 = (strlen(a_fo->filename[1])==0u || strcmp(a_fo->filename[1],"-")==0); }
+    else { stdo2 = (!isatty(fileno(stdout)) && a_fo->count==1 && stdo1==0); }
+    if (stdo1+stdo2>1) { cerr << progstr+": " << __LINE__ << errstr << "can only use stdout for one output" << endl; return 1; }
+    wo1 = (stdo1 || a_fo->count>0); wo2 = (stdo2 || a_fo->count>1);
+
+
+    //Open inputs
+    if (stdi1) { ifs1.copyfmt(cin); ifs1.basic_ios<char>::rdbuf(cin.rdbuf()); } else { ifs1.open(a_fi->filename[0]); }
+    if (!ifs1) { cerr << progstr+": " << __LINE__ << errstr << "problem opening input file 1" << endl; return 1; }
+    if (stdi2) { ifs2.copyfmt(cin); ifs2.basic_ios<char>::rdbuf(cin.rdbuf()); } else { ifs2.open(a_fi->filename[1]); }
+    if (!ifs2) { cerr << progstr+": " << __LINE__ << errstr << "problem opening input file 2" << endl; return 1; }
+
+
+    //Read input headers
+    if (!read_input_header(ifs1,i1)) { cerr << progstr+": " << __LINE__ << errstr << "problem reading header for input file 1" << endl; return 1; }
+    if (!read_input_header(ifs2,i2)) { cerr << progstr+": " << __LINE__ << errstr << "problem reading header for input file 2" << endl; return 1; }
+    if ((i1.T==oktypes).sum()==0 || (i2.T==oktypes).sum()==0)
+    {
+        cerr << progstr+": " << __LINE__ << errstr << "input data type must be in " << "{";
+        for (auto o : oktypes) { cerr << int(o) << ((o==oktypes[oktypes.size()-1u]) ? "}" : ","); }
+        cerr << endl; return 1;
+    }
+
+
+    //Get options
+
+    //Get Q
+    if (a_l->count==0) { Q = 1023u; }
+    else if (a_l->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "L (filter length) must be positive" << endl; return 1; }
+    else { Q = size_t(a_l->ival[0]) - 1u; }
+
+    //Get Lb
+    if (a_b->count==0) { Lb = 256u; }
+    else if (a_b->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "blocksize must be positive" << endl; return 1; }
+    else { Lb = size_t(a_b->ival[0]); }
+
+    //Get mu
+    if (a_m->count==0) { mu = 0.5; }
+    else if (a_m->dval[0]<DBL_EPSILON) { cerr << progstr+": " << __LINE__ << errstr << "mu (step size) must be positive" << endl; return 1; }
+    else { mu = a_m->dval[0]; }
+
+    //Get delta
+    if (a_r->count==0) { delta = 1e-6; }
+    else if (a_r->dval[0]<0.0) { cerr << progstr+": " << __LINE__ << errstr << "delta (regularization) must be nonnegative" << endl; return 1; }
+    else { delta = a_r->dval[0]; }
+
+
+    //Checks
+    if (i1.T!=i2.T) { cerr << progstr+": " << __LINE__ << errstr << "inputs must have the same data type" << endl; return 1; }
+    if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) found to be empty" << endl; return 1; }
+    if (i2.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (D) found to be empty" << endl; return 1; }
+    if (!i1.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) must be a vector" << endl; return 1; }
+    if (!i2.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (D) must be a vector" << endl; return 1; }
+    if (i1.N()!=i2.N()) { cerr << progstr+": " << __LINE__ << errstr << "inputs 1 and 2 (X and D) must have the same length" << endl; return 1; }
+
+
+    //Set output header infos
+    o1.F = o2.F = i2.F;
+    o1.T = o2.T = i2.T;
+    o1.R = i2.R; o1.C = i2.C; o1.S = i2.S; o1.H = i2.H;
+    o2.R = (i2.isrowvec()) ? 1u : Q+1u;
+    o2.C = (i2.isrowvec()) ? Q+1u : 1u;
+    o2.S = o2.H = 1u;
+
+
+    //Open outputs
+    if (wo1)
+    {
+        if (stdo1) { ofs1.copyfmt(cout); ofs1.basic_ios<char>::rdbuf(cout.rdbuf()); } else { ofs1.open(a_fo->filename[0]); }
+        if (!ofs1) { cerr << progstr+": " << __LINE__ << errstr << "problem opening output file 1" << endl; return 1; }
+    }
+    if (wo2)
+    {
+        if (stdo2) { ofs2.copyfmt(cout); ofs2.basic_ios<char>::rdbuf(cout.rdbuf()); } else { ofs2.open(a_fo->filename[1]); }
+        if (!ofs2) { cerr << progstr+": " << __LINE__ << errstr << "problem opening output file 2" << endl; return 1; }
+    }
+
+
+    //Write output headers
+    if (wo1 && !write_output_header(ofs1,o1)) { cerr << progstr+": " << __LINE__ << errstr << "problem writing header for output file 1" << endl; return 1; }
+    if (wo2 && !write_output_header(ofs2,o2)) { cerr << progstr+": " << __LINE__ << errstr << "problem writing header for output file 2" << endl; return 1; }
+
+
+    //Other prep
+    
+
+    //Process
+    if (i1.T==1u)
+    {
+        float *X, *D, *E, *W;
+        try { X = new float[i1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+        try { D = new float[i2.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (D)" << endl; return 1; }
+        try { E = new float[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file 1 (E)" << endl; return 1; }
+        try { W = new float[o2.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file 2 (W)" << endl; return 1; }
+        try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+        try { ifs2.read(reinterpret_cast<char*>(D),i2.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (D)" << endl; return 1; }
+        if (codee::pbfdaf_s(E,W,X,D,nullptr,i1.N(),Q,Lb,float(mu),float(delta)))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(E),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file 1 (E)" << endl; return 1; }
+        }
+        if (wo2)
+        {
+            try { ofs2.write(reinterpret_cast<char*>(W),o2.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file 2 (W)" << endl; return 1; }
+        }
+        delete[] X; delete[] D; delete[] E; delete[] W;
+    }
+    else if (i1.T==2)
+    {
+        double *X, *D, *E, *W;
+        try { X = new double[i1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+        try { D = new double[i2.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (D)" << endl; return 1; }
+        try { E = new double[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file 1 (E)" << endl; return 1; }
+        try { W = new double[o2.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file 2 (W)" << endl; return 1; }
+        try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+        try { ifs2.read(reinterpret_cast<char*>(D),i2.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (D)" << endl; return 1; }
+        if (codee::pbfdaf_d(E,W,X,D,nullptr,i1.N(),Q,Lb,double(mu),double(delta)))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(E),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file 1 (E)" << endl; return 1; }
+        }
+        if (wo2)
+        {
+            try { ofs2.write(reinterpret_cast<char*>(W),o2.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file 2 (W)" << endl; return 1; }
+        }
+        delete[] X; delete[] D; delete[] E; delete[] W;
+    }
+    else
+    {
+        cerr << progstr+": " << __LINE__ << errstr << "data type not supported" << endl; return 1;
+    }
+    
+
+    //Exit
+    return ret;
+}
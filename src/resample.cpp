@@ -0,0 +1,275 @@
+//@author Erik Edwards
+//@date 2018-present
+//@license BSD 3-clause
+
+
+#include <iostream>
+#include <fstream>
+#include <unistd.h>
+#include <string>
+#include <cstring>
+#include <valarray>
+#include <unordered_map>
+#include <argtable2.h>
+#include "cmli.hpp"
+#include "resample.c"
+
+#ifdef I
+#undef I
+#endif
+
+
+int main(int argc, char *argv[])
+{
+    using namespace std;
+
+
+    //Declarations
+    int ret = 0;
+    const string errstr = ": \033[1;31merror:\033[0m ";
+    const string warstr = ": \033[1;35mwarning:\033[0m ";
+    const string progstr(__FILE__,string(__FILE__).find_last_of("/")+1,strlen(__FILE__)-string(__FILE__).find_last_of("/")-5);
+    const valarray<size_t> oktypes = {1u,2u,101u,102u};
+    const size_t I = 1u, O = 1u;
+    ifstream ifs1; ofstream ofs1;
+    int8_t stdi1, stdo1, wo1;
+    ioinfo i1, o1;
+    size_t dim, p, q, Nz, Lx, Ly, Lb, g;
+    double beta;
+
+
+    //Description
+    string descr;
+    descr += "Resamples each vector in X by the rational factor p/q,\n";
+    descr += "using a polyphase FIR filter (like resample_poly in SciPy).\n";
+    descr += "Only the kept output samples are computed.\n";
+    descr += "\n";
+    descr += "The filter is a Kaiser-windowed sinc lowpass, with cutoff at the\n";
+    descr += "lower of the input and output Nyquist frequencies.\n";
+    descr += "The filter delay is compensated, so the output is aligned with X.\n";
+    descr += "\n";
+    descr += "Use -p (--up) to give the upsample factor [default=1].\n";
+    descr += "Use -q (--down) to give the downsample factor [default=1].\n";
+    descr += "These are divided by their gcd (so -p16000 -q44100 is p=160, q=441).\n";
+    descr += "\n";
+    descr += "Use -n (--nzc) to give the number of zero-crossings of the sinc\n";
+    descr += "on each side of the filter center (the quality) [default=10].\n";
+    descr += "The filter length is 2*n*max(p,q)+1 (after division by gcd).\n";
+    descr += "\n";
+    descr += "Use -b (--beta) to give the Kaiser window parameter [default=5.0].\n";
+    descr += "\n";
+    descr += "Use -d (--dim) to give the dimension along which to resample.\n";
+    descr += "Default is 0 (along cols), unless X is a row vector.\n";
+    descr += "\n";
+    descr += "The length of each vector in Y is Ly = ceil(L*p/q).\n";
+    descr += "If dim==0, then Y has size Ly x C x S x H.\n";
+    descr += "If dim==1, then Y has size R x Ly x S x H.\n";
+    descr += "If dim==2, then Y has size R x C x Ly x H.\n";
+    descr += "If dim==3, then Y has size R x C x S x Ly.\n";
+    descr += "\n";
+    descr += "Examples:\n";
+    descr += "$ resample -p16000 -q44100 X -o Y \n";
+    descr += "$ resample -d1 -p1 -q3 X > Y \n";
+    descr += "$ cat X | resample -p3 -q2 -n20 -b8 > Y \n";
+
+
+    //Argtable
+    int nerrs;
+    struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input file (X)");
+    struct arg_int    *a_p = arg_intn("p","up","<uint>",0,1,"upsample factor [default=1]");
+    struct arg_int    *a_q = arg_intn("q","down","<uint>",0,1,"downsample factor [default=1]");
+    struct arg_int    *a_n = arg_intn("n","nzc","<uint>",0,1,"num zero-crossings on each side [default=10]");
+    struct arg_dbl    *a_b = arg_dbln("b","beta","<dbl>",0,1,"Kaiser window parameter [default=5.0]");
+    struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"dimension along which to resample [default=0]");
+    struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+    struct arg_lit *a_help = arg_litn("h","help",0,1,"display this help and exit");
+    struct arg_end  *a_end = arg_end(5);
+    void *argtable[] = {a_fi, a_p, a_q, a_n, a_b, a_d, a_fo, a_help, a_end};
+    if (arg_nullcheck(argtable)!=0) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating argtable" << endl; return 1; }
+    nerrs = arg_parse(argc, argv, argtable);
+    if (a_help->count>0)
+    {
+        cout << "Usage: " << progstr; arg_print_syntax(stdout, argtable, "\n");
+        cout << endl; arg_print_glossary(stdout, argtable, "  %-25s %s\n");
+        cout << endl << descr; return 1;
+    }
+    if (nerrs>0) { arg_print_errors(stderr,a_end,(progstr+": "+to_string(__LINE__)+errstr).c_str()); return 1; }
+
+
+    //Check stdin
+    stdi1 = (a_fi->count==0 || strlen(a_fi->filename[0])==0u || strcmp(a_fi->filename[0],"-")==0);
+    if (stdi1>0 && isatty(fileno(stdin))) { cerr << progstr+": " << __LINE__ << errstr << "no stdin detected" << endl; return 1; }
+
+
+    //Check stdout
+    if (a_fo->count>0) { stdo1 = (strlen(a_fo->filename[0])==0u || strcmp(a_fo->filename[0],"-")==0); }
+    else { stdo1 = (!isatty(fileno(stdout))); }
+    wo1 = (stdo1 || a_fo->count>0);
+
+
+    //Open input
+    if (stdi1) { ifs1.copyfmt(cin); ifs1.basic_ios<char>::rdbuf(cin.rdbuf()); } else { ifs1.open(a_fi->filename[0]); }
+    if (!ifs1) { cerr << progstr+": " << __LINE__ << errstr << "problem opening input file" << endl; return 1; }
+
+
+    //Read input header
+    if (!read_input_header(ifs1,i1)) { cerr << progstr+": " << __LINE__ << errstr << "problem reading header for input file" << endl; return 1; }
+    if ((i1.T==oktypes).sum()==0)
+    {
+        cerr << progstr+": " << __LINE__ << errstr << "input data type must be in " << "{";
+        for (auto o : oktypes) { cerr << int(o) << ((o==oktypes[oktypes.size()-1u]) ? "}" : ","); }
+        cerr << endl; return 1;
+    }
+
+
+    //Get options
+
+    //Get dim
+    if (a_d->count==0) { dim = i1.isrowvec() ? 1u : 0u; }
+    else if (a_d->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "dim must be nonnegative" << endl; return 1; }
+    else { dim = size_t(a_d->ival[0]); }
+    if (dim>3u) { cerr << progstr+": " << __LINE__ << errstr << "dim must be in {0,1,2,3}" << endl; return 1; }
+
+    //Get p
+    if (a_p->count==0) { p = 1u; }
+    else if (a_p->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "p (upsample factor) must be positive" << endl; return 1; }
+    else { p = size_t(a_p->ival[0]); }
+
+    //Get q
+    if (a_q->count==0) { q = 1u; }
+    else if (a_q->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "q (downsample factor) must be positive" << endl; return 1; }
+    else { q = size_t(a_q->ival[0]); }
+
+    //Get Nz
+    if (a_n->count==0) { Nz = 10u; }
+    else if (a_n->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "n (num zero-crossings) must be positive" << endl; return 1; }
+    else { Nz = size_t(a_n->ival[0]); }
+
+    //Get beta
+    beta = (a_b->count>0) ? a_b->dval[0] : 5.0;
+    if (beta<0.0) { cerr << progstr+": " << __LINE__ << errstr << "beta must be nonnegative" << endl; return 1; }
+
+
+    //Checks
+    Lx = (dim==0u) ? i1.R : (dim==1u) ? i1.C : (dim==2u) ? i1.S : i1.H;
+    if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) found to be empty" << endl; return 1; }
+    if (Lx<2u) { cerr << progstr+": " << __LINE__ << errstr << "cannot work along a singleton dimension" << endl; return 1; }
+
+
+    //Set output header info
+    g = p; for (size_t r=q, t; r>0u; ) { t = g%r; g = r; r = t; }
+    p /= g; q /= g;
+    Ly = (Lx*p+q-1u) / q;
+    o1.F = i1.F; o1.T = i1.T;
+    o1.R = (dim==0u) ? Ly : i1.R;
+    o1.C = (dim==1u) ? Ly : i1.C;
+    o1.S = (dim==2u) ? Ly : i1.S;
+    o1.H = (dim==3u) ? Ly : i1.H;
+
+
+    //Open output
+    if (wo1)
+    {
+        if (stdo1) { ofs1.copyfmt(cout); ofs1.basic_ios<char>::rdbuf(cout.rdbuf()); } else { ofs1.open(a_fo->filename[0]); }
+        if (!ofs1) { cerr << progstr+": " << __LINE__ << errstr << "problem opening output file 1" << endl; return 1; }
+    }
+
+
+    //Write output header
+    if (wo1 && !write_output_header(ofs1,o1)) { cerr << progstr+": " << __LINE__ << errstr << "problem writing header for output file 1" << endl; return 1; }
+
+
+    //Other prep
+    Lb = 2u*Nz*((p>q) ? p : q) + 1u;
+    
+
+    //Process
+    if (i1.T==1u)
+    {
+        float *X, *B, *Y;
+        try { X = new float[i1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+        try { B = new float[Lb]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for filter (B)" << endl; return 1; }
+        try { Y = new float[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+        if (codee::resample_design_s(B,p,q,Nz,float(beta))) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (codee::resample_s(Y,X,B,nullptr,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Lb,p,q,dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] B; delete[] Y;
+    }
+    else if (i1.T==2)
+    {
+        double *X, *B, *Y;
+        try { X = new double[i1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+        try { B = new double[Lb]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for filter (B)" << endl; return 1; }
+        try { Y = new double[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+        if (codee::resample_design_d(B,p,q,Nz,double(beta))) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (codee::resample_d(Y,X,B,nullptr,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Lb,p,q,dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] B; delete[] Y;
+    }
+    else if (i1.T==101u)
+    {
+        float *X, *B, *Y;
+        try { X = new float[2u*i1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+        try { B = new float[Lb]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for filter (B)" << endl; return 1; }
+        try { Y = new float[2u*o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+        if (codee::resample_design_s(B,p,q,Nz,float(beta))) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (codee::resample_c(Y,X,B,nullptr,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Lb,p,q,dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] B; delete[] Y;
+    }
+    else if (i1.T==102u)
+    {
+        double *X, *B, *Y;
+        try { X = new double[2u*i1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+        try { B = new double[Lb]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for filter (B)" << endl; return 1; }
+        try { Y = new double[2u*o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+        if (codee::resample_design_d(B,p,q,Nz,double(beta))) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (codee::resample_z(Y,X,B,nullptr,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Lb,p,q,dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] X; delete[] B; delete[] Y;
+    }
+    else
+    {
+        cerr << progstr+": " << __LINE__ << errstr << "data type not supported" << endl; return 1;
+    }
+    
+
+    //Exit
+    return ret;
+}
@@ -36,6 +36,7 @@ int main(int argc, char *argv[])
     int8_t stdo1, wo1;
     ioinfo o1;
     size_t N, dim, samp;
+    int ev;
 
 
     //Description
@@ -54,6 +55,10 @@ int main(int argc, char *argv[])
     descr += "\n";
     descr += "Use -s (--samp) to give the sample number of the impulse [default=0].\n";
     descr += "\n";
+    descr += "Include -e (--events) to output an event list instead (see densify),\n";
+    descr += "which has a 6-element header, and then the index of the impulse.\n";
+    descr += "Y is then a column vector of doubles (and -t is only used by densify).\n";
+    descr += "\n";
     descr += "Since this is a generating function (no inputs), the output data type\n";
     descr += "and file format can be specified by -t and -f, respectively. \n";
     descr += "\n";
@@ -61,6 +66,7 @@ int main(int argc, char *argv[])
     descr += "$ unit_impulse -n32 -o Y \n";
     descr += "$ unit_impulse -n32 -s9 > Y \n";
     descr += "$ unit_impulse -n32 -s1 -d1 -t1 -f101 > Y \n";
+    descr += "$ unit_impulse -n32 -s9 -e > Y \n";
 
 
     //Argtable
@@ -70,10 +76,11 @@ int main(int argc, char *argv[])
     struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"nonsingleton dimension [default=0 -> col vec]");
     struct arg_int *a_otyp = arg_intn("t","type","<uint>",0,1,"output data type [default=1]");
     struct arg_int *a_ofmt = arg_intn("f","fmt","<uint>",0,1,"output file format [default=147]");
+    struct arg_lit    *a_e = arg_litn("e","events",0,1,"output event list instead of signal");
     struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
     struct arg_lit *a_help = arg_litn("h","help",0,1,"display this help and exit");
     struct arg_end  *a_end = arg_end(5);
-    void *argtable[] = {a_s, a_n, a_d, a_otyp, a_ofmt, a_fo, a_help, a_end};
+    void *argtable[] = {a_s, a_n, a_d, a_otyp, a_ofmt, a_e, a_fo, a_help, a_end};
     if (arg_nullcheck(argtable)!=0) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating argtable" << endl; return 1; }
     nerrs = arg_parse(argc, argv, argtable);
     if (a_help->count>0)
@@ -128,11 +135,16 @@ int main(int argc, char *argv[])
     if (samp>=N) { cerr << progstr+": " << __LINE__ << errstr << "samp must be < N" << endl; return 1; }
 
 
+    //Get ev
+    ev = (a_e->count>0);
+
+
     //Set output header info
     o1.R = (dim==0u) ? N : 1u;
     o1.C = (dim==1u) ? N : 1u;
     o1.S = (dim==2u) ? N : 1u;
     o1.H = (dim==3u) ? N : 1u;
+    if (ev) { o1.T = 2u; o1.R = 7u; o1.C = o1.S = o1.H = 1u; }
 
 
     //Open output
@@ -151,7 +163,21 @@ int main(int argc, char *argv[])
 
 
     //Process
-    if (o1.T==1u)
+    if (ev)
+    {
+        double *Y;
+        try { Y = new double[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        if (codee::unit_impulse_events(Y,(dim==0u)?N:1u,(dim==1u)?N:1u,(dim==2u)?N:1u,(dim==3u)?N:1u,samp))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+        delete[] Y;
+    }
+    else if (o1.T==1u)
     {
         float *Y;
         try { Y = new float[o1.N()]; }
@@ -0,0 +1,88 @@
+//Includes
+#include "fir_decim.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u};
+const size_t I = 1u, O = 1u;
+size_t dim, M, Lx, Ly;
+
+//Description
+string descr;
+descr += "Decimation of each vector in X by an integer factor M,\n";
+descr += "with an anti-aliasing lowpass filter (like decimate in Octave).\n";
+descr += "\n";
+descr += "For large M, this is done in multiple stages (each of factor <= 8),\n";
+descr += "each with a Hamming-windowed sinc lowpass filter (order 20 x stage factor).\n";
+descr += "Only the kept outputs of each stage are computed (polyphase decimator).\n";
+descr += "The delay of each stage is compensated, so Y is aligned with X.\n";
+descr += "\n";
+descr += "Use -m (--M) to give the decimation factor [default=2].\n";
+descr += "Each vector in Y has length Ly = ceil(L/M).\n";
+descr += "\n";
+descr += "Use -d (--dim) to give the dimension along which to decimate.\n";
+descr += "Default is 0 (along cols), unless X is a row vector.\n";
+descr += "\n";
+descr += "If dim==0, then Y has size Ly x C x S x H.\n";
+descr += "If dim==1, then Y has size R x Ly x S x H.\n";
+descr += "If dim==2, then Y has size R x C x Ly x H.\n";
+descr += "If dim==3, then Y has size R x C x S x Ly.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ decimate -m4 X -o Y \n";
+descr += "$ decimate -d1 -m60 X > Y \n";
+descr += "$ cat X | decimate -m10 > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input file (X)");
+struct arg_int    *a_m = arg_intn("m","M","<uint>",0,1,"decimation factor [default=2]");
+struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"dimension along which to decimate [default=0]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get dim
+if (a_d->count==0) { dim = i1.isrowvec() ? 1u : 0u; }
+else if (a_d->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "dim must be nonnegative" << endl; return 1; }
+else { dim = size_t(a_d->ival[0]); }
+if (dim>3u) { cerr << progstr+": " << __LINE__ << errstr << "dim must be in {0,1,2,3}" << endl; return 1; }
+
+//Get M
+if (a_m->count==0) { M = 2u; }
+else if (a_m->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "M (decimation factor) must be positive" << endl; return 1; }
+else { M = size_t(a_m->ival[0]); }
+
+//Checks
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) found to be empty" << endl; return 1; }
+
+//Set output header info
+Lx = (dim==0u) ? i1.R : (dim==1u) ? i1.C : (dim==2u) ? i1.S : i1.H;
+Ly = (Lx+M-1u) / M;
+o1.F = i1.F; o1.T = i1.T;
+o1.R = (dim==0u) ? Ly : i1.R;
+o1.C = (dim==1u) ? Ly : i1.C;
+o1.S = (dim==2u) ? Ly : i1.S;
+o1.H = (dim==3u) ? Ly : i1.H;
+
+//Other prep
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *Y;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+    if (codee::decimate_s(Y,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),M,dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] Y;
+}
+
+//Finish
+
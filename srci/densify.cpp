@@ -0,0 +1,92 @@
+//Includes
+#include "densify.c"
+
+//Declarations
+const valarray<size_t> oktypes = {2u};
+const size_t I = 1u, O = 1u;
+double *X;
+
+//Description
+string descr;
+descr += "Densifies an event list X, giving the full (dense) tensor Y.\n";
+descr += "Y has the event values at the event indices, and 0 elsewhere.\n";
+descr += "\n";
+descr += "This is for compatibility, since zcs, lcs, mcs, unit_impulse,\n";
+descr += "delta_impulse and rect_pulse can output event lists (with -e).\n";
+descr += "Y is then the same as those tools give without -e.\n";
+descr += "\n";
+descr += "X is a vector of doubles, with a 6-element header:\n";
+descr += "R, C, S, H (the size of Y), E (the number of events),\n";
+descr += "and 1 if values are included (or 0, then all values are 1).\n";
+descr += "Then come the E indices into Y, and then the E values (if included).\n";
+descr += "\n";
+descr += "Use -t (--type) to give the output data type [default=1].\n";
+descr += "Y has the same file format as X.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ densify X -o Y \n";
+descr += "$ zcs -e X | densify > Y \n";
+descr += "$ unit_impulse -n32 -s9 -e | densify -t2 > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input file (X)");
+struct arg_int *a_otyp = arg_intn("t","type","<uint>",0,1,"output data type [default=1]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get o1.T
+if (a_otyp->count==0) { o1.T = 1u; }
+else if (a_otyp->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "data type must be positive int" << endl; return 1; }
+else { o1.T = size_t(a_otyp->ival[0]); }
+if (o1.T!=1u && o1.T!=2u && o1.T!=101u && o1.T!=102u) { cerr << progstr+": " << __LINE__ << errstr << "output data type must be in {1,2,101,102}" << endl; return 1; }
+
+//Checks
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) found to be empty" << endl; return 1; }
+if (!i1.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) must be a vector" << endl; return 1; }
+if (i1.N()<6u) { cerr << progstr+": " << __LINE__ << errstr << "input (X) must have at least 6 elements (header)" << endl; return 1; }
+
+//Set output header info
+//X is read here, since its header sets the output size
+try { X = new double[i1.N()]; }
+catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+if (X[0]<1.0 || X[1]<1.0 || X[2]<1.0 || X[3]<1.0) { cerr << progstr+": " << __LINE__ << errstr << "input (X) has invalid header" << endl; return 1; }
+o1.F = i1.F;
+o1.R = size_t(X[0]); o1.C = size_t(X[1]); o1.S = size_t(X[2]); o1.H = size_t(X[3]);
+
+//Other prep
+
+//Process
+if (o1.T==1u)
+{
+    float *Y;
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    if (codee::densify_s(Y,X,i1.N()))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] Y;
+}
+else if (o1.T==101u)
+{
+    float *Y;
+    try { Y = new float[2u*o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    if (codee::densify_c(Y,X,i1.N()))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] Y;
+}
+
+//Finish
+
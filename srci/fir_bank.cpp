@@ -0,0 +1,112 @@
+//Includes
+#include "fir_bank.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u,101u,102u};
+const size_t I = 2u, O = 1u;
+size_t NB, Q, nfft;
+
+//Description
+string descr;
+descr += "FIR filterbank: causal FIR filter of vector (1D signal) X,\n";
+descr += "by each of the NB filters in matrix B.\n";
+descr += "This uses the overlap-save method with FFT blocks of length nfft,\n";
+descr += "with only one FFT of each input block shared by all NB filters,\n";
+descr += "so it is much faster than NB separate calls to fir_fft or fir_ola.\n";
+descr += "\n";
+descr += "Each filter has length Q+1 (Q is the filter order),\n";
+descr += "and is in reverse chronological order (usual convention).\n";
+descr += "This performs causal filtering only! \n";
+descr += "\n";
+descr += "For each filter b: \n";
+descr += "Y[b,t] = B[b,0]*X[t] + B[b,1]*X[t-1] + ... + B[b,Q]*X[t-Q]\n";
+descr += "\n";
+descr += "The coefficients of each filter must be contiguous in memory, so:\n";
+descr += "If row-major, then B has size NB x (Q+1), and Y has size NB x N.\n";
+descr += "If col-major, then B has size (Q+1) x NB, and Y has size N x NB.\n";
+descr += "\n";
+descr += "Use -n (--nfft) to give the FFT block length (must be > Q).\n";
+descr += "The default is chosen from Q and NB to minimize the cost per output sample.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ fir_bank X B -o Y \n";
+descr += "$ fir_bank -n4096 X B > Y \n";
+descr += "$ cat X | fir_bank - B > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input files (X,B)");
+struct arg_int    *a_n = arg_intn("n","nfft","<uint>",0,1,"FFT block length [default from Q and NB]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get nfft
+if (a_n->count==0) { nfft = 0u; }
+else if (a_n->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "nfft must be positive" << endl; return 1; }
+else { nfft = size_t(a_n->ival[0]); }
+
+//Checks
+if (i1.T!=i2.T) { cerr << progstr+": " << __LINE__ << errstr << "inputs must have the same data type" << endl; return 1; }
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) found to be empty" << endl; return 1; }
+if (i2.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (B) found to be empty" << endl; return 1; }
+if (!i1.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) must be a vector" << endl; return 1; }
+if (!i2.ismat()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (B) must be a matrix" << endl; return 1; }
+if (nfft>0u && nfft<((i2.isrowmajor()) ? i2.C : i2.R)) { cerr << progstr+": " << __LINE__ << errstr << "nfft must be > Q (length of filters minus 1)" << endl; return 1; }
+
+//Set output header info
+NB = (i2.isrowmajor()) ? i2.R : i2.C;
+Q = ((i2.isrowmajor()) ? i2.C : i2.R) - 1u;
+o1.F = i1.F; o1.T = i1.T;
+o1.R = (i1.isrowmajor()) ? NB : i1.N();
+o1.C = (i1.isrowmajor()) ? i1.N() : NB;
+o1.S = o1.H = 1u;
+
+//Other prep
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *B, *Y;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+    try { B = new float[i2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (B)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+    try { ifs2.read(reinterpret_cast<char*>(B),i2.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (B)" << endl; return 1; }
+    if (codee::fir_bank_s(Y,X,B,i1.N(),NB,Q,nfft))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; } 
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] B; delete[] Y;
+}
+else if (i1.T==101u)
+{
+    float *X, *B, *Y;
+    try { X = new float[2u*i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+    try { B = new float[2u*i2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (B)" << endl; return 1; }
+    try { Y = new float[2u*o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+    try { ifs2.read(reinterpret_cast<char*>(B),i2.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (B)" << endl; return 1; }
+    if (codee::fir_bank_c(Y,X,B,i1.N(),NB,Q,nfft))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; } 
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] B; delete[] Y;
+}
+
+//Finish
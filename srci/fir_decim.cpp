@@ -0,0 +1,102 @@
+//Includes
+#include "fir_decim.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u};
+const size_t I = 2u, O = 1u;
+size_t dim, Q, M, Lx, Ly;
+
+//Description
+string descr;
+descr += "FIR filter of each vector (1D signal) in X,\n";
+descr += "using FIR filter coefficients in vector B,\n";
+descr += "followed by decimation by M (keeping samples 0, M, 2M, ...).\n";
+descr += "Only the kept outputs are computed (polyphase decimator),\n";
+descr += "so this costs 1/M of fir (and the output is the same as fir then every M-th).\n";
+descr += "Each vector in Y has length Ly = ceil(L/M).\n";
+descr += "\n";
+descr += "B has length Q+1 (Q is the filter order). \n";
+descr += "B is in reverse chronological order (usual convention).\n";
+descr += "This performs causal filtering only! \n";
+descr += "\n";
+descr += "For a univariate signal X: \n";
+descr += "Y[t] = B[0]*X[t] + B[1]*X[t-1] + ... + B[Q]*X[t-Q]\n";
+descr += "\n";
+descr += "Use -d (--dim) to give the dimension (axis) along which to filter.\n";
+descr += "Use -d0 to operate along cols, -d1 to operate along rows, etc.\n";
+descr += "The default is 0 (along cols), unless X is a row vector.\n";
+descr += "\n";
+descr += "Use -m (--M) to give the decimation factor [default=2].\n";
+descr += "\n";
+descr += "If dim==0, then Y has size Ly x C x S x H.\n";
+descr += "If dim==1, then Y has size R x Ly x S x H.\n";
+descr += "If dim==2, then Y has size R x C x Ly x H.\n";
+descr += "If dim==3, then Y has size R x C x S x Ly.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ fir_decim -m4 X B -o Y \n";
+descr += "$ fir_decim -d1 -m3 X B > Y \n";
+descr += "$ cat X | fir_decim -m2 - B > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input files (X,B)");
+struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"dimension along which to filter [default=0]");
+struct arg_int    *a_m = arg_intn("m","M","<uint>",0,1,"decimation factor [default=2]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get dim
+if (a_d->count==0) { dim = i1.isvec() ? i1.nonsingleton1() : 0u; }
+else if (a_d->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "dim must be nonnegative" << endl; return 1; }
+else { dim = size_t(a_d->ival[0]); }
+if (dim>3u) { cerr << progstr+": " << __LINE__ << errstr << "dim must be in {0,1,2,3}" << endl; return 1; }
+
+//Get M
+if (a_m->count==0) { M = 2u; }
+else if (a_m->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "M (decimation factor) must be positive" << endl; return 1; }
+else { M = size_t(a_m->ival[0]); }
+
+//Checks
+if (i1.T!=i2.T) { cerr << progstr+": " << __LINE__ << errstr << "inputs must have the same data type" << endl; return 1; }
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) found to be empty" << endl; return 1; }
+if (i2.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (B) found to be empty" << endl; return 1; }
+if (!i2.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (B) must be a vector" << endl; return 1; }
+
+//Set output header info
+Lx = (dim==0u) ? i1.R : (dim==1u) ? i1.C : (dim==2u) ? i1.S : i1.H;
+Ly = (Lx+M-1u) / M;
+o1.F = i1.F; o1.T = i1.T;
+o1.R = (dim==0u) ? Ly : i1.R;
+o1.C = (dim==1u) ? Ly : i1.C;
+o1.S = (dim==2u) ? Ly : i1.S;
+o1.H = (dim==3u) ? Ly : i1.H;
+
+//Other prep
+Q = i2.N() - 1u;
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *B, *Y;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+    try { B = new float[i2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (B)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+    try { ifs2.read(reinterpret_cast<char*>(B),i2.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (B)" << endl; return 1; }
+    if (codee::fir_decim_s(Y,X,B,nullptr,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Q,M,dim))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; } 
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] B; delete[] Y;
+}
+
+//Finish
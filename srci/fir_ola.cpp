@@ -0,0 +1,114 @@
+//Includes
+#include "fir_ola.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u,101u,102u};
+const size_t I = 2u, O = 1u;
+size_t dim, Q, nfft;
+
+//Description
+string descr;
+descr += "FIR filter of each vector (1D signal) in X,\n";
+descr += "using FIR filter coefficients in vector B. \n";
+descr += "This uses the overlap-save method with FFT blocks of length nfft,\n";
+descr += "so memory is O(nfft) and the FFT of B is computed only once.\n";
+descr += "\n";
+descr += "B has length Q+1 (Q is the filter order). \n";
+descr += "B is in reverse chronological order (usual convention).\n";
+descr += "This performs causal filtering only! \n";
+descr += "\n";
+descr += "For a univariate signal X: \n";
+descr += "Y[t] = B[0]*X[t] + B[1]*X[t-1] + ... + B[Q]*X[t-Q]\n";
+descr += "\n";
+descr += "Use -d (--dim) to give the dimension (axis) along which to filter.\n";
+descr += "Use -d0 to operate along cols, -d1 to operate along rows, etc.\n";
+descr += "The default is 0 (along cols), unless X is a row vector.\n";
+descr += "\n";
+descr += "Use -n (--nfft) to give the FFT block length (must be > Q).\n";
+descr += "The default is chosen from Q to minimize the cost per output sample.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ fir_ola X B -o Y \n";
+descr += "$ fir_ola -d1 -n4096 X B > Y \n";
+descr += "$ cat X | fir_ola - B > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input files (X,B)");
+struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"dimension along which to filter [default=0]");
+struct arg_int    *a_n = arg_intn("n","nfft","<uint>",0,1,"FFT block length [default from Q]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get dim
+if (a_d->count==0) { dim = i1.isvec() ? i1.nonsingleton1() : 0u; }
+else if (a_d->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "dim must be nonnegative" << endl; return 1; }
+else { dim = size_t(a_d->ival[0]); }
+if (dim>3u) { cerr << progstr+": " << __LINE__ << errstr << "dim must be in {0,1,2,3}" << endl; return 1; }
+
+//Get nfft
+if (a_n->count==0) { nfft = 0u; }
+else if (a_n->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "nfft must be positive" << endl; return 1; }
+else { nfft = size_t(a_n->ival[0]); }
+
+//Checks
+if (i1.T!=i2.T) { cerr << progstr+": " << __LINE__ << errstr << "inputs must have the same data type" << endl; return 1; }
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) found to be empty" << endl; return 1; }
+if (i2.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (B) found to be empty" << endl; return 1; }
+if (!i2.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (B) must be a vector" << endl; return 1; }
+if (nfft>0u && nfft<i2.N()) { cerr << progstr+": " << __LINE__ << errstr << "nfft must be > Q (length of B minus 1)" << endl; return 1; }
+
+//Set output header info
+o1.F = i1.F; o1.T = i1.T;
+o1.R = i1.R; o1.C = i1.C; o1.S = i1.S; o1.H = i1.H;
+
+//Other prep
+Q = i2.N() - 1u;
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *B, *Y;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+    try { B = new float[i2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (B)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+    try { ifs2.read(reinterpret_cast<char*>(B),i2.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (B)" << endl; return 1; }
+    if (codee::fir_ola_s(Y,X,B,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Q,nfft,dim))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; } 
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] B; delete[] Y;
+}
+else if (i1.T==101u)
+{
+    float *X, *B, *Y;
+    try { X = new float[2u*i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+    try { B = new float[2u*i2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (B)" << endl; return 1; }
+    try { Y = new float[2u*o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+    try { ifs2.read(reinterpret_cast<char*>(B),i2.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (B)" << endl; return 1; }
+    if (codee::fir_ola_c(Y,X,B,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Q,nfft,dim))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; } 
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] B; delete[] Y;
+}
+
+//Finish
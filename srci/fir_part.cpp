@@ -0,0 +1,134 @@
+//Includes
+#include "fir_part.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u};
+const size_t I = 2u, O = 1u;
+size_t dim, Lx, Q, Lb, P, Lc;
+
+//Description
+string descr;
+descr += "FIR filter of each vector (1D signal) in X,\n";
+descr += "using FIR filter coefficients in vector B. \n";
+descr += "This uses uniformly-partitioned convolution: B is split into\n";
+descr += "partitions of length Lb (the block size), and the spectrum of each\n";
+descr += "input block is kept in a frequency-domain delay line (FDL).\n";
+descr += "This is meant for long filters (e.g., room impulse responses),\n";
+descr += "where the latency is only one block (Lb samples).\n";
+descr += "\n";
+descr += "B has length Q+1 (Q is the filter order). \n";
+descr += "B is in reverse chronological order (usual convention).\n";
+descr += "This performs causal filtering only! \n";
+descr += "\n";
+descr += "For a univariate signal X: \n";
+descr += "Y[t] = B[0]*X[t] + B[1]*X[t-1] + ... + B[Q]*X[t-Q]\n";
+descr += "\n";
+descr += "Use -d (--dim) to give the dimension (axis) along which to filter.\n";
+descr += "Use -d0 to operate along cols, -d1 to operate along rows, etc.\n";
+descr += "The default is 0 (along cols), unless X is a row vector.\n";
+descr += "\n";
+descr += "Use -b (--blocksize) to give the block size Lb [default=256].\n";
+descr += "The FFTs have length 2*Lb, and there are ceil((Q+1)/Lb) partitions.\n";
+descr += "\n";
+descr += "If X is a vector, it is streamed through in blocks (of about 4096 samps),\n";
+descr += "so that output is written as input arrives (e.g., from a pipe),\n";
+descr += "and memory use does not grow with the length of X.\n";
+descr += "Otherwise, X is read in full before filtering.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ fir_part X B -o Y \n";
+descr += "$ fir_part -d1 -b64 X B > Y \n";
+descr += "$ cat X | fir_part - B > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input files (X,B)");
+struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"dimension along which to filter [default=0]");
+struct arg_int    *a_b = arg_intn("b","blocksize","<uint>",0,1,"block size (partition length) [default=256]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get dim
+if (a_d->count==0) { dim = i1.isvec() ? i1.nonsingleton1() : 0u; }
+else if (a_d->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "dim must be nonnegative" << endl; return 1; }
+else { dim = size_t(a_d->ival[0]); }
+if (dim>3u) { cerr << progstr+": " << __LINE__ << errstr << "dim must be in {0,1,2,3}" << endl; return 1; }
+
+//Get Lb
+if (a_b->count==0) { Lb = 256u; }
+else if (a_b->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "blocksize must be positive" << endl; return 1; }
+else { Lb = size_t(a_b->ival[0]); }
+
+//Checks
+if (i1.T!=i2.T) { cerr << progstr+": " << __LINE__ << errstr << "inputs must have the same data type" << endl; return 1; }
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) found to be empty" << endl; return 1; }
+if (i2.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (B) found to be empty" << endl; return 1; }
+if (!i2.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (B) must be a vector" << endl; return 1; }
+
+//Set output header info
+o1.F = i1.F; o1.T = i1.T;
+o1.R = i1.R; o1.C = i1.C; o1.S = i1.S; o1.H = i1.H;
+
+//Other prep
+Lx = (dim==0u) ? i1.R : (dim==1u) ? i1.C : (dim==2u) ? i1.S : i1.H;
+Q = i2.N() - 1u;
+P = (Q+Lb) / Lb;
+Lc = (Lb<4096u) ? Lb*(4096u/Lb) : Lb;
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *B, *Hp, *Y;
+    try { B = new float[i2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (B)" << endl; return 1; }
+    try { Hp = new float[2u*(Lb+1u)*P]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for partition spectra" << endl; return 1; }
+    try { ifs2.read(reinterpret_cast<char*>(B),i2.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (B)" << endl; return 1; }
+    if (codee::fir_part_init_s(Hp,B,Q,Lb))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (Lx==i1.N())
+    {
+        //Stream X through in blocks of Lc samps, carrying the state Z between blocks
+        float *Z;
+        try { X = new float[Lc]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+        try { Y = new float[Lc]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        try { Z = new float[Lb+2u*(Lb+1u)*P+1u](); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for filter state" << endl; return 1; }
+        for (size_t l=0u; l<Lx; l+=Lc)
+        {
+            const size_t Mc = (Lx-l<Lc) ? Lx-l : Lc;
+            try { ifs1.read(reinterpret_cast<char*>(X),Mc*sizeof(float)); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+            if (codee::fir_part_s(Y,X,Hp,Z,Mc,1u,1u,1u,i1.iscolmajor(),Q,Lb,0u))
+            { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+            if (wo1)
+            {
+                try { ofs1.write(reinterpret_cast<char*>(Y),Mc*sizeof(float)); ofs1.flush(); }
+                catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+            }
+        }
+        delete[] Z;
+    }
+    else
+    {
+        try { X = new float[i1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+        try { Y = new float[o1.N()]; }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+        try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+        if (codee::fir_part_s(Y,X,Hp,nullptr,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Q,Lb,dim))
+        { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+        if (wo1)
+        {
+            try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+            catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+        }
+    }
+    delete[] X; delete[] B; delete[] Hp; delete[] Y;
+}
+
+//Finish
@@ -0,0 +1,119 @@
+//Includes
+#include <cfloat>
+#include "gammatone.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u};
+const size_t I = 1u, O = 1u;
+size_t NB, ord, otyp;
+double sr, fmin, fmax;
+
+//Description
+string descr;
+descr += "Gammatone filterbank: filters vector (1D signal) X by each of NB\n";
+descr += "gammatone filters, with center freqs uniformly spaced on the ERB-rate scale.\n";
+descr += "\n";
+descr += "This uses the recursive complex one-pole cascade (Holdsworth et al. 1988),\n";
+descr += "so the cost is O(ord) per sample per channel, instead of a long FIR.\n";
+descr += "Each channel has unity gain at its center freq,\n";
+descr += "and bandwidth 1.019*ERB(cf) for ord=4 (Glasberg & Moore 1990).\n";
+descr += "\n";
+descr += "Use -r (--srate) to give the sample rate of X in Hz [default=16000].\n";
+descr += "\n";
+descr += "Use -n (--NB) to give the number of filters (channels) [default=64].\n";
+descr += "\n";
+descr += "Use -l (--fmin) to give the lowest center freq in Hz [default=50].\n";
+descr += "Use -u (--fmax) to give the highest center freq in Hz [default=0.4*srate].\n";
+descr += "\n";
+descr += "Use -p (--order) to give the gammatone filter order [default=4].\n";
+descr += "\n";
+descr += "Include -e (--envelope) to output the envelope (Hilbert magnitude) of each channel.\n";
+descr += "Include -w (--hwr) to output the half-wave rectified bandpass signals.\n";
+descr += "The default is to output the bandpass signals.\n";
+descr += "\n";
+descr += "Samples from one channel are always contiguous in memory, so:\n";
+descr += "If row-major, then Y has size NB x N.\n";
+descr += "If col-major, then Y has size N x NB.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ gammatone X -o Y \n";
+descr += "$ gammatone -r8000 -n32 -l100 -u3500 X > Y \n";
+descr += "$ cat X | gammatone -e -n128 > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input file (X)");
+struct arg_dbl   *a_sr = arg_dbln("r","srate","<dbl>",0,1,"sample rate in Hz [default=16000]");
+struct arg_int   *a_nb = arg_intn("n","NB","<uint>",0,1,"number of filters [default=64]");
+struct arg_dbl   *a_fl = arg_dbln("l","fmin","<dbl>",0,1,"lowest center freq in Hz [default=50]");
+struct arg_dbl   *a_fu = arg_dbln("u","fmax","<dbl>",0,1,"highest center freq in Hz [default=0.4*srate]");
+struct arg_int   *a_or = arg_intn("p","order","<uint>",0,1,"filter order [default=4]");
+struct arg_lit   *a_en = arg_litn("e","envelope",0,1,"include to output the envelopes");
+struct arg_lit   *a_hw = arg_litn("w","hwr",0,1,"include to output half-wave rectified signals");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get sr
+if (a_sr->count==0) { sr = 16000.0; }
+else if (a_sr->dval[0]<DBL_EPSILON) { cerr << progstr+": " << __LINE__ << errstr << "sample rate must be positive" << endl; return 1; }
+else { sr = a_sr->dval[0]; }
+
+//Get NB
+if (a_nb->count==0) { NB = 64u; }
+else if (a_nb->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "NB (number of filters) must be positive" << endl; return 1; }
+else { NB = size_t(a_nb->ival[0]); }
+
+//Get fmin
+if (a_fl->count==0) { fmin = 50.0; }
+else if (a_fl->dval[0]<DBL_EPSILON) { cerr << progstr+": " << __LINE__ << errstr << "fmin must be positive" << endl; return 1; }
+else { fmin = a_fl->dval[0]; }
+
+//Get fmax
+if (a_fu->count==0) { fmax = 0.4 * sr; }
+else if (a_fu->dval[0]<fmin) { cerr << progstr+": " << __LINE__ << errstr << "fmax must be >= fmin" << endl; return 1; }
+else { fmax = a_fu->dval[0]; }
+if (fmax>=0.5*sr) { cerr << progstr+": " << __LINE__ << errstr << "fmax must be < srate/2" << endl; return 1; }
+
+//Get ord
+if (a_or->count==0) { ord = 4u; }
+else if (a_or->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "order must be positive" << endl; return 1; }
+else { ord = size_t(a_or->ival[0]); }
+
+//Get otyp
+if (a_en->count>0 && a_hw->count>0) { cerr << progstr+": " << __LINE__ << errstr << "cannot use both -e and -w" << endl; return 1; }
+otyp = (a_en->count>0) ? 1u : (a_hw->count>0) ? 2u : 0u;
+
+//Checks
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) found to be empty" << endl; return 1; }
+if (!i1.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) must be a vector" << endl; return 1; }
+if (fmin>fmax) { cerr << progstr+": " << __LINE__ << errstr << "fmin must be <= fmax" << endl; return 1; }
+
+//Set output header info
+o1.F = i1.F; o1.T = i1.T;
+o1.R = (i1.isrowmajor()) ? NB : i1.N();
+o1.C = (i1.isrowmajor()) ? i1.N() : NB;
+o1.S = o1.H = 1u;
+
+//Other prep
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *Y;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+    if (codee::gammatone_s(Y,X,nullptr,i1.N(),NB,float(sr),float(fmin),float(fmax),ord,otyp))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] Y;
+}
+
+//Finish
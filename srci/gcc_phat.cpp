@@ -0,0 +1,146 @@
+//Includes
+#include "gcc_phat.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u};
+const size_t I = 2u, O = 1u;
+size_t Nch, N, L, stp, W, nfft, M, P;
+int snip_edges, wt, interp;
+
+//Description
+string descr;
+descr += "GCC-PHAT time-delay estimation for the Nch channels in X1,\n";
+descr += "e.g. for the TDOAs (time differences of arrival) of a microphone array.\n";
+descr += "\n";
+descr += "Each channel of X1 is framed and windowed by X2 (window of length L),\n";
+descr += "exactly as in stft, and the FFT of each frame is taken.\n";
+descr += "For each pair of channels i<j, in the order (0,1) (0,2) ... (0,Nch-1) (1,2) ...,\n";
+descr += "the weighted cross-spectrum is inverse transformed to give the GCC,\n";
+descr += "and the TDOA is the lag (in samples) of the max GCC within lags -M to M.\n";
+descr += "A positive TDOA means that channel i is delayed relative to channel j.\n";
+descr += "\n";
+descr += "The samples of each channel must be contiguous in memory, so:\n";
+descr += "If row-major, then X1 has size Nch x N, and Y has size W x P.\n";
+descr += "If col-major, then X1 has size N x Nch, and Y has size P x W.\n";
+descr += "where P = Nch*(Nch-1)/2 is the number of pairs, and W is the number of frames.\n";
+descr += "So the P TDOAs of each frame are contiguous in memory.\n";
+descr += "\n";
+descr += "Use -s (--step) to give the step-size (frame-shift) in samples [default=160].\n";
+descr += "\n";
+descr += "Use -e (--snip-edges) to set snip-edges to true [default=false].\n";
+descr += "The number of frames (W) is set as in stft (see stft for details).\n";
+descr += "\n";
+descr += "Use -m (--maxlag) to give the max lag M [default=L/4].\n";
+descr += "This is usually set from the max distance between microphones.\n";
+descr += "\n";
+descr += "Use -n (--nfft) to give the FFT length [default is next-pow-2 of L+M].\n";
+descr += "This must be >= L and >= 2*M+2.\n";
+descr += "\n";
+descr += "Use -w (--weighting) to give the weighting of the cross-spectra [default=1].\n";
+descr += "0: none (plain cross-correlation)\n";
+descr += "1: PHAT (phase transform), i.e. divide by the magnitude of the cross-spectrum\n";
+descr += "2: SCOT (smoothed coherence transform), i.e. divide by sqrt(Pi*Pj),\n";
+descr += "   where Pi is the power spectrum of channel i averaged over all frames.\n";
+descr += "\n";
+descr += "Use -i (--interp) to give the sub-sample peak interpolation [default=1].\n";
+descr += "0: none (integer lags)\n";
+descr += "1: parabolic interpolation through the 3 samples around the peak\n";
+descr += "2: sinc (band-limited) interpolation, by Newton iterations on the GCC\n";
+descr += "   (more accurate than parabolic, but slower).\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ gcc_phat -s160 -m16 X1 X2 -o Y \n";
+descr += "$ gcc_phat -e -i2 X1 X2 > Y \n";
+descr += "$ cat X1 | gcc_phat -m16 - X2 > Y \n";
+descr += "$ gcc_phat -s256 -m16 -w2 X1 <(hann -l512) > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input files (X1,X2)");
+struct arg_int  *a_stp = arg_intn("s","step","<uint>",0,1,"step in samps between each frame [default=160]");
+struct arg_lit  *a_sne = arg_litn("e","snip-edges",0,1,"include to snip edges [default=false]");
+struct arg_int    *a_m = arg_intn("m","maxlag","<uint>",0,1,"max lag [default=L/4]");
+struct arg_int  *a_nfft = arg_intn("n","nfft","<uint>",0,1,"FFT length [default=nextpow2(L+M)]");
+struct arg_int   *a_wt = arg_intn("w","weighting","<uint>",0,1,"weighting: 0=none, 1=PHAT, 2=SCOT [default=1]");
+struct arg_int   *a_ip = arg_intn("i","interp","<uint>",0,1,"peak interp: 0=none, 1=parabolic, 2=sinc [default=1]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get stp
+if (a_stp->count==0) { stp = 160u; }
+else if (a_stp->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "stp must be positive" << endl; return 1; }
+else { stp = size_t(a_stp->ival[0]); }
+
+//Get snip_edges
+snip_edges = (a_sne->count>0);
+
+//Get M
+L = i2.N();
+if (a_m->count==0) { M = L/4u; }
+else if (a_m->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "maxlag must be nonnegative" << endl; return 1; }
+else { M = size_t(a_m->ival[0]); }
+
+//Get nfft
+if (a_nfft->count==0) { nfft = 1u; while (nfft<L+M || nfft<2u*M+2u) { nfft *= 2u; } }
+else if (a_nfft->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "nfft must be positive" << endl; return 1; }
+else { nfft = size_t(a_nfft->ival[0]); }
+
+//Get wt
+if (a_wt->count==0) { wt = 1; }
+else if (a_wt->ival[0]<0 || a_wt->ival[0]>2) { cerr << progstr+": " << __LINE__ << errstr << "weighting must be in {0,1,2}" << endl; return 1; }
+else { wt = a_wt->ival[0]; }
+
+//Get interp
+if (a_ip->count==0) { interp = 1; }
+else if (a_ip->ival[0]<0 || a_ip->ival[0]>2) { cerr << progstr+": " << __LINE__ << errstr << "interp must be in {0,1,2}" << endl; return 1; }
+else { interp = a_ip->ival[0]; }
+
+//Checks
+if (i1.iscomplex() || i2.iscomplex()) { cerr << progstr+": " << __LINE__ << errstr << "inputs must be real-valued" << endl; return 1; }
+if (i1.T!=i2.T) { cerr << progstr+": " << __LINE__ << errstr << "inputs must have the same data type" << endl; return 1; }
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X1) found to be empty" << endl; return 1; }
+if (!i1.ismat()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X1) must be a matrix" << endl; return 1; }
+if (!i2.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (X2) must be a vector" << endl; return 1; }
+if (i2.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (X2) found to be empty" << endl; return 1; }
+Nch = (i1.isrowmajor()) ? i1.R : i1.C;
+N = (i1.isrowmajor()) ? i1.C : i1.R;
+if (Nch<2u) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X1) must have at least 2 channels" << endl; return 1; }
+if (snip_edges && L>N) { cerr << progstr+": " << __LINE__ << errstr << "L (winlength) must be <= N if snip-edges" << endl; return 1; }
+if (nfft<L) { cerr << progstr+": " << __LINE__ << errstr << "nfft must be >= L (winlength)" << endl; return 1; }
+if (nfft<2u*M+2u) { cerr << progstr+": " << __LINE__ << errstr << "nfft must be >= 2*M+2" << endl; return 1; }
+
+//Set output header info
+P = Nch*(Nch-1u)/2u;
+W = (snip_edges) ? 1u+(N-L)/stp : (N+stp/2u)/stp;
+o1.F = i1.F; o1.T = i1.T;
+o1.R = (i1.isrowmajor()) ? W : P;
+o1.C = (i1.isrowmajor()) ? P : W;
+o1.S = o1.H = 1u;
+
+//Other prep
+
+//Process
+if (i1.T==1u)
+{
+    float *X1, *X2, *Y;
+    try { X1 = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X1)" << endl; return 1; }
+    try { X2 = new float[i2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (X2)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X1),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X1)" << endl; return 1; }
+    try { ifs2.read(reinterpret_cast<char*>(X2),i2.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (X2)" << endl; return 1; }
+    if (codee::gcc_phat_s(Y,X1,X2,Nch,N,L,nfft,stp,snip_edges,M,wt,interp))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X1; delete[] X2; delete[] Y;
+}
+
+//Finish
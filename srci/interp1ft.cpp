@@ -0,0 +1,104 @@
+//Includes
+#include "interp1ft.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u,101u,102u};
+const size_t I = 1u, O = 1u;
+size_t dim, Lx, Ly;
+
+//Description
+string descr;
+descr += "Band-limited interpolation of each vector in X,\n";
+descr += "by zero-padding (or truncating) in the frequency domain.\n";
+descr += "This is like interpft in Octave, or resample in SciPy.\n";
+descr += "\n";
+descr += "X is assumed to be periodic (so this works best for periodic signals,\n";
+descr += "or for signals that go smoothly to 0 at both ends).\n";
+descr += "\n";
+descr += "Use -n (--N) to give the length of each vector in Y.\n";
+descr += "This can be any positive integer, so Ly/L can be fractional.\n";
+descr += "If Ly<L, then this is band-limited downsampling.\n";
+descr += "\n";
+descr += "Use -d (--dim) to give the dimension along which to interpolate.\n";
+descr += "Default is 0 (along cols), unless X is a row vector.\n";
+descr += "\n";
+descr += "If dim==0, then Y has size Ly x C x S x H.\n";
+descr += "If dim==1, then Y has size R x Ly x S x H.\n";
+descr += "If dim==2, then Y has size R x C x Ly x H.\n";
+descr += "If dim==3, then Y has size R x C x S x Ly.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ interp1ft -n1024 X -o Y \n";
+descr += "$ interp1ft -d1 -n300 X > Y \n";
+descr += "$ cat X | interp1ft -n300 > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input file (X)");
+struct arg_int    *a_n = arg_intn("n","N","<uint>",0,1,"length of vecs in Y [default=2*L]");
+struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"dimension along which to interpolate [default=0]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get dim
+if (a_d->count==0) { dim = i1.isrowvec() ? 1u : 0u; }
+else if (a_d->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "dim must be nonnegative" << endl; return 1; }
+else { dim = size_t(a_d->ival[0]); }
+if (dim>3u) { cerr << progstr+": " << __LINE__ << errstr << "dim must be in {0,1,2,3}" << endl; return 1; }
+
+//Get Ly
+Lx = (dim==0u) ? i1.R : (dim==1u) ? i1.C : (dim==2u) ? i1.S : i1.H;
+if (a_n->count==0) { Ly = 2u*Lx; }
+else if (a_n->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "N (length of output vecs) must be positive" << endl; return 1; }
+else { Ly = size_t(a_n->ival[0]); }
+
+//Checks
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) found to be empty" << endl; return 1; }
+
+//Set output header info
+o1.F = i1.F; o1.T = i1.T;
+o1.R = (dim==0u) ? Ly : i1.R;
+o1.C = (dim==1u) ? Ly : i1.C;
+o1.S = (dim==2u) ? Ly : i1.S;
+o1.H = (dim==3u) ? Ly : i1.H;
+
+//Other prep
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *Y;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+    if (codee::interp1ft_s(Y,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Ly,dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] Y;
+}
+else if (i1.T==101u)
+{
+    float *X, *Y;
+    try { X = new float[2u*i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+    try { Y = new float[2u*o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+    if (codee::interp1ft_c(Y,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Ly,dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] Y;
+}
+
+//Finish
+
@@ -0,0 +1,96 @@
+//Includes
+#include "lattice_fir.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u};
+const size_t I = 2u, O = 1u;
+size_t dim, Lx, V, P, W, stp;
+
+//Description
+string descr;
+descr += "Lattice (all-zero) analysis filter of each vector in X,\n";
+descr += "driven directly by the reflection coefficients (RCs) in RC.\n";
+descr += "This is the whitening (prediction-error) filter A(z), where A = rc2poly(RC),\n";
+descr += "but without converting to polynomial coefficients.\n";
+descr += "Use lattice_iir for the inverse (synthesis) filter 1/A(z).\n";
+descr += "\n";
+descr += "The RCs can be updated per frame: RC has W frames of P RCs for each vector,\n";
+descr += "and frame w is used for samples w*stp to w*stp+stp-1 (the last frame to the end).\n";
+descr += "The P RCs of each frame are contiguous in memory, so for one vector X:\n";
+descr += "If row-major, then RC has size W x P.\n";
+descr += "If col-major, then RC has size P x W.\n";
+descr += "For several vectors in X, the W frames of each vector are in turn,\n";
+descr += "e.g. for W=1, RC has size V x P (row-major) or P x V (col-major).\n";
+descr += "\n";
+descr += "Use -d (--dim) to give the dimension (axis) along which to filter.\n";
+descr += "Use -d0 to operate along cols, -d1 to operate along rows, etc.\n";
+descr += "The default is 0 (along cols), unless X is a row vector.\n";
+descr += "\n";
+descr += "Use -s (--stp) to give the frame step in samples [default=ceil(L/W)].\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ lattice_fir X RC -o Y \n";
+descr += "$ lattice_fir -s160 X RC > Y \n";
+descr += "$ cat X | lattice_fir -d1 - RC > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input files (X,RC)");
+struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"dimension along which to filter [default=0]");
+struct arg_int    *a_s = arg_intn("s","stp","<uint>",0,1,"frame step in samples [default=ceil(L/W)]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get dim
+if (a_d->count==0) { dim = i1.isrowvec() ? 1u : 0u; }
+else if (a_d->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "dim must be nonnegative" << endl; return 1; }
+else { dim = size_t(a_d->ival[0]); }
+if (dim>3u) { cerr << progstr+": " << __LINE__ << errstr << "dim must be in {0,1,2,3}" << endl; return 1; }
+
+//Checks
+if (i1.T!=i2.T) { cerr << progstr+": " << __LINE__ << errstr << "inputs must have the same data type" << endl; return 1; }
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) found to be empty" << endl; return 1; }
+if (i2.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (RC) found to be empty" << endl; return 1; }
+if (!i2.ismat()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (RC) must be a matrix" << endl; return 1; }
+Lx = (dim==0u) ? i1.R : (dim==1u) ? i1.C : (dim==2u) ? i1.S : i1.H;
+V = i1.N() / Lx;
+P = (i2.isrowmajor()) ? i2.C : i2.R;
+if ((i2.N()/P)%V!=0u) { cerr << progstr+": " << __LINE__ << errstr << "number of frames in RC must be a multiple of the number of vectors in X" << endl; return 1; }
+W = i2.N() / (P*V);
+
+//Get stp
+if (a_s->count==0) { stp = (Lx+W-1u) / W; }
+else if (a_s->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "stp must be positive" << endl; return 1; }
+else { stp = size_t(a_s->ival[0]); }
+
+//Set output header info
+o1.F = i1.F; o1.T = i1.T;
+o1.R = i1.R; o1.C = i1.C; o1.S = i1.S; o1.H = i1.H;
+
+//Other prep
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *RC, *Y;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+    try { RC = new float[i2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (RC)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+    try { ifs2.read(reinterpret_cast<char*>(RC),i2.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (RC)" << endl; return 1; }
+    if (codee::lattice_fir_s(Y,X,RC,nullptr,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),P,W,stp,dim))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] RC; delete[] Y;
+}
+
+//Finish
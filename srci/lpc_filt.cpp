@@ -0,0 +1,98 @@
+//Includes
+#include "lpc_filt.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u};
+const size_t I = 2u, O = 1u;
+size_t W, P, stp;
+int syn, interp;
+
+//Description
+string descr;
+descr += "Time-varying (frame-wise) LPC filtering of vector X,\n";
+descr += "with per-frame polynomial coeffs in matrix A (e.g. from sig2poly).\n";
+descr += "The filter runs continuously over X with carried state,\n";
+descr += "so there are no edge discontinuities at frame boundaries.\n";
+descr += "\n";
+descr += "A has W frames of P+1 coeffs (a0 a1 ... aP), usually with a0=1.\n";
+descr += "The coeffs of each frame are contiguous in memory, so:\n";
+descr += "If row-major, then A has size W x (P+1).\n";
+descr += "If col-major, then A has size (P+1) x W.\n";
+descr += "Frame w is used for samples w*stp to w*stp+stp-1 (the last frame to the end).\n";
+descr += "\n";
+descr += "The default is the inverse (analysis) filter, giving the LPC residual:\n";
+descr += "Y[n] = (a0*X[n] + a1*X[n-1] + ... + aP*X[n-P]) / a0\n";
+descr += "\n";
+descr += "Include -y (--synthesis) to use the synthesis filter instead:\n";
+descr += "Y[n] = X[n] - (a1*Y[n-1] + ... + aP*Y[n-P]) / a0\n";
+descr += "\n";
+descr += "Include -i (--interp) to linearly interpolate the coeffs over each hop,\n";
+descr += "from frame w (at sample w*stp) to frame w+1 (at sample w*stp+stp).\n";
+descr += "\n";
+descr += "Use -s (--step) to give the step in samps between frames [default=160].\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ lpc_filt -s80 X A -o E \n";
+descr += "$ lpc_filt -s80 -y E A > Y \n";
+descr += "$ cat X | lpc_filt -i - A > E \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input files (X,A)");
+struct arg_int  *a_stp = arg_intn("s","step","<uint>",0,1,"step in samps between frames [default=160]");
+struct arg_lit  *a_syn = arg_litn("y","synthesis",0,1,"include to use synthesis filter [default=inverse]");
+struct arg_lit  *a_itp = arg_litn("i","interp",0,1,"include to interpolate coeffs over each hop");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get stp
+if (a_stp->count==0) { stp = 160u; }
+else if (a_stp->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "stp must be positive" << endl; return 1; }
+else { stp = size_t(a_stp->ival[0]); }
+
+//Get syn
+syn = (a_syn->count>0);
+
+//Get interp
+interp = (a_itp->count>0);
+
+//Checks
+if (i1.T!=i2.T) { cerr << progstr+": " << __LINE__ << errstr << "inputs must have the same data type" << endl; return 1; }
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) found to be empty" << endl; return 1; }
+if (i2.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (A) found to be empty" << endl; return 1; }
+if (!i1.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) must be a vector" << endl; return 1; }
+if (!i2.ismat()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (A) must be a matrix" << endl; return 1; }
+
+//Set output header info
+o1.F = i1.F; o1.T = i1.T;
+o1.R = i1.R; o1.C = i1.C; o1.S = i1.S; o1.H = i1.H;
+
+//Other prep
+W = (i2.isrowmajor()) ? i2.R : i2.C;
+P = ((i2.isrowmajor()) ? i2.C : i2.R) - 1u;
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *A, *Y;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+    try { A = new float[i2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (A)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+    try { ifs2.read(reinterpret_cast<char*>(A),i2.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (A)" << endl; return 1; }
+    if (codee::lpc_filt_s(Y,X,A,nullptr,i1.N(),W,P,stp,syn,interp))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] A; delete[] Y;
+}
+
+//Finish
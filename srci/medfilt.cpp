@@ -0,0 +1,86 @@
+//Includes
+#include "medfilt.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u};
+const size_t I = 1u, O = 1u;
+size_t dim, W;
+double p;
+
+//Description
+string descr;
+descr += "Sliding median filter of each vector in X.\n";
+descr += "This is like medfilt1 in Octave, with zero-padding at the edges.\n";
+descr += "\n";
+descr += "Use -w (--winlength) to give the window length W [default=3].\n";
+descr += "The window is centered for odd W, i.e. Y[n] uses X[n-h]...X[n+h], h=(W-1)/2.\n";
+descr += "\n";
+descr += "Use -p (--percentile) to output another order statistic [default=50].\n";
+descr += "This outputs the value of rank k = round(p/100*(W-1)) within each window,\n";
+descr += "so -p0 gives a sliding min, and -p100 gives a sliding max.\n";
+descr += "For even W, the median is the lower of the 2 middle values.\n";
+descr += "\n";
+descr += "Each output costs O(log W), so long windows are fine.\n";
+descr += "\n";
+descr += "Use -d (--dim) to give the dimension along which to filter.\n";
+descr += "Default is 0 (along cols), unless X is a row vector.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ medfilt -w5 X -o Y \n";
+descr += "$ medfilt -d1 -w9 -p90 X > Y \n";
+descr += "$ cat X | medfilt -w5 > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input file (X)");
+struct arg_int    *a_w = arg_intn("w","winlength","<uint>",0,1,"window length [default=3]");
+struct arg_dbl    *a_p = arg_dbln("p","percentile","<dbl>",0,1,"percentile in [0 100] [default=50]");
+struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"dimension along which to filter [default=0]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get dim
+if (a_d->count==0) { dim = i1.isrowvec() ? 1u : 0u; }
+else if (a_d->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "dim must be nonnegative" << endl; return 1; }
+else { dim = size_t(a_d->ival[0]); }
+if (dim>3u) { cerr << progstr+": " << __LINE__ << errstr << "dim must be in {0,1,2,3}" << endl; return 1; }
+
+//Get W
+if (a_w->count==0) { W = 3u; }
+else if (a_w->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "W (winlength) must be positive" << endl; return 1; }
+else { W = size_t(a_w->ival[0]); }
+
+//Get p
+p = (a_p->count>0) ? a_p->dval[0] : 50.0;
+if (p<0.0 || p>100.0) { cerr << progstr+": " << __LINE__ << errstr << "p (percentile) must be in [0 100]" << endl; return 1; }
+
+//Checks
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) found to be empty" << endl; return 1; }
+
+//Set output header info
+o1.F = i1.F; o1.T = i1.T;
+o1.R = i1.R; o1.C = i1.C; o1.S = i1.S; o1.H = i1.H;
+
+//Other prep
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *Y;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+    if (codee::medfilt_s(Y,X,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),W,float(p),dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] Y;
+}
+
+//Finish
+
@@ -0,0 +1,87 @@
+//Includes
+#include "ncc.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u};
+const size_t I = 2u, O = 1u;
+size_t N, Nt, L, Ny;
+
+//Description
+string descr;
+descr += "Sliding normalized cross-correlation (NCC) of signal X1 with each template in X2,\n";
+descr += "e.g. for template matching of many templates against one long signal.\n";
+descr += "\n";
+descr += "For each template k, and each position n = 0 to N-L:\n";
+descr += "Y[k][n] = sum_l (X1[n+l]-mx) * (X2[k][l]-mt) / sqrt(sum_l (X1[n+l]-mx)^2 * sum_l (X2[k][l]-mt)^2),\n";
+descr += "where mx is the mean of X1 over the window, and mt is the mean of template k.\n";
+descr += "This is the Pearson correlation at each position, in [-1 1].\n";
+descr += "Where X1 or a template is constant (zero variance), Y is set to 0.\n";
+descr += "\n";
+descr += "X1 is a vector of length N. X2 has Nt templates of length L (L <= N),\n";
+descr += "and only positions where the template is fully within X1 are output (shape 'valid').\n";
+descr += "\n";
+descr += "The samples of each template must be contiguous in memory, so:\n";
+descr += "If row-major, then X2 has size Nt x L, and Y has size Nt x (N-L+1).\n";
+descr += "If col-major, then X2 has size L x Nt, and Y has size (N-L+1) x Nt.\n";
+descr += "\n";
+descr += "The numerators use direct summation or overlap-save FFTs (as in xcorr_auto),\n";
+descr += "with each block of X1 transformed only once for all templates.\n";
+descr += "The denominators use running sums, shared by all templates.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ ncc X1 X2 -o Y \n";
+descr += "$ ncc X1 X2 > Y \n";
+descr += "$ cat X1 | ncc - X2 > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input files (X1,X2)");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Checks
+if (i1.iscomplex() || i2.iscomplex()) { cerr << progstr+": " << __LINE__ << errstr << "inputs must be real-valued" << endl; return 1; }
+if (i1.T!=i2.T) { cerr << progstr+": " << __LINE__ << errstr << "inputs must have the same data type" << endl; return 1; }
+if (!i1.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X1) must be a vector" << endl; return 1; }
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X1) found to be empty" << endl; return 1; }
+if (!i2.ismat()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (X2) must be a matrix" << endl; return 1; }
+if (i2.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (X2) found to be empty" << endl; return 1; }
+N = i1.N();
+Nt = (i2.isrowmajor()) ? i2.R : i2.C;
+L = (i2.isrowmajor()) ? i2.C : i2.R;
+if (L>N) { cerr << progstr+": " << __LINE__ << errstr << "length of templates (L) must be <= length of X1" << endl; return 1; }
+
+//Set output header info
+Ny = N - L + 1u;
+o1.F = i1.F; o1.T = i1.T;
+o1.R = (i2.isrowmajor()) ? Nt : Ny;
+o1.C = (i2.isrowmajor()) ? Ny : Nt;
+o1.S = o1.H = 1u;
+
+//Other prep
+
+//Process
+if (i1.T==1u)
+{
+    float *X1, *X2, *Y;
+    try { X1 = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X1)" << endl; return 1; }
+    try { X2 = new float[i2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (X2)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X1),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X1)" << endl; return 1; }
+    try { ifs2.read(reinterpret_cast<char*>(X2),i2.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (X2)" << endl; return 1; }
+    if (codee::ncc_s(Y,X1,X2,N,Nt,L))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X1; delete[] X2; delete[] Y;
+}
+
+//Finish
@@ -0,0 +1,121 @@
+//Includes
+#include <cfloat>
+#include "pbfdaf.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u};
+const size_t I = 2u, O = 2u;
+size_t Q, Lb;
+double mu, delta;
+
+//Description
+string descr;
+descr += "Partitioned-block frequency-domain adaptive filter (PBFDAF or MDF),\n";
+descr += "with NLMS step-size normalization in each frequency bin.\n";
+descr += "This is the usual adaptive filter for acoustic echo cancellation.\n";
+descr += "\n";
+descr += "X is the far-end reference signal, and D is the near-end (mic) signal.\n";
+descr += "The adaptive FIR filter W (length Q+1) models the echo path from X to D,\n";
+descr += "and the error E = D - W*X is the echo-cancelled output.\n";
+descr += "\n";
+descr += "W is split into partitions of length Lb (the block size),\n";
+descr += "so the cost per sample is O(log Lb) + O((Q+1)/Lb), instead of O(Q).\n";
+descr += "The latency is Lb samples.\n";
+descr += "\n";
+descr += "Use -l (--L) to give the filter length Q+1 [default=1024].\n";
+descr += "\n";
+descr += "Use -b (--blocksize) to give the block (partition) length [default=256].\n";
+descr += "\n";
+descr += "Use -m (--mu) to give the step size in (0 1] [default=0.5].\n";
+descr += "Smaller mu adapts slower, but is more robust to near-end talk.\n";
+descr += "\n";
+descr += "Use -r (--delta) to give the regularization (in units of signal power) [default=1e-6].\n";
+descr += "\n";
+descr += "The 1st output is E (same size as D),\n";
+descr += "and the 2nd output is the final filter W (a vector of length Q+1).\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ pbfdaf X D -o E -o W \n";
+descr += "$ pbfdaf -l4096 -b512 -m0.3 X D -o E -o W \n";
+descr += "$ cat D | pbfdaf X - > E \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input files (X,D)");
+struct arg_int    *a_l = arg_intn("l","L","<uint>",0,1,"filter length (Q+1) [default=1024]");
+struct arg_int    *a_b = arg_intn("b","blocksize","<uint>",0,1,"block size (partition length) [default=256]");
+struct arg_dbl    *a_m = arg_dbln("m","mu","<dbl>",0,1,"step size [default=0.5]");
+struct arg_dbl    *a_r = arg_dbln("r","delta","<dbl>",0,1,"regularization [default=1e-6]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output files (E,W)");
+
+//Get options
+
+//Get Q
+if (a_l->count==0) { Q = 1023u; }
+else if (a_l->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "L (filter length) must be positive" << endl; return 1; }
+else { Q = size_t(a_l->ival[0]) - 1u; }
+
+//Get Lb
+if (a_b->count==0) { Lb = 256u; }
+else if (a_b->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "blocksize must be positive" << endl; return 1; }
+else { Lb = size_t(a_b->ival[0]); }
+
+//Get mu
+if (a_m->count==0) { mu = 0.5; }
+else if (a_m->dval[0]<DBL_EPSILON) { cerr << progstr+": " << __LINE__ << errstr << "mu (step size) must be positive" << endl; return 1; }
+else { mu = a_m->dval[0]; }
+
+//Get delta
+if (a_r->count==0) { delta = 1e-6; }
+else if (a_r->dval[0]<0.0) { cerr << progstr+": " << __LINE__ << errstr << "delta (regularization) must be nonnegative" << endl; return 1; }
+else { delta = a_r->dval[0]; }
+
+//Checks
+if (i1.T!=i2.T) { cerr << progstr+": " << __LINE__ << errstr << "inputs must have the same data type" << endl; return 1; }
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) found to be empty" << endl; return 1; }
+if (i2.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (D) found to be empty" << endl; return 1; }
+if (!i1.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 1 (X) must be a vector" << endl; return 1; }
+if (!i2.isvec()) { cerr << progstr+": " << __LINE__ << errstr << "input 2 (D) must be a vector" << endl; return 1; }
+if (i1.N()!=i2.N()) { cerr << progstr+": " << __LINE__ << errstr << "inputs 1 and 2 (X and D) must have the same length" << endl; return 1; }
+
+//Set output header info
+o1.F = o2.F = i2.F;
+o1.T = o2.T = i2.T;
+o1.R = i2.R; o1.C = i2.C; o1.S = i2.S; o1.H = i2.H;
+o2.R = (i2.isrowvec()) ? 1u : Q+1u;
+o2.C = (i2.isrowvec()) ? Q+1u : 1u;
+o2.S = o2.H = 1u;
+
+//Other prep
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *D, *E, *W;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 1 (X)" << endl; return 1; }
+    try { D = new float[i2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file 2 (D)" << endl; return 1; }
+    try { E = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file 1 (E)" << endl; return 1; }
+    try { W = new float[o2.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file 2 (W)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 1 (X)" << endl; return 1; }
+    try { ifs2.read(reinterpret_cast<char*>(D),i2.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file 2 (D)" << endl; return 1; }
+    if (codee::pbfdaf_s(E,W,X,D,nullptr,i1.N(),Q,Lb,float(mu),float(delta)))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(E),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file 1 (E)" << endl; return 1; }
+    }
+    if (wo2)
+    {
+        try { ofs2.write(reinterpret_cast<char*>(W),o2.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file 2 (W)" << endl; return 1; }
+    }
+    delete[] X; delete[] D; delete[] E; delete[] W;
+}
+
+//Finish
@@ -7,6 +7,7 @@ const valarray<size_t> oktypes = {1u,2u,101u,102u};
 const size_t I = 0u, O = 1u;
 size_t N, dim, samp, w;
 double amp;
+int ev;
 
 //Description
 string descr;
@@ -26,6 +27,10 @@ descr += "Use -s (--samp) to give the sample number of the impulse [default=0].\
 descr += "\n";
 descr += "Use -w (--width) to give the sample number of the impulse [default=0].\n";
 descr += "\n";
+descr += "Include -e (--events) to output an event list instead (see densify),\n";
+descr += "which has a 6-element header, then the index of each samp of the pulse, and then the values.\n";
+descr += "Y is then a column vector of doubles (and -t is only used by densify).\n";
+descr += "\n";
 descr += "Since this is a generating function (no inputs), the output data type\n";
 descr += "and file format can be specified by -t and -f, respectively. \n";
 descr += "\n";
@@ -33,6 +38,7 @@ descr += "Examples:\n";
 descr += "$ rect_pulse -n32 -w3 -o Y \n";
 descr += "$ rect_pulse -n32 -s9 > Y \n";
 descr += "$ rect_pulse -n32 -s1 -w5 -d1 -t1 -f101 > Y \n";
+descr += "$ rect_pulse -n32 -s9 -w5 -e > Y \n";
 
 //Argtable
 struct arg_dbl  *a_amp = arg_dbln("a","amp","<dbl>",0,1,"amplitude [default=1.0]");
@@ -42,6 +48,7 @@ struct arg_int    *a_n = arg_intn("n","N","<uint>",0,1,"num samples in output [d
 struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"nonsingleton dimension [default=0 -> col vec]");
 struct arg_int *a_otyp = arg_intn("t","type","<uint>",0,1,"output data type [default=1]");
 struct arg_int *a_ofmt = arg_intn("f","fmt","<uint>",0,1,"output file format [default=147]");
+struct arg_lit    *a_e = arg_litn("e","events",0,1,"output event list instead of signal");
 struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
 
 //Get options
@@ -91,6 +98,9 @@ amp = (a_amp->count>0) ? a_amp->dval[0] : 1.0;
 if (o1.T==1u && amp<=-double(FLT_MAX)) { cerr << progstr+": " << __LINE__ << errstr << "amplitude must be > " << -double(FLT_MAX) << endl; return 1; }
 if (o1.T==1u && amp>=double(FLT_MAX)) { cerr << progstr+": " << __LINE__ << errstr << "amplitude must be < " << double(FLT_MAX) << endl; return 1; }
 
+//Get ev
+ev = (a_e->count>0);
+
 //Checks
 
 //Set output header info
@@ -98,11 +108,26 @@ o1.R = (dim==0u) ? N : 1u;
 o1.C = (dim==1u) ? N : 1u;
 o1.S = (dim==2u) ? N : 1u;
 o1.H = (dim==3u) ? N : 1u;
+if (ev) { o1.T = 2u; o1.R = 6u+2u*w; o1.C = o1.S = o1.H = 1u; }
 
 //Other prep
 
 //Process
-if (o1.T==1u)
+if (ev)
+{
+    double *Y;
+    try { Y = new double[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    if (codee::rect_pulse_events(Y,(dim==0u)?N:1u,(dim==1u)?N:1u,(dim==2u)?N:1u,(dim==3u)?N:1u,samp,w,amp))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] Y;
+}
+else if (o1.T==1u)
 {
     float *Y;
     try { Y = new float[o1.N()]; }
@@ -0,0 +1,141 @@
+//Includes
+#include "resample.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u,101u,102u};
+const size_t I = 1u, O = 1u;
+size_t dim, p, q, Nz, Lx, Ly, Lb, g;
+double beta;
+
+//Description
+string descr;
+descr += "Resamples each vector in X by the rational factor p/q,\n";
+descr += "using a polyphase FIR filter (like resample_poly in SciPy).\n";
+descr += "Only the kept output samples are computed.\n";
+descr += "\n";
+descr += "The filter is a Kaiser-windowed sinc lowpass, with cutoff at the\n";
+descr += "lower of the input and output Nyquist frequencies.\n";
+descr += "The filter delay is compensated, so the output is aligned with X.\n";
+descr += "\n";
+descr += "Use -p (--up) to give the upsample factor [default=1].\n";
+descr += "Use -q (--down) to give the downsample factor [default=1].\n";
+descr += "These are divided by their gcd (so -p16000 -q44100 is p=160, q=441).\n";
+descr += "\n";
+descr += "Use -n (--nzc) to give the number of zero-crossings of the sinc\n";
+descr += "on each side of the filter center (the quality) [default=10].\n";
+descr += "The filter length is 2*n*max(p,q)+1 (after division by gcd).\n";
+descr += "\n";
+descr += "Use -b (--beta) to give the Kaiser window parameter [default=5.0].\n";
+descr += "\n";
+descr += "Use -d (--dim) to give the dimension along which to resample.\n";
+descr += "Default is 0 (along cols), unless X is a row vector.\n";
+descr += "\n";
+descr += "The length of each vector in Y is Ly = ceil(L*p/q).\n";
+descr += "If dim==0, then Y has size Ly x C x S x H.\n";
+descr += "If dim==1, then Y has size R x Ly x S x H.\n";
+descr += "If dim==2, then Y has size R x C x Ly x H.\n";
+descr += "If dim==3, then Y has size R x C x S x Ly.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ resample -p16000 -q44100 X -o Y \n";
+descr += "$ resample -d1 -p1 -q3 X > Y \n";
+descr += "$ cat X | resample -p3 -q2 -n20 -b8 > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input file (X)");
+struct arg_int    *a_p = arg_intn("p","up","<uint>",0,1,"upsample factor [default=1]");
+struct arg_int    *a_q = arg_intn("q","down","<uint>",0,1,"downsample factor [default=1]");
+struct arg_int    *a_n = arg_intn("n","nzc","<uint>",0,1,"num zero-crossings on each side [default=10]");
+struct arg_dbl    *a_b = arg_dbln("b","beta","<dbl>",0,1,"Kaiser window parameter [default=5.0]");
+struct arg_int    *a_d = arg_intn("d","dim","<uint>",0,1,"dimension along which to resample [default=0]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get dim
+if (a_d->count==0) { dim = i1.isrowvec() ? 1u : 0u; }
+else if (a_d->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "dim must be nonnegative" << endl; return 1; }
+else { dim = size_t(a_d->ival[0]); }
+if (dim>3u) { cerr << progstr+": " << __LINE__ << errstr << "dim must be in {0,1,2,3}" << endl; return 1; }
+
+//Get p
+if (a_p->count==0) { p = 1u; }
+else if (a_p->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "p (upsample factor) must be positive" << endl; return 1; }
+else { p = size_t(a_p->ival[0]); }
+
+//Get q
+if (a_q->count==0) { q = 1u; }
+else if (a_q->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "q (downsample factor) must be positive" << endl; return 1; }
+else { q = size_t(a_q->ival[0]); }
+
+//Get Nz
+if (a_n->count==0) { Nz = 10u; }
+else if (a_n->ival[0]<1) { cerr << progstr+": " << __LINE__ << errstr << "n (num zero-crossings) must be positive" << endl; return 1; }
+else { Nz = size_t(a_n->ival[0]); }
+
+//Get beta
+beta = (a_b->count>0) ? a_b->dval[0] : 5.0;
+if (beta<0.0) { cerr << progstr+": " << __LINE__ << errstr << "beta must be nonnegative" << endl; return 1; }
+
+//Checks
+Lx = (dim==0u) ? i1.R : (dim==1u) ? i1.C : (dim==2u) ? i1.S : i1.H;
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) found to be empty" << endl; return 1; }
+if (Lx<2u) { cerr << progstr+": " << __LINE__ << errstr << "cannot work along a singleton dimension" << endl; return 1; }
+
+//Set output header info
+g = p; for (size_t r=q, t; r>0u; ) { t = g%r; g = r; r = t; }
+p /= g; q /= g;
+Ly = (Lx*p+q-1u) / q;
+o1.F = i1.F; o1.T = i1.T;
+o1.R = (dim==0u) ? Ly : i1.R;
+o1.C = (dim==1u) ? Ly : i1.C;
+o1.S = (dim==2u) ? Ly : i1.S;
+o1.H = (dim==3u) ? Ly : i1.H;
+
+//Other prep
+Lb = 2u*Nz*((p>q) ? p : q) + 1u;
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *B, *Y;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+    try { B = new float[Lb]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for filter (B)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+    if (codee::resample_design_s(B,p,q,Nz,float(beta))) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (codee::resample_s(Y,X,B,nullptr,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Lb,p,q,dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] B; delete[] Y;
+}
+else if (i1.T==101u)
+{
+    float *X, *B, *Y;
+    try { X = new float[2u*i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+    try { B = new float[Lb]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for filter (B)" << endl; return 1; }
+    try { Y = new float[2u*o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+    if (codee::resample_design_s(B,p,q,Nz,float(beta))) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (codee::resample_c(Y,X,B,nullptr,i1.R,i1.C,i1.S,i1.H,i1.iscolmajor(),Lb,p,q,dim)) { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] B; delete[] Y;
+}
+
+//Finish
+
@@ -10,7 +10,7 @@ size_t dim, L1, Ly, str, dil, pad;
 string descr;
 descr += "1D cross-correlation of each vector in X1 with X2.\n";
 descr += "This gives same result as xcorr1d, but uses FFT internally.\n";
-descr += "This has not been found to be faster than xcorr1d.\n";
+descr += "This uses overlap-save with a cached FFT of X2, and is meant for long X2.\n";
 descr += "\n";
 descr += "Use -d (--dim) to give the dimension (axis) along which to operate.\n";
 descr += "Use -d0 to operate along cols, -d1 to operate along rows, etc.\n";
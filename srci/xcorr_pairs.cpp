@@ -0,0 +1,100 @@
+//Includes
+#include "xcorr_pairs.c"
+
+//Declarations
+const valarray<size_t> oktypes = {1u,2u,101u,102u};
+const size_t I = 1u, O = 1u;
+size_t Nch, L, M, P;
+
+//Description
+string descr;
+descr += "All-pairs cross-correlation of the Nch channels in X,\n";
+descr += "e.g. for the cross-correlation matrix of a microphone array.\n";
+descr += "\n";
+descr += "For each pair of channels i<=j, in the order (0,0) (0,1) ... (0,Nch-1) (1,1) ...,\n";
+descr += "Yij[m] = sum_n Xi[n+m] * conj(Xj[n]), for lags m = -M to M.\n";
+descr += "So there are P = Nch*(Nch+1)/2 pairs, each with 2*M+1 lags.\n";
+descr += "\n";
+descr += "Each channel is transformed (FFT) only once, and the cross-spectra\n";
+descr += "are inverse transformed in batches, so this is much faster than\n";
+descr += "running xcorr for each pair. For small M, direct summation is used.\n";
+descr += "\n";
+descr += "The samples of each channel must be contiguous in memory, so:\n";
+descr += "If row-major, then X has size Nch x L, and Y has size P x (2*M+1).\n";
+descr += "If col-major, then X has size L x Nch, and Y has size (2*M+1) x P.\n";
+descr += "\n";
+descr += "Use -m (--maxlag) to give the max lag M [default=L-1].\n";
+descr += "Only lags -M to M are computed, which also reduces the FFT length.\n";
+descr += "\n";
+descr += "Examples:\n";
+descr += "$ xcorr_pairs X -o Y \n";
+descr += "$ xcorr_pairs -m32 X > Y \n";
+descr += "$ cat X | xcorr_pairs -m100 > Y \n";
+
+//Argtable
+struct arg_file  *a_fi = arg_filen(nullptr,nullptr,"<file>",I-1,I,"input file (X)");
+struct arg_int    *a_m = arg_intn("m","maxlag","<uint>",0,1,"max lag [default=L-1]");
+struct arg_file  *a_fo = arg_filen("o","ofile","<file>",0,O,"output file (Y)");
+
+//Get options
+
+//Get M
+L = (i1.isrowmajor()) ? i1.C : i1.R;
+if (a_m->count==0) { M = (L>0u) ? L-1u : 0u; }
+else if (a_m->ival[0]<0) { cerr << progstr+": " << __LINE__ << errstr << "maxlag must be nonnegative" << endl; return 1; }
+else { M = size_t(a_m->ival[0]); }
+
+//Checks
+if (i1.isempty()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) found to be empty" << endl; return 1; }
+if (!i1.ismat()) { cerr << progstr+": " << __LINE__ << errstr << "input (X) must be a matrix" << endl; return 1; }
+Nch = (i1.isrowmajor()) ? i1.R : i1.C;
+P = Nch*(Nch+1u)/2u;
+if (M>=L) { cerr << progstr+": " << __LINE__ << errstr << "maxlag must be < L (length of channels)" << endl; return 1; }
+
+//Set output header info
+o1.F = i1.F; o1.T = i1.T;
+o1.R = (i1.isrowmajor()) ? P : 2u*M+1u;
+o1.C = (i1.isrowmajor()) ? 2u*M+1u : P;
+o1.S = o1.H = 1u;
+
+//Other prep
+
+//Process
+if (i1.T==1u)
+{
+    float *X, *Y;
+    try { X = new float[i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+    try { Y = new float[o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+    if (codee::xcorr_pairs_s(Y,X,Nch,L,M))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] Y;
+}
+else if (i1.T==101u)
+{
+    float *X, *Y;
+    try { X = new float[2u*i1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for input file (X)" << endl; return 1; }
+    try { Y = new float[2u*o1.N()]; }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem allocating for output file (Y)" << endl; return 1; }
+    try { ifs1.read(reinterpret_cast<char*>(X),i1.nbytes()); }
+    catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem reading input file (X)" << endl; return 1; }
+    if (codee::xcorr_pairs_c(Y,X,Nch,L,M))
+    { cerr << progstr+": " << __LINE__ << errstr << "problem during function call" << endl; return 1; }
+    if (wo1)
+    {
+        try { ofs1.write(reinterpret_cast<char*>(Y),o1.nbytes()); }
+        catch (...) { cerr << progstr+": " << __LINE__ << errstr << "problem writing output file (Y)" << endl; return 1; }
+    }
+    delete[] X; delete[] Y;
+}
+
+//Finish